@@ -256,6 +256,17 @@ void			Sys_LeaveCriticalSection(int index) {}
 void			Sys_WaitForEvent(int index) {}
 void			Sys_TriggerEvent(int index) {}
 
+void			Sys_ParallelJobs(xjob_t function, void *data, int count)
+{
+	for (int i = 0; i < count; i++) {
+		function(data, i);
+	}
+}
+int				Sys_NumJobThreads(void)
+{
+	return 0;
+}
+
 /*
 ==============
 idSysLocal stub
@@ -341,6 +352,15 @@ sysEvent_t		idSysLocal::GenerateMouseMoveEvent(int deltax, int deltay)
 void			idSysLocal::OpenURL(const char *url, bool quit) { }
 void			idSysLocal::StartProcess(const char *exeName, bool quit) { }
 
+void			idSysLocal::ParallelJobs(xjob_t function, void *data, int count)
+{
+	Sys_ParallelJobs(function, data, count);
+}
+int				idSysLocal::NumJobThreads(void)
+{
+	return 0;
+}
+
 void			idSysLocal::FPU_EnableExceptions(int exceptions) { }
 
 idSysLocal		sysLocal;
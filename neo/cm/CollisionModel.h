@@ -80,6 +80,21 @@ typedef struct trace_s {
 
 typedef int cmHandle_t;
 
+// translation for a batch
+typedef struct cm_translation_s {
+	trace_t					results;		// collision result
+	idVec3					start;			// start of the translation
+	idVec3					end;			// end of the translation
+	const idTraceModel *	trm;			// trace model to translate, NULL for a point
+	idMat3					trmAxis;		// orientation of the trace model
+	int						contentMask;	// contents to collide with
+	cmHandle_t				model;			// model to collide with
+	const idTraceModel *	modelTrm;		// if set this trace model is collided with instead of the model
+	const idMaterial *		modelMaterial;	// material for the modelTrm polygons
+	idVec3					modelOrigin;	// position of the model
+	idMat3					modelAxis;		// orientation of the model
+} cm_translation_t;
+
 #define CM_CLIP_EPSILON		0.25f			// always stay this distance away from any model
 #define CM_BOX_EPSILON		1.0f			// should always be larger than clip epsilon
 #define CM_MAX_TRACE_DIST	4096.0f			// maximum distance a trace model may be traced, point traces are unlimited
@@ -118,6 +133,9 @@ class idCollisionModelManager
 		virtual void			Translation(trace_t *results, const idVec3 &start, const idVec3 &end,
 		                const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 		                cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis) = 0;
+		// Translates a batch of trace models, the translations are spread over the job threads.
+		// Must be called from the game thread. The results are the same as calling Translation for each one.
+		virtual void			Translations(cm_translation_t *translations, int numTranslations) = 0;
 		// Rotates a trace model and reports the first collision if any.
 		virtual void			Rotation(trace_t *results, const idVec3 &start, const idRotation &rotation,
 		                const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -60,12 +60,10 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush(cm_traceWork_t *tw, cm_br
 	float d, bestd;
 	idVec3 *p;
 
-	if (b->checkcount == idCollisionModelManagerLocal::checkCount) {
+	if (CM_CheckPrimitive(tw, &b->checkcount)) {
 		return false;
 	}
 
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
-
 	if (!(b->contents & tw->contents)) {
 		return false;
 	}
@@ -81,6 +79,26 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush(cm_traceWork_t *tw, cm_br
 		numVerts = tw->numVerts;
 	}
 
+	// test four trm vertices at a time
+	if (tw->simd) {
+		j = CM_SoAFirstPointInside(b->planes, b->numPlanes, tw->soaVerts.p, numVerts, bestPlane);
+
+		if (j >= 0) {
+			tw->trace.fraction = 0.0f;
+			tw->trace.c.type = CONTACT_TRMVERTEX;
+			tw->trace.c.normal = b->planes[bestPlane].Normal();
+			tw->trace.c.dist = b->planes[bestPlane].Dist();
+			tw->trace.c.contents = b->contents;
+			tw->trace.c.material = b->material;
+			tw->trace.c.point = tw->vertices[j].p;
+			tw->trace.c.modelFeature = 0;
+			tw->trace.c.trmFeature = j;
+			return true;
+		}
+
+		return false;
+	}
+
 	for (j = 0; j < numVerts; j++) {
 		p = &tw->vertices[j].p;
 
@@ -123,12 +141,12 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush(cm_traceWork_t *tw, cm_br
 CM_SetTrmEdgeSidedness
 ================
 */
-#define CM_SetTrmEdgeSidedness( edge, bpl, epl, bitNum ) {							\
-	if ( !(edge->sideSet & (1<<bitNum)) ) {											\
+#define CM_SetTrmEdgeSidedness( mark, bpl, epl, bitNum ) {							\
+	if ( !((mark)->sideSet & (1<<bitNum)) ) {										\
 		float fl;																	\
 		fl = (bpl).PermutedInnerProduct( epl );										\
-		edge->side = (edge->side & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);	\
-		edge->sideSet |= (1 << bitNum);												\
+		(mark)->side = ((mark)->side & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);	\
+		(mark)->sideSet |= (1 << bitNum);											\
 	}																				\
 }
 
@@ -137,18 +155,18 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {								\
-	if ( !((v)->sideSet & (1<<bitNum)) ) {											\
+#define CM_SetTrmPolygonSidedness( v, mark, plane, bitNum ) {						\
+	if ( !((mark)->sideSet & (1<<bitNum)) ) {										\
 		float fl;																	\
 		fl = plane.Distance( (v)->p );												\
 		/* cannot use float sign bit because it is undetermined when fl == 0.0f */	\
 		if ( fl < 0.0f ) {															\
-			(v)->side |= (1 << bitNum);												\
+			(mark)->side |= (1 << bitNum);											\
 		}																			\
 		else {																		\
-			(v)->side &= ~(1 << bitNum);											\
+			(mark)->side &= ~(1 << bitNum);											\
 		}																			\
-		(v)->sideSet |= (1 << bitNum);												\
+		(mark)->sideSet |= (1 << bitNum);											\
 	}																				\
 }
 
@@ -167,14 +185,13 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 	cm_trmEdge_t *trmEdge;
 	cm_edge_t *edge;
 	cm_vertex_t *v, *v1, *v2;
+	cm_mark_t *mark, *v1Mark, *v2Mark;
 
 	// if already checked this polygon
-	if (p->checkcount == idCollisionModelManagerLocal::checkCount) {
+	if (CM_CheckPrimitive(tw, &p->checkcount)) {
 		return false;
 	}
 
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
-
 	// if this polygon does not have the right contents behind it
 	if (!(p->contents & tw->contents)) {
 		return false;
@@ -208,7 +225,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 			edge = tw->model->edges + abs(edgeNum);
 
 			// if this edge is already tested
-			if (edge->checkcount == idCollisionModelManagerLocal::checkCount) {
+			if (CM_EdgeMark(tw, edge)->checkcount == tw->checkCount) {
 				continue;
 			}
 
@@ -216,7 +233,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 				v = &tw->model->vertices[edge->vertexNum[j]];
 
 				// if this vertex is already tested
-				if (v->checkcount == idCollisionModelManagerLocal::checkCount) {
+				if (CM_VertexMark(tw, v)->checkcount == tw->checkCount) {
 					continue;
 				}
 
@@ -257,8 +274,10 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 		edge = tw->model->edges + abs(edgeNum);
 
 		// reset sidedness cache if this is the first time we encounter this edge
-		if (edge->checkcount != idCollisionModelManagerLocal::checkCount) {
-			edge->sideSet = 0;
+		mark = CM_EdgeMark(tw, edge);
+
+		if (mark->checkcount != tw->checkCount) {
+			mark->sideSet = 0;
 		}
 
 		// pluecker coordinate for edge
@@ -267,17 +286,27 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 		v = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]];
 
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if (v->checkcount != idCollisionModelManagerLocal::checkCount) {
-			v->sideSet = 0;
+		mark = CM_VertexMark(tw, v);
+
+		if (mark->checkcount != tw->checkCount) {
+			mark->sideSet = 0;
 		}
 
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		mark->checkcount = tw->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
-	for (i = 0; i < tw->numVerts; i++) {
-		d = p->plane.Distance(tw->vertices[i].p);
-		sides[i] = d < 0.0f ? -1 : 1;
+	if (tw->simd) {
+		CM_SoAPlaneDistances(tw->soaStartDist, p->plane, tw->soaVerts.p, tw->soaVerts.count);
+
+		for (i = 0; i < tw->numVerts; i++) {
+			sides[i] = tw->soaStartDist[i] < 0.0f ? -1 : 1;
+		}
+	} else {
+		for (i = 0; i < tw->numVerts; i++) {
+			d = p->plane.Distance(tw->vertices[i].p);
+			sides[i] = d < 0.0f ? -1 : 1;
+		}
 	}
 
 	// test if any trm edges go through the polygon
@@ -295,9 +324,10 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 			edgeNum = p->edges[j];
 			edge = tw->model->edges + abs(edgeNum);
 #if 1
-			CM_SetTrmEdgeSidedness(edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i);
+			mark = CM_EdgeMark(tw, edge);
+			CM_SetTrmEdgeSidedness(mark, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i);
 
-			if (INTSIGNBITSET(edgeNum) ^((edge->side >> i) & 1) ^ flip) {
+			if (INTSIGNBITSET(edgeNum) ^((mark->side >> i) & 1) ^ flip) {
 				break;
 			}
 
@@ -339,26 +369,29 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 	for (i = 0; i < p->numEdges; i++) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		mark = CM_EdgeMark(tw, edge);
 
-		if (edge->checkcount == idCollisionModelManagerLocal::checkCount) {
+		if (mark->checkcount == tw->checkCount) {
 			continue;
 		}
 
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		mark->checkcount = tw->checkCount;
 
 		for (j = 0; j < tw->numPolys; j++) {
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness(v1, tw->polys[j].plane, j);
+			v1Mark = CM_VertexMark(tw, v1);
+			CM_SetTrmPolygonSidedness(v1, v1Mark, tw->polys[j].plane, j);
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness(v2, tw->polys[j].plane, j);
+			v2Mark = CM_VertexMark(tw, v2);
+			CM_SetTrmPolygonSidedness(v2, v2Mark, tw->polys[j].plane, j);
 
 			// if the polygon edge does not cross the trm polygon plane
-			if (!(((v1->side ^ v2->side) >> j) & 1)) {
+			if (!(((v1Mark->side ^ v2Mark->side) >> j) & 1)) {
 				continue;
 			}
 
-			flip = (v1->side >> j) & 1;
+			flip = (v1Mark->side >> j) & 1;
 #else
 			float d1, d2;
 
@@ -386,9 +419,9 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon(cm_traceWork_t *tw, cm_polyg
 				trmEdge = tw->edges + abs(trmEdgeNum);
 #if 1
 				bitNum = abs(trmEdgeNum);
-				CM_SetTrmEdgeSidedness(edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum);
+				CM_SetTrmEdgeSidedness(mark, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum);
 
-				if (INTSIGNBITSET(trmEdgeNum) ^((edge->side >> bitNum) & 1) ^ flip) {
+				if (INTSIGNBITSET(trmEdgeNum) ^((mark->side >> bitNum) & 1) ^ flip) {
 					break;
 				}
 
@@ -459,7 +492,7 @@ cm_node_t *idCollisionModelManagerLocal::PointNode(const idVec3 &p, cm_model_t *
 idCollisionModelManagerLocal::PointContents
 ================
 */
-int idCollisionModelManagerLocal::PointContents(const idVec3 p, cmHandle_t model)
+int idCollisionModelManagerLocal::PointContents(const idVec3 p, cmHandle_t model, int slot)
 {
 	int i;
 	float d;
@@ -468,7 +501,7 @@ int idCollisionModelManagerLocal::PointContents(const idVec3 p, cmHandle_t model
 	cm_brush_t *b;
 	idPlane *plane;
 
-	node = idCollisionModelManagerLocal::PointNode(p, idCollisionModelManagerLocal::models[model]);
+	node = idCollisionModelManagerLocal::PointNode(p, ModelForSlot(slot, model));
 
 	for (bref = node->brushes; bref; bref = bref->next) {
 		b = bref->b;
@@ -512,7 +545,7 @@ int idCollisionModelManagerLocal::PointContents(const idVec3 p, cmHandle_t model
 idCollisionModelManagerLocal::TransformedPointContents
 ==================
 */
-int	idCollisionModelManagerLocal::TransformedPointContents(const idVec3 &p, cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis)
+int	idCollisionModelManagerLocal::TransformedPointContents(const idVec3 &p, cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis, int slot)
 {
 	idVec3 p_l;
 
@@ -523,7 +556,7 @@ int	idCollisionModelManagerLocal::TransformedPointContents(const idVec3 &p, cmHa
 		p_l *= modelAxis;
 	}
 
-	return idCollisionModelManagerLocal::PointContents(p_l, model);
+	return idCollisionModelManagerLocal::PointContents(p_l, model, slot);
 }
 
 
@@ -532,7 +565,7 @@ int	idCollisionModelManagerLocal::TransformedPointContents(const idVec3 &p, cmHa
 idCollisionModelManagerLocal::ContentsTrm
 ==================
 */
-int idCollisionModelManagerLocal::ContentsTrm(trace_t *results, const idVec3 &start,
+int idCollisionModelManagerLocal::ContentsTrm(int slot, trace_t *results, const idVec3 &start,
                 const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
                 cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis)
 {
@@ -547,7 +580,7 @@ int idCollisionModelManagerLocal::ContentsTrm(trace_t *results, const idVec3 &st
 	             trm->bounds[1][1] - trm->bounds[0][1] <= 0.0f &&
 	             trm->bounds[1][2] - trm->bounds[0][2] <= 0.0f)) {
 
-		results->c.contents = idCollisionModelManagerLocal::TransformedPointContents(start, model, modelOrigin, modelAxis);
+		results->c.contents = idCollisionModelManagerLocal::TransformedPointContents(start, model, modelOrigin, modelAxis, slot);
 		results->fraction = (results->c.contents == 0);
 		results->endpos = start;
 		results->endAxis = trmAxis;
@@ -555,7 +588,8 @@ int idCollisionModelManagerLocal::ContentsTrm(trace_t *results, const idVec3 &st
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.slot = slot;
+	tw.checkCount = NextCheckCount(slot);
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -566,8 +600,9 @@ int idCollisionModelManagerLocal::ContentsTrm(trace_t *results, const idVec3 &st
 	tw.positionTest = true;
 	tw.pointTrace = false;
 	tw.quickExit = false;
+	tw.simd = false;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = ModelForSlot(slot, model);
 	tw.start = start - modelOrigin;
 	tw.end = tw.start;
 
@@ -627,6 +662,11 @@ int idCollisionModelManagerLocal::ContentsTrm(trace_t *results, const idVec3 &st
 		tw.size.AddPoint(tw.vertices[i].p - tw.start);
 	}
 
+	if (cm_simd.GetBool()) {
+		CM_SetupTrmVertexSoA(&tw.soaVerts, tw.vertices, tw.numVerts, false);
+		tw.simd = true;
+	}
+
 	// setup trm edges
 	for (i = 1; i <= tw.numEdges; i++) {
 		// edge start, end and pluecker coordinate
@@ -705,5 +745,5 @@ int idCollisionModelManagerLocal::Contents(const idVec3 &start,
 		return 0;
 	}
 
-	return ContentsTrm(&results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
+	return ContentsTrm(0, &results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
 }
@@ -259,11 +259,11 @@ void idCollisionModelManagerLocal::DrawPolygon(cm_model_t *model, cm_polygon_t *
 			edgeNum = p->edges[i];
 			edge = model->edges + abs(edgeNum);
 
-			if (edge->checkcount == checkCount) {
+			if (edge->mark.checkcount == checkCount[0]) {
 				continue;
 			}
 
-			edge->checkcount = checkCount;
+			edge->mark.checkcount = checkCount[0];
 			DrawEdge(model, edgeNum, origin, axis);
 		}
 	}
@@ -303,7 +303,7 @@ void idCollisionModelManagerLocal::DrawNodePolygons(cm_model_t *model, cm_node_t
 				}
 			}
 
-			if (p->checkcount == checkCount) {
+			if (p->checkcount == checkCount[0]) {
 				continue;
 			}
 
@@ -312,7 +312,7 @@ void idCollisionModelManagerLocal::DrawNodePolygons(cm_model_t *model, cm_node_t
 			}
 
 			DrawPolygon(model, p, origin, axis, viewOrigin);
-			p->checkcount = checkCount;
+			p->checkcount = checkCount[0];
 		}
 
 		if (node->planeType == -1) {
@@ -353,7 +353,7 @@ void idCollisionModelManagerLocal::DrawModel(cmHandle_t handle, const idVec3 &mo
 
 	model = models[ handle ];
 	viewPos = (viewOrigin - modelOrigin) * modelAxis.Transpose();
-	checkCount++;
+	checkCount[0]++;
 	DrawNodePolygons(model, model->node, modelOrigin, modelAxis, viewPos, radius);
 }
 
@@ -378,6 +378,7 @@ static idCVar cm_testWalk("cm_testWalk",			"1",					CVAR_GAME | CVAR_BOOL,		"");
 static idCVar cm_testLength("cm_testLength",		"1024",					CVAR_GAME | CVAR_FLOAT,		"");
 static idCVar cm_testRadius("cm_testRadius",		"64",					CVAR_GAME | CVAR_FLOAT,		"");
 static idCVar cm_testAngle("cm_testAngle",			"60",					CVAR_GAME | CVAR_FLOAT,		"");
+static idCVar cm_testSIMD("cm_testSIMD",			"0",					CVAR_GAME | CVAR_BOOL,		"compare the test translations and contents with and without cm_simd");
 
 static int total_translation;
 static int min_translation = 999999;
@@ -477,6 +478,51 @@ void idCollisionModelManagerLocal::DebugOutput(const idVec3 &origin)
 
 	common->Printf("%s translations: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_translation, max_translation, (float) total_translation / num_translation);
 
+	if (cm_testSIMD.GetBool()) {
+		// run the same translations and position tests with the scalar code and the SIMD kernels
+		int numDiffs = 0;
+		double scalarTime, simdTime;
+		bool simd = cm_simd.GetBool();
+		trace_t *scalarTraces = (trace_t *) Mem_Alloc(cm_testTimes.GetInteger() * sizeof(trace_t));
+		int *scalarContents = (int *) Mem_Alloc(cm_testTimes.GetInteger() * sizeof(int));
+
+		cm_simd.SetBool(false);
+		timer.Clear();
+		timer.Start();
+
+		for (i = 0; i < cm_testTimes.GetInteger(); i++) {
+			Translation(&scalarTraces[i], start, testend[i], &itm, boxAxis, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, cm_testModel.GetInteger(), vec3_origin, modelAxis);
+			scalarContents[i] = Contents(testend[i], &itm, boxAxis, -1, cm_testModel.GetInteger(), vec3_origin, modelAxis);
+		}
+
+		timer.Stop();
+		scalarTime = timer.Milliseconds();
+
+		cm_simd.SetBool(true);
+		timer.Clear();
+		timer.Start();
+
+		for (i = 0; i < cm_testTimes.GetInteger(); i++) {
+			Translation(&trace, start, testend[i], &itm, boxAxis, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, cm_testModel.GetInteger(), vec3_origin, modelAxis);
+			k = Contents(testend[i], &itm, boxAxis, -1, cm_testModel.GetInteger(), vec3_origin, modelAxis);
+
+			if (idMath::Fabs(trace.fraction - scalarTraces[i].fraction) > 1e-4f || trace.c.contents != scalarTraces[i].c.contents || k != scalarContents[i]) {
+				numDiffs++;
+			}
+		}
+
+		timer.Stop();
+		simdTime = timer.Milliseconds();
+
+		cm_simd.SetBool(simd);
+		Mem_Free(scalarTraces);
+		Mem_Free(scalarContents);
+
+		common->Printf("%s translations + contents: scalar %1.2f ms (%1.0f/sec), simd %1.2f ms (%1.0f/sec), %d differ\n", buf,
+		               scalarTime, cm_testTimes.GetInteger() * 1000.0 / Max(scalarTime, 0.001),
+		               simdTime, cm_testTimes.GetInteger() * 1000.0 / Max(simdTime, 0.001), numDiffs);
+	}
+
 	if (cm_testRandomMany.GetBool()) {
 		// if many traces in one random direction
 		for (i = 0; i < 3; i++) {
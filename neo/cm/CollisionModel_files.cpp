@@ -87,11 +87,11 @@ int idCollisionModelManagerLocal::CountPolygonMemory(cm_node_t *node) const
 	for (pref = node->polygons; pref; pref = pref->next) {
 		p = pref->p;
 
-		if (p->checkcount == checkCount) {
+		if (p->checkcount == checkCount[0]) {
 			continue;
 		}
 
-		p->checkcount = checkCount;
+		p->checkcount = checkCount[0];
 
 		memory += sizeof(cm_polygon_t) + (p->numEdges - 1) * sizeof(p->edges[0]);
 	}
@@ -118,11 +118,11 @@ void idCollisionModelManagerLocal::WritePolygons(idFile *fp, cm_node_t *node)
 	for (pref = node->polygons; pref; pref = pref->next) {
 		p = pref->p;
 
-		if (p->checkcount == checkCount) {
+		if (p->checkcount == checkCount[0]) {
 			continue;
 		}
 
-		p->checkcount = checkCount;
+		p->checkcount = checkCount[0];
 		fp->WriteFloatString("\t%d (", p->numEdges);
 
 		for (i = 0; i < p->numEdges; i++) {
@@ -157,11 +157,11 @@ int idCollisionModelManagerLocal::CountBrushMemory(cm_node_t *node) const
 	for (bref = node->brushes; bref; bref = bref->next) {
 		b = bref->b;
 
-		if (b->checkcount == checkCount) {
+		if (b->checkcount == checkCount[0]) {
 			continue;
 		}
 
-		b->checkcount = checkCount;
+		b->checkcount = checkCount[0];
 
 		memory += sizeof(cm_brush_t) + (b->numPlanes - 1) * sizeof(b->planes[0]);
 	}
@@ -188,11 +188,11 @@ void idCollisionModelManagerLocal::WriteBrushes(idFile *fp, cm_node_t *node)
 	for (bref = node->brushes; bref; bref = bref->next) {
 		b = bref->b;
 
-		if (b->checkcount == checkCount) {
+		if (b->checkcount == checkCount[0]) {
 			continue;
 		}
 
-		b->checkcount = checkCount;
+		b->checkcount = checkCount[0];
 		fp->WriteFloatString("\t%d {\n", b->numPlanes);
 
 		for (i = 0; i < b->numPlanes; i++) {
@@ -240,17 +240,17 @@ void idCollisionModelManagerLocal::WriteCollisionModel(idFile *fp, cm_model_t *m
 	WriteNodes(fp, model->node);
 	fp->WriteFloatString("\t}\n");
 	// polygons
-	checkCount++;
+	checkCount[0]++;
 	polygonMemory = CountPolygonMemory(model->node);
 	fp->WriteFloatString("\tpolygons /* polygonMemory = */ %d {\n", polygonMemory);
-	checkCount++;
+	checkCount[0]++;
 	WritePolygons(fp, model->node);
 	fp->WriteFloatString("\t}\n");
 	// brushes
-	checkCount++;
+	checkCount[0]++;
 	brushMemory = CountBrushMemory(model->node);
 	fp->WriteFloatString("\tbrushes /* brushMemory = */ %d {\n", brushMemory);
-	checkCount++;
+	checkCount[0]++;
 	WriteBrushes(fp, model->node);
 	fp->WriteFloatString("\t}\n");
 	// closing brace
@@ -361,13 +361,11 @@ void idCollisionModelManagerLocal::ParseVertices(idLexer *src, cm_model_t *model
 	src->ExpectTokenString("{");
 	model->numVertices = src->ParseInt();
 	model->maxVertices = model->numVertices;
-	model->vertices = (cm_vertex_t *) Mem_Alloc(model->maxVertices * sizeof(cm_vertex_t));
+	model->vertices = (cm_vertex_t *) levelArena.Alloc(model->maxVertices * sizeof(cm_vertex_t));
 
 	for (i = 0; i < model->numVertices; i++) {
 		src->Parse1DMatrix(3, model->vertices[i].p.ToFloatPtr());
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
-		model->vertices[i].checkcount = 0;
+		memset(&model->vertices[i].mark, 0, sizeof(model->vertices[i].mark));
 	}
 
 	src->ExpectTokenString("}");
@@ -385,19 +383,17 @@ void idCollisionModelManagerLocal::ParseEdges(idLexer *src, cm_model_t *model)
 	src->ExpectTokenString("{");
 	model->numEdges = src->ParseInt();
 	model->maxEdges = model->numEdges;
-	model->edges = (cm_edge_t *) Mem_Alloc(model->maxEdges * sizeof(cm_edge_t));
+	model->edges = (cm_edge_t *) levelArena.Alloc(model->maxEdges * sizeof(cm_edge_t));
 
 	for (i = 0; i < model->numEdges; i++) {
 		src->ExpectTokenString("(");
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString(")");
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
+		memset(&model->edges[i].mark, 0, sizeof(model->edges[i].mark));
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
-		model->edges[i].checkcount = 0;
 		model->numInternalEdges += model->edges[i].internal;
 	}
 
@@ -444,7 +440,7 @@ void idCollisionModelManagerLocal::ParsePolygons(idLexer *src, cm_model_t *model
 	idToken token;
 
 	if (src->CheckTokenType(TT_NUMBER, 0, &token)) {
-		model->polygonBlock = (cm_polygonBlock_t *) Mem_Alloc(sizeof(cm_polygonBlock_t) + token.GetIntValue());
+		model->polygonBlock = (cm_polygonBlock_t *) levelArena.Alloc(sizeof(cm_polygonBlock_t) + token.GetIntValue());
 		model->polygonBlock->bytesRemaining = token.GetIntValue();
 		model->polygonBlock->next = ((byte *) model->polygonBlock) + sizeof(cm_polygonBlock_t);
 	}
@@ -491,7 +487,7 @@ void idCollisionModelManagerLocal::ParseBrushes(idLexer *src, cm_model_t *model)
 	idToken token;
 
 	if (src->CheckTokenType(TT_NUMBER, 0, &token)) {
-		model->brushBlock = (cm_brushBlock_t *) Mem_Alloc(sizeof(cm_brushBlock_t) + token.GetIntValue());
+		model->brushBlock = (cm_brushBlock_t *) levelArena.Alloc(sizeof(cm_brushBlock_t) + token.GetIntValue());
 		model->brushBlock->bytesRemaining = token.GetIntValue();
 		model->brushBlock->next = ((byte *) model->brushBlock) + sizeof(cm_brushBlock_t);
 	}
@@ -587,7 +583,7 @@ bool idCollisionModelManagerLocal::ParseCollisionModel(idLexer *src)
 	}
 
 	// calculate edge normals
-	checkCount++;
+	checkCount[0]++;
 	CalculateEdgeNormals(model, model->node);
 	// get model bounds from brush and polygon bounds
 	CM_GetNodeBounds(&model->bounds, model->node);
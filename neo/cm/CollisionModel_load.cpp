@@ -175,6 +175,15 @@ Free map
 ===============================================================================
 */
 
+/*
+================
+idCollisionModelManagerLocal::idCollisionModelManagerLocal
+================
+*/
+idCollisionModelManagerLocal::idCollisionModelManagerLocal(void) : levelArena("collision", MEMTAG_COLLISION, 4 << 20)
+{
+}
+
 /*
 ================
 idCollisionModelManagerLocal::Clear
@@ -185,12 +194,17 @@ void idCollisionModelManagerLocal::Clear(void)
 	mapName.Clear();
 	mapFileTime = 0;
 	loaded = 0;
-	checkCount = 0;
+	// the check counts of the slots other than 0 count down from distinct values
+	checkCount[0] = 0;
+	for (int slot = 1; slot < CM_MAX_TRACE_SLOTS; slot++) {
+		checkCount[slot] = (CM_MAX_TRACE_SLOTS - 1) - slot;
+	}
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
+	memset(trmModels, 0, sizeof(trmModels));
 	memset(trmPolygons, 0, sizeof(trmPolygons));
-	trmBrushes[0] = NULL;
+	memset(trmBrushes, 0, sizeof(trmBrushes));
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
@@ -200,84 +214,6 @@ void idCollisionModelManagerLocal::Clear(void)
 	numContacts = 0;
 }
 
-/*
-================
-idCollisionModelManagerLocal::RemovePolygonReferences_r
-================
-*/
-void idCollisionModelManagerLocal::RemovePolygonReferences_r(cm_node_t *node, cm_polygon_t *p)
-{
-	cm_polygonRef_t *pref;
-
-	while (node) {
-		for (pref = node->polygons; pref; pref = pref->next) {
-			if (pref->p == p) {
-				pref->p = NULL;
-				// cannot return here because we can have links down the tree due to polygon merging
-				//return;
-			}
-		}
-
-		// if leaf node
-		if (node->planeType == -1) {
-			break;
-		}
-
-		if (p->bounds[0][node->planeType] > node->planeDist) {
-			node = node->children[0];
-		} else if (p->bounds[1][node->planeType] < node->planeDist) {
-			node = node->children[1];
-		} else {
-			RemovePolygonReferences_r(node->children[1], p);
-			node = node->children[0];
-		}
-	}
-}
-
-/*
-================
-idCollisionModelManagerLocal::RemoveBrushReferences_r
-================
-*/
-void idCollisionModelManagerLocal::RemoveBrushReferences_r(cm_node_t *node, cm_brush_t *b)
-{
-	cm_brushRef_t *bref;
-
-	while (node) {
-		for (bref = node->brushes; bref; bref = bref->next) {
-			if (bref->b == b) {
-				bref->b = NULL;
-				return;
-			}
-		}
-
-		// if leaf node
-		if (node->planeType == -1) {
-			break;
-		}
-
-		if (b->bounds[0][node->planeType] > node->planeDist) {
-			node = node->children[0];
-		} else if (b->bounds[1][node->planeType] < node->planeDist) {
-			node = node->children[1];
-		} else {
-			RemoveBrushReferences_r(node->children[1], b);
-			node = node->children[0];
-		}
-	}
-}
-
-/*
-================
-idCollisionModelManagerLocal::FreeNode
-================
-*/
-void idCollisionModelManagerLocal::FreeNode(cm_node_t *node)
-{
-	// don't free the node here
-	// the nodes are allocated in blocks which are freed when the model is freed
-}
-
 /*
 ================
 idCollisionModelManagerLocal::FreePolygonReference
@@ -286,7 +222,7 @@ idCollisionModelManagerLocal::FreePolygonReference
 void idCollisionModelManagerLocal::FreePolygonReference(cm_polygonRef_t *pref)
 {
 	// don't free the polygon reference here
-	// the polygon references are allocated in blocks which are freed when the model is freed
+	// the polygon references are allocated in blocks from the level arena which is freed with the map
 }
 
 /*
@@ -297,7 +233,7 @@ idCollisionModelManagerLocal::FreeBrushReference
 void idCollisionModelManagerLocal::FreeBrushReference(cm_brushRef_t *bref)
 {
 	// don't free the brush reference here
-	// the brush references are allocated in blocks which are freed when the model is freed
+	// the brush references are allocated in blocks from the level arena which is freed with the map
 }
 
 /*
@@ -310,9 +246,8 @@ void idCollisionModelManagerLocal::FreePolygon(cm_model_t *model, cm_polygon_t *
 	model->numPolygons--;
 	model->polygonMemory -= sizeof(cm_polygon_t) + (poly->numEdges - 1) * sizeof(poly->edges[0]);
 
-	if (model->polygonBlock == NULL) {
-		Mem_Free(poly);
-	}
+	// don't free the polygon here
+	// the polygons are allocated from the level arena which is freed with the map
 }
 
 /*
@@ -325,60 +260,8 @@ void idCollisionModelManagerLocal::FreeBrush(cm_model_t *model, cm_brush_t *brus
 	model->numBrushes--;
 	model->brushMemory -= sizeof(cm_brush_t) + (brush->numPlanes - 1) * sizeof(brush->planes[0]);
 
-	if (model->brushBlock == NULL) {
-		Mem_Free(brush);
-	}
-}
-
-/*
-================
-idCollisionModelManagerLocal::FreeTree_r
-================
-*/
-void idCollisionModelManagerLocal::FreeTree_r(cm_model_t *model, cm_node_t *headNode, cm_node_t *node)
-{
-	cm_polygonRef_t *pref;
-	cm_polygon_t *p;
-	cm_brushRef_t *bref;
-	cm_brush_t *b;
-
-	// free all polygons at this node
-	for (pref = node->polygons; pref; pref = node->polygons) {
-		p = pref->p;
-
-		if (p) {
-			// remove all other references to this polygon
-			RemovePolygonReferences_r(headNode, p);
-			FreePolygon(model, p);
-		}
-
-		node->polygons = pref->next;
-		FreePolygonReference(pref);
-	}
-
-	// free all brushes at this node
-	for (bref = node->brushes; bref; bref = node->brushes) {
-		b = bref->b;
-
-		if (b) {
-			// remove all other references to this brush
-			RemoveBrushReferences_r(headNode, b);
-			FreeBrush(model, b);
-		}
-
-		node->brushes = bref->next;
-		FreeBrushReference(bref);
-	}
-
-	// recurse down the tree
-	if (node->planeType != -1) {
-		FreeTree_r(model, headNode, node->children[0]);
-		node->children[0] = NULL;
-		FreeTree_r(model, headNode, node->children[1]);
-		node->children[1] = NULL;
-	}
-
-	FreeNode(node);
+	// don't free the brush here
+	// the brushes are allocated from the level arena which is freed with the map
 }
 
 /*
@@ -388,42 +271,7 @@ idCollisionModelManagerLocal::FreeModel
 */
 void idCollisionModelManagerLocal::FreeModel(cm_model_t *model)
 {
-	cm_polygonRefBlock_t *polygonRefBlock, *nextPolygonRefBlock;
-	cm_brushRefBlock_t *brushRefBlock, *nextBrushRefBlock;
-	cm_nodeBlock_t *nodeBlock, *nextNodeBlock;
-
-	// free the tree structure
-	if (model->node) {
-		FreeTree_r(model, model->node, model->node);
-	}
-
-	// free blocks with polygon references
-	for (polygonRefBlock = model->polygonRefBlocks; polygonRefBlock; polygonRefBlock = nextPolygonRefBlock) {
-		nextPolygonRefBlock = polygonRefBlock->next;
-		Mem_Free(polygonRefBlock);
-	}
-
-	// free blocks with brush references
-	for (brushRefBlock = model->brushRefBlocks; brushRefBlock; brushRefBlock = nextBrushRefBlock) {
-		nextBrushRefBlock = brushRefBlock->next;
-		Mem_Free(brushRefBlock);
-	}
-
-	// free blocks with nodes
-	for (nodeBlock = model->nodeBlocks; nodeBlock; nodeBlock = nextNodeBlock) {
-		nextNodeBlock = nodeBlock->next;
-		Mem_Free(nodeBlock);
-	}
-
-	// free block allocated polygons
-	Mem_Free(model->polygonBlock);
-	// free block allocated brushes
-	Mem_Free(model->brushBlock);
-	// free edges
-	Mem_Free(model->edges);
-	// free vertices
-	Mem_Free(model->vertices);
-	// free the model
+	// everything the model points to lives in the level arena and is freed with the map
 	delete model;
 }
 
@@ -451,7 +299,8 @@ void idCollisionModelManagerLocal::FreeMap(void)
 
 	FreeTrmModelStructure();
 
-	Mem_Free(models);
+	// all model data including the model list goes away at once
+	levelArena.FreeAll();
 
 	Clear();
 
@@ -465,23 +314,29 @@ idCollisionModelManagerLocal::FreeTrmModelStructure
 */
 void idCollisionModelManagerLocal::FreeTrmModelStructure(void)
 {
-	int i;
+	int i, slot;
+	cm_model_t *model;
 
 	assert(models);
 
-	if (!models[MAX_SUBMODELS]) {
-		return;
-	}
+	for (slot = 0; slot < CM_MAX_TRACE_SLOTS; slot++) {
+		model = trmModels[slot];
 
-	for (i = 0; i < MAX_TRACEMODEL_POLYS; i++) {
-		FreePolygon(models[MAX_SUBMODELS], trmPolygons[i]->p);
-	}
+		if (!model) {
+			continue;
+		}
+
+		for (i = 0; i < MAX_TRACEMODEL_POLYS; i++) {
+			FreePolygon(model, trmPolygons[slot][i]->p);
+		}
 
-	FreeBrush(models[MAX_SUBMODELS], trmBrushes[0]->b);
+		FreeBrush(model, trmBrushes[slot][0]->b);
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel(models[MAX_SUBMODELS]);
+		model->node->polygons = NULL;
+		model->node->brushes = NULL;
+		FreeModel(model);
+		trmModels[slot] = NULL;
+	}
 }
 
 
@@ -514,11 +369,11 @@ void idCollisionModelManagerLocal::CalculateEdgeNormals(cm_model_t *model, cm_no
 			p = pref->p;
 
 			// if we checked this polygon already
-			if (p->checkcount == checkCount) {
+			if (p->checkcount == checkCount[0]) {
 				continue;
 			}
 
-			p->checkcount = checkCount;
+			p->checkcount = checkCount[0];
 
 			for (i = 0; i < p->numEdges; i++) {
 				edgeNum = p->edges[i];
@@ -588,6 +443,7 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel(void)
 	model->maxEdges = 0;
 	model->numEdges = 0;
 	model->edges= NULL;
+	memset(model->slotMarks, 0, sizeof(model->slotMarks));
 	model->node = NULL;
 	model->nodeBlocks = NULL;
 	model->polygonRefBlocks = NULL;
@@ -616,7 +472,7 @@ cm_node_t *idCollisionModelManagerLocal::AllocNode(cm_model_t *model, int blockS
 	cm_nodeBlock_t *nodeBlock;
 
 	if (!model->nodeBlocks || !model->nodeBlocks->nextNode) {
-		nodeBlock = (cm_nodeBlock_t *) Mem_ClearedAlloc(sizeof(cm_nodeBlock_t) + blockSize * sizeof(cm_node_t));
+		nodeBlock = (cm_nodeBlock_t *) levelArena.ClearedAlloc(sizeof(cm_nodeBlock_t) + blockSize * sizeof(cm_node_t));
 		nodeBlock->nextNode = (cm_node_t *)(((byte *) nodeBlock) + sizeof(cm_nodeBlock_t));
 		nodeBlock->next = model->nodeBlocks;
 		model->nodeBlocks = nodeBlock;
@@ -649,7 +505,7 @@ cm_polygonRef_t *idCollisionModelManagerLocal::AllocPolygonReference(cm_model_t
 	cm_polygonRefBlock_t *prefBlock;
 
 	if (!model->polygonRefBlocks || !model->polygonRefBlocks->nextRef) {
-		prefBlock = (cm_polygonRefBlock_t *) Mem_Alloc(sizeof(cm_polygonRefBlock_t) + blockSize * sizeof(cm_polygonRef_t));
+		prefBlock = (cm_polygonRefBlock_t *) levelArena.Alloc(sizeof(cm_polygonRefBlock_t) + blockSize * sizeof(cm_polygonRef_t));
 		prefBlock->nextRef = (cm_polygonRef_t *)(((byte *) prefBlock) + sizeof(cm_polygonRefBlock_t));
 		prefBlock->next = model->polygonRefBlocks;
 		model->polygonRefBlocks = prefBlock;
@@ -681,7 +537,7 @@ cm_brushRef_t *idCollisionModelManagerLocal::AllocBrushReference(cm_model_t *mod
 	cm_brushRefBlock_t *brefBlock;
 
 	if (!model->brushRefBlocks || !model->brushRefBlocks->nextRef) {
-		brefBlock = (cm_brushRefBlock_t *) Mem_Alloc(sizeof(cm_brushRefBlock_t) + blockSize * sizeof(cm_brushRef_t));
+		brefBlock = (cm_brushRefBlock_t *) levelArena.Alloc(sizeof(cm_brushRefBlock_t) + blockSize * sizeof(cm_brushRef_t));
 		brefBlock->nextRef = (cm_brushRef_t *)(((byte *) brefBlock) + sizeof(cm_brushRefBlock_t));
 		brefBlock->next = model->brushRefBlocks;
 		model->brushRefBlocks = brefBlock;
@@ -720,7 +576,7 @@ cm_polygon_t *idCollisionModelManagerLocal::AllocPolygon(cm_model_t *model, int
 		model->polygonBlock->next += size;
 		model->polygonBlock->bytesRemaining -= size;
 	} else {
-		poly = (cm_polygon_t *) Mem_Alloc(size);
+		poly = (cm_polygon_t *) levelArena.Alloc(size);
 	}
 
 	return poly;
@@ -745,7 +601,7 @@ cm_brush_t *idCollisionModelManagerLocal::AllocBrush(cm_model_t *model, int numP
 		model->brushBlock->next += size;
 		model->brushBlock->bytesRemaining -= size;
 	} else {
-		brush = (cm_brush_t *) Mem_Alloc(size);
+		brush = (cm_brush_t *) levelArena.Alloc(size);
 	}
 
 	return brush;
@@ -790,26 +646,12 @@ idCollisionModelManagerLocal::SetupTrmModelStructure
 */
 void idCollisionModelManagerLocal::SetupTrmModelStructure(void)
 {
-	int i;
+	int i, slot;
 	cm_node_t *node;
 	cm_model_t *model;
 
-	// setup model
-	model = AllocModel();
-
 	assert(models);
-	models[MAX_SUBMODELS] = model;
-	// create node to hold the collision data
-	node = (cm_node_t *) AllocNode(model, 1);
-	node->planeType = -1;
-	model->node = node;
-	// allocate vertex and edge arrays
-	model->numVertices = 0;
-	model->maxVertices = MAX_TRACEMODEL_VERTS;
-	model->vertices = (cm_vertex_t *) Mem_ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
-	model->numEdges = 0;
-	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
-	model->edges = (cm_edge_t *) Mem_ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
+
 	// create a material for the trace model polygons
 	trmMaterial = declManager->FindMaterial("_tracemodel", false);
 
@@ -817,26 +659,95 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure(void)
 		common->FatalError("_tracemodel material not found");
 	}
 
-	// allocate polygons
-	for (i = 0; i < MAX_TRACEMODEL_POLYS; i++) {
-		trmPolygons[i] = AllocPolygonReference(model, MAX_TRACEMODEL_POLYS);
-		trmPolygons[i]->p = AllocPolygon(model, MAX_TRACEMODEL_POLYEDGES);
-		trmPolygons[i]->p->bounds.Clear();
-		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
-		trmPolygons[i]->p->contents = -1;		// all contents
-		trmPolygons[i]->p->material = trmMaterial;
-		trmPolygons[i]->p->numEdges = 0;
+	// each trace slot gets its own model so trace models can be converted on several threads
+	for (slot = 0; slot < CM_MAX_TRACE_SLOTS; slot++) {
+		// setup model
+		model = AllocModel();
+		trmModels[slot] = model;
+		// create node to hold the collision data
+		node = (cm_node_t *) AllocNode(model, 1);
+		node->planeType = -1;
+		model->node = node;
+		// allocate vertex and edge arrays
+		model->numVertices = 0;
+		model->maxVertices = MAX_TRACEMODEL_VERTS;
+		model->vertices = (cm_vertex_t *) levelArena.ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
+		model->numEdges = 0;
+		model->maxEdges = MAX_TRACEMODEL_EDGES+1;
+		model->edges = (cm_edge_t *) levelArena.ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
+		AllocSlotMarks(model, slot);
+
+		// allocate polygons
+		for (i = 0; i < MAX_TRACEMODEL_POLYS; i++) {
+			trmPolygons[slot][i] = AllocPolygonReference(model, MAX_TRACEMODEL_POLYS);
+			trmPolygons[slot][i]->p = AllocPolygon(model, MAX_TRACEMODEL_POLYEDGES);
+			trmPolygons[slot][i]->p->bounds.Clear();
+			trmPolygons[slot][i]->p->plane.Zero();
+			trmPolygons[slot][i]->p->checkcount = 0;
+			trmPolygons[slot][i]->p->contents = -1;		// all contents
+			trmPolygons[slot][i]->p->material = trmMaterial;
+			trmPolygons[slot][i]->p->numEdges = 0;
+		}
+
+		// allocate brush for position test
+		trmBrushes[slot][0] = AllocBrushReference(model, 1);
+		trmBrushes[slot][0]->b = AllocBrush(model, MAX_TRACEMODEL_POLYS);
+		trmBrushes[slot][0]->b->primitiveNum = 0;
+		trmBrushes[slot][0]->b->bounds.Clear();
+		trmBrushes[slot][0]->b->checkcount = 0;
+		trmBrushes[slot][0]->b->contents = -1;		// all contents
+		trmBrushes[slot][0]->b->numPlanes = 0;
+	}
+
+	// the trace model handle refers to the model of the game thread slot
+	models[MAX_SUBMODELS] = trmModels[0];
+}
+
+/*
+================
+idCollisionModelManagerLocal::ModelForSlot
+
+  TRACE_MODEL_HANDLE refers to the trace model set up in the slot
+================
+*/
+cm_model_t *idCollisionModelManagerLocal::ModelForSlot(int slot, cmHandle_t model) const
+{
+	if (model == TRACE_MODEL_HANDLE) {
+		return trmModels[slot];
+	}
+
+	return models[model];
+}
+
+/*
+================
+idCollisionModelManagerLocal::AllocSlotMarks
+
+  slot 0 keeps its marks in the vertices and edges
+================
+*/
+void idCollisionModelManagerLocal::AllocSlotMarks(cm_model_t *model, int slot)
+{
+	if (slot == 0 || model->slotMarks[slot]) {
+		return;
+	}
+
+	model->slotMarks[slot] = (cm_mark_t *) levelArena.ClearedAlloc((model->maxVertices + model->maxEdges) * sizeof(cm_mark_t));
+}
+
+/*
+================
+idCollisionModelManagerLocal::NextCheckCount
+================
+*/
+int idCollisionModelManagerLocal::NextCheckCount(int slot)
+{
+	if (slot == 0) {
+		return ++checkCount[0];
 	}
 
-	// allocate brush for position test
-	trmBrushes[0] = AllocBrushReference(model, 1);
-	trmBrushes[0]->b = AllocBrush(model, MAX_TRACEMODEL_POLYS);
-	trmBrushes[0]->b->primitiveNum = 0;
-	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
-	trmBrushes[0]->b->contents = -1;		// all contents
-	trmBrushes[0]->b->numPlanes = 0;
+	checkCount[slot] -= CM_MAX_TRACE_SLOTS - 1;
+	return checkCount[slot];
 }
 
 /*
@@ -848,23 +759,41 @@ as a reusable temporary buffer
 ================
 */
 cmHandle_t idCollisionModelManagerLocal::SetupTrmModel(const idTraceModel &trm, const idMaterial *material)
+{
+	return SetupTrmModelSlot(0, trm, material);
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTrmModelSlot
+
+Converts the trace model into the temporary model of the given trace slot.
+TRACE_MODEL_HANDLE refers to this model for traces run in the same slot.
+================
+*/
+cmHandle_t idCollisionModelManagerLocal::SetupTrmModelSlot(int slot, const idTraceModel &trm, const idMaterial *material)
 {
 	int i, j;
 	cm_vertex_t *vertex;
 	cm_edge_t *edge;
 	cm_polygon_t *poly;
 	cm_model_t *model;
+	cm_polygonRef_t **polygons;
+	cm_brushRef_t *brush;
 	const traceModelVert_t *trmVert;
 	const traceModelEdge_t *trmEdge;
 	const traceModelPoly_t *trmPoly;
 
 	assert(models);
+	assert(slot >= 0 && slot < CM_MAX_TRACE_SLOTS);
 
 	if (material == NULL) {
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	model = trmModels[slot];
+	polygons = trmPolygons[slot];
+	brush = trmBrushes[slot][0];
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 
@@ -880,7 +809,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel(const idTraceModel &trm,
 
 	for (i = 0; i < trm.numVerts; i++, vertex++, trmVert++) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
+		vertex->mark.sideSet = 0;
 	}
 
 	// edges
@@ -893,7 +822,11 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel(const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
+		edge->mark.sideSet = 0;
+	}
+
+	if (slot != 0) {
+		memset(model->slotMarks[slot], 0, (model->maxVertices + model->maxEdges) * sizeof(cm_mark_t));
 	}
 
 	// polygons
@@ -901,7 +834,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel(const idTraceModel &trm,
 	trmPoly = trm.polys;
 
 	for (i = 0; i < trm.numPolys; i++, trmPoly++) {
-		poly = trmPolygons[i]->p;
+		poly = polygons[i]->p;
 		poly->numEdges = trmPoly->numEdges;
 
 		for (j = 0; j < trmPoly->numEdges; j++) {
@@ -913,23 +846,23 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel(const idTraceModel &trm,
 		poly->bounds = trmPoly->bounds;
 		poly->material = material;
 		// link polygon at node
-		trmPolygons[i]->next = model->node->polygons;
-		model->node->polygons = trmPolygons[i];
+		polygons[i]->next = model->node->polygons;
+		model->node->polygons = polygons[i];
 	}
 
 	// if the trace model is convex
 	if (trm.isConvex) {
 		// setup brush for position test
-		trmBrushes[0]->b->numPlanes = trm.numPolys;
+		brush->b->numPlanes = trm.numPolys;
 
 		for (i = 0; i < trm.numPolys; i++) {
-			trmBrushes[0]->b->planes[i] = trmPolygons[i]->p->plane;
+			brush->b->planes[i] = polygons[i]->p->plane;
 		}
 
-		trmBrushes[0]->b->bounds = trm.bounds;
+		brush->b->bounds = trm.bounds;
 		// link brush at node
-		trmBrushes[0]->next = model->node->brushes;
-		model->node->brushes = trmBrushes[0];
+		brush->next = model->node->brushes;
+		model->node->brushes = brush;
 	}
 
 	// model bounds
@@ -1201,11 +1134,11 @@ void idCollisionModelManagerLocal::R_ChopWindingListWithTreeBrushes(cm_windingLi
 			b = bref->b;
 
 			// if we checked this brush already
-			if (b->checkcount == checkCount) {
+			if (b->checkcount == checkCount[0]) {
 				continue;
 			}
 
-			b->checkcount = checkCount;
+			b->checkcount = checkCount[0];
 
 			// if the windings in the list originate from this brush
 			if (b->primitiveNum == list->primitiveNum) {
@@ -1294,7 +1227,7 @@ idFixedWinding *idCollisionModelManagerLocal::WindingOutsideBrushes(idFixedWindi
 	cm_windingList->contents = contents;
 	cm_windingList->primitiveNum = primitiveNum;
 	//
-	checkCount++;
+	checkCount[0]++;
 	R_ChopWindingListWithTreeBrushes(cm_windingList, headNode);
 
 	//
@@ -1698,11 +1631,11 @@ void idCollisionModelManagerLocal::MergeTreePolygons(cm_model_t *model, cm_node_
 				p = pref->p;
 
 				// if we checked this polygon already
-				if (p->checkcount == checkCount) {
+				if (p->checkcount == checkCount[0]) {
 					continue;
 				}
 
-				p->checkcount = checkCount;
+				p->checkcount = checkCount[0];
 
 				// try to merge this polygon with other polygons in the tree
 				if (MergePolygonWithTreePolygons(model, model->node, p)) {
@@ -1991,11 +1924,11 @@ void idCollisionModelManagerLocal::FindInternalEdges(cm_model_t *model, cm_node_
 			p = pref->p;
 
 			// if we checked this polygon already
-			if (p->checkcount == checkCount) {
+			if (p->checkcount == checkCount[0]) {
 				continue;
 			}
 
-			p->checkcount = checkCount;
+			p->checkcount = checkCount[0];
 
 			FindInternalPolygonEdges(model, model->node, p);
 
@@ -2546,15 +2479,14 @@ int idCollisionModelManagerLocal::GetVertex(cm_model_t *model, const idVec3 &v,
 		// resize vertex array
 		model->maxVertices = (float) model->maxVertices * 1.5f + 1;
 		oldVertices = model->vertices;
-		model->vertices = (cm_vertex_t *) Mem_ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
+		model->vertices = (cm_vertex_t *) levelArena.ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
 		memcpy(model->vertices, oldVertices, model->numVertices * sizeof(cm_vertex_t));
-		Mem_Free(oldVertices);
 
 		cm_vertexHash->ResizeIndex(model->maxVertices);
 	}
 
 	model->vertices[model->numVertices].p = vert;
-	model->vertices[model->numVertices].checkcount = 0;
+	memset(&model->vertices[model->numVertices].mark, 0, sizeof(model->vertices[model->numVertices].mark));
 	*vertexNum = model->numVertices;
 	// add vertice to hash
 	cm_vertexHash->Add(hashKey, model->numVertices);
@@ -2635,9 +2567,8 @@ int idCollisionModelManagerLocal::GetEdge(cm_model_t *model, const idVec3 &v1, c
 		// resize edge array
 		model->maxEdges = (float) model->maxEdges * 1.5f + 1;
 		oldEdges = model->edges;
-		model->edges = (cm_edge_t *) Mem_ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
+		model->edges = (cm_edge_t *) levelArena.ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
 		memcpy(model->edges, oldEdges, model->numEdges * sizeof(cm_edge_t));
-		Mem_Free(oldEdges);
 
 		cm_edgeHash->ResizeIndex(model->maxEdges);
 	}
@@ -2646,7 +2577,7 @@ int idCollisionModelManagerLocal::GetEdge(cm_model_t *model, const idVec3 &v1, c
 	model->edges[model->numEdges].vertexNum[0] = v1num;
 	model->edges[model->numEdges].vertexNum[1] = v2num;
 	model->edges[model->numEdges].internal = false;
-	model->edges[model->numEdges].checkcount = 0;
+	memset(&model->edges[model->numEdges].mark, 0, sizeof(model->edges[model->numEdges].mark));
 	model->edges[model->numEdges].numUsers = 1; // used by one polygon atm
 	model->edges[model->numEdges].normal.Zero();
 	//
@@ -3133,11 +3064,11 @@ void idCollisionModelManagerLocal::RemapEdges(cm_node_t *node, int *edgeRemap)
 			p = pref->p;
 
 			// if we checked this polygon already
-			if (p->checkcount == checkCount) {
+			if (p->checkcount == checkCount[0]) {
 				continue;
 			}
 
-			p->checkcount = checkCount;
+			p->checkcount = checkCount[0];
 
 			for (i = 0; i < p->numEdges; i++) {
 				if (p->edges[i] < 0) {
@@ -3169,8 +3100,6 @@ void idCollisionModelManagerLocal::OptimizeArrays(cm_model_t *model)
 {
 	int i, newNumVertices, newNumEdges, *v;
 	int *remap;
-	cm_edge_t *oldEdges;
-	cm_vertex_t *oldVertices;
 
 	remap = (int *) Mem_ClearedAlloc(Max(model->numVertices, model->numEdges) * sizeof(int));
 
@@ -3213,29 +3142,14 @@ void idCollisionModelManagerLocal::OptimizeArrays(cm_model_t *model)
 	}
 
 	// change polygon edge indexes
-	checkCount++;
+	checkCount[0]++;
 	RemapEdges(model->node, remap);
 	model->numEdges = newNumEdges;
 
 	Mem_Free(remap);
 
-	// realloc vertices
-	oldVertices = model->vertices;
-
-	if (oldVertices) {
-		model->vertices = (cm_vertex_t *) Mem_ClearedAlloc(model->numVertices * sizeof(cm_vertex_t));
-		memcpy(model->vertices, oldVertices, model->numVertices * sizeof(cm_vertex_t));
-		Mem_Free(oldVertices);
-	}
-
-	// realloc edges
-	oldEdges = model->edges;
-
-	if (oldEdges) {
-		model->edges = (cm_edge_t *) Mem_ClearedAlloc(model->numEdges * sizeof(cm_edge_t));
-		memcpy(model->edges, oldEdges, model->numEdges * sizeof(cm_edge_t));
-		Mem_Free(oldEdges);
-	}
+	// the vertex and edge arrays are not shrunk, they live in the level arena
+	// where a smaller copy would only take more memory
 }
 
 /*
@@ -3246,13 +3160,13 @@ idCollisionModelManagerLocal::FinishModel
 void idCollisionModelManagerLocal::FinishModel(cm_model_t *model)
 {
 	// try to merge polygons
-	checkCount++;
+	checkCount[0]++;
 	MergeTreePolygons(model, model->node);
 	// find internal edges (no mesh can ever collide with internal edges)
-	checkCount++;
+	checkCount[0]++;
 	FindInternalEdges(model, model->node);
 	// calculate edge normals
-	checkCount++;
+	checkCount[0]++;
 	CalculateEdgeNormals(model, model->node);
 
 	//common->Printf( "%s vertex hash spread is %d\n", model->name.c_str(), cm_vertexHash->GetSpread() );
@@ -3346,8 +3260,8 @@ cm_model_t *idCollisionModelManagerLocal::LoadRenderModel(const char *fileName)
 		model->maxEdges += surf->geometry->numIndexes;
 	}
 
-	model->vertices = (cm_vertex_t *) Mem_ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
-	model->edges = (cm_edge_t *) Mem_ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
+	model->vertices = (cm_vertex_t *) levelArena.ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
+	model->edges = (cm_edge_t *) levelArena.ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
 
 	// setup hash to speed up finding shared vertices and edges
 	SetupHash();
@@ -3435,8 +3349,8 @@ cm_model_t *idCollisionModelManagerLocal::CollisionModelForMapEntity(const idMap
 	CM_EstimateVertsAndEdges(mapEnt, &model->maxVertices, &model->maxEdges);
 	model->numVertices = 0;
 	model->numEdges = 0;
-	model->vertices = (cm_vertex_t *) Mem_ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
-	model->edges = (cm_edge_t *) Mem_ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
+	model->vertices = (cm_vertex_t *) levelArena.ClearedAlloc(model->maxVertices * sizeof(cm_vertex_t));
+	model->edges = (cm_edge_t *) levelArena.ClearedAlloc(model->maxEdges * sizeof(cm_edge_t));
 
 	cm_vertexHash->ResizeIndex(model->maxVertices);
 	cm_edgeHash->ResizeIndex(model->maxEdges);
@@ -3685,6 +3599,7 @@ idCollisionModelManagerLocal::LoadMap
 */
 void idCollisionModelManagerLocal::LoadMap(const idMapFile *mapFile)
 {
+	idScopedMemTag	memTag(MEMTAG_COLLISION);
 
 	if (mapFile == NULL) {
 		common->Error("idCollisionModelManagerLocal::LoadMap: NULL mapFile");
@@ -3710,7 +3625,7 @@ void idCollisionModelManagerLocal::LoadMap(const idMapFile *mapFile)
 	// models
 	maxModels = MAX_SUBMODELS;
 	numModels = 0;
-	models = (cm_model_t **) Mem_ClearedAlloc((maxModels+1) * sizeof(cm_model_t *));
+	models = (cm_model_t **) levelArena.ClearedAlloc((maxModels+1) * sizeof(cm_model_t *));
 
 	// setup hash to speed up finding shared vertices and edges
 	SetupHash();
@@ -3914,11 +3829,11 @@ bool idCollisionModelManagerLocal::TrmFromModel_r(idTraceModel &trm, cm_node_t *
 		for (pref = node->polygons; pref; pref = pref->next) {
 			p = pref->p;
 
-			if (p->checkcount == checkCount) {
+			if (p->checkcount == checkCount[0]) {
 				continue;
 			}
 
-			p->checkcount = checkCount;
+			p->checkcount = checkCount[0];
 
 			if (trm.numPolys >= MAX_TRACEMODEL_POLYS) {
 				return false;
@@ -3984,7 +3899,7 @@ bool idCollisionModelManagerLocal::TrmFromModel(const cm_model_t *model, idTrace
 	trm.bounds.Clear();
 
 	// copy polygons
-	checkCount++;
+	checkCount[0]++;
 
 	if (!TrmFromModel_r(trm, model->node)) {
 		common->Printf("idCollisionModelManagerLocal::TrmFromModel: model %s has too many polygons.\n", model->name.c_str());
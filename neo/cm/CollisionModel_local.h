@@ -58,6 +58,8 @@ If you have questions concerning this license or the applicable additional terms
 #define VERTEX_EPSILON						0.1f
 #define CHOP_EPSILON						0.1f
 
+#define CM_MAX_TRACE_SLOTS					4		// translations running at the same time each need their own slot
+
 
 typedef struct cm_windingList_s {
 	int					numWindings;			// number of windings
@@ -78,19 +80,21 @@ Collision model
 ===============================================================================
 */
 
+typedef struct cm_mark_s {
+	int						checkcount;			// for multi-check avoidance
+	unsigned long			side;				// each bit tells at which side of a trace model feature this primitive is
+	unsigned long			sideSet;			// each bit tells if sidedness for the trace model feature has been calculated yet
+} cm_mark_t;
+
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
+	cm_mark_t				mark;				// sidedness relative to the trace model edges for trace slot 0
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
+	cm_mark_t				mark;				// sidedness relative to the trace model vertices for trace slot 0
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -102,7 +106,7 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance, see CM_CheckPrimitive
 	int						contents;			// contents behind polygon
 	const idMaterial 		*material;			// material
 	idPlane					plane;				// polygon plane
@@ -126,7 +130,7 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance, see CM_CheckPrimitive
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial 		*material;			// material
@@ -171,6 +175,7 @@ typedef struct cm_model_s {
 	int						maxEdges;			// size of edge array
 	int						numEdges;			// number of edges
 	cm_edge_t 				*edges;				// array with all edges used by the model
+	cm_mark_t 				*slotMarks[CM_MAX_TRACE_SLOTS];	// vertex then edge marks of the trace slots other than 0, allocated when first used
 	cm_node_t 				*node;				// first node of spatial subdivision
 	// blocks with allocated memory
 	cm_nodeBlock_t 		*nodeBlocks;			// list with blocks of nodes
@@ -231,6 +236,8 @@ typedef struct cm_trmPolygon_s {
 	idBounds rotationBounds;						// rotation bounds for this polygon
 } cm_trmPolygon_t;
 
+#include "CollisionModel_simd.h"
+
 typedef struct cm_traceWork_s {
 	int numVerts;
 	cm_trmVertex_t vertices[MAX_TRACEMODEL_VERTS];	// trm vertices
@@ -239,6 +246,8 @@ typedef struct cm_traceWork_s {
 	int numPolys;
 	cm_trmPolygon_t polys[MAX_TRACEMODEL_POLYS];	// trm polygons
 	cm_model_t *model;								// model colliding with
+	int slot;										// trace slot the marks on the model primitives are kept in
+	int checkCount;									// for multi-check avoidance, unique over all trace slots
 	idVec3 start;									// start of trace
 	idVec3 end;										// end of trace
 	idVec3 dir;										// trace direction
@@ -255,6 +264,7 @@ typedef struct cm_traceWork_s {
 	bool axisIntersectsTrm;							// true if the rotation axis intersects the trace model
 	bool getContacts;								// true if retrieving contacts
 	bool quickExit;									// set to quickly stop the collision detection calculations
+	bool simd;										// true if using the SIMD kernels with soaVerts
 
 	idVec3 origin;									// origin of rotation in model space
 	idVec3 axis;									// rotation axis in model space
@@ -275,11 +285,60 @@ typedef struct cm_traceWork_s {
 	idPluecker polygonEdgePlueckerCache[CM_MAX_POLYGON_EDGES];
 	idPluecker polygonVertexPlueckerCache[CM_MAX_POLYGON_EDGES];
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
+	cm_trmVertexSoA_t soaVerts;						// trm vertices in structure of arrays layout
+	float soaStartDist[MAX_TRACEMODEL_VERTS];		// distances of the trm vertices to the current polygon plane
+	float soaEndDist[MAX_TRACEMODEL_VERTS];
 } cm_traceWork_t;
 
 /*
 ===============================================================================
 
+Trace slot marks
+
+Slot 0 keeps its marks in the vertices and edges, the other slots keep them in
+side arrays of the model so the primitives stay small for the game thread.
+Polygons and brushes share one check count between the slots. The check counts
+of slot 0 are positive and the ones of the other slots are negative and never
+the same for two slots, so a slot only skips primitives it checked itself.
+Slots run on several job threads at once, so the shared count is only accessed
+with atomic loads and stores through CM_CheckPrimitive. When another slot
+replaced the count in between, the primitive is tested again.
+
+===============================================================================
+*/
+
+ID_INLINE cm_mark_t *CM_VertexMark(const cm_traceWork_t *tw, cm_vertex_t *v)
+{
+	if (tw->slot == 0) {
+		return &v->mark;
+	}
+
+	return &tw->model->slotMarks[tw->slot][v - tw->model->vertices];
+}
+
+ID_INLINE cm_mark_t *CM_EdgeMark(const cm_traceWork_t *tw, cm_edge_t *edge)
+{
+	if (tw->slot == 0) {
+		return &edge->mark;
+	}
+
+	return &tw->model->slotMarks[tw->slot][tw->model->maxVertices + (edge - tw->model->edges)];
+}
+
+// returns true if the polygon or brush with the given check count was already checked by the trace
+ID_INLINE bool CM_CheckPrimitive(const cm_traceWork_t *tw, int *checkcount)
+{
+	if (__atomic_load_n(checkcount, __ATOMIC_RELAXED) == tw->checkCount) {
+		return true;
+	}
+
+	__atomic_store_n(checkcount, tw->checkCount, __ATOMIC_RELAXED);
+	return false;
+}
+
+/*
+===============================================================================
+
 Collision Map
 
 ===============================================================================
@@ -293,6 +352,8 @@ typedef struct cm_procNode_s {
 class idCollisionModelManagerLocal : public idCollisionModelManager
 {
 	public:
+						idCollisionModelManagerLocal(void);
+
 		// load collision models from a map file
 		void			LoadMap(const idMapFile *mapFile);
 		// frees all the collision models
@@ -322,6 +383,8 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		void			Translation(trace_t *results, const idVec3 &start, const idVec3 &end,
 		                                    const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 		                                    cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis);
+		// translates a batch of trms, possibly on several threads
+		void			Translations(cm_translation_t *translations, int numTranslations);
 		// rotates a trm and reports the first collision if any
 		void			Rotation(trace_t *results, const idVec3 &start, const idRotation &rotation,
 		                                 const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -355,6 +418,10 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		bool			TranslateTrmThroughPolygon(cm_traceWork_t *tw, cm_polygon_t *p);
 		void			SetupTranslationHeartPlanes(cm_traceWork_t *tw);
 		void			SetupTrm(cm_traceWork_t *tw, const idTraceModel *trm);
+		void			TranslationSlot(int slot, trace_t *results, const idVec3 &start, const idVec3 &end,
+		                const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+		                cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis);
+		static void		TranslationJob(void *data, int index);
 
 	private:			// CollisionMap_rotate.cpp
 		int				CollisionBetweenEdgeBounds(cm_traceWork_t *tw, const idVec3 &va, const idVec3 &vb,
@@ -388,9 +455,9 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		bool			TestTrmVertsInBrush(cm_traceWork_t *tw, cm_brush_t *b);
 		bool			TestTrmInPolygon(cm_traceWork_t *tw, cm_polygon_t *p);
 		cm_node_t 		*PointNode(const idVec3 &p, cm_model_t *model);
-		int				PointContents(const idVec3 p, cmHandle_t model);
-		int				TransformedPointContents(const idVec3 &p, cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis);
-		int				ContentsTrm(trace_t *results, const idVec3 &start,
+		int				PointContents(const idVec3 p, cmHandle_t model, int slot = 0);
+		int				TransformedPointContents(const idVec3 &p, cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis, int slot = 0);
+		int				ContentsTrm(int slot, trace_t *results, const idVec3 &start,
 		                const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 		                cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis);
 
@@ -404,14 +471,10 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		void			Clear(void);
 		void			FreeTrmModelStructure(void);
 		// model deallocation
-		void			RemovePolygonReferences_r(cm_node_t *node, cm_polygon_t *p);
-		void			RemoveBrushReferences_r(cm_node_t *node, cm_brush_t *b);
-		void			FreeNode(cm_node_t *node);
 		void			FreePolygonReference(cm_polygonRef_t *pref);
 		void			FreeBrushReference(cm_brushRef_t *bref);
 		void			FreePolygon(cm_model_t *model, cm_polygon_t *poly);
 		void			FreeBrush(cm_model_t *model, cm_brush_t *brush);
-		void			FreeTree_r(cm_model_t *model, cm_node_t *headNode, cm_node_t *node);
 		void			FreeModel(cm_model_t *model);
 		// merging polygons
 		void			ReplacePolygons(cm_model_t *model, cm_node_t *node, cm_polygon_t *p1, cm_polygon_t *p2, cm_polygon_t *newp);
@@ -443,6 +506,10 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		void			AddPolygonToNode(cm_model_t *model, cm_node_t *node, cm_polygon_t *p);
 		void			AddBrushToNode(cm_model_t *model, cm_node_t *node, cm_brush_t *b);
 		void			SetupTrmModelStructure(void);
+		cmHandle_t		SetupTrmModelSlot(int slot, const idTraceModel &trm, const idMaterial *material);
+		cm_model_t 	*ModelForSlot(int slot, cmHandle_t model) const;
+		void			AllocSlotMarks(cm_model_t *model, int slot);
+		int				NextCheckCount(int slot);
 		void			R_FilterPolygonIntoTree(cm_model_t *model, cm_node_t *node, cm_polygonRef_t *pref, cm_polygon_t *p);
 		void			R_FilterBrushIntoTree(cm_model_t *model, cm_node_t *node, cm_brushRef_t *pref, cm_brush_t *b);
 		cm_node_t 		*R_CreateAxialBSPTree(cm_model_t *model, cm_node_t *node, const idBounds &bounds);
@@ -504,15 +571,16 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		idStr			mapName;
 		ID_TIME_T			mapFileTime;
 		int				loaded;
-		// for multi-check avoidance
-		int				checkCount;
+		// for multi-check avoidance, one counter per trace slot, see NextCheckCount
+		int				checkCount[CM_MAX_TRACE_SLOTS];
 		// models
 		int				maxModels;
 		int				numModels;
 		cm_model_t 	**models;
-		// polygons and brush for trm model
-		cm_polygonRef_t *trmPolygons[MAX_TRACEMODEL_POLYS];
-		cm_brushRef_t 	*trmBrushes[1];
+		// models, polygons and brush for trm model, one per trace slot
+		cm_model_t 	*trmModels[CM_MAX_TRACE_SLOTS];
+		cm_polygonRef_t *trmPolygons[CM_MAX_TRACE_SLOTS][MAX_TRACEMODEL_POLYS];
+		cm_brushRef_t 	*trmBrushes[CM_MAX_TRACE_SLOTS][1];
 		const idMaterial *trmMaterial;
 		// for data pruning
 		int				numProcNodes;
@@ -522,7 +590,10 @@ class idCollisionModelManagerLocal : public idCollisionModelManager
 		contactInfo_t 	*contacts;
 		int				maxContacts;
 		int				numContacts;
+		// memory for all the models of the map
+		idLevelArena	levelArena;
 };
 
 // for debugging
 extern idCVar cm_debugCollision;
+extern idCVar cm_simd;
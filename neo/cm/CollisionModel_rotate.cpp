@@ -527,7 +527,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon(cm_traceWork_t *t
 		edge = tw->model->edges + abs(edgeNum);
 
 		// if this edge is already checked
-		if (edge->checkcount == idCollisionModelManagerLocal::checkCount) {
+		if (edge->mark.checkcount == tw->checkCount) {
 			continue;
 		}
 
@@ -1109,11 +1109,11 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon(cm_traceWork_t *tw, c
 	idVec3 *rotationOrigin;
 
 	// if already checked this polygon
-	if (p->checkcount == idCollisionModelManagerLocal::checkCount) {
+	if (p->checkcount == tw->checkCount) {
 		return false;
 	}
 
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if (!(p->contents & tw->contents)) {
@@ -1213,12 +1213,12 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon(cm_traceWork_t *tw, c
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 
-			if (e->checkcount == idCollisionModelManagerLocal::checkCount) {
+			if (e->mark.checkcount == tw->checkCount) {
 				continue;
 			}
 
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->mark.checkcount = tw->checkCount;
 
 			// can never collide with internal edges
 			if (e->internal) {
@@ -1231,12 +1231,12 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon(cm_traceWork_t *tw, c
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 
 				// if this vertex is already checked
-				if (v->checkcount == idCollisionModelManagerLocal::checkCount) {
+				if (v->mark.checkcount == tw->checkCount) {
 					continue;
 				}
 
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->mark.checkcount = tw->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if (!tw->bounds.ContainsPoint(v->p)) {
@@ -1332,7 +1332,8 @@ void idCollisionModelManagerLocal::Rotation180(trace_t *results, const idVec3 &r
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.slot = 0;
+	tw.checkCount = NextCheckCount(0);
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -1721,7 +1722,7 @@ void idCollisionModelManagerLocal::Rotation(trace_t *results, const idVec3 &star
 
 	// if special position test
 	if (rotation.GetAngle() == 0.0f) {
-		idCollisionModelManagerLocal::ContentsTrm(results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
+		idCollisionModelManagerLocal::ContentsTrm(0, results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
 		return;
 	}
 
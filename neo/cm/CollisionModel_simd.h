@@ -0,0 +1,341 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __COLLISIONMODEL_SIMD_H__
+#define __COLLISIONMODEL_SIMD_H__
+
+/*
+===============================================================================
+
+	SIMD kernels for the trace model vs. polygonal model collision detection.
+
+	The trace model vertices are copied into a structure of arrays so a
+	single model plane or pluecker coordinate is tested against four trace
+	model vertices per instruction. The kernels evaluate the same expressions
+	in the same order as idPlane::Distance and idPluecker::PermutedInnerProduct.
+
+===============================================================================
+*/
+
+#if defined( __ARM_NEON__ ) || defined( __ARM_NEON )
+#include <arm_neon.h>
+#define CM_SIMD_NEON
+#elif defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+#include <xmmintrin.h>
+#define CM_SIMD_SSE
+#endif
+
+typedef struct cm_trmVertexSoA_s {
+	int count;										// number of vertices rounded up to a multiple of 4
+	unsigned long bits;								// one bit set for each trace model vertex
+	float p[3][MAX_TRACEMODEL_VERTS];				// vertex positions
+	float endp[3][MAX_TRACEMODEL_VERTS];			// end points of the vertices after movement
+	float pl[6][MAX_TRACEMODEL_VERTS];				// pluecker coordinates for the vertex movement
+} cm_trmVertexSoA_t;
+
+/*
+================
+CM_SetupTrmVertexSoA
+
+  the padding is filled with copies of the last vertex so every lane holds valid numbers
+================
+*/
+ID_INLINE void CM_SetupTrmVertexSoA(cm_trmVertexSoA_t *soa, const cm_trmVertex_t *verts, const int numVerts, const bool movement)
+{
+	int i, j, k;
+
+	soa->count = (numVerts + 3) & ~3;
+	soa->bits = numVerts >= 32 ? ~0UL : (1UL << numVerts) - 1;
+
+	for (i = 0; i < soa->count; i++) {
+		k = i < numVerts ? i : numVerts - 1;
+
+		for (j = 0; j < 3; j++) {
+			soa->p[j][i] = verts[k].p[j];
+		}
+
+		if (!movement) {
+			continue;
+		}
+
+		// the end point and pluecker coordinate are only calculated for used vertices
+		if (!verts[k].used) {
+			for (j = 0; j < 3; j++) {
+				soa->endp[j][i] = 0.0f;
+			}
+
+			for (j = 0; j < 6; j++) {
+				soa->pl[j][i] = 0.0f;
+			}
+
+			continue;
+		}
+
+		for (j = 0; j < 3; j++) {
+			soa->endp[j][i] = verts[k].endp[j];
+		}
+
+		for (j = 0; j < 6; j++) {
+			soa->pl[j][i] = verts[k].pl[j];
+		}
+	}
+}
+
+/*
+================
+CM_SoAPlaneDistances
+
+  distances of count points to the plane, count must be a multiple of 4
+================
+*/
+ID_INLINE void CM_SoAPlaneDistances(float *dist, const idPlane &plane, const float xyz[3][MAX_TRACEMODEL_VERTS], const int count)
+{
+	int i;
+
+#if defined( CM_SIMD_NEON )
+	const float32x4_t a = vdupq_n_f32(plane[0]);
+	const float32x4_t b = vdupq_n_f32(plane[1]);
+	const float32x4_t c = vdupq_n_f32(plane[2]);
+	const float32x4_t d = vdupq_n_f32(plane[3]);
+
+	for (i = 0; i < count; i += 4) {
+		float32x4_t r;
+		r = vaddq_f32(vmulq_f32(a, vld1q_f32(xyz[0] + i)), vmulq_f32(b, vld1q_f32(xyz[1] + i)));
+		r = vaddq_f32(r, vmulq_f32(c, vld1q_f32(xyz[2] + i)));
+		vst1q_f32(dist + i, vaddq_f32(r, d));
+	}
+
+#elif defined( CM_SIMD_SSE )
+	const __m128 a = _mm_set1_ps(plane[0]);
+	const __m128 b = _mm_set1_ps(plane[1]);
+	const __m128 c = _mm_set1_ps(plane[2]);
+	const __m128 d = _mm_set1_ps(plane[3]);
+
+	for (i = 0; i < count; i += 4) {
+		__m128 r;
+		r = _mm_add_ps(_mm_mul_ps(a, _mm_loadu_ps(xyz[0] + i)), _mm_mul_ps(b, _mm_loadu_ps(xyz[1] + i)));
+		r = _mm_add_ps(r, _mm_mul_ps(c, _mm_loadu_ps(xyz[2] + i)));
+		_mm_storeu_ps(dist + i, _mm_add_ps(r, d));
+	}
+
+#else
+
+	for (i = 0; i < count; i++) {
+		dist[i] = plane[0] * xyz[0][i] + plane[1] * xyz[1][i] + plane[2] * xyz[2][i] + plane[3];
+	}
+
+#endif
+}
+
+/*
+================
+CM_SoAPermutedInnerProductSigns
+
+  returns a bit mask with the sign bits of pl.PermutedInnerProduct( vertex pluecker ) for count vertices
+================
+*/
+ID_INLINE unsigned long CM_SoAPermutedInnerProductSigns(const idPluecker &pl, const float soa[6][MAX_TRACEMODEL_VERTS], const int count)
+{
+	int i;
+	unsigned long bits = 0;
+
+#if defined( CM_SIMD_NEON )
+	const float32x4_t p0 = vdupq_n_f32(pl[0]);
+	const float32x4_t p1 = vdupq_n_f32(pl[1]);
+	const float32x4_t p2 = vdupq_n_f32(pl[2]);
+	const float32x4_t p3 = vdupq_n_f32(pl[3]);
+	const float32x4_t p4 = vdupq_n_f32(pl[4]);
+	const float32x4_t p5 = vdupq_n_f32(pl[5]);
+	const int32_t shiftValues[4] = { 0, 1, 2, 3 };
+	const int32x4_t shifts = vld1q_s32(shiftValues);
+
+	for (i = 0; i < count; i += 4) {
+		float32x4_t r;
+		uint32x4_t s;
+		uint32x2_t t;
+		r = vaddq_f32(vmulq_f32(p0, vld1q_f32(soa[4] + i)), vmulq_f32(p1, vld1q_f32(soa[5] + i)));
+		r = vaddq_f32(r, vmulq_f32(p2, vld1q_f32(soa[3] + i)));
+		r = vaddq_f32(r, vmulq_f32(p4, vld1q_f32(soa[0] + i)));
+		r = vaddq_f32(r, vmulq_f32(p5, vld1q_f32(soa[1] + i)));
+		r = vaddq_f32(r, vmulq_f32(p3, vld1q_f32(soa[2] + i)));
+		s = vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(r), 31), shifts);
+		t = vpadd_u32(vget_low_u32(s), vget_high_u32(s));
+		t = vpadd_u32(t, t);
+		bits |= (unsigned long) vget_lane_u32(t, 0) << i;
+	}
+
+#elif defined( CM_SIMD_SSE )
+	const __m128 p0 = _mm_set1_ps(pl[0]);
+	const __m128 p1 = _mm_set1_ps(pl[1]);
+	const __m128 p2 = _mm_set1_ps(pl[2]);
+	const __m128 p3 = _mm_set1_ps(pl[3]);
+	const __m128 p4 = _mm_set1_ps(pl[4]);
+	const __m128 p5 = _mm_set1_ps(pl[5]);
+
+	for (i = 0; i < count; i += 4) {
+		__m128 r;
+		r = _mm_add_ps(_mm_mul_ps(p0, _mm_loadu_ps(soa[4] + i)), _mm_mul_ps(p1, _mm_loadu_ps(soa[5] + i)));
+		r = _mm_add_ps(r, _mm_mul_ps(p2, _mm_loadu_ps(soa[3] + i)));
+		r = _mm_add_ps(r, _mm_mul_ps(p4, _mm_loadu_ps(soa[0] + i)));
+		r = _mm_add_ps(r, _mm_mul_ps(p5, _mm_loadu_ps(soa[1] + i)));
+		r = _mm_add_ps(r, _mm_mul_ps(p3, _mm_loadu_ps(soa[2] + i)));
+		bits |= (unsigned long) _mm_movemask_ps(r) << i;
+	}
+
+#else
+
+	for (i = 0; i < count; i++) {
+		float fl = pl[0] * soa[4][i] + pl[1] * soa[5][i] + pl[2] * soa[3][i] + pl[4] * soa[0][i] + pl[5] * soa[1][i] + pl[3] * soa[2][i];
+		bits |= (unsigned long) FLOATSIGNBITSET(fl) << i;
+	}
+
+#endif
+
+	return bits;
+}
+
+/*
+================
+CM_SoAFirstPointInside
+
+  returns the index of the first point at the back of all planes or -1 if there is none
+  bestPlane is set to the first plane the point is closest to
+================
+*/
+ID_INLINE int CM_SoAFirstPointInside(const idPlane *planes, const int numPlanes, const float xyz[3][MAX_TRACEMODEL_VERTS], const int numPoints, int &bestPlane)
+{
+	int i, j;
+
+#if defined( CM_SIMD_NEON ) || defined( CM_SIMD_SSE )
+	float best[4];
+	int inside;
+
+	for (j = 0; j < numPoints; j += 4) {
+#if defined( CM_SIMD_NEON )
+		const float32x4_t x = vld1q_f32(xyz[0] + j);
+		const float32x4_t y = vld1q_f32(xyz[1] + j);
+		const float32x4_t z = vld1q_f32(xyz[2] + j);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		float32x4_t bestd = vdupq_n_f32(-idMath::INFINITY);
+		float32x4_t bestp = zero;
+		uint32x4_t outside = vdupq_n_u32(0);
+		uint32x2_t t;
+
+		for (i = 0; i < numPlanes; i++) {
+			float32x4_t d;
+			uint32x4_t closer;
+			d = vaddq_f32(vmulq_f32(vdupq_n_f32(planes[i][0]), x), vmulq_f32(vdupq_n_f32(planes[i][1]), y));
+			d = vaddq_f32(d, vmulq_f32(vdupq_n_f32(planes[i][2]), z));
+			d = vaddq_f32(d, vdupq_n_f32(planes[i][3]));
+			outside = vorrq_u32(outside, vcgeq_f32(d, zero));
+			closer = vcgtq_f32(d, bestd);
+			bestd = vbslq_f32(closer, d, bestd);
+			bestp = vbslq_f32(closer, vdupq_n_f32((float) i), bestp);
+
+			// stop when all four points are outside
+			t = vand_u32(vget_low_u32(outside), vget_high_u32(outside));
+
+			if ((vget_lane_u32(t, 0) & vget_lane_u32(t, 1)) != 0) {
+				break;
+			}
+		}
+
+		inside = (((~vgetq_lane_u32(outside, 0)) >> 31) << 0) |
+		         (((~vgetq_lane_u32(outside, 1)) >> 31) << 1) |
+		         (((~vgetq_lane_u32(outside, 2)) >> 31) << 2) |
+		         (((~vgetq_lane_u32(outside, 3)) >> 31) << 3);
+		vst1q_f32(best, bestp);
+#else
+		const __m128 x = _mm_loadu_ps(xyz[0] + j);
+		const __m128 y = _mm_loadu_ps(xyz[1] + j);
+		const __m128 z = _mm_loadu_ps(xyz[2] + j);
+		const __m128 zero = _mm_setzero_ps();
+		__m128 bestd = _mm_set1_ps(-idMath::INFINITY);
+		__m128 bestp = zero;
+		__m128 outside = zero;
+
+		for (i = 0; i < numPlanes; i++) {
+			__m128 d, closer;
+			d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes[i][0]), x), _mm_mul_ps(_mm_set1_ps(planes[i][1]), y));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(planes[i][2]), z));
+			d = _mm_add_ps(d, _mm_set1_ps(planes[i][3]));
+			outside = _mm_or_ps(outside, _mm_cmpge_ps(d, zero));
+			closer = _mm_cmpgt_ps(d, bestd);
+			bestd = _mm_or_ps(_mm_and_ps(closer, d), _mm_andnot_ps(closer, bestd));
+			bestp = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps((float) i)), _mm_andnot_ps(closer, bestp));
+
+			// stop when all four points are outside
+			if (_mm_movemask_ps(outside) == 15) {
+				break;
+			}
+		}
+
+		inside = _mm_movemask_ps(outside) ^ 15;
+		_mm_storeu_ps(best, bestp);
+#endif
+
+		for (i = 0; i < 4 && j + i < numPoints; i++) {
+			if (inside & (1 << i)) {
+				bestPlane = (int) best[i];
+				return j + i;
+			}
+		}
+	}
+
+#else
+	float d, bestd;
+
+	for (j = 0; j < numPoints; j++) {
+		bestPlane = 0;
+		bestd = -idMath::INFINITY;
+
+		for (i = 0; i < numPlanes; i++) {
+			d = planes[i][0] * xyz[0][j] + planes[i][1] * xyz[1][j] + planes[i][2] * xyz[2][j] + planes[i][3];
+
+			if (d >= 0.0f) {
+				break;
+			}
+
+			if (d > bestd) {
+				bestd = d;
+				bestPlane = i;
+			}
+		}
+
+		if (i >= numPlanes) {
+			return j;
+		}
+	}
+
+#endif
+
+	return -1;
+}
+
+#endif /* !__COLLISIONMODEL_SIMD_H__ */
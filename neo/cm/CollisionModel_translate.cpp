@@ -39,6 +39,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "CollisionModel_local.h"
 
+idCVar cm_simd("cm_simd", "1", CVAR_GAME | CVAR_BOOL, "test the trace model vertices four at a time with SIMD instructions");
+
 /*
 ===============================================================================
 
@@ -205,7 +207,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness(cm_vertex_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum)
+ID_INLINE void CM_SetVertexSidedness(cm_mark_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum)
 {
 	if (!(v->sideSet & (1<<bitNum))) {
 		float fl;
@@ -222,7 +224,7 @@ CM_SetEdgeSidedness
   stores for the given model edge at which side one of the trm vertices
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness(cm_edge_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum)
+ID_INLINE void CM_SetEdgeSidedness(cm_mark_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum)
 {
 	if (!(edge->sideSet & (1<<bitNum))) {
 		float fl;
@@ -244,15 +246,17 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon(cm_traceWork_t
 	idVec3 start, end, normal;
 	cm_edge_t *edge;
 	cm_vertex_t *v1, *v2;
+	cm_mark_t *edgeMark, *v1Mark, *v2Mark;
 	idPluecker *pl, epsPl;
 
 	// check edges for a collision
 	for (i = 0; i < poly->numEdges; i++) {
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		edgeMark = CM_EdgeMark(tw, edge);
 
 		// if this edge is already checked
-		if (edge->checkcount == idCollisionModelManagerLocal::checkCount) {
+		if (edgeMark->checkcount == tw->checkCount) {
 			continue;
 		}
 
@@ -263,22 +267,24 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon(cm_traceWork_t
 
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness(edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0]);
-		CM_SetEdgeSidedness(edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1]);
+		CM_SetEdgeSidedness(edgeMark, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0]);
+		CM_SetEdgeSidedness(edgeMark, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1]);
 
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if (!(((edge->side >> trmEdge->vertexNum[0]) ^(edge->side >> trmEdge->vertexNum[1])) & 1)) {
+		if (!(((edgeMark->side >> trmEdge->vertexNum[0]) ^(edgeMark->side >> trmEdge->vertexNum[1])) & 1)) {
 			continue;
 		}
 
 		// get the sides at which the polygon edge vertices pass the trm edge
 		v1 = tw->model->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
-		CM_SetVertexSidedness(v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum);
+		v1Mark = CM_VertexMark(tw, v1);
+		CM_SetVertexSidedness(v1Mark, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum);
 		v2 = tw->model->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
-		CM_SetVertexSidedness(v2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum);
+		v2Mark = CM_VertexMark(tw, v2);
+		CM_SetVertexSidedness(v2Mark, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum);
 
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
-		if (!((v1->side ^ v2->side) & (1<<trmEdge->bitNum))) {
+		if (!((v1Mark->side ^ v2Mark->side) & (1<<trmEdge->bitNum))) {
 			continue;
 		}
 
@@ -386,6 +392,36 @@ float CM_TranslationPlaneFraction(idPlane &plane, idVec3 &start, idVec3 &end)
 
 #else
 
+/*
+================
+CM_TranslationDistanceFraction
+
+  same as CM_TranslationPlaneFraction with the plane distances of the start and end point calculated up front
+================
+*/
+ID_INLINE float CM_TranslationDistanceFraction(float d1, float d2)
+{
+	float d2eps;
+
+	d2eps = d2 - CM_CLIP_EPSILON;
+
+	if (FLOATSIGNBITNOTSET(d2eps)) {
+		return 1.0f;
+	}
+
+	if (FLOATSIGNBITSET(d1)) {
+		return 1.0f;
+	}
+
+	d2 = d1 - d2;
+
+	if (d2 <= 0.0f) {
+		return 1.0f;
+	}
+
+	return (d1-CM_CLIP_EPSILON) / d2;
+}
+
 float CM_TranslationPlaneFraction(idPlane &plane, idVec3 &start, idVec3 &end)
 {
 	float d1, d2, d2eps;
@@ -430,17 +466,23 @@ void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon(cm_traceWork
 	int i, edgeNum;
 	float f;
 	cm_edge_t *edge;
+	cm_mark_t *edgeMark;
 
-	f = CM_TranslationPlaneFraction(poly->plane, v->p, v->endp);
+	if (tw->simd) {
+		f = CM_TranslationDistanceFraction(tw->soaStartDist[bitNum], tw->soaEndDist[bitNum]);
+	} else {
+		f = CM_TranslationPlaneFraction(poly->plane, v->p, v->endp);
+	}
 
 	if (f < tw->trace.fraction) {
 
 		for (i = 0; i < poly->numEdges; i++) {
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
-			CM_SetEdgeSidedness(edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum);
+			edgeMark = CM_EdgeMark(tw, edge);
+			CM_SetEdgeSidedness(edgeMark, tw->polygonEdgePlueckerCache[i], v->pl, bitNum);
 
-			if (INTSIGNBITSET(edgeNum) ^((edge->side >> bitNum) & 1)) {
+			if (INTSIGNBITSET(edgeNum) ^((edgeMark->side >> bitNum) & 1)) {
 				return;
 			}
 		}
@@ -479,6 +521,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon(cm_traceWork_t *
 	int i, edgeNum;
 	float f;
 	cm_edge_t *edge;
+	cm_mark_t *edgeMark;
 	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction(poly->plane, v->p, v->endp);
@@ -488,19 +531,20 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon(cm_traceWork_t *
 		for (i = 0; i < poly->numEdges; i++) {
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
+			edgeMark = CM_EdgeMark(tw, edge);
 
 			// if we didn't yet calculate the sidedness for this edge
-			if (edge->checkcount != idCollisionModelManagerLocal::checkCount) {
+			if (edgeMark->checkcount != tw->checkCount) {
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edgeMark->checkcount = tw->checkCount;
 				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
 				fl = v->pl.PermutedInnerProduct(pl);
-				edge->side = FLOATSIGNBITSET(fl);
+				edgeMark->side = FLOATSIGNBITSET(fl);
 			}
 
 			// if the point passes the edge at the wrong side
 			//if ( (edgeNum > 0) == edge->side ) {
-			if (INTSIGNBITSET(edgeNum) ^ edge->side) {
+			if (INTSIGNBITSET(edgeNum) ^ edgeMark->side) {
 				return;
 			}
 		}
@@ -539,18 +583,20 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon(cm_traceWork
 	int i, edgeNum;
 	float f;
 	cm_trmEdge_t *edge;
+	cm_mark_t *mark;
 
 	f = CM_TranslationPlaneFraction(trmpoly->plane, v->p, endp);
 
 	if (f < tw->trace.fraction) {
+		mark = CM_VertexMark(tw, v);
 
 		for (i = 0; i < trmpoly->numEdges; i++) {
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs(edgeNum);
 
-			CM_SetVertexSidedness(v, pl, edge->pl, edge->bitNum);
+			CM_SetVertexSidedness(mark, pl, edge->pl, edge->bitNum);
 
-			if (INTSIGNBITSET(edgeNum) ^((v->side >> edge->bitNum) & 1)) {
+			if (INTSIGNBITSET(edgeNum) ^((mark->side >> edge->bitNum) & 1)) {
 				return;
 			}
 		}
@@ -595,14 +641,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon(cm_traceWork_t *tw
 	cm_trmPolygon_t *bp;
 	cm_vertex_t *v;
 	cm_edge_t *e;
+	cm_mark_t *mark;
 
 	// if already checked this polygon
-	if (p->checkcount == idCollisionModelManagerLocal::checkCount) {
+	if (CM_CheckPrimitive(tw, &p->checkcount)) {
 		return false;
 	}
 
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
-
 	// if this polygon does not have the right contents behind it
 	if (!(p->contents & tw->contents)) {
 		return false;
@@ -659,20 +704,30 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon(cm_traceWork_t *tw
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 
-			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if (e->checkcount != idCollisionModelManagerLocal::checkCount) {
-				e->sideSet = 0;
-			}
-
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine(tw->model->vertices[e->vertexNum[0]].p,
 			                tw->model->vertices[e->vertexNum[1]].p);
 
+			// reset sidedness cache if this is the first time we encounter this edge during this trace
+			mark = CM_EdgeMark(tw, e);
+
+			if (mark->checkcount != tw->checkCount) {
+				if (tw->simd) {
+					// sides of all trm vertices at once
+					mark->side = CM_SoAPermutedInnerProductSigns(tw->polygonEdgePlueckerCache[i], tw->soaVerts.pl, tw->soaVerts.count);
+					mark->sideSet = tw->soaVerts.bits;
+				} else {
+					mark->sideSet = 0;
+				}
+			}
+
 			v = &tw->model->vertices[e->vertexNum[INTSIGNBITSET(edgeNum)]];
 
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if (v->checkcount != idCollisionModelManagerLocal::checkCount) {
-				v->sideSet = 0;
+			mark = CM_VertexMark(tw, v);
+
+			if (mark->checkcount != tw->checkCount) {
+				mark->sideSet = 0;
 			}
 
 			// pluecker coordinate for vertex movement vector
@@ -682,6 +737,12 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon(cm_traceWork_t *tw
 		// copy first to last so we can easily cycle through for the edges
 		tw->polygonVertexPlueckerCache[p->numEdges] = tw->polygonVertexPlueckerCache[0];
 
+		// distances of all trm vertices to the polygon plane
+		if (tw->simd) {
+			CM_SoAPlaneDistances(tw->soaStartDist, p->plane, tw->soaVerts.p, tw->soaVerts.count);
+			CM_SoAPlaneDistances(tw->soaEndDist, p->plane, tw->soaVerts.endp, tw->soaVerts.count);
+		}
+
 		// trace trm vertices through polygon
 		for (i = 0; i < tw->numVerts; i++) {
 			bv = tw->vertices + i;
@@ -704,13 +765,14 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon(cm_traceWork_t *tw
 		for (i = 0; i < p->numEdges; i++) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			mark = CM_EdgeMark(tw, e);
 
-			if (e->checkcount == idCollisionModelManagerLocal::checkCount) {
+			if (mark->checkcount == tw->checkCount) {
 				continue;
 			}
 
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			mark->checkcount = tw->checkCount;
 
 			// can never collide with internal edges
 			if (e->internal) {
@@ -721,14 +783,15 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon(cm_traceWork_t *tw
 			for (k = 0; k < 2; k++) {
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
+				mark = CM_VertexMark(tw, v);
 
 				// if this vertex is already checked
-				if (v->checkcount == idCollisionModelManagerLocal::checkCount) {
+				if (mark->checkcount == tw->checkCount) {
 					continue;
 				}
 
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				mark->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if (!tw->bounds.ContainsPoint(v->p)) {
@@ -839,11 +902,28 @@ void idCollisionModelManagerLocal::SetupTranslationHeartPlanes(cm_traceWork_t *t
 idCollisionModelManagerLocal::Translation
 ================
 */
+void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &start, const idVec3 &end,
+                const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+                cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis)
+{
+	TranslationSlot(0, results, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
+}
+
+/*
+================
+idCollisionModelManagerLocal::TranslationSlot
+
+  the trace work and the marks on the model primitives are kept per trace slot
+  so translations in different slots can run at the same time
+================
+*/
 #ifdef _DEBUG
 static int entered = 0;
 #endif
 
-void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &start, const idVec3 &end,
+ALIGN16(static cm_traceWork_t translationWork[CM_MAX_TRACE_SLOTS]);
+
+void idCollisionModelManagerLocal::TranslationSlot(int slot, trace_t *results, const idVec3 &start, const idVec3 &end,
                 const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
                 cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis)
 {
@@ -856,7 +936,7 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16(static cm_traceWork_t tw);
+	cm_traceWork_t &tw = translationWork[slot];
 
 	assert(((byte *)&start) < ((byte *)results) || ((byte *)&start) >= (((byte *)results) + sizeof(trace_t)));
 	assert(((byte *)&end) < ((byte *)results) || ((byte *)&end) >= (((byte *)results) + sizeof(trace_t)));
@@ -869,14 +949,14 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 		return;
 	}
 
-	if (!idCollisionModelManagerLocal::models[model]) {
+	if (!ModelForSlot(slot, model)) {
 		common->Printf("idCollisionModelManagerLocal::Translation: invalid model\n");
 		return;
 	}
 
 	// if case special position test
 	if (start[0] == end[0] && start[1] == end[1] && start[2] == end[2]) {
-		idCollisionModelManagerLocal::ContentsTrm(results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
+		idCollisionModelManagerLocal::ContentsTrm(slot, results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis);
 		return;
 	}
 
@@ -884,7 +964,7 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 	bool startsolid = false;
 
 	// test whether or not stuck to begin with
-	if (cm_debugCollision.GetBool()) {
+	if (cm_debugCollision.GetBool() && slot == 0) {
 		if (!entered && !idCollisionModelManagerLocal::getContacts) {
 			entered = 1;
 
@@ -899,7 +979,8 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.slot = slot;
+	tw.checkCount = NextCheckCount(slot);
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -909,11 +990,12 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
+	tw.getContacts = idCollisionModelManagerLocal::getContacts && slot == 0;
+	tw.simd = false;
 	tw.contacts = idCollisionModelManagerLocal::contacts;
 	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = ModelForSlot(slot, model);
 	tw.start = start - modelOrigin;
 	tw.end = end - modelOrigin;
 	tw.dir = end - start;
@@ -979,7 +1061,10 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 			results->c.dist += modelOrigin * results->c.normal;
 		}
 
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		if (tw.getContacts) {
+			idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		}
+
 		return;
 	}
 
@@ -992,11 +1077,15 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 		results->c.material = NULL;
 		results->c.point = start;
 
-		if (session->rw) {
-			session->rw->DebugArrow(colorRed, start, end, 1);
+		// only report from the game thread
+		if (slot == 0) {
+			if (session->rw) {
+				session->rw->DebugArrow(colorRed, start, end, 1);
+			}
+
+			common->Printf("idCollisionModelManagerLocal::Translation: huge translation\n");
 		}
 
-		common->Printf("idCollisionModelManagerLocal::Translation: huge translation\n");
 		return;
 	}
 
@@ -1120,6 +1209,11 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 		}
 	}
 
+	if (cm_simd.GetBool()) {
+		CM_SetupTrmVertexSoA(&tw.soaVerts, tw.vertices, tw.numVerts, true);
+		tw.simd = true;
+	}
+
 	// bounds for full trace, a little bit larger for epsilons
 	for (i = 0; i < 3; i++) {
 		if (tw.start[i] < tw.end[i]) {
@@ -1212,7 +1306,7 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 #ifdef _DEBUG
 
 	// test for missed collisions
-	if (cm_debugCollision.GetBool()) {
+	if (cm_debugCollision.GetBool() && slot == 0) {
 		if (!entered && !idCollisionModelManagerLocal::getContacts) {
 			entered = 1;
 
@@ -1232,3 +1326,90 @@ void idCollisionModelManagerLocal::Translation(trace_t *results, const idVec3 &s
 
 #endif
 }
+
+static idCVar cm_parallelTranslations("cm_parallelTranslations", "1", CVAR_GAME | CVAR_BOOL, "spread batched translations over the job threads");
+
+typedef struct cm_translationBatch_s {
+	idCollisionModelManagerLocal *	manager;
+	cm_translation_t *				translations;
+	int								numTranslations;
+	volatile int					next;			// next translation to hand out
+} cm_translationBatch_t;
+
+/*
+================
+idCollisionModelManagerLocal::TranslationJob
+================
+*/
+void idCollisionModelManagerLocal::TranslationJob(void *data, int index)
+{
+	cm_translationBatch_t *batch = (cm_translationBatch_t *)data;
+	idCollisionModelManagerLocal *manager = batch->manager;
+	cm_translation_t *t;
+	cmHandle_t model;
+	int i;
+
+	// every job has its own slot, the translations are handed out one at a time
+	for (i = __sync_fetch_and_add(&batch->next, 1); i < batch->numTranslations; i = __sync_fetch_and_add(&batch->next, 1)) {
+		t = &batch->translations[i];
+		model = t->model;
+
+		if (t->modelTrm) {
+			model = manager->SetupTrmModelSlot(index, *t->modelTrm, t->modelMaterial);
+		}
+
+		manager->TranslationSlot(index, &t->results, t->start, t->end, t->trm, t->trmAxis, t->contentMask, model, t->modelOrigin, t->modelAxis);
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::Translations
+================
+*/
+void idCollisionModelManagerLocal::Translations(cm_translation_t *translations, int numTranslations)
+{
+	cm_translationBatch_t batch;
+	cm_model_t *model;
+	int i, slot, numJobs;
+
+	if (numTranslations <= 0) {
+		return;
+	}
+
+	batch.manager = this;
+	batch.translations = translations;
+	batch.numTranslations = numTranslations;
+	batch.next = 0;
+
+	numJobs = 1;
+
+	if (cm_parallelTranslations.GetBool()) {
+		// jobs without a free thread find no translations left once they run
+		numJobs = Min(CM_MAX_TRACE_SLOTS, numTranslations);
+	}
+
+	if (numJobs <= 1) {
+		TranslationJob(&batch, 0);
+		return;
+	}
+
+	// the jobs cannot allocate, so setup the marks of the other slots first
+	for (i = 0; i < numTranslations; i++) {
+		if (translations[i].modelTrm || translations[i].model == TRACE_MODEL_HANDLE) {
+			continue;
+		}
+
+		model = models[translations[i].model];
+
+		if (!model) {
+			continue;
+		}
+
+		for (slot = 1; slot < numJobs; slot++) {
+			AllocSlotMarks(model, slot);
+		}
+	}
+
+	Sys_ParallelJobs(TranslationJob, &batch, numJobs);
+}
@@ -241,7 +241,7 @@ void idGameEdit::ParseSpawnArgsToRenderEntity(const idDict *args, renderEntity_t
 
 	memset(renderEntity, 0, sizeof(*renderEntity));
 
-	temp = args->GetString("model");
+	temp = args->GetString(KEY_Model);
 
 	modelDef = NULL;
 
@@ -277,11 +277,11 @@ void idGameEdit::ParseSpawnArgsToRenderEntity(const idDict *args, renderEntity_t
 		renderEntity->customShader = declManager->FindMaterial(temp);
 	}
 
-	args->GetVector("origin", "0 0 0", renderEntity->origin);
+	args->GetVector(KEY_Origin, "0 0 0", renderEntity->origin);
 
 	// get the rotation matrix in either full form, or single angle form
-	if (!args->GetMatrix("rotation", "1 0 0 0 1 0 0 0 1", renderEntity->axis)) {
-		angle = args->GetFloat("angle");
+	if (!args->GetMatrix(KEY_Rotation, "1 0 0 0 1 0 0 0 1", renderEntity->axis)) {
+		angle = args->GetFloat(KEY_Angle);
 
 		if (angle != 0.0f) {
 			renderEntity->axis = idAngles(0.0f, angle, 0.0f).ToMat3();
@@ -506,7 +506,7 @@ void idEntity::Spawn(void)
 
 	gameLocal.RegisterEntity(this);
 
-	spawnArgs.GetString("classname", NULL, &classname);
+	spawnArgs.GetString(KEY_Classname, NULL, &classname);
 	const idDeclEntityDef *def = gameLocal.FindEntityDef(classname, false);
 
 	if (def) {
@@ -561,7 +561,7 @@ void idEntity::Spawn(void)
 
 	fl.solidForTeam = spawnArgs.GetBool("solidForTeam", "0");
 	fl.neverDormant = spawnArgs.GetBool("neverDormant", "0");
-	fl.hidden = spawnArgs.GetBool("hide", "0");
+	fl.hidden = spawnArgs.GetBool(KEY_Hide, "0");
 
 	if (fl.hidden) {
 		// make sure we're hidden, since a spawn function might not set it up right
@@ -580,7 +580,7 @@ void idEntity::Spawn(void)
 
 	if (!gameLocal.isClient) {
 		// common->DPrintf( "NET: DBG %s - %s is synced: %s\n", spawnArgs.GetString( "classname", "" ), GetType()->classname, fl.networkSync ? "true" : "false" );
-		if (spawnArgs.GetString("classname", "")[ 0 ] == '\0' && !fl.networkSync) {
+		if (spawnArgs.GetString(KEY_Classname, "")[ 0 ] == '\0' && !fl.networkSync) {
 			common->DPrintf("NET: WRN %s entity, no classname, and no networkSync?\n", GetType()->classname);
 		}
 	}
@@ -588,7 +588,7 @@ void idEntity::Spawn(void)
 #endif
 
 	// every object will have a unique name
-	temp = spawnArgs.GetString("name", va("%s_%s_%d", GetClassname(), spawnArgs.GetString("classname"), entityNumber));
+	temp = spawnArgs.GetString(KEY_Name, va("%s_%s_%d", GetClassname(), spawnArgs.GetString(KEY_Classname), entityNumber));
 	SetName(temp);
 
 	// if we have targets, wait until all entities are spawned to get them
@@ -601,20 +601,20 @@ void idEntity::Spawn(void)
 		}
 	}
 
-	health = spawnArgs.GetInt("health");
+	health = spawnArgs.GetInt(KEY_Health);
 
 	InitDefaultPhysics(origin, axis);
 
 	SetOrigin(origin);
 	SetAxis(axis);
 
-	temp = spawnArgs.GetString("model");
+	temp = spawnArgs.GetString(KEY_Model);
 
 	if (temp && *temp) {
 		SetModel(temp);
 	}
 
-	if (spawnArgs.GetString("bind", "", &temp)) {
+	if (spawnArgs.GetString(KEY_Bind, "", &temp)) {
 		PostEventMS(&EV_SpawnBind, 0);
 	}
 
@@ -956,6 +956,35 @@ void idEntity::Think(void)
 	Present();
 }
 
+/*
+================
+idEntity::NeedsParallelThink
+================
+*/
+bool idEntity::NeedsParallelThink(void) const
+{
+	return false;
+}
+
+/*
+================
+idEntity::ParallelThink
+================
+*/
+void idEntity::ParallelThink(void)
+{
+}
+
+/*
+================
+idEntity::CheckParallelThink
+================
+*/
+bool idEntity::CheckParallelThink(void)
+{
+	return true;
+}
+
 /*
 ================
 idEntity::DoDormantTests
@@ -5581,6 +5610,63 @@ void idAnimatedEntity::Think(void)
 	UpdateDamageEffects();
 }
 
+/*
+================
+idAnimatedEntity::NeedsParallelThink
+
+Only visible animating models, anything else keeps building its frame on demand.
+================
+*/
+bool idAnimatedEntity::NeedsParallelThink(void) const
+{
+	if (!(thinkFlags & TH_ANIMATE) || fl.hidden || modelDefHandle == -1) {
+		return false;
+	}
+
+	return animator.ModelHandle() && animator.IsAnimating(gameLocal.GetTimeGroupTime(timeGroup));
+}
+
+/*
+================
+idAnimatedEntity::ParallelThink
+
+Builds the joints for the current frame so that the render callback and joint
+queries find them up to date.  The pose only depends on the animator's state,
+so building it early gives the same joints as building it on demand.  Uses the
+time of the entity's time group directly, SetTimeState isn't thread safe.
+================
+*/
+void idAnimatedEntity::ParallelThink(void)
+{
+	animator.CreateFrame(gameLocal.GetTimeGroupTime(timeGroup), false);
+}
+
+/*
+================
+idAnimatedEntity::CheckParallelThink
+================
+*/
+bool idAnimatedEntity::CheckParallelThink(void)
+{
+	idJointMat	*joints;
+	idJointMat	*parallelJoints;
+	int			numJoints;
+
+	animator.GetJoints(&numJoints, &joints);
+
+	// the pose of small models far away is not rebuilt every frame
+	if (!numJoints || !animator.FrameIsCurrent(gameLocal.GetTimeGroupTime(timeGroup))) {
+		return true;
+	}
+
+	parallelJoints = (idJointMat *)_alloca16(numJoints * sizeof(parallelJoints[0]));
+	memcpy(parallelJoints, joints, numJoints * sizeof(parallelJoints[0]));
+
+	animator.CreateFrame(gameLocal.GetTimeGroupTime(timeGroup), true);
+
+	return memcmp(parallelJoints, joints, numJoints * sizeof(parallelJoints[0])) == 0;
+}
+
 /*
 ================
 idAnimatedEntity::UpdateAnimation
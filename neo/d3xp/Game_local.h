@@ -104,6 +104,7 @@ void gameError(const char *fmt, ...);
 
 #include "physics/Clip.h"
 #include "physics/Push.h"
+#include "physics/Physics_LOD.h"
 
 #include "Pvs.h"
 #include "MultiplayerGame.h"
@@ -331,6 +332,7 @@ class idGameLocal : public idGame
 
 		idClip					clip;					// collision detection
 		idPush					push;					// geometric pushing
+		idPhysicsLOD			physicsLOD;				// physics level of detail
 		idPVS					pvs;					// potential visible set
 
 		idTestModel 			*testmodel;				// for development testing of models
@@ -348,6 +350,7 @@ class idGameLocal : public idGame
 		int						cinematicMaxSkipTime;	// time to end cinematic when skipping.  there's a possibility of an infinite loop if the map isn't set up right.
 		bool					inCinematic;			// game is playing cinematic (player controls frozen)
 		bool					skipCinematic;
+		bool					inParallelThink;		// entities are running ParallelThink on the job threads
 
 		// are kept up to date with changes to serverInfo
 		int						framenum;
@@ -452,6 +455,8 @@ class idGameLocal : public idGame
 
 		virtual void				GetMapLoadingGUI(char gui[ MAX_STRING_CHARS ]);
 
+		virtual void				GetMemTagStats(memTagStats_t stats[MEMTAG_NUM]);
+
 		// ---------------------- Public idGameLocal Interface -------------------
 
 		void					Printf(const char *fmt, ...) const id_attribute((format(printf,2,3)));
@@ -604,6 +609,7 @@ class idGameLocal : public idGame
 		pvsHandle_t				playerConnectedAreas;	// all areas connected to any player area
 
 		idVec3					gravity;				// global gravity vector
+		idList<idEntity *>		parallelThinkEntities;	// entities running ParallelThink this frame
 		gameState_t				gamestate;				// keeps track of whether we're spawning, shutting down, or normal gameplay
 		bool					influenceActive;		// true when a phantasm is happening
 		int						nextGibTime;
@@ -649,6 +655,8 @@ class idGameLocal : public idGame
 		void					FreePlayerPVS(void);
 		void					UpdateGravity(void);
 		void					SortActiveEntityList(void);
+		void					RunParallelThink(void);
+		static void				ParallelThinkJob(void *data, int index);
 		void					ShowTargets(void);
 		void					RunDebugInfo(void);
 
@@ -686,6 +694,19 @@ class idGameLocal : public idGame
 extern idGameLocal			gameLocal;
 extern idAnimManager		animationLib;
 
+// interned spawn arg keys looked up for every spawned entity
+extern const idDictKey		KEY_Classname;
+extern const idDictKey		KEY_Name;
+extern const idDictKey		KEY_SpawnClass;
+extern const idDictKey		KEY_SpawnFunc;
+extern const idDictKey		KEY_Model;
+extern const idDictKey		KEY_Origin;
+extern const idDictKey		KEY_Rotation;
+extern const idDictKey		KEY_Angle;
+extern const idDictKey		KEY_Health;
+extern const idDictKey		KEY_Hide;
+extern const idDictKey		KEY_Bind;
+
 //============================================================================
 
 class idGameError : public idException
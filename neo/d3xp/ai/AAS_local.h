@@ -86,6 +86,21 @@ class idRoutingObstacle
 };
 
 
+typedef struct aasPathQuery_s {
+	aasPathHandle_t				handle;					// 0 if the query is not used
+	bool						fly;					// fly or walk path
+	int							areaNum;
+	idVec3						origin;
+	int							goalAreaNum;
+	idVec3						goalOrigin;
+	int							travelFlags;
+	int							queueService;			// number of ServicePathQueries calls when queued
+	bool						done;					// set once the path has been created
+	bool						found;
+	aasPath_t					path;
+} aasPathQuery_t;
+
+
 class idAASLocal : public idAAS
 {
 	public:
@@ -122,6 +137,10 @@ class idAASLocal : public idAAS
 		virtual void				ShowWalkPath(const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin) const;
 		virtual void				ShowFlyPath(const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin) const;
 		virtual bool				FindNearestGoal(aasGoal_t &goal, int areaNum, const idVec3 origin, const idVec3 &target, int travelFlags, aasObstacle_t *obstacles, int numObstacles, idAASCallback &callback) const;
+		virtual aasPathHandle_t		QueuePathQuery(bool fly, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags);
+		virtual aasPathQueryStatus_t GetPathQueryResult(aasPathHandle_t handle, aasPath_t &path, bool &found) const;
+		virtual void				FreePathQuery(aasPathHandle_t handle);
+		virtual void				ServicePathQueries(void);
 
 	private:
 		idAASFile 					*file;
@@ -141,6 +160,26 @@ class idAASLocal : public idAAS
 		mutable idRoutingCache 	*cacheListEnd;			// end of list with cache sorted from oldest to newest
 		mutable int					totalCacheMemory;		// total cache memory used
 		idList<idRoutingObstacle *>	obstacleList;			// list with obstacles
+		idLevelArena				routingArena;			// memory for the routing data above, freed with the AAS file
+		mutable bool				routingCacheShared;		// the routing cache is used by several job threads
+		idList<idRoutingUpdate *>	areaUpdateSets;			// areaUpdate and the copies for the job threads
+		idList<idRoutingUpdate *>	portalUpdateSets;		// portalUpdate and the copies for the job threads
+		mutable idList<idRoutingUpdate *> freeAreaUpdates;	// sets not in use while the routing cache is shared
+		mutable idList<idRoutingUpdate *> freePortalUpdates;
+
+	private:	// path queries
+		idList<aasPathQuery_t>		pathQueries;			// queries by the low bits of their handle
+		idList<int>					pendingPathQueries;		// queries serviced by the running ServicePathQueries
+		int							numPathQuerySlots;		// job threads the pending queries are spread over
+		int							pathQuerySequence;		// high bits of the next handle
+		int							numPathQueryServices;	// ServicePathQueries calls, once per game frame
+		int							numServicedPathQueries;	// path query statistics since the map was loaded
+		int							maxPathQueueDepth;
+		int							totalPathQueryLatency;	// in game frames, summed when a serviced query is freed
+		int							numFreedPathQueries;
+		int							maxPathQueryLatency;
+		float						totalPathServiceTime;	// in milliseconds
+		float						maxPathServiceTime;
 
 	private:	// routing
 		bool						SetupRouting(void);
@@ -168,12 +207,20 @@ class idAASLocal : public idAAS
 		bool						SetAreaState_r(int nodeNum, const idBounds &bounds, const int areaContents, bool disabled);
 		void						GetBoundsAreas_r(int nodeNum, const idBounds &bounds, idList<int> &areas) const;
 		void						SetObstacleState(const idRoutingObstacle *obstacle, bool enable);
+		void						ShareRoutingCache(int numThreads);
+		void						UnshareRoutingCache(void);
+		idRoutingUpdate 			*AllocRoutingUpdate(idList<idRoutingUpdate *> &freeUpdates, idRoutingUpdate *update) const;
+		void						FreeRoutingUpdate(idList<idRoutingUpdate *> &freeUpdates, idRoutingUpdate *update) const;
+		idRoutingCache 			*FindRoutingCache(idRoutingCache *list, int travelFlags) const;
 
 	private:	// pathing
 		bool						EdgeSplitPoint(idVec3 &split, int edgeNum, const idPlane &plane) const;
 		bool						FloorEdgeSplitPoint(idVec3 &split, int areaNum, const idPlane &splitPlane, const idPlane &frontPlane, bool closest) const;
 		idVec3						SubSampleWalkPath(int areaNum, const idVec3 &origin, const idVec3 &start, const idVec3 &end, int travelFlags, int &endAreaNum) const;
 		idVec3						SubSampleFlyPath(int areaNum, const idVec3 &origin, const idVec3 &start, const idVec3 &end, int travelFlags, int &endAreaNum) const;
+		void						ClearPathQueries(void);
+		void						PathQueryStats(void) const;
+		static void					PathQueryJob(void *data, int index);
 
 	private:	// debug
 		const idBounds 			&DefaultSearchBounds(void) const;
@@ -34,6 +34,9 @@ If you have questions concerning this license or the applicable additional terms
 #define SUBSAMPLE_WALK_PATH		1
 #define SUBSAMPLE_FLY_PATH		0
 
+#define PATHQUERY_INDEX_BITS	12
+#define PATHQUERY_INDEX_MASK	((1 << PATHQUERY_INDEX_BITS) - 1)
+
 const int		maxWalkPathIterations		= 10;
 const float		maxWalkPathDistance			= 500.0f;
 const float		walkPathSampleDistance		= 8.0f;
@@ -755,3 +758,233 @@ int idAASLocal::GetWallEdges(int areaNum, const idBounds &bounds, int travelFlag
 
 	return numEdges;
 }
+
+/*
+============
+idAASLocal::ClearPathQueries
+============
+*/
+void idAASLocal::ClearPathQueries(void)
+{
+	pathQueries.Clear();
+	pendingPathQueries.Clear();
+	numPathQuerySlots = 0;
+	pathQuerySequence = 1;
+	numPathQueryServices = 0;
+	numServicedPathQueries = 0;
+	maxPathQueueDepth = 0;
+	totalPathQueryLatency = 0;
+	numFreedPathQueries = 0;
+	maxPathQueryLatency = 0;
+	totalPathServiceTime = 0.0f;
+	maxPathServiceTime = 0.0f;
+}
+
+/*
+============
+idAASLocal::QueuePathQuery
+============
+*/
+aasPathHandle_t idAASLocal::QueuePathQuery(bool fly, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags)
+{
+	int i;
+	aasPathQuery_t *query;
+
+	for (i = 0; i < pathQueries.Num(); i++) {
+		if (!pathQueries[i].handle) {
+			break;
+		}
+	}
+
+	if (i >= pathQueries.Num()) {
+		if (i > PATHQUERY_INDEX_MASK) {
+			common->Warning("idAASLocal::QueuePathQuery: too many path queries");
+			return 0;
+		}
+
+		pathQueries.SetNum(i + 1);
+	}
+
+	query = &pathQueries[i];
+	query->handle = (pathQuerySequence << PATHQUERY_INDEX_BITS) | i;
+	query->fly = fly;
+	query->areaNum = areaNum;
+	query->origin = origin;
+	query->goalAreaNum = goalAreaNum;
+	query->goalOrigin = goalOrigin;
+	query->travelFlags = travelFlags;
+	query->queueService = numPathQueryServices;
+	query->done = false;
+	query->found = false;
+
+	// the sequence stays positive and never zero so a handle is never 0
+	pathQuerySequence = (pathQuerySequence + 1) & ((1 << (31 - PATHQUERY_INDEX_BITS)) - 1);
+
+	if (!pathQuerySequence) {
+		pathQuerySequence = 1;
+	}
+
+	// report bad areas here instead of from the job threads
+	if (file && areaNum != goalAreaNum && (areaNum <= 0 || areaNum >= file->GetNumAreas() || goalAreaNum <= 0 || goalAreaNum >= file->GetNumAreas())) {
+		common->Printf("QueuePathQuery: areaNum %d or goalAreaNum %d out of range\n", areaNum, goalAreaNum);
+		query->path.type = PATHTYPE_WALK;
+		query->path.moveGoal = origin;
+		query->path.moveAreaNum = areaNum;
+		query->path.secondaryGoal = origin;
+		query->path.reachability = NULL;
+		query->done = true;
+	}
+
+	return query->handle;
+}
+
+/*
+============
+idAASLocal::GetPathQueryResult
+============
+*/
+aasPathQueryStatus_t idAASLocal::GetPathQueryResult(aasPathHandle_t handle, aasPath_t &path, bool &found) const
+{
+	int index;
+	const aasPathQuery_t *query;
+
+	index = handle & PATHQUERY_INDEX_MASK;
+
+	if (handle <= 0 || index >= pathQueries.Num() || pathQueries[index].handle != handle) {
+		return PATHQUERY_INVALID;
+	}
+
+	query = &pathQueries[index];
+
+	if (!query->done) {
+		return PATHQUERY_PENDING;
+	}
+
+	path = query->path;
+	found = query->found;
+	return PATHQUERY_DONE;
+}
+
+/*
+============
+idAASLocal::FreePathQuery
+============
+*/
+void idAASLocal::FreePathQuery(aasPathHandle_t handle)
+{
+	int index, latency;
+	aasPathQuery_t *query;
+
+	index = handle & PATHQUERY_INDEX_MASK;
+
+	if (handle <= 0 || index >= pathQueries.Num() || pathQueries[index].handle != handle) {
+		return;
+	}
+
+	query = &pathQueries[index];
+
+	if (query->done) {
+		// number of frames the query was outstanding
+		latency = numPathQueryServices - query->queueService;
+		totalPathQueryLatency += latency;
+		maxPathQueryLatency = Max(maxPathQueryLatency, latency);
+		numFreedPathQueries++;
+	}
+
+	query->handle = 0;
+}
+
+/*
+============
+idAASLocal::PathQueryJob
+============
+*/
+void idAASLocal::PathQueryJob(void *data, int index)
+{
+	idAASLocal *aas = static_cast<idAASLocal *>(data);
+	aasPathQuery_t *query;
+	int i;
+
+	// every job takes every numPathQuerySlots'th query so the work is spread evenly
+	for (i = index; i < aas->pendingPathQueries.Num(); i += aas->numPathQuerySlots) {
+		query = &aas->pathQueries[ aas->pendingPathQueries[ i ] ];
+
+		if (query->fly) {
+			query->found = aas->FlyPathToGoal(query->path, query->areaNum, query->origin, query->goalAreaNum, query->goalOrigin, query->travelFlags);
+		} else {
+			query->found = aas->WalkPathToGoal(query->path, query->areaNum, query->origin, query->goalAreaNum, query->goalOrigin, query->travelFlags);
+		}
+
+		query->done = true;
+	}
+}
+
+/*
+============
+idAASLocal::ServicePathQueries
+
+  Creates the paths of all queued queries on the job threads.  The routing
+  cache is shared between the threads while the queries run, so nothing else
+  may use this AAS until it returns.
+============
+*/
+void idAASLocal::ServicePathQueries(void)
+{
+	int i;
+	float ms;
+	idTimer timer;
+
+	numPathQueryServices++;
+
+	for (i = 0; i < pathQueries.Num(); i++) {
+		if (pathQueries[i].handle && !pathQueries[i].done) {
+			pendingPathQueries.Append(i);
+		}
+	}
+
+	if (!pendingPathQueries.Num()) {
+		return;
+	}
+
+	timer.Start();
+
+	numPathQuerySlots = Min(pendingPathQueries.Num(), sys->NumJobThreads() + 1);
+
+	if (file && numPathQuerySlots > 1) {
+		ShareRoutingCache(numPathQuerySlots);
+		sys->ParallelJobs(PathQueryJob, this, numPathQuerySlots);
+		UnshareRoutingCache();
+	} else {
+		numPathQuerySlots = 1;
+		PathQueryJob(this, 0);
+	}
+
+	timer.Stop();
+	ms = timer.Milliseconds();
+
+	numServicedPathQueries += pendingPathQueries.Num();
+	maxPathQueueDepth = Max(maxPathQueueDepth, pendingPathQueries.Num());
+	totalPathServiceTime += ms;
+	maxPathServiceTime = Max(maxPathServiceTime, ms);
+
+	pendingPathQueries.SetNum(0, false);
+}
+
+/*
+============
+idAASLocal::PathQueryStats
+============
+*/
+void idAASLocal::PathQueryStats(void) const
+{
+	common->Printf("%6d path queries in %d frames, at most %d in a frame\n", numServicedPathQueries, numPathQueryServices, maxPathQueueDepth);
+
+	if (numPathQueryServices) {
+		common->Printf("%6.2f path queries per frame on average\n", (float)numServicedPathQueries / numPathQueryServices);
+		common->Printf("%6.2f ms servicing path queries per frame on average, %.2f ms at most\n", totalPathServiceTime / numPathQueryServices, maxPathServiceTime);
+	}
+
+	if (numFreedPathQueries) {
+		common->Printf("%6.2f frames path query latency on average, %d frames at most\n", (float)totalPathQueryLatency / numFreedPathQueries, maxPathQueryLatency);
+	}
+}
@@ -39,6 +39,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #define LEDGE_TRAVELTIME_PANALTY	250
 
+#define ROUTING_CACHE_CRITICAL_SECTION	CRITICAL_SECTION_THREE
+
 /*
 ============
 idRoutingCache::idRoutingCache
@@ -142,7 +144,7 @@ void idAASLocal::CalculateAreaTravelTimes(void)
 		numAreaTravelTimes += numReach * numRevReach;
 	}
 
-	areaTravelTimes = (unsigned short *) Mem_Alloc(numAreaTravelTimes * sizeof(unsigned short));
+	areaTravelTimes = (unsigned short *) routingArena.Alloc(numAreaTravelTimes * sizeof(unsigned short));
 	bytePtr = (byte *) areaTravelTimes;
 
 	for (n = 0; n < file->GetNumAreas(); n++) {
@@ -193,7 +195,6 @@ idAASLocal::DeleteAreaTravelTimes
 */
 void idAASLocal::DeleteAreaTravelTimes(void)
 {
-	Mem_Free(areaTravelTimes);
 	areaTravelTimes = NULL;
 	numAreaTravelTimes = 0;
 }
@@ -214,7 +215,7 @@ void idAASLocal::SetupRoutingCache(void)
 		areaCacheIndexSize += file->GetCluster(i).numReachableAreas;
 	}
 
-	areaCacheIndex = (idRoutingCache ** *) Mem_ClearedAlloc(file->GetNumClusters() * sizeof(idRoutingCache **) +
+	areaCacheIndex = (idRoutingCache ** *) routingArena.ClearedAlloc(file->GetNumClusters() * sizeof(idRoutingCache **) +
 	                 areaCacheIndexSize * sizeof(idRoutingCache *));
 	bytePtr = ((byte *)areaCacheIndex) + file->GetNumClusters() * sizeof(idRoutingCache **);
 
@@ -224,12 +225,16 @@ void idAASLocal::SetupRoutingCache(void)
 	}
 
 	portalCacheIndexSize = file->GetNumAreas();
-	portalCacheIndex = (idRoutingCache **) Mem_ClearedAlloc(portalCacheIndexSize * sizeof(idRoutingCache *));
+	portalCacheIndex = (idRoutingCache **) routingArena.ClearedAlloc(portalCacheIndexSize * sizeof(idRoutingCache *));
+
+	areaUpdate = (idRoutingUpdate *) routingArena.ClearedAlloc(file->GetNumAreas() * sizeof(idRoutingUpdate));
+	portalUpdate = (idRoutingUpdate *) routingArena.ClearedAlloc((file->GetNumPortals()+1) * sizeof(idRoutingUpdate));
 
-	areaUpdate = (idRoutingUpdate *) Mem_ClearedAlloc(file->GetNumAreas() * sizeof(idRoutingUpdate));
-	portalUpdate = (idRoutingUpdate *) Mem_ClearedAlloc((file->GetNumPortals()+1) * sizeof(idRoutingUpdate));
+	goalAreaTravelTimes = (unsigned short *) routingArena.ClearedAlloc(file->GetNumAreas() * sizeof(unsigned short));
 
-	goalAreaTravelTimes = (unsigned short *) Mem_ClearedAlloc(file->GetNumAreas() * sizeof(unsigned short));
+	areaUpdateSets.Append(areaUpdate);
+	portalUpdateSets.Append(portalUpdate);
+	routingCacheShared = false;
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
@@ -288,19 +293,20 @@ void idAASLocal::ShutdownRoutingCache(void)
 
 	DeletePortalCache();
 
-	Mem_Free(areaCacheIndex);
 	areaCacheIndex = NULL;
 	areaCacheIndexSize = 0;
-	Mem_Free(portalCacheIndex);
 	portalCacheIndex = NULL;
 	portalCacheIndexSize = 0;
-	Mem_Free(areaUpdate);
 	areaUpdate = NULL;
-	Mem_Free(portalUpdate);
 	portalUpdate = NULL;
-	Mem_Free(goalAreaTravelTimes);
 	goalAreaTravelTimes = NULL;
 
+	areaUpdateSets.Clear();
+	portalUpdateSets.Clear();
+	freeAreaUpdates.Clear();
+	freePortalUpdates.Clear();
+	routingCacheShared = false;
+
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
 }
@@ -326,6 +332,9 @@ void idAASLocal::ShutdownRouting(void)
 {
 	DeleteAreaTravelTimes();
 	ShutdownRoutingCache();
+
+	// the travel times and cache indexes are all in the routing arena
+	routingArena.FreeAll();
 }
 
 /*
@@ -358,6 +367,7 @@ void idAASLocal::RoutingStats(void) const
 	gameLocal.Printf("%6d area travel times (%d KB)\n", numAreaTravelTimes, (numAreaTravelTimes * sizeof(unsigned short)) >> 10);
 	gameLocal.Printf("%6d area cache entries (%d KB)\n", areaCacheIndexSize, (areaCacheIndexSize * sizeof(idRoutingCache *)) >> 10);
 	gameLocal.Printf("%6d portal cache entries (%d KB)\n", portalCacheIndexSize, (portalCacheIndexSize * sizeof(idRoutingCache *)) >> 10);
+	routingArena.Print();
 }
 
 /*
@@ -629,6 +639,100 @@ void idAASLocal::RemoveAllObstacles(void)
 	obstacleList.Clear();
 }
 
+/*
+============
+idAASLocal::ShareRoutingCache
+
+  prepares the routing cache for use by numThreads job threads at once
+============
+*/
+void idAASLocal::ShareRoutingCache(int numThreads)
+{
+	// cache can't be deleted while other threads may be reading it
+	while (totalCacheMemory > MAX_ROUTING_CACHE_MEMORY) {
+		DeleteOldestCache();
+	}
+
+	// each thread updating a cache needs its own update memory
+	while (areaUpdateSets.Num() < numThreads) {
+		areaUpdateSets.Append((idRoutingUpdate *) routingArena.ClearedAlloc(file->GetNumAreas() * sizeof(idRoutingUpdate)));
+		portalUpdateSets.Append((idRoutingUpdate *) routingArena.ClearedAlloc((file->GetNumPortals()+1) * sizeof(idRoutingUpdate)));
+	}
+
+	freeAreaUpdates = areaUpdateSets;
+	freePortalUpdates = portalUpdateSets;
+
+	routingCacheShared = true;
+}
+
+/*
+============
+idAASLocal::UnshareRoutingCache
+============
+*/
+void idAASLocal::UnshareRoutingCache(void)
+{
+	routingCacheShared = false;
+}
+
+/*
+============
+idAASLocal::AllocRoutingUpdate
+
+  returns update memory that is not used by any other thread
+============
+*/
+idRoutingUpdate *idAASLocal::AllocRoutingUpdate(idList<idRoutingUpdate *> &freeUpdates, idRoutingUpdate *update) const
+{
+	if (!routingCacheShared) {
+		return update;
+	}
+
+	sys->EnterCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+	assert(freeUpdates.Num() > 0);
+	update = freeUpdates[ freeUpdates.Num() - 1 ];
+	freeUpdates.SetNum(freeUpdates.Num() - 1, false);
+	sys->LeaveCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+
+	return update;
+}
+
+/*
+============
+idAASLocal::FreeRoutingUpdate
+============
+*/
+void idAASLocal::FreeRoutingUpdate(idList<idRoutingUpdate *> &freeUpdates, idRoutingUpdate *update) const
+{
+	if (!routingCacheShared) {
+		return;
+	}
+
+	sys->EnterCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+	freeUpdates.Append(update);
+	sys->LeaveCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+}
+
+/*
+============
+idAASLocal::FindRoutingCache
+
+  returns the cache in the list without undesired travel flags
+============
+*/
+idRoutingCache *idAASLocal::FindRoutingCache(idRoutingCache *list, int travelFlags) const
+{
+	idRoutingCache *cache;
+
+	for (cache = list; cache; cache = cache->next) {
+		if (cache->travelFlags == travelFlags) {
+			break;
+		}
+	}
+
+	return cache;
+}
+
 /*
 ============
 idAASLocal::LinkCache
@@ -764,7 +868,7 @@ void idAASLocal::UpdateAreaRoutingCache(idRoutingCache *areaCache) const
 {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
-	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
+	idRoutingUpdate *updates, *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
 	idReachability *reach;
 	const aasArea_t *nextArea;
 
@@ -782,8 +886,10 @@ void idAASLocal::UpdateAreaRoutingCache(idRoutingCache *areaCache) const
 	badTravelFlags = ~areaCache->travelFlags;
 	memset(startAreaTravelTimes, 0, sizeof(startAreaTravelTimes));
 
+	updates = AllocRoutingUpdate(freeAreaUpdates, areaUpdate);
+
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &updates[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -848,7 +954,7 @@ void idAASLocal::UpdateAreaRoutingCache(idRoutingCache *areaCache) const
 
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate = &updates[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -877,11 +983,17 @@ void idAASLocal::UpdateAreaRoutingCache(idRoutingCache *areaCache) const
 			}
 		}
 	}
+
+	FreeRoutingUpdate(freeAreaUpdates, updates);
 }
 
 /*
 ============
 idAASLocal::GetAreaRoutingCache
+
+  When the routing cache is shared new cache is only added to the index once
+  it is complete, and the cache some other thread added in the mean time is
+  used instead if there is one.
 ============
 */
 idRoutingCache *idAASLocal::GetAreaRoutingCache(int clusterNum, int areaNum, int travelFlags) const
@@ -891,36 +1003,58 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache(int clusterNum, int areaNum, int
 
 	// number of the area in the cluster
 	clusterAreaNum = ClusterAreaNum(clusterNum, areaNum);
-	// pointer to the cache for the area in the cluster
-	clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
 
-	// check if cache without undesired travel flags already exists
-	for (cache = clusterCache; cache; cache = cache->next) {
-		if (cache->travelFlags == travelFlags) {
-			break;
-		}
+	if (routingCacheShared) {
+		sys->EnterCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
 	}
 
+	// check if cache without undesired travel flags already exists
+	cache = FindRoutingCache(areaCacheIndex[clusterNum][clusterAreaNum], travelFlags);
+
 	// if no cache found
 	if (!cache) {
-		cache = new idRoutingCache(file->GetCluster(clusterNum).numReachableAreas);
-		cache->type = CACHETYPE_AREA;
-		cache->cluster = clusterNum;
-		cache->areaNum = areaNum;
-		cache->startTravelTime = 1;
-		cache->travelFlags = travelFlags;
-		cache->prev = NULL;
-		cache->next = clusterCache;
+		if (routingCacheShared) {
+			sys->LeaveCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+		}
 
-		if (clusterCache) {
-			clusterCache->prev = cache;
+		idRoutingCache *newCache = new idRoutingCache(file->GetCluster(clusterNum).numReachableAreas);
+		newCache->type = CACHETYPE_AREA;
+		newCache->cluster = clusterNum;
+		newCache->areaNum = areaNum;
+		newCache->startTravelTime = 1;
+		newCache->travelFlags = travelFlags;
+		UpdateAreaRoutingCache(newCache);
+
+		if (routingCacheShared) {
+			sys->EnterCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
 		}
 
-		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache(cache);
+		cache = FindRoutingCache(areaCacheIndex[clusterNum][clusterAreaNum], travelFlags);
+
+		if (cache) {
+			delete newCache;
+		} else {
+			// pointer to the cache for the area in the cluster
+			clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
+
+			cache = newCache;
+			cache->prev = NULL;
+			cache->next = clusterCache;
+
+			if (clusterCache) {
+				clusterCache->prev = cache;
+			}
+
+			areaCacheIndex[clusterNum][clusterAreaNum] = cache;
+		}
 	}
 
 	LinkCache(cache);
+
+	if (routingCacheShared) {
+		sys->LeaveCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+	}
+
 	return cache;
 }
 
@@ -936,9 +1070,11 @@ void idAASLocal::UpdatePortalRoutingCache(idRoutingCache *portalCache) const
 	const aasPortal_t *portal;
 	const aasCluster_t *cluster;
 	idRoutingCache *cache;
-	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
+	idRoutingUpdate *updates, *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
+
+	updates = AllocRoutingUpdate(freePortalUpdates, portalUpdate);
 
-	curUpdate = &portalUpdate[ file->GetNumPortals()];
+	curUpdate = &updates[ file->GetNumPortals()];
 	curUpdate->cluster = portalCache->cluster;
 	curUpdate->areaNum = portalCache->areaNum;
 	curUpdate->tmpTravelTime = portalCache->startTravelTime;
@@ -992,7 +1128,7 @@ void idAASLocal::UpdatePortalRoutingCache(idRoutingCache *portalCache) const
 
 				portalCache->travelTimes[portalNum] = t;
 				portalCache->reachabilities[portalNum] = cache->reachabilities[clusterAreaNum];
-				nextUpdate = &portalUpdate[portalNum];
+				nextUpdate = &updates[portalNum];
 
 				if (portal->clusters[0] == curUpdate->cluster) {
 					nextUpdate->cluster = portal->clusters[1];
@@ -1021,6 +1157,8 @@ void idAASLocal::UpdatePortalRoutingCache(idRoutingCache *portalCache) const
 			}
 		}
 	}
+
+	FreeRoutingUpdate(freePortalUpdates, updates);
 }
 
 /*
@@ -1032,33 +1170,54 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache(int clusterNum, int areaNum, i
 {
 	idRoutingCache *cache;
 
-	// check if cache without undesired travel flags already exists
-	for (cache = portalCacheIndex[areaNum]; cache; cache = cache->next) {
-		if (cache->travelFlags == travelFlags) {
-			break;
-		}
+	if (routingCacheShared) {
+		sys->EnterCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
 	}
 
+	// check if cache without undesired travel flags already exists
+	cache = FindRoutingCache(portalCacheIndex[areaNum], travelFlags);
+
 	// if no cache found
 	if (!cache) {
-		cache = new idRoutingCache(file->GetNumPortals());
-		cache->type = CACHETYPE_PORTAL;
-		cache->cluster = clusterNum;
-		cache->areaNum = areaNum;
-		cache->startTravelTime = 1;
-		cache->travelFlags = travelFlags;
-		cache->prev = NULL;
-		cache->next = portalCacheIndex[areaNum];
-
-		if (portalCacheIndex[areaNum]) {
-			portalCacheIndex[areaNum]->prev = cache;
+		if (routingCacheShared) {
+			sys->LeaveCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
 		}
 
-		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache(cache);
+		idRoutingCache *newCache = new idRoutingCache(file->GetNumPortals());
+		newCache->type = CACHETYPE_PORTAL;
+		newCache->cluster = clusterNum;
+		newCache->areaNum = areaNum;
+		newCache->startTravelTime = 1;
+		newCache->travelFlags = travelFlags;
+		UpdatePortalRoutingCache(newCache);
+
+		if (routingCacheShared) {
+			sys->EnterCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+		}
+
+		cache = FindRoutingCache(portalCacheIndex[areaNum], travelFlags);
+
+		if (cache) {
+			delete newCache;
+		} else {
+			cache = newCache;
+			cache->prev = NULL;
+			cache->next = portalCacheIndex[areaNum];
+
+			if (portalCacheIndex[areaNum]) {
+				portalCacheIndex[areaNum]->prev = cache;
+			}
+
+			portalCacheIndex[areaNum] = cache;
+		}
 	}
 
 	LinkCache(cache);
+
+	if (routingCacheShared) {
+		sys->LeaveCriticalSection(ROUTING_CACHE_CRITICAL_SECTION);
+	}
+
 	return cache;
 }
 
@@ -1097,7 +1256,9 @@ bool idAASLocal::RouteToGoalArea(int areaNum, const idVec3 origin, int goalAreaN
 		return false;
 	}
 
-	while (totalCacheMemory > MAX_ROUTING_CACHE_MEMORY) {
+	// the job threads can't delete cache other threads may be reading,
+	// ShareRoutingCache makes room before the cache is shared
+	while (!routingCacheShared && totalCacheMemory > MAX_ROUTING_CACHE_MEMORY) {
 		DeleteOldestCache();
 	}
 
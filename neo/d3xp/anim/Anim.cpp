@@ -33,6 +33,70 @@ If you have questions concerning this license or the applicable additional terms
 
 bool idAnimManager::forceExport = false;
 
+/*
+====================
+MD5Anim_DecodeJoint
+
+Sets the animated components of a joint on top of its base frame.
+====================
+*/
+static void MD5Anim_DecodeJoint(const jointAnimInfo_t &info, const idJointQuat &base, const float *components, idJointQuat &joint)
+{
+	joint = base;
+
+	if (info.animBits & ANIM_TX) {
+		joint.t.x = *components++;
+	}
+
+	if (info.animBits & ANIM_TY) {
+		joint.t.y = *components++;
+	}
+
+	if (info.animBits & ANIM_TZ) {
+		joint.t.z = *components++;
+	}
+
+	if (info.animBits & (ANIM_QX|ANIM_QY|ANIM_QZ)) {
+
+		if (info.animBits & ANIM_QX) {
+			joint.q.x = *components++;
+		}
+
+		if (info.animBits & ANIM_QY) {
+			joint.q.y = *components++;
+		}
+
+		if (info.animBits & ANIM_QZ) {
+			joint.q.z = *components;
+		}
+
+		joint.q.w = joint.q.CalcW();
+	}
+}
+
+/*
+====================
+MD5Anim_RotationError
+
+Returns the angle in degrees between two joint rotations.
+====================
+*/
+static float MD5Anim_RotationError(const idQuat &q1, const idQuat &q2)
+{
+	idQuat	d;
+	float	length;
+
+	if (q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w < 0.0f) {
+		d = q1 + q2;
+	} else {
+		d = q1 - q2;
+	}
+
+	// |q1 - q2| = 2 * sin( angle / 4 ), which stays accurate for small angles
+	length = idMath::Sqrt(d.x * d.x + d.y * d.y + d.z * d.z + d.w * d.w);
+	return RAD2DEG(4.0f * idMath::ASin(length * 0.5f));
+}
+
 /***********************************************************************
 
 	idMD5Anim
@@ -51,6 +115,9 @@ idMD5Anim::idMD5Anim()
 	numJoints	= 0;
 	frameRate	= 24;
 	animLength	= 0;
+	numAnimatedComponents = 0;
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
 	totaldelta.Zero();
 }
 
@@ -77,11 +144,18 @@ void idMD5Anim::Free(void)
 	animLength	= 0;
 	name		= "";
 
+	numAnimatedComponents = 0;
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
+
 	totaldelta.Zero();
 
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	quantizedFrames.Clear();
+	componentBias.Clear();
+	componentScale.Clear();
 }
 
 /*
@@ -156,16 +230,221 @@ idMD5Anim::Allocated
 */
 size_t idMD5Anim::Allocated(void) const
 {
-	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size_t	size = bounds.Allocated() + jointInfo.Allocated() + baseFrame.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += quantizedFrames.Allocated() + componentBias.Allocated() + componentScale.Allocated();
 	return size;
 }
 
+/*
+====================
+idMD5Anim::UncompressedSize
+
+Returns the size the anim would have with float frames.
+====================
+*/
+size_t idMD5Anim::UncompressedSize(void) const
+{
+	if (!IsCompressed()) {
+		return Size();
+	}
+
+	return Size() - quantizedFrames.Allocated() - componentBias.Allocated() - componentScale.Allocated() + numAnimatedComponents * numFrames * sizeof(float);
+}
+
+/*
+====================
+idMD5Anim::IsCompressed
+====================
+*/
+bool idMD5Anim::IsCompressed(void) const
+{
+	return (quantizedFrames.Num() != 0);
+}
+
+/*
+====================
+idMD5Anim::CompressionError
+====================
+*/
+void idMD5Anim::CompressionError(float &translation, float &rotation) const
+{
+	translation = maxTranslationError;
+	rotation = maxRotationError;
+}
+
+/*
+====================
+idMD5Anim::Compress
+
+Quantizes every animated component to 16 bits over the range the component
+covers in this anim.  The float frames are kept when the quantization moves
+any joint further than g_animCompressTranslationError or rotates it more than
+g_animCompressRotationError.
+====================
+*/
+void idMD5Anim::Compress(void)
+{
+	int				i, j, c;
+	float			minValue, maxValue, value, error;
+	const float		*original;
+	float			*decoded;
+	idJointQuat		joint1, joint2;
+
+	if (!numAnimatedComponents) {
+		return;
+	}
+
+	componentBias.SetGranularity(1);
+	componentBias.SetNum(numAnimatedComponents);
+	componentScale.SetGranularity(1);
+	componentScale.SetNum(numAnimatedComponents);
+	quantizedFrames.SetGranularity(1);
+	quantizedFrames.SetNum(numAnimatedComponents * numFrames);
+
+	for (c = 0; c < numAnimatedComponents; c++) {
+		minValue = maxValue = componentFrames[ c ];
+
+		for (i = 1; i < numFrames; i++) {
+			value = componentFrames[ i * numAnimatedComponents + c ];
+
+			if (value < minValue) {
+				minValue = value;
+			} else if (value > maxValue) {
+				maxValue = value;
+			}
+		}
+
+		componentBias[ c ] = minValue;
+		componentScale[ c ] = (maxValue - minValue) / 65535.0f;
+
+		for (i = 0; i < numFrames; i++) {
+			if (componentScale[ c ] > 0.0f) {
+				value = (componentFrames[ i * numAnimatedComponents + c ] - minValue) / componentScale[ c ];
+				quantizedFrames[ i * numAnimatedComponents + c ] = idMath::ClampInt(0, 65535, (int)(value + 0.5f));
+			} else {
+				quantizedFrames[ i * numAnimatedComponents + c ] = 0;
+			}
+		}
+	}
+
+	// measure the error on the joints rather than on the components
+	// because the quaternion w is derived from the other three
+	decoded = (float *)_alloca16(numAnimatedComponents * sizeof(decoded[ 0 ]));
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
+
+	for (i = 0; i < numFrames; i++) {
+		original = &componentFrames[ i * numAnimatedComponents ];
+		SIMDProcessor->DequantizeComponents(decoded, &quantizedFrames[ i * numAnimatedComponents ], componentBias.Ptr(), componentScale.Ptr(), numAnimatedComponents);
+
+		for (j = 0; j < numJoints; j++) {
+			if (!jointInfo[ j ].animBits) {
+				continue;
+			}
+
+			MD5Anim_DecodeJoint(jointInfo[ j ], baseFrame[ j ], original + jointInfo[ j ].firstComponent, joint1);
+			MD5Anim_DecodeJoint(jointInfo[ j ], baseFrame[ j ], decoded + jointInfo[ j ].firstComponent, joint2);
+
+			error = (joint1.t - joint2.t).Length();
+
+			if (error > maxTranslationError) {
+				maxTranslationError = error;
+			}
+
+			error = MD5Anim_RotationError(joint1.q, joint2.q);
+
+			if (error > maxRotationError) {
+				maxRotationError = error;
+			}
+		}
+	}
+
+	if (maxTranslationError > g_animCompressTranslationError.GetFloat() || maxRotationError > g_animCompressRotationError.GetFloat()) {
+		gameLocal.DPrintf("anim '%s' exceeds the compression error bounds (%.4f units, %.4f degrees), keeping float frames\n", name.c_str(), maxTranslationError, maxRotationError);
+		quantizedFrames.Clear();
+		componentBias.Clear();
+		componentScale.Clear();
+		return;
+	}
+
+	componentFrames.Clear();
+}
+
+/*
+====================
+idMD5Anim::GetFrameComponents
+
+Returns count components of a frame starting at first.  Compressed frames
+are decoded into buffer.
+====================
+*/
+const float *idMD5Anim::GetFrameComponents(int framenum, int first, int count, float *buffer) const
+{
+	if (!IsCompressed()) {
+		return &componentFrames[ framenum * numAnimatedComponents + first ];
+	}
+
+	SIMDProcessor->DequantizeComponents(buffer, &quantizedFrames[ framenum * numAnimatedComponents + first ], &componentBias[ first ], &componentScale[ first ], count);
+	return buffer;
+}
+
+/*
+====================
+idMD5Anim::GetJointComponents
+
+Returns all components of a frame, indexed by the firstComponent of the joints.
+Compressed frames only decode the components of the joints in index into buffer,
+runs of adjacent joints are decoded at once.
+====================
+*/
+const float *idMD5Anim::GetJointComponents(int framenum, const int *index, int numIndexes, float *buffer) const
+{
+	int i, first, count, runFirst, runCount;
+	const jointAnimInfo_t *infoPtr;
+
+	if (!IsCompressed()) {
+		return &componentFrames[ framenum * numAnimatedComponents ];
+	}
+
+	runFirst = 0;
+	runCount = 0;
+
+	for (i = 0; i < numIndexes; i++) {
+		infoPtr = &jointInfo[ index[ i ] ];
+
+		if (!infoPtr->animBits) {
+			continue;
+		}
+
+		first = infoPtr->firstComponent;
+		count = idMath::BitCount(infoPtr->animBits);
+
+		if (first == runFirst + runCount) {
+			runCount += count;
+			continue;
+		}
+
+		if (runCount) {
+			GetFrameComponents(framenum, runFirst, runCount, buffer + runFirst);
+		}
+
+		runFirst = first;
+		runCount = count;
+	}
+
+	if (runCount) {
+		GetFrameComponents(framenum, runFirst, runCount, buffer + runFirst);
+	}
+
+	return buffer;
+}
+
 /*
 ====================
 idMD5Anim::LoadAnim
 ====================
 */
-bool idMD5Anim::LoadAnim(const char *filename)
+bool idMD5Anim::LoadAnim(const char *filename, bool compress)
 {
 	int		version;
 	idLexer	parser(LEXFL_ALLOWPATHNAMES | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT);
@@ -357,6 +636,10 @@ bool idMD5Anim::LoadAnim(const char *filename)
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ((numFrames - 1) * 1000 + frameRate - 1) / frameRate;
 
+	if (compress && g_animCompress.GetBool()) {
+		Compress();
+	}
+
 	// done
 	return true;
 }
@@ -485,8 +768,12 @@ void idMD5Anim::GetOrigin(idVec3 &offset, int time, int cyclecount) const
 
 	ConvertTimeToFrame(time, cyclecount, frame);
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float components1[ 3 ];
+	float components2[ 3 ];
+	int first = jointInfo[ 0 ].firstComponent;
+	int count = Min(3, numAnimatedComponents - first);
+	const float *componentPtr1 = GetFrameComponents(frame.frame1, first, count, components1);
+	const float *componentPtr2 = GetFrameComponents(frame.frame2, first, count, components2);
 
 	if (jointInfo[ 0 ].animBits & ANIM_TX) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -529,8 +816,12 @@ void idMD5Anim::GetOriginRotation(idQuat &rotation, int time, int cyclecount) co
 
 	ConvertTimeToFrame(time, cyclecount, frame);
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float components1[ 6 ];
+	float components2[ 6 ];
+	int first = jointInfo[ 0 ].firstComponent;
+	int count = Min(6, numAnimatedComponents - first);
+	const float	*jointframe1 = GetFrameComponents(frame.frame1, first, count, components1);
+	const float	*jointframe2 = GetFrameComponents(frame.frame2, first, count, components2);
 
 	if (animBits & ANIM_TX) {
 		jointframe1++;
@@ -645,8 +936,12 @@ void idMD5Anim::GetBounds(idBounds &bnds, int time, int cyclecount) const
 	offset = baseFrame[ 0 ].t;
 
 	if (jointInfo[ 0 ].animBits & (ANIM_TX | ANIM_TY | ANIM_TZ)) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float components1[ 3 ];
+		float components2[ 3 ];
+		int first = jointInfo[ 0 ].firstComponent;
+		int count = Min(3, numAnimatedComponents - first);
+		const float *componentPtr1 = GetFrameComponents(frame.frame1, first, count, components1);
+		const float *componentPtr2 = GetFrameComponents(frame.frame2, first, count, components2);
 
 		if (jointInfo[ 0 ].animBits & ANIM_TX) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -687,6 +982,7 @@ void idMD5Anim::GetInterpolatedFrame(frameBlend_t &frame, idJointQuat *joints, c
 	idJointQuat				*jointPtr;
 	idJointQuat				*blendPtr;
 	int						*lerpIndex;
+	float					*components;
 
 	// copy the baseframe
 	SIMDProcessor->Memcpy(joints, baseFrame.Ptr(), baseFrame.Num() * sizeof(baseFrame[ 0 ]));
@@ -700,8 +996,9 @@ void idMD5Anim::GetInterpolatedFrame(frameBlend_t &frame, idJointQuat *joints, c
 	lerpIndex = (int *)_alloca16(baseFrame.Num() * sizeof(lerpIndex[ 0 ]));
 	numLerpJoints = 0;
 
-	frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
-	frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
+	components = (float *)_alloca16(2 * numAnimatedComponents * sizeof(components[ 0 ]));
+	frame1 = GetJointComponents(frame.frame1, index, numIndexes, components);
+	frame2 = GetJointComponents(frame.frame2, index, numIndexes, components + numAnimatedComponents);
 
 	for (i = 0; i < numIndexes; i++) {
 		int j = index[i];
@@ -874,6 +1171,7 @@ void idMD5Anim::GetSingleFrame(int framenum, idJointQuat *joints, const int *ind
 	int						animBits;
 	idJointQuat				*jointPtr;
 	const jointAnimInfo_t	*infoPtr;
+	float					*components;
 
 	// copy the baseframe
 	SIMDProcessor->Memcpy(joints, baseFrame.Ptr(), baseFrame.Num() * sizeof(baseFrame[ 0 ]));
@@ -883,7 +1181,8 @@ void idMD5Anim::GetSingleFrame(int framenum, idJointQuat *joints, const int *ind
 		return;
 	}
 
-	frame = &componentFrames[ framenum * numAnimatedComponents ];
+	components = (float *)_alloca16(numAnimatedComponents * sizeof(components[ 0 ]));
+	frame = GetJointComponents(framenum, index, numIndexes, components);
 
 	for (i = 0; i < numIndexes; i++) {
 		int j = index[i];
@@ -1043,6 +1342,32 @@ idMD5Anim *idAnimManager::GetAnim(const char *name)
 	return anim;
 }
 
+/*
+====================
+idAnimManager::PrefetchAnim
+
+Starts reading an anim that hasn't been loaded yet in the background.
+====================
+*/
+void idAnimManager::PrefetchAnim(const char *name)
+{
+	idMD5Anim **animptrptr;
+	idStr extension;
+	idStr filename = name;
+
+	filename.ExtractFileExtension(extension);
+
+	if (extension != MD5_ANIM_EXT) {
+		return;
+	}
+
+	if (animations.Get(filename, &animptrptr)) {
+		return;
+	}
+
+	fileSystem->PrefetchFile(filename);
+}
+
 /*
 ================
 idAnimManager::ReloadAnims
@@ -1106,11 +1431,15 @@ void idAnimManager::ListAnims(void) const
 	idMD5Anim	*anim;
 	size_t		size;
 	size_t		s;
+	size_t		uncompressedSize;
 	size_t		namesize;
 	int			num;
+	int			numCompressed;
 
 	num = 0;
+	numCompressed = 0;
 	size = 0;
+	uncompressedSize = 0;
 
 	for (i = 0; i < animations.Num(); i++) {
 		animptr = animations.GetIndex(i);
@@ -1118,9 +1447,14 @@ void idAnimManager::ListAnims(void) const
 		if (animptr && *animptr) {
 			anim = *animptr;
 			s = anim->Size();
-			gameLocal.Printf("%8zd bytes : %2d refs : %s\n", s, anim->NumRefs(), anim->Name());
+			gameLocal.Printf("%8zd bytes : %8zd float : %2d refs : %s\n", s, anim->UncompressedSize(), anim->NumRefs(), anim->Name());
 			size += s;
+			uncompressedSize += anim->UncompressedSize();
 			num++;
+
+			if (anim->IsCompressed()) {
+				numCompressed++;
+			}
 		}
 	}
 
@@ -1131,9 +1465,113 @@ void idAnimManager::ListAnims(void) const
 	}
 
 	gameLocal.Printf("\n%zd memory used in %d anims\n", size, num);
+	gameLocal.Printf("%zd memory saved by %d compressed anims (%zd with float frames)\n", uncompressedSize - size, numCompressed, uncompressedSize);
 	gameLocal.Printf("%zd memory used in %d joint names\n", namesize, jointnames.Num());
 }
 
+/*
+================
+idAnimManager::TestCompression
+
+Compares every compressed anim against a float copy loaded from disk.
+================
+*/
+void idAnimManager::TestCompression(void) const
+{
+	int				i, j, k, numJoints;
+	idMD5Anim		**animptr;
+	const idMD5Anim	*anim;
+	idMD5Anim		floatAnim;
+	idJointQuat		*joints1;
+	idJointQuat		*joints2;
+	int				*index;
+	frameBlend_t	frame;
+	float			error, translationError, rotationError;
+	float			maxTranslationError, maxRotationError;
+	int				num, numFailed;
+
+	num = 0;
+	numFailed = 0;
+	maxTranslationError = 0.0f;
+	maxRotationError = 0.0f;
+
+	for (i = 0; i < animations.Num(); i++) {
+		animptr = animations.GetIndex(i);
+
+		if (!animptr || !*animptr || !(*animptr)->IsCompressed()) {
+			continue;
+		}
+
+		anim = *animptr;
+
+		if (!floatAnim.LoadAnim(anim->Name(), false)) {
+			gameLocal.Warning("Couldn't load anim: '%s'", anim->Name());
+			continue;
+		}
+
+		numJoints = anim->NumJoints();
+		joints1 = (idJointQuat *)Mem_Alloc16(numJoints * sizeof(joints1[ 0 ]));
+		joints2 = (idJointQuat *)Mem_Alloc16(numJoints * sizeof(joints2[ 0 ]));
+		index = (int *)Mem_Alloc16(numJoints * sizeof(index[ 0 ]));
+
+		for (j = 0; j < numJoints; j++) {
+			index[ j ] = j;
+		}
+
+		translationError = 0.0f;
+		rotationError = 0.0f;
+
+		// compare each frame and the midpoint to the next one
+		for (j = 0; j < anim->NumFrames(); j++) {
+			frame.cycleCount = 0;
+			frame.frame1 = j;
+			frame.frame2 = Min(j + 1, anim->NumFrames() - 1);
+			frame.frontlerp = 0.5f;
+			frame.backlerp = 0.5f;
+
+			anim->GetInterpolatedFrame(frame, joints1, index, numJoints);
+			floatAnim.GetInterpolatedFrame(frame, joints2, index, numJoints);
+
+			for (k = 0; k < numJoints; k++) {
+				error = (joints1[ k ].t - joints2[ k ].t).Length();
+				translationError = Max(translationError, error);
+				error = MD5Anim_RotationError(joints1[ k ].q, joints2[ k ].q);
+				rotationError = Max(rotationError, error);
+			}
+
+			anim->GetSingleFrame(j, joints1, index, numJoints);
+			floatAnim.GetSingleFrame(j, joints2, index, numJoints);
+
+			for (k = 0; k < numJoints; k++) {
+				error = (joints1[ k ].t - joints2[ k ].t).Length();
+				translationError = Max(translationError, error);
+				error = MD5Anim_RotationError(joints1[ k ].q, joints2[ k ].q);
+				rotationError = Max(rotationError, error);
+			}
+		}
+
+		Mem_Free16(joints1);
+		Mem_Free16(joints2);
+		Mem_Free16(index);
+
+		if (translationError > g_animCompressTranslationError.GetFloat() || rotationError > g_animCompressRotationError.GetFloat()) {
+			gameLocal.Printf("%8.4f units : %8.4f degrees : %s " S_COLOR_RED "X\n", translationError, rotationError, anim->Name());
+			numFailed++;
+		} else {
+			gameLocal.Printf("%8.4f units : %8.4f degrees : %s\n", translationError, rotationError, anim->Name());
+		}
+
+		maxTranslationError = Max(maxTranslationError, translationError);
+		maxRotationError = Max(maxRotationError, rotationError);
+		num++;
+	}
+
+	floatAnim.Free();
+
+	gameLocal.Printf("\n%d compressed anims tested, %d outside the error bounds\n", num, numFailed);
+	gameLocal.Printf("largest error %.4f units, %.4f degrees\n", maxTranslationError, maxRotationError);
+}
+
 /*
 ================
 idAnimManager::FlushUnusedAnims
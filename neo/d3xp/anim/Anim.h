@@ -98,6 +98,15 @@ typedef struct {
 	jointModTransform_t		transform_axis;
 } jointMod_t;
 
+//
+// animation level of detail
+//
+typedef enum {
+	ANIMLOD_FULL,				// all joints every frame
+	ANIMLOD_REDUCED,			// only the essential joints every frame
+	ANIMLOD_LOW					// only the essential joints at a reduced update rate
+} animLOD_t;
+
 #define	ANIM_TX				BIT( 0 )
 #define	ANIM_TY				BIT( 1 )
 #define	ANIM_TZ				BIT( 2 )
@@ -237,10 +246,19 @@ class idMD5Anim
 		idList<jointAnimInfo_t>	jointInfo;
 		idList<idJointQuat>		baseFrame;
 		idList<float>			componentFrames;
+		idList<unsigned short>	quantizedFrames;		// 16 bit components, replaces componentFrames when compressed
+		idList<float>			componentBias;			// per component minimum
+		idList<float>			componentScale;			// per component range / 65535
+		float					maxTranslationError;	// worst error introduced by the quantization
+		float					maxRotationError;		// in degrees
 		idStr					name;
 		idVec3					totaldelta;
 		mutable int				ref_count;
 
+		void					Compress(void);
+		const float				*GetFrameComponents(int framenum, int first, int count, float *buffer) const;
+		const float				*GetJointComponents(int framenum, const int *index, int numIndexes, float *buffer) const;
+
 	public:
 		idMD5Anim();
 		~idMD5Anim();
@@ -251,7 +269,10 @@ class idMD5Anim
 		size_t					Size(void) const {
 			return sizeof(*this) + Allocated();
 		};
-		bool					LoadAnim(const char *filename);
+		bool					LoadAnim(const char *filename, bool compress = true);
+		bool					IsCompressed(void) const;
+		size_t					UncompressedSize(void) const;
+		void					CompressionError(float &translation, float &rotation) const;
 
 		void					IncreaseRefs(void) const;
 		void					DecreaseRefs(void) const;
@@ -416,7 +437,7 @@ class idAnimBlend
 		void						SetFrame(const idDeclModelDef *modelDef, int animnum, int frame, int currenttime, int blendtime);
 		void						CycleAnim(const idDeclModelDef *modelDef, int animnum, int currenttime, int blendtime);
 		void						PlayAnim(const idDeclModelDef *modelDef, int animnum, int currenttime, int blendtime);
-		bool						BlendAnim(int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOrigin, bool overrideBlend, bool printInfo) const;
+		bool						BlendAnim(int currentTime, int channel, const int *index, int numIndexes, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOrigin, bool overrideBlend, bool printInfo) const;
 		void						BlendOrigin(int currentTime, idVec3 &blendPos, float &blendWeight, bool removeOriginOffset) const;
 		void						BlendDelta(int fromtime, int totime, idVec3 &blendDelta, float &blendWeight) const;
 		void						BlendDeltaRotation(int fromtime, int totime, idQuat &blendDelta, float &blendWeight) const;
@@ -531,8 +552,9 @@ class idAnimator
 
 		void						ForceUpdate(void);
 		void						ClearForceUpdate(void);
-		bool						CreateFrame(int animtime, bool force);
+		bool						CreateFrame(int animtime, bool force, bool exact = false);
 		bool						FrameHasChanged(int animtime) const;
+		bool						FrameIsCurrent(int animtime) const;
 		void						GetDelta(int fromtime, int totime, idVec3 &delta) const;
 		bool						GetDeltaRotation(int fromtime, int totime, idMat3 &delta) const;
 		void						GetOrigin(int currentTime, idVec3 &pos) const;
@@ -563,6 +585,9 @@ class idAnimator
 		void						ClearAllAnims(int currentTime, int cleartime);
 
 		jointHandle_t				GetJointHandle(const char *name) const;
+		// critical joints and their parents are always blended, even at a reduced level of detail.
+		// joints looked up by name, queried or modified are marked critical automatically.
+		void						SetJointCritical(jointHandle_t jointnum) const;
 		const char 				*GetJointName(jointHandle_t handle) const;
 		int							GetChannelForJoint(jointHandle_t joint) const;
 		bool						GetJointTransform(jointHandle_t jointHandle, int currenttime, idVec3 &offset, idMat3 &axis);
@@ -579,6 +604,8 @@ class idAnimator
 	private:
 		void						FreeData(void);
 		void						PushAnims(int channel, int currentTime, int blendTime);
+		animLOD_t					SelectLOD(void) const;
+		void						UpdateLODJoints(void);
 
 	private:
 		const idDeclModelDef 		*modelDef;
@@ -602,6 +629,11 @@ class idAnimator
 		idList<idJointQuat>			AFPoseJointFrame;
 		idBounds					AFPoseBounds;
 		int							AFPoseTime;
+
+		idList<int>					lodChannelJoints[ ANIM_NumAnimChannels ];	// joints blended at a reduced level of detail
+		mutable idList<bool>		lodCriticalJoints;		// mutable because joints are marked in GetJointHandle
+		mutable bool				lodJointsChanged;
+		float						lodBoneLength;			// bone length lodChannelJoints was built with
 };
 
 /*
@@ -622,8 +654,10 @@ class idAnimManager
 
 		void						Shutdown(void);
 		idMD5Anim 					*GetAnim(const char *name);
+		void						PrefetchAnim(const char *name);
 		void						ReloadAnims(void);
 		void						ListAnims(void) const;
+		void						TestCompression(void) const;
 		int							JointIndex(const char *name);
 		const char 				*JointName(int index) const;
 
@@ -2000,7 +2000,7 @@ void idAnimBlend::CallFrameCommands(idEntity *ent, int fromtime, int totime) con
 idAnimBlend::BlendAnim
 =====================
 */
-bool idAnimBlend::BlendAnim(int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOriginOffset, bool overrideBlend, bool printInfo) const
+bool idAnimBlend::BlendAnim(int currentTime, int channel, const int *index, int numIndexes, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOriginOffset, bool overrideBlend, bool printInfo) const
 {
 	int				i;
 	float			lerp;
@@ -2051,10 +2051,10 @@ bool idAnimBlend::BlendAnim(int currentTime, int channel, int numJoints, idJoint
 		md5anim = anim->MD5Anim(0);
 
 		if (frame) {
-			md5anim->GetSingleFrame(frame - 1, jointFrame, modelDef->GetChannelJoints(channel), modelDef->NumJointsOnChannel(channel));
+			md5anim->GetSingleFrame(frame - 1, jointFrame, index, numIndexes);
 		} else {
 			md5anim->ConvertTimeToFrame(time, cycle, frametime);
-			md5anim->GetInterpolatedFrame(frametime, jointFrame, modelDef->GetChannelJoints(channel), modelDef->NumJointsOnChannel(channel));
+			md5anim->GetInterpolatedFrame(frametime, jointFrame, index, numIndexes);
 		}
 	} else {
 		//
@@ -2077,14 +2077,14 @@ bool idAnimBlend::BlendAnim(int currentTime, int channel, int numJoints, idJoint
 				md5anim = anim->MD5Anim(i);
 
 				if (frame) {
-					md5anim->GetSingleFrame(frame - 1, ptr, modelDef->GetChannelJoints(channel), modelDef->NumJointsOnChannel(channel));
+					md5anim->GetSingleFrame(frame - 1, ptr, index, numIndexes);
 				} else {
-					md5anim->GetInterpolatedFrame(frametime, ptr, modelDef->GetChannelJoints(channel), modelDef->NumJointsOnChannel(channel));
+					md5anim->GetInterpolatedFrame(frametime, ptr, index, numIndexes);
 				}
 
 				// only blend after the first anim is mixed in
 				if (ptr != jointFrame) {
-					SIMDProcessor->BlendJoints(jointFrame, ptr, lerp, modelDef->GetChannelJoints(channel), modelDef->NumJointsOnChannel(channel));
+					SIMDProcessor->BlendJoints(jointFrame, ptr, lerp, index, numIndexes);
 				}
 
 				ptr = mixFrame;
@@ -2114,10 +2114,7 @@ bool idAnimBlend::BlendAnim(int currentTime, int channel, int numJoints, idJoint
 		blendWeight = weight;
 
 		if (channel != ANIMCHANNEL_ALL) {
-			const int *index = modelDef->GetChannelJoints(channel);
-			const int num = modelDef->NumJointsOnChannel(channel);
-
-			for (i = 0; i < num; i++) {
+			for (i = 0; i < numIndexes; i++) {
 				int j = index[i];
 				blendFrame[j].t = jointFrame[j].t;
 				blendFrame[j].q = jointFrame[j].q;
@@ -2126,7 +2123,7 @@ bool idAnimBlend::BlendAnim(int currentTime, int channel, int numJoints, idJoint
 	} else {
 		blendWeight += weight;
 		lerp = weight / blendWeight;
-		SIMDProcessor->BlendJoints(blendFrame, jointFrame, lerp, modelDef->GetChannelJoints(channel), modelDef->NumJointsOnChannel(channel));
+		SIMDProcessor->BlendJoints(blendFrame, jointFrame, lerp, index, numIndexes);
 	}
 
 	if (printInfo) {
@@ -2881,6 +2878,29 @@ bool idDeclModelDef::ParseAnim(idLexer &src, int numDefaultAnims)
 	return true;
 }
 
+/*
+================
+PrefetchModelAnims
+
+Hands all the anims of the model to the file system up front, so they can be read
+and inflated side by side while the first ones are being parsed.
+================
+*/
+static void PrefetchModelAnims(const char *text, const int textLength)
+{
+	idLexer	src;
+	idToken	token;
+
+	src.LoadMemory(text, textLength, "");
+	src.SetFlags(DECL_LEXER_FLAGS | LEXFL_NOERRORS | LEXFL_NOWARNINGS);
+
+	while (src.ReadToken(&token)) {
+		if (token.Find("." MD5_ANIM_EXT, false) != -1) {
+			animationLib.PrefetchAnim(token);
+		}
+	}
+}
+
 /*
 ================
 idDeclModelDef::Parse
@@ -2903,6 +2923,8 @@ bool idDeclModelDef::Parse(const char *text, const int textLength)
 	idList<jointHandle_t> jointList;
 	int					numDefaultAnims;
 
+	PrefetchModelAnims(text, textLength);
+
 	src.LoadMemory(text, textLength, GetFileName(), GetLineNum());
 	src.SetFlags(DECL_LEXER_FLAGS);
 	src.SkipUntilString("{");
@@ -3398,6 +3420,8 @@ idAnimator::idAnimator()
 	stoppedAnimatingUpdate	= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
+	lodJointsChanged		= true;
+	lodBoneLength			= 0.0f;
 
 	frameBounds.Clear();
 
@@ -3435,6 +3459,12 @@ size_t idAnimator::Allocated(void) const
 
 	size = jointMods.Allocated() + numJoints * sizeof(joints[0]) + jointMods.Num() * sizeof(jointMods[ 0 ]) + AFPoseJointMods.Allocated() + AFPoseJointFrame.Allocated() + AFPoseJoints.Allocated();
 
+	for (int i = 0; i < ANIM_NumAnimChannels; i++) {
+		size += lodChannelJoints[ i ].Allocated();
+	}
+
+	size += lodCriticalJoints.Allocated();
+
 	return size;
 }
 
@@ -3629,6 +3659,13 @@ void idAnimator::FreeData(void)
 	joints = NULL;
 	numJoints = 0;
 
+	for (i = ANIMCHANNEL_ALL; i < ANIM_NumAnimChannels; i++) {
+		lodChannelJoints[ i ].Clear();
+	}
+
+	lodCriticalJoints.Clear();
+	lodJointsChanged = true;
+
 	modelDef = NULL;
 
 	ForceUpdate();
@@ -4031,6 +4068,8 @@ void idAnimator::SetJointPos(jointHandle_t jointnum, jointModTransform_t transfo
 	jointMod->pos = pos;
 	jointMod->transform_pos = transform_type;
 
+	SetJointCritical(jointnum);
+
 	if (entity) {
 		entity->BecomeActive(TH_ANIMATE);
 	}
@@ -4074,6 +4113,8 @@ void idAnimator::SetJointAxis(jointHandle_t jointnum, jointModTransform_t transf
 	jointMod->mat = mat;
 	jointMod->transform_axis = transform_type;
 
+	SetJointCritical(jointnum);
+
 	if (entity) {
 		entity->BecomeActive(TH_ANIMATE);
 	}
@@ -4638,12 +4679,139 @@ bool idAnimator::FrameHasChanged(int currentTime) const
 	return false;
 }
 
+/*
+=====================
+idAnimator::FrameIsCurrent
+
+  returns true if the joints were built for the given time
+=====================
+*/
+bool idAnimator::FrameIsCurrent(int currentTime) const
+{
+	return (lastTransformTime == currentTime);
+}
+
+/*
+=====================
+idAnimator::SelectLOD
+
+  selects the level of detail from the distance to the closest player and
+  the size of the model relative to that distance
+=====================
+*/
+animLOD_t idAnimator::SelectLOD(void) const
+{
+	int			i;
+	float		distSqr, minDistSqr;
+	idEntity	*player;
+
+	if (!g_animLOD.GetBool() || !entity || gameLocal.inCinematic) {
+		return ANIMLOD_FULL;
+	}
+
+	const idVec3 &origin = entity->GetPhysics()->GetOrigin();
+
+	minDistSqr = idMath::INFINITY;
+
+	for (i = 0; i < gameLocal.numClients; i++) {
+		player = gameLocal.entities[ i ];
+
+		if (!player || !player->IsType(idPlayer::Type)) {
+			continue;
+		}
+
+		distSqr = (player->GetPhysics()->GetOrigin() - origin).LengthSqr();
+
+		if (distSqr < minDistSqr) {
+			minDistSqr = distSqr;
+		}
+	}
+
+	if (minDistSqr < Square(g_animLODDistance.GetFloat())) {
+		return ANIMLOD_FULL;
+	}
+
+	if (!frameBounds.IsCleared() && Square(frameBounds.GetRadius()) < Square(g_animLODScreenSize.GetFloat()) * minDistSqr) {
+		return ANIMLOD_LOW;
+	}
+
+	return ANIMLOD_REDUCED;
+}
+
+/*
+=====================
+idAnimator::UpdateLODJoints
+
+  builds the joint lists blended at a reduced level of detail.  joints are
+  skipped if every bone in their sub-tree is shorter than g_animLODBoneLength
+  in the default pose, like fingers and facial joints, unless they are critical.
+  skipped joints keep the default pose.
+=====================
+*/
+void idAnimator::UpdateLODJoints(void)
+{
+	int					i, j, num;
+	int					parentNum;
+	bool				*keep;
+	float				minLengthSqr;
+	idJointMat			*pose;
+	const int			*jointParent;
+	const int			*index;
+
+	lodJointsChanged = false;
+	lodBoneLength = g_animLODBoneLength.GetFloat();
+
+	jointParent = modelDef->JointParents();
+
+	pose = (idJointMat *)_alloca16(numJoints * sizeof(pose[0]));
+	SIMDProcessor->ConvertJointQuatsToJointMats(pose, modelDef->GetDefaultPose(), numJoints);
+	SIMDProcessor->TransformJoints(pose, jointParent, 1, numJoints - 1);
+
+	keep = (bool *)_alloca(numJoints * sizeof(keep[0]));
+	memset(keep, 0, numJoints * sizeof(keep[0]));
+
+	minLengthSqr = Square(lodBoneLength);
+
+	// parents always come before their children so walking backwards
+	// marks the parents of any kept joint before they are tested
+	for (i = numJoints - 1; i > 0; i--) {
+		parentNum = jointParent[ i ];
+
+		if (!keep[ i ] && (i >= lodCriticalJoints.Num() || !lodCriticalJoints[ i ])) {
+			if ((pose[ i ].ToVec3() - pose[ parentNum ].ToVec3()).LengthSqr() < minLengthSqr) {
+				continue;
+			}
+		}
+
+		keep[ i ] = true;
+		keep[ parentNum ] = true;
+	}
+
+	keep[ 0 ] = true;
+
+	for (i = ANIMCHANNEL_ALL; i < ANIM_NumAnimChannels; i++) {
+		index = modelDef->GetChannelJoints(i);
+		num = modelDef->NumJointsOnChannel(i);
+
+		lodChannelJoints[ i ].SetNum(0, false);
+
+		for (j = 0; j < num; j++) {
+			if (keep[ index[ j ] ]) {
+				lodChannelJoints[ i ].Append(index[ j ]);
+			}
+		}
+	}
+}
+
 /*
 =====================
 idAnimator::CreateFrame
+
+  unless exact is set the pose of distant and small models may be reused for
+  a while, joint queries always get a pose for the given time
 =====================
 */
-bool idAnimator::CreateFrame(int currentTime, bool force)
+bool idAnimator::CreateFrame(int currentTime, bool force, bool exact)
 {
 	int					i, j;
 	int					numJoints;
@@ -4652,10 +4820,13 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 	bool				debugInfo;
 	float				baseBlend;
 	float				blendWeight;
+	animLOD_t			lod;
 	const idAnimBlend 	*blend;
 	const int 			*jointParent;
 	const jointMod_t 	*jointMod;
 	const idJointQuat 	*defaultPose;
+	const int			*channelJoints[ ANIM_NumAnimChannels ];
+	int					numChannelJoints[ ANIM_NumAnimChannels ];
 
 	static idCVar		r_showSkel("r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2>);
 
@@ -4677,13 +4848,22 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 		}
 	}
 
+	lod = r_showSkel.GetInteger() ? ANIMLOD_FULL : SelectLOD();
+
+	// small models far away keep their pose for a while
+	if (!force && !exact && lod == ANIMLOD_LOW && lastTransformTime != -1 && !stoppedAnimatingUpdate) {
+		if (currentTime > lastTransformTime && currentTime - lastTransformTime < g_animLODInterval.GetInteger()) {
+			return false;
+		}
+	}
+
 	lastTransformTime = currentTime;
 	stoppedAnimatingUpdate = false;
 
 	if (entity && ((g_debugAnim.GetInteger() == entity->entityNumber) || (g_debugAnim.GetInteger() == -2))) {
 		debugInfo = true;
 		gameLocal.Printf("---------------\n%d: entity '%s':\n", gameLocal.time, entity->GetName());
-		gameLocal.Printf("model '%s':\n", modelDef->GetModelName());
+		gameLocal.Printf("model '%s': lod %d\n", modelDef->GetModelName(), lod);
 	} else {
 		debugInfo = false;
 	}
@@ -4705,6 +4885,21 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 	idJointQuat *jointFrame = (idJointQuat *)_alloca16(numJoints * sizeof(jointFrame[0]));
 	SIMDProcessor->Memcpy(jointFrame, defaultPose, numJoints * sizeof(jointFrame[0]));
 
+	// get the joints to blend on each channel
+	if (lod != ANIMLOD_FULL && (lodJointsChanged || lodBoneLength != g_animLODBoneLength.GetFloat())) {
+		UpdateLODJoints();
+	}
+
+	for (i = ANIMCHANNEL_ALL; i < ANIM_NumAnimChannels; i++) {
+		if (lod == ANIMLOD_FULL) {
+			channelJoints[ i ] = modelDef->GetChannelJoints(i);
+			numChannelJoints[ i ] = modelDef->NumJointsOnChannel(i);
+		} else {
+			channelJoints[ i ] = lodChannelJoints[ i ].Ptr();
+			numChannelJoints[ i ] = lodChannelJoints[ i ].Num();
+		}
+	}
+
 	hasAnim = false;
 
 	// blend the all channel
@@ -4712,7 +4907,7 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 	blend = channels[ ANIMCHANNEL_ALL ];
 
 	for (j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++) {
-		if (blend->BlendAnim(currentTime, ANIMCHANNEL_ALL, numJoints, jointFrame, baseBlend, removeOriginOffset, false, debugInfo)) {
+		if (blend->BlendAnim(currentTime, ANIMCHANNEL_ALL, channelJoints[ ANIMCHANNEL_ALL ], numChannelJoints[ ANIMCHANNEL_ALL ], numJoints, jointFrame, baseBlend, removeOriginOffset, false, debugInfo)) {
 			hasAnim = true;
 
 			if (baseBlend >= 1.0f) {
@@ -4724,7 +4919,7 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 	// only blend other channels if there's enough space to blend into
 	if (baseBlend < 1.0f) {
 		for (i = ANIMCHANNEL_ALL + 1; i < ANIM_NumAnimChannels; i++) {
-			if (!modelDef->NumJointsOnChannel(i)) {
+			if (!numChannelJoints[ i ]) {
 				continue;
 			}
 
@@ -4737,7 +4932,7 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 			blend = channels[ i ];
 
 			for (j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++) {
-				if (blend->BlendAnim(currentTime, i, numJoints, jointFrame, blendWeight, removeOriginOffset, false, debugInfo)) {
+				if (blend->BlendAnim(currentTime, i, channelJoints[ i ], numChannelJoints[ i ], numJoints, jointFrame, blendWeight, removeOriginOffset, false, debugInfo)) {
 					hasAnim = true;
 
 					if (blendWeight >= 1.0f) {
@@ -4754,12 +4949,12 @@ bool idAnimator::CreateFrame(int currentTime, bool force)
 	}
 
 	// blend in the eyelids
-	if (modelDef->NumJointsOnChannel(ANIMCHANNEL_EYELIDS)) {
+	if (numChannelJoints[ ANIMCHANNEL_EYELIDS ]) {
 		blend = channels[ ANIMCHANNEL_EYELIDS ];
 		blendWeight = baseBlend;
 
 		for (j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++) {
-			if (blend->BlendAnim(currentTime, ANIMCHANNEL_EYELIDS, numJoints, jointFrame, blendWeight, removeOriginOffset, true, debugInfo)) {
+			if (blend->BlendAnim(currentTime, ANIMCHANNEL_EYELIDS, channelJoints[ ANIMCHANNEL_EYELIDS ], numChannelJoints[ ANIMCHANNEL_EYELIDS ], numJoints, jointFrame, blendWeight, removeOriginOffset, true, debugInfo)) {
 				hasAnim = true;
 
 				if (blendWeight >= 1.0f) {
@@ -4927,7 +5122,9 @@ bool idAnimator::GetJointTransform(jointHandle_t jointHandle, int currentTime, i
 		return false;
 	}
 
-	CreateFrame(currentTime, false);
+	// gameplay relies on queried joints so never reduce or throttle them
+	SetJointCritical(jointHandle);
+	CreateFrame(currentTime, false, true);
 
 	offset = joints[ jointHandle ].ToVec3();
 	axis = joints[ jointHandle ].ToMat3();
@@ -4952,8 +5149,11 @@ bool idAnimator::GetJointLocalTransform(jointHandle_t jointHandle, int currentTi
 		return false;
 	}
 
+	// gameplay relies on queried joints so never reduce or throttle them
+	SetJointCritical(jointHandle);
+
 	// FIXME: overkill
-	CreateFrame(currentTime, false);
+	CreateFrame(currentTime, false, true);
 
 	if (jointHandle > 0) {
 		idJointMat m = joints[ jointHandle ];
@@ -4975,11 +5175,43 @@ idAnimator::GetJointHandle
 */
 jointHandle_t idAnimator::GetJointHandle(const char *name) const
 {
+	jointHandle_t jointnum;
+
 	if (!modelDef || !modelDef->ModelHandle()) {
 		return INVALID_JOINT;
 	}
 
-	return modelDef->ModelHandle()->GetJointHandle(name);
+	jointnum = modelDef->ModelHandle()->GetJointHandle(name);
+
+	// joints looked up by name are used by gameplay code
+	SetJointCritical(jointnum);
+
+	return jointnum;
+}
+
+/*
+=====================
+idAnimator::SetJointCritical
+
+  critical joints and their parents are always blended exactly, even at a reduced level of detail
+=====================
+*/
+void idAnimator::SetJointCritical(jointHandle_t jointnum) const
+{
+	if ((jointnum < 0) || (jointnum >= numJoints)) {
+		return;
+	}
+
+	if (lodCriticalJoints.Num() != numJoints) {
+		lodCriticalJoints.AssureSize(numJoints, false);
+	}
+
+	if (!lodCriticalJoints[ jointnum ]) {
+		lodCriticalJoints[ jointnum ] = true;
+		lodJointsChanged = true;
+		// the current frame might not include the joint
+		lastTransformTime = -1;
+	}
 }
 
 /*
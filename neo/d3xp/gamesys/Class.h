@@ -43,15 +43,269 @@ extern const idEventDef EV_SafeRemove;
 
 typedef void (idClass::*eventCallback_t)(void);
 
+// calls an event callback with the arguments unpacked from the array built by idEvent::CopyArgs
+typedef void (*eventInvoke_t)(idClass *object, eventCallback_t callback, const intptr_t *data);
+
+struct idEventThunk {
+	eventInvoke_t		invoke;
+	unsigned int		formatspecIndex;		// argument layout the thunk expects, compared against idEventDef::GetFormatspecIndex
+};
+
 template< class Type >
 struct idEventFunc {
 	const idEventDef	*event;
 	eventCallback_t		function;
+	idEventThunk		thunk;
 };
 
 // added & so gcc could compile this
-#define EVENT( event, function )	{ &( event ), ( void ( idClass::* )( void ) )( &function ) },
-#define END_CLASS					{ NULL, NULL } };
+#define EVENT( event, function )	{ &( event ), ( void ( idClass::* )( void ) )( &function ), idEventThunkFor( &function ) },
+#define END_CLASS					{ NULL, NULL, { NULL, 0 } } };
+
+/*
+================
+idEventArgument
+
+Converts an element of the event argument array back to the parameter type of the callback.
+Floats are stored as their bit pattern, vectors and traces as pointers.
+================
+*/
+template< class Type >
+struct idEventArgument {
+	enum { isFloat = 0 };
+	static Type Get(const intptr_t &data)			{
+		return (Type)data;
+	}
+};
+
+template<>
+struct idEventArgument<float> {
+	enum { isFloat = 1 };
+	static float Get(const intptr_t &data)			{
+		return *reinterpret_cast<const float *>(&data);
+	}
+};
+
+template< class Type >
+struct idEventArgument<Type &> {
+	enum { isFloat = 0 };
+	static Type &Get(const intptr_t &data)			{
+		return *reinterpret_cast<Type *>(data);
+	}
+};
+
+/*
+================
+idEventThunk0 - idEventThunk8
+
+Type specialized callers for each event callback signature, so that the arguments don't
+have to be dispatched through the generic switch on the formatspec index.
+================
+*/
+#define EVENT_THUNK_FORMAT( numargs, bits )	( ( 1u << ( ( numargs ) + D_EVENT_MAXARGS ) ) | ( bits ) )
+#define EVENT_THUNK_FLOAT( arg, index )		( idEventArgument<arg>::isFloat << ( index ) )
+#define EVENT_THUNK_ARG( arg, index )		idEventArgument<arg>::Get( data[ index ] )
+
+template< class Class, class Func >
+struct idEventThunk0 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))();
+	}
+};
+
+template< class Class, class Func, class A1 >
+struct idEventThunk1 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0));
+	}
+};
+
+template< class Class, class Func, class A1, class A2 >
+struct idEventThunk2 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1));
+	}
+};
+
+template< class Class, class Func, class A1, class A2, class A3 >
+struct idEventThunk3 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1), EVENT_THUNK_ARG(A3, 2));
+	}
+};
+
+template< class Class, class Func, class A1, class A2, class A3, class A4 >
+struct idEventThunk4 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1), EVENT_THUNK_ARG(A3, 2),
+		        EVENT_THUNK_ARG(A4, 3));
+	}
+};
+
+template< class Class, class Func, class A1, class A2, class A3, class A4, class A5 >
+struct idEventThunk5 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1), EVENT_THUNK_ARG(A3, 2),
+		        EVENT_THUNK_ARG(A4, 3), EVENT_THUNK_ARG(A5, 4));
+	}
+};
+
+template< class Class, class Func, class A1, class A2, class A3, class A4, class A5, class A6 >
+struct idEventThunk6 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1), EVENT_THUNK_ARG(A3, 2),
+		        EVENT_THUNK_ARG(A4, 3), EVENT_THUNK_ARG(A5, 4), EVENT_THUNK_ARG(A6, 5));
+	}
+};
+
+template< class Class, class Func, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+struct idEventThunk7 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1), EVENT_THUNK_ARG(A3, 2),
+		        EVENT_THUNK_ARG(A4, 3), EVENT_THUNK_ARG(A5, 4), EVENT_THUNK_ARG(A6, 5), EVENT_THUNK_ARG(A7, 6));
+	}
+};
+
+template< class Class, class Func, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+struct idEventThunk8 {
+	static void Invoke(idClass *object, eventCallback_t callback, const intptr_t *data) {
+		(static_cast<Class *>(object)->*reinterpret_cast<Func>(callback))(EVENT_THUNK_ARG(A1, 0), EVENT_THUNK_ARG(A2, 1), EVENT_THUNK_ARG(A3, 2),
+		        EVENT_THUNK_ARG(A4, 3), EVENT_THUNK_ARG(A5, 4), EVENT_THUNK_ARG(A6, 5), EVENT_THUNK_ARG(A7, 6), EVENT_THUNK_ARG(A8, 7));
+	}
+};
+
+/*
+================
+idEventThunkFor
+
+Picks the thunk matching the signature of the callback passed to the EVENT macro.
+================
+*/
+template< class Class >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(void))
+{
+	idEventThunk thunk = { &idEventThunk0< Class, void (Class::*)(void) >::Invoke, EVENT_THUNK_FORMAT(0, 0) };
+	return thunk;
+}
+
+template< class Class, class A1 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1))
+{
+	idEventThunk thunk = { &idEventThunk1< Class, void (Class::*)(A1), A1 >::Invoke, EVENT_THUNK_FORMAT(1, EVENT_THUNK_FLOAT(A1, 0)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2))
+{
+	idEventThunk thunk = { &idEventThunk2< Class, void (Class::*)(A1, A2), A1, A2 >::Invoke, EVENT_THUNK_FORMAT(2, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3))
+{
+	idEventThunk thunk = { &idEventThunk3< Class, void (Class::*)(A1, A2, A3), A1, A2, A3 >::Invoke, EVENT_THUNK_FORMAT(3, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4))
+{
+	idEventThunk thunk = { &idEventThunk4< Class, void (Class::*)(A1, A2, A3, A4), A1, A2, A3, A4 >::Invoke, EVENT_THUNK_FORMAT(4, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5))
+{
+	idEventThunk thunk = { &idEventThunk5< Class, void (Class::*)(A1, A2, A3, A4, A5), A1, A2, A3, A4, A5 >::Invoke, EVENT_THUNK_FORMAT(5, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5, class A6 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5, A6))
+{
+	idEventThunk thunk = { &idEventThunk6< Class, void (Class::*)(A1, A2, A3, A4, A5, A6), A1, A2, A3, A4, A5, A6 >::Invoke, EVENT_THUNK_FORMAT(6, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4) | EVENT_THUNK_FLOAT(A6, 5)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5, A6, A7))
+{
+	idEventThunk thunk = { &idEventThunk7< Class, void (Class::*)(A1, A2, A3, A4, A5, A6, A7), A1, A2, A3, A4, A5, A6, A7 >::Invoke, EVENT_THUNK_FORMAT(7, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4) | EVENT_THUNK_FLOAT(A6, 5) | EVENT_THUNK_FLOAT(A7, 6)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5, A6, A7, A8))
+{
+	idEventThunk thunk = { &idEventThunk8< Class, void (Class::*)(A1, A2, A3, A4, A5, A6, A7, A8), A1, A2, A3, A4, A5, A6, A7, A8 >::Invoke, EVENT_THUNK_FORMAT(8, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4) | EVENT_THUNK_FLOAT(A6, 5) | EVENT_THUNK_FLOAT(A7, 6) | EVENT_THUNK_FLOAT(A8, 7)) };
+	return thunk;
+}
+
+template< class Class >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(void) const)
+{
+	idEventThunk thunk = { &idEventThunk0< Class, void (Class::*)(void) const >::Invoke, EVENT_THUNK_FORMAT(0, 0) };
+	return thunk;
+}
+
+template< class Class, class A1 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1) const)
+{
+	idEventThunk thunk = { &idEventThunk1< Class, void (Class::*)(A1) const, A1 >::Invoke, EVENT_THUNK_FORMAT(1, EVENT_THUNK_FLOAT(A1, 0)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2) const)
+{
+	idEventThunk thunk = { &idEventThunk2< Class, void (Class::*)(A1, A2) const, A1, A2 >::Invoke, EVENT_THUNK_FORMAT(2, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3) const)
+{
+	idEventThunk thunk = { &idEventThunk3< Class, void (Class::*)(A1, A2, A3) const, A1, A2, A3 >::Invoke, EVENT_THUNK_FORMAT(3, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4) const)
+{
+	idEventThunk thunk = { &idEventThunk4< Class, void (Class::*)(A1, A2, A3, A4) const, A1, A2, A3, A4 >::Invoke, EVENT_THUNK_FORMAT(4, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5) const)
+{
+	idEventThunk thunk = { &idEventThunk5< Class, void (Class::*)(A1, A2, A3, A4, A5) const, A1, A2, A3, A4, A5 >::Invoke, EVENT_THUNK_FORMAT(5, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5, class A6 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5, A6) const)
+{
+	idEventThunk thunk = { &idEventThunk6< Class, void (Class::*)(A1, A2, A3, A4, A5, A6) const, A1, A2, A3, A4, A5, A6 >::Invoke, EVENT_THUNK_FORMAT(6, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4) | EVENT_THUNK_FLOAT(A6, 5)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5, A6, A7) const)
+{
+	idEventThunk thunk = { &idEventThunk7< Class, void (Class::*)(A1, A2, A3, A4, A5, A6, A7) const, A1, A2, A3, A4, A5, A6, A7 >::Invoke, EVENT_THUNK_FORMAT(7, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4) | EVENT_THUNK_FLOAT(A6, 5) | EVENT_THUNK_FLOAT(A7, 6)) };
+	return thunk;
+}
+
+template< class Class, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+ID_INLINE idEventThunk idEventThunkFor(void (Class::*)(A1, A2, A3, A4, A5, A6, A7, A8) const)
+{
+	idEventThunk thunk = { &idEventThunk8< Class, void (Class::*)(A1, A2, A3, A4, A5, A6, A7, A8) const, A1, A2, A3, A4, A5, A6, A7, A8 >::Invoke, EVENT_THUNK_FORMAT(8, EVENT_THUNK_FLOAT(A1, 0) | EVENT_THUNK_FLOAT(A2, 1) | EVENT_THUNK_FLOAT(A3, 2) | EVENT_THUNK_FLOAT(A4, 3) | EVENT_THUNK_FLOAT(A5, 4) | EVENT_THUNK_FLOAT(A6, 5) | EVENT_THUNK_FLOAT(A7, 6) | EVENT_THUNK_FLOAT(A8, 7)) };
+	return thunk;
+}
 
 
 class idEventArg
@@ -311,6 +565,7 @@ class idTypeInfo
 
 		idEventFunc<idClass> *		eventCallbacks;
 		eventCallback_t 			*eventMap;
+		eventInvoke_t				*eventInvokers;			// parallel to eventMap, NULL where the generic dispatch has to be used
 		idTypeInfo 				*super;
 		idTypeInfo 				*next;
 		bool						freeEventMap;
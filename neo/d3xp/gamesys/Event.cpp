@@ -226,12 +226,271 @@ const idEventDef *idEventDef::FindEvent(const char *name)
 
 ***********************************************************************/
 
+#define EVENT_OBJECT_HASH_SIZE		1024
+
+/*
+================
+idEventSchedule
+
+Binary heap of the scheduled events ordered by time, events scheduled for
+the same time are serviced in the order they were scheduled in.
+================
+*/
+class idEventSchedule
+{
+	public:
+		void						Clear(void);
+		int							Num(void) const;
+		idEvent						*First(void) const;
+		void						Add(idEvent *event);
+		void						Remove(idEvent *event);
+		int							GetSorted(idEvent **list) const;
+
+	private:
+		idEvent						*heap[ MAX_EVENTS ];
+		int							num;
+		int							sequence;
+
+		static bool					Before(const idEvent *a, const idEvent *b);
+		static int					Compare(const void *a, const void *b);
+		void						Set(int index, idEvent *event);
+		void						SiftUp(int index);
+		void						SiftDown(int index);
+};
+
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
+static idEventSchedule EventQueue;
 #ifdef _D3XP
-static idLinkList<idEvent> FastEventQueue;
+static idEventSchedule FastEventQueue;
 #endif
 static idEvent EventPool[ MAX_EVENTS ];
+static idEvent *ObjectEvents[ EVENT_OBJECT_HASH_SIZE ];
+
+/*
+================
+ObjectEventHash
+================
+*/
+static ID_INLINE int ObjectEventHash(const idClass *obj)
+{
+	return (int)((reinterpret_cast<uintptr_t>(obj) >> 4) & (EVENT_OBJECT_HASH_SIZE - 1));
+}
+
+/*
+================
+idEventSchedule::Clear
+================
+*/
+void idEventSchedule::Clear(void)
+{
+	num = 0;
+	sequence = 0;
+}
+
+/*
+================
+idEventSchedule::Num
+================
+*/
+int idEventSchedule::Num(void) const
+{
+	return num;
+}
+
+/*
+================
+idEventSchedule::First
+================
+*/
+idEvent *idEventSchedule::First(void) const
+{
+	return num ? heap[ 0 ] : NULL;
+}
+
+/*
+================
+idEventSchedule::Before
+================
+*/
+bool idEventSchedule::Before(const idEvent *a, const idEvent *b)
+{
+	if (a->time != b->time) {
+		return a->time < b->time;
+	}
+
+	// the sequence may wrap
+	return (a->sequence - b->sequence) < 0;
+}
+
+/*
+================
+idEventSchedule::Compare
+================
+*/
+int idEventSchedule::Compare(const void *a, const void *b)
+{
+	const idEvent *eventA = *static_cast<idEvent *const *>(a);
+	const idEvent *eventB = *static_cast<idEvent *const *>(b);
+
+	if (Before(eventA, eventB)) {
+		return -1;
+	}
+
+	if (Before(eventB, eventA)) {
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+================
+idEventSchedule::Set
+================
+*/
+ID_INLINE void idEventSchedule::Set(int index, idEvent *event)
+{
+	heap[ index ] = event;
+	event->scheduleIndex = index;
+}
+
+/*
+================
+idEventSchedule::SiftUp
+================
+*/
+void idEventSchedule::SiftUp(int index)
+{
+	idEvent *event = heap[ index ];
+
+	while (index > 0) {
+		int parent = (index - 1) >> 1;
+
+		if (!Before(event, heap[ parent ])) {
+			break;
+		}
+
+		Set(index, heap[ parent ]);
+		index = parent;
+	}
+
+	Set(index, event);
+}
+
+/*
+================
+idEventSchedule::SiftDown
+================
+*/
+void idEventSchedule::SiftDown(int index)
+{
+	idEvent *event = heap[ index ];
+
+	while (1) {
+		int child = index * 2 + 1;
+
+		if (child >= num) {
+			break;
+		}
+
+		if (child + 1 < num && Before(heap[ child + 1 ], heap[ child ])) {
+			child++;
+		}
+
+		if (!Before(heap[ child ], event)) {
+			break;
+		}
+
+		Set(index, heap[ child ]);
+		index = child;
+	}
+
+	Set(index, event);
+}
+
+/*
+================
+idEventSchedule::Add
+================
+*/
+void idEventSchedule::Add(idEvent *event)
+{
+	int hash;
+
+	assert(!event->schedule);
+	assert(num < MAX_EVENTS);
+
+	event->schedule = this;
+	event->sequence = sequence++;
+	heap[ num ] = event;
+	SiftUp(num++);
+
+	// link it with the other events of the object so they can be cancelled without going through the queue
+	hash = ObjectEventHash(event->object);
+	event->prevObjectEvent = NULL;
+	event->nextObjectEvent = ObjectEvents[ hash ];
+
+	if (ObjectEvents[ hash ]) {
+		ObjectEvents[ hash ]->prevObjectEvent = event;
+	}
+
+	ObjectEvents[ hash ] = event;
+}
+
+/*
+================
+idEventSchedule::Remove
+================
+*/
+void idEventSchedule::Remove(idEvent *event)
+{
+	int index;
+
+	assert(event->schedule == this);
+	assert(heap[ event->scheduleIndex ] == event);
+
+	index = event->scheduleIndex;
+	num--;
+
+	if (index < num) {
+		Set(index, heap[ num ]);
+
+		if (index > 0 && Before(heap[ index ], heap[ (index - 1) >> 1 ])) {
+			SiftUp(index);
+		} else {
+			SiftDown(index);
+		}
+	}
+
+	if (event->prevObjectEvent) {
+		event->prevObjectEvent->nextObjectEvent = event->nextObjectEvent;
+	} else {
+		ObjectEvents[ ObjectEventHash(event->object) ] = event->nextObjectEvent;
+	}
+
+	if (event->nextObjectEvent) {
+		event->nextObjectEvent->prevObjectEvent = event->prevObjectEvent;
+	}
+
+	event->schedule = NULL;
+	event->nextObjectEvent = NULL;
+	event->prevObjectEvent = NULL;
+}
+
+/*
+================
+idEventSchedule::GetSorted
+
+  fills the list with the events in the order they will be serviced
+================
+*/
+int idEventSchedule::GetSorted(idEvent **list) const
+{
+	memcpy(list, heap, num * sizeof(list[ 0 ]));
+	qsort(list, num, sizeof(list[ 0 ]), Compare);
+
+	return num;
+}
 
 bool idEvent::initialized = false;
 
@@ -396,6 +655,8 @@ void idEvent::Free(void)
 		data = NULL;
 	}
 
+	Unschedule();
+
 	eventdef	= NULL;
 	time		= 0;
 	object		= NULL;
@@ -405,6 +666,18 @@ void idEvent::Free(void)
 	eventNode.AddToEnd(FreeEvents);
 }
 
+/*
+================
+idEvent::Unschedule
+================
+*/
+void idEvent::Unschedule(void)
+{
+	if (schedule) {
+		schedule->Remove(this);
+	}
+}
+
 /*
 ================
 idEvent::Schedule
@@ -412,37 +685,24 @@ idEvent::Schedule
 */
 void idEvent::Schedule(idClass *obj, const idTypeInfo *type, int time)
 {
-	idEvent *event;
-
 	assert(initialized);
 
 	if (!initialized) {
 		return;
 	}
 
+	Unschedule();
+
 	object = obj;
 	typeinfo = type;
 
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
 
-	eventNode.Remove();
-
 #ifdef _D3XP
 
 	if (obj->IsType(idEntity::Type) && (((idEntity *)(obj))->timeGroup == TIME_GROUP2)) {
-		event = FastEventQueue.Next();
-
-		while ((event != NULL) && (this->time >= event->time)) {
-			event = event->eventNode.Next();
-		}
-
-		if (event) {
-			eventNode.InsertBefore(event->eventNode);
-		} else {
-			eventNode.AddToEnd(FastEventQueue);
-		}
-
+		FastEventQueue.Add(this);
 		return;
 	} else {
 		this->time = gameLocal.slow.time + time;
@@ -450,17 +710,7 @@ void idEvent::Schedule(idClass *obj, const idTypeInfo *type, int time)
 
 #endif
 
-	event = EventQueue.Next();
-
-	while ((event != NULL) && (this->time >= event->time)) {
-		event = event->eventNode.Next();
-	}
-
-	if (event) {
-		eventNode.InsertBefore(event->eventNode);
-	} else {
-		eventNode.AddToEnd(EventQueue);
-	}
+	EventQueue.Add(this);
 }
 
 /*
@@ -477,20 +727,8 @@ void idEvent::CancelEvents(const idClass *obj, const idEventDef *evdef)
 		return;
 	}
 
-	for (event = EventQueue.Next(); event != NULL; event = next) {
-		next = event->eventNode.Next();
-
-		if (event->object == obj) {
-			if (!evdef || (evdef == event->eventdef)) {
-				event->Free();
-			}
-		}
-	}
-
-#ifdef _D3XP
-
-	for (event = FastEventQueue.Next(); event != NULL; event = next) {
-		next = event->eventNode.Next();
+	for (event = ObjectEvents[ ObjectEventHash(obj) ]; event != NULL; event = next) {
+		next = event->nextObjectEvent;
 
 		if (event->object == obj) {
 			if (!evdef || (evdef == event->eventdef)) {
@@ -498,8 +736,6 @@ void idEvent::CancelEvents(const idClass *obj, const idEventDef *evdef)
 			}
 		}
 	}
-
-#endif
 }
 
 /*
@@ -516,11 +752,16 @@ void idEvent::ClearEventList(void)
 	//
 	FreeEvents.Clear();
 	EventQueue.Clear();
+#ifdef _D3XP
+	FastEventQueue.Clear();
+#endif
+	memset(ObjectEvents, 0, sizeof(ObjectEvents));
 
 	//
 	// add the events to the free list
 	//
 	for (i = 0; i < MAX_EVENTS; i++) {
+		EventPool[ i ].schedule = NULL;
 		EventPool[ i ].Free();
 	}
 }
@@ -546,8 +787,8 @@ void idEvent::ServiceEvents(void)
 
 	num = 0;
 
-	while (!EventQueue.IsListEmpty()) {
-		event = EventQueue.Next();
+	while (EventQueue.Num()) {
+		event = EventQueue.First();
 		assert(event);
 
 		if (event->time > gameLocal.time) {
@@ -606,7 +847,7 @@ void idEvent::ServiceEvents(void)
 
 		// the event is removed from its list so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unschedule();
 		assert(event->object);
 		event->object->ProcessEventArgPtr(ev, args);
 
@@ -655,8 +896,8 @@ void idEvent::ServiceFastEvents()
 
 	num = 0;
 
-	while (!FastEventQueue.IsListEmpty()) {
-		event = FastEventQueue.Next();
+	while (FastEventQueue.Num()) {
+		event = FastEventQueue.First();
 		assert(event);
 
 		if (event->time > gameLocal.fast.time) {
@@ -715,7 +956,7 @@ void idEvent::ServiceFastEvents()
 
 		// the event is removed from its list so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unschedule();
 		assert(event->object);
 		event->object->ProcessEventArgPtr(ev, args);
 
@@ -808,18 +1049,23 @@ idEvent::Save
 void idEvent::Save(idSaveGame *savefile)
 {
 	char *str;
-	int i, size;
+	int i, j, num, size;
 	idEvent	*event;
+	idList<idEvent *> events;
 	byte *dataPtr;
 	bool validTrace;
 	const char	*format;
 	idStr s;
 
-	savefile->WriteInt(EventQueue.Num());
+	// write the events in the order they will be serviced
+	events.SetNum(EventQueue.Num());
+	num = EventQueue.GetSorted(events.Ptr());
+
+	savefile->WriteInt(num);
 
-	event = EventQueue.Next();
+	for (j = 0; j < num; j++) {
+		event = events[ j ];
 
-	while (event != NULL) {
 		savefile->WriteInt(event->time);
 		savefile->WriteString(event->eventdef->GetName());
 		savefile->WriteString(event->typeinfo->classname);
@@ -875,24 +1121,24 @@ void idEvent::Save(idSaveGame *savefile)
 		}
 
 		assert(size == event->eventdef->GetArgSize());
-		event = event->eventNode.Next();
 	}
 
 #ifdef _D3XP
 	// Save the Fast EventQueue
-	savefile->WriteInt(FastEventQueue.Num());
+	events.SetNum(FastEventQueue.Num());
+	num = FastEventQueue.GetSorted(events.Ptr());
 
-	event = FastEventQueue.Next();
+	savefile->WriteInt(num);
+
+	for (j = 0; j < num; j++) {
+		event = events[ j ];
 
-	while (event != NULL) {
 		savefile->WriteInt(event->time);
 		savefile->WriteString(event->eventdef->GetName());
 		savefile->WriteString(event->typeinfo->classname);
 		savefile->WriteObject(event->object);
 		savefile->WriteInt(event->eventdef->GetArgSize());
 		savefile->Write(event->data, event->eventdef->GetArgSize());
-
-		event = event->eventNode.Next();
 	}
 
 #endif
@@ -922,7 +1168,6 @@ void idEvent::Restore(idRestoreGame *savefile)
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd(EventQueue);
 
 		savefile->ReadInt(event->time);
 
@@ -943,6 +1188,7 @@ void idEvent::Restore(idRestoreGame *savefile)
 		}
 
 		savefile->ReadObject(event->object);
+		EventQueue.Add(event);
 
 		// read the args
 		savefile->ReadInt(argsize);
@@ -1018,7 +1264,6 @@ void idEvent::Restore(idRestoreGame *savefile)
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd(FastEventQueue);
 
 		savefile->ReadInt(event->time);
 
@@ -1039,6 +1284,7 @@ void idEvent::Restore(idRestoreGame *savefile)
 		}
 
 		savefile->ReadObject(event->object);
+		FastEventQueue.Add(event);
 
 		// read the args
 		savefile->ReadInt(argsize);
@@ -49,6 +49,7 @@ Event are used for scheduling tasks and for linking script commands.
 
 class idClass;
 class idTypeInfo;
+class idEventSchedule;
 
 class idEventDef
 {
@@ -88,6 +89,8 @@ class idRestoreGame;
 
 class idEvent
 {
+		friend class idEventSchedule;
+
 	private:
 		const idEventDef			*eventdef;
 		byte						*data;
@@ -95,7 +98,15 @@ class idEvent
 		idClass						*object;
 		const idTypeInfo			*typeinfo;
 
-		idLinkList<idEvent>			eventNode;
+		idLinkList<idEvent>			eventNode;				// free list
+
+		idEventSchedule				*schedule;				// queue the event is scheduled in, NULL when not scheduled
+		int							scheduleIndex;			// position in the queue
+		int							sequence;				// keeps events scheduled for the same time in order
+		idEvent						*nextObjectEvent;		// scheduled events of objects with the same hash
+		idEvent						*prevObjectEvent;
+
+		void						Unschedule(void);
 
 		static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
 
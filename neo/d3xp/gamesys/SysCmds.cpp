@@ -181,6 +181,23 @@ void Cmd_ReloadScript_f(const idCmdArgs &args)
 	gameLocal.Error("Exiting map to reload scripts");
 }
 
+/*
+==================
+Cmd_TestScriptCache_f
+==================
+*/
+void Cmd_TestScriptCache_f(const idCmdArgs &args)
+{
+	// shutdown the map because entities may point to script objects
+	gameLocal.MapShutdown();
+
+	// compile the scripts, then restore them from the cache and compare
+	gameLocal.program.TestCache(SCRIPT_DEFAULT);
+
+	// error out so that the user can rerun the scripts
+	gameLocal.Error("Exiting map to reload scripts");
+}
+
 /*
 ===================
 Cmd_Script_f
@@ -220,6 +237,281 @@ void Cmd_Script_f(const idCmdArgs &args)
 	}
 }
 
+/*
+===================
+Cmd_TestScriptSpeed_f
+
+Runs a synthetic script the given number of times and reports how fast the interpreter went through it.
+===================
+*/
+void Cmd_TestScriptSpeed_f(const idCmdArgs &args)
+{
+	static int			funccount = 0;
+	idStr				text;
+	idStr				funcname;
+	const function_t	*func;
+	idThread			*thread;
+	idTimer				timer;
+	int					i, count, statements;
+
+	if (!gameLocal.CheatsOk()) {
+		return;
+	}
+
+	count = (args.Argc() > 1) ? atoi(args.Argv(1)) : 10;
+
+	if (count < 1) {
+		count = 1;
+	}
+
+	sprintf(funcname, "TestScriptSpeed_%d", funccount++);
+	sprintf(text,
+	        "void %s() {\n"
+	        "	float i;\n"
+	        "	float j;\n"
+	        "	float sum;\n"
+	        "	vector v;\n"
+	        "	string s;\n"
+	        "	for( i = 0; i < 1000; i++ ) {\n"
+	        "		for( j = 0; j < 50; j++ ) {\n"
+	        "			if ( j >= 25 ) {\n"
+	        "				sum = sum + j * 0.5;\n"
+	        "			} else {\n"
+	        "				sum = sum - j;\n"
+	        "			}\n"
+	        "			v = v + '1 0 0' * j;\n"
+	        "		}\n"
+	        "		s = \"value \" + sum;\n"
+	        "	}\n"
+	        "}\n", funcname.c_str());
+
+	if (!gameLocal.program.CompileText("testScriptSpeed", text, true)) {
+		return;
+	}
+
+	func = gameLocal.program.FindFunction(funcname);
+
+	if (!func) {
+		return;
+	}
+
+	statements = idInterpreter::executedStatements;
+
+	timer.Start();
+
+	for (i = 0; i < count; i++) {
+		thread = new idThread(func);
+		thread->Start();
+	}
+
+	timer.Stop();
+
+	statements = idInterpreter::executedStatements - statements;
+
+	gameLocal.Printf("%d runs in %.1f msec, %d statements dispatched, %.2f million per second\n",
+	                 count, timer.Milliseconds(), statements, statements / idMath::ClampFloat(0.001f, idMath::INFINITY, timer.Milliseconds()) * 0.001f);
+}
+
+/*
+==================
+Cmd_TestEventSpeed_f
+
+Calls a few typical script events on the world entity the same way the interpreter does,
+once through the event thunks and once through the generic formatspec switch.
+==================
+*/
+void Cmd_TestEventSpeed_f(const idCmdArgs &args)
+{
+	static const char	*eventNames[] = { "getOrigin", "getShaderParm", "getKey", "distanceToPoint" };
+	const int			numEvents = sizeof(eventNames) / sizeof(eventNames[ 0 ]);
+	const idEventDef	*events[ numEvents ];
+	intptr_t			data[ numEvents ][ D_EVENT_MAXARGS ];
+	idVec3				point;
+	idTimer				timer;
+	double				msec[ 2 ];
+	bool				useThunks;
+	int					i, j, pass, count;
+
+	if (!gameLocal.CheatsOk()) {
+		return;
+	}
+
+	if (!gameLocal.world) {
+		gameLocal.Printf("No map loaded\n");
+		return;
+	}
+
+	count = (args.Argc() > 1) ? atoi(args.Argv(1)) : 100000;
+
+	if (count < 1) {
+		count = 1;
+	}
+
+	for (i = 0; i < numEvents; i++) {
+		events[ i ] = idEventDef::FindEvent(eventNames[ i ]);
+
+		if (!events[ i ] || !gameLocal.world->RespondsTo(*events[ i ])) {
+			gameLocal.Printf("worldspawn doesn't respond to '%s'\n", eventNames[ i ]);
+			return;
+		}
+	}
+
+	point.Zero();
+	memset(data, 0, sizeof(data));
+	data[ 2 ][ 0 ] = reinterpret_cast<intptr_t>("classname");
+	data[ 3 ][ 0 ] = reinterpret_cast<intptr_t>(&point);
+
+	useThunks = g_eventThunks.GetBool();
+
+	for (pass = 0; pass < 2; pass++) {
+		g_eventThunks.SetBool(pass == 0);
+
+		timer.Clear();
+		timer.Start();
+
+		for (i = 0; i < count; i++) {
+			for (j = 0; j < numEvents; j++) {
+				gameLocal.world->ProcessEventArgPtr(events[ j ], data[ j ]);
+			}
+		}
+
+		timer.Stop();
+		msec[ pass ] = idMath::ClampFloat(0.001f, idMath::INFINITY, timer.Milliseconds());
+	}
+
+	g_eventThunks.SetBool(useThunks);
+
+	count *= numEvents;
+	gameLocal.Printf("%d events: thunks %.1f msec (%.2f million per second), formatspec switch %.1f msec (%.2f million per second)\n",
+	                 count, msec[ 0 ], count / msec[ 0 ] * 0.001f, msec[ 1 ], count / msec[ 1 ] * 0.001f);
+}
+
+/*
+==================
+Cmd_RecordClipQueries_f
+==================
+*/
+void Cmd_RecordClipQueries_f(const idCmdArgs &args)
+{
+	int count;
+
+	count = (args.Argc() > 1) ? atoi(args.Argv(1)) : 10000;
+
+	if (count < 1) {
+		count = 1;
+	}
+
+	gameLocal.clip.RecordQueries(count);
+	gameLocal.Printf("recording the next %d clip queries\n", count);
+}
+
+/*
+==================
+Cmd_TestClipQueries_f
+==================
+*/
+void Cmd_TestClipQueries_f(const idCmdArgs &args)
+{
+	int runs;
+
+	runs = (args.Argc() > 1) ? atoi(args.Argv(1)) : 10;
+
+	if (runs < 1) {
+		runs = 1;
+	}
+
+	gameLocal.clip.TestQueries(runs);
+}
+
+/*
+==================
+Cmd_ClipQueryCacheStats_f
+==================
+*/
+void Cmd_ClipQueryCacheStats_f(const idCmdArgs &args)
+{
+	if (!g_clipQueryCache.GetBool()) {
+		gameLocal.Printf("g_clipQueryCache is off\n");
+	}
+
+	gameLocal.clip.PrintQueryCacheStats();
+}
+
+/*
+==================
+Cmd_TestTranslations_f
+
+Traces a spread of points and player boxes from the view one at a time and
+batched, and reports differences in the results and the time they take.
+==================
+*/
+void Cmd_TestTranslations_f(const idCmdArgs &args)
+{
+	int							i, count, differ;
+	idPlayer					*player;
+	idVec3						origin, dir;
+	idMat3						axis;
+	idRandom					random;
+	idList<clipTranslation_t>	translations;
+	idList<trace_t>				results;
+	idTimer						timer;
+	double						singleTime, batchTime;
+
+	player = gameLocal.GetLocalPlayer();
+
+	if (!player || !gameLocal.CheatsOk()) {
+		return;
+	}
+
+	count = (args.Argc() > 1) ? atoi(args.Argv(1)) : 64;
+	count = idMath::ClampInt(1, MAX_GENTITIES, count);
+
+	player->GetViewPos(origin, axis);
+
+	translations.SetNum(count);
+	results.SetNum(count);
+
+	for (i = 0; i < count; i++) {
+		dir = axis[0] + axis[1] * (random.CRandomFloat() * 0.3f) + axis[2] * (random.CRandomFloat() * 0.3f);
+		dir.Normalize();
+
+		translations[i].start = origin;
+		translations[i].end = origin + dir * 2048.0f;
+		translations[i].mdl = (i & 1) ? player->GetPhysics()->GetClipModel() : NULL;
+		translations[i].trmAxis = mat3_identity;
+		translations[i].contentMask = MASK_SHOT_RENDERMODEL;
+		translations[i].passEntity = player;
+	}
+
+	timer.Clear();
+	timer.Start();
+
+	for (i = 0; i < count; i++) {
+		gameLocal.clip.Translation(results[i], translations[i].start, translations[i].end, translations[i].mdl,
+		                           translations[i].trmAxis, translations[i].contentMask, translations[i].passEntity);
+	}
+
+	timer.Stop();
+	singleTime = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	gameLocal.clip.Translations(translations.Ptr(), count);
+	timer.Stop();
+	batchTime = timer.Milliseconds();
+
+	differ = 0;
+
+	for (i = 0; i < count; i++) {
+		if (results[i].fraction != translations[i].results.fraction || results[i].c.entityNum != translations[i].results.c.entityNum) {
+			differ++;
+		}
+	}
+
+	gameLocal.Printf("%d translations: one at a time %.2f msec, batched %.2f msec%s\n", count, singleTime, batchTime,
+	                 differ ? va(", %d RESULTS DIFFER", differ) : "");
+}
+
 /*
 ==================
 KillEntities
@@ -1589,6 +1881,16 @@ static void Cmd_ReloadAnims_f(const idCmdArgs &args)
 	animationLib.ReloadAnims();
 }
 
+/*
+==================
+Cmd_TestAnimCompression_f
+==================
+*/
+static void Cmd_TestAnimCompression_f(const idCmdArgs &args)
+{
+	animationLib.TestCompression();
+}
+
 /*
 ==================
 Cmd_ListAnims_f
@@ -2603,6 +2905,7 @@ void idGameLocal::InitConsoleCommands(void)
 	cmdSystem->AddCommand("testSaveGame",			TestSaveGame_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"test a save game for a level");
 	cmdSystem->AddCommand("game_memory",			idClass::DisplayInfo_f,		CMD_FL_GAME,				"displays game class info");
 	cmdSystem->AddCommand("listClasses",			idClass::ListClasses_f,		CMD_FL_GAME,				"lists game classes");
+	cmdSystem->AddCommand("showGameDictMemory",	idDict::ShowMemoryUsage_f,	CMD_FL_GAME,				"shows memory used by dictionaries of the game");
 	cmdSystem->AddCommand("listThreads",			idThread::ListThreads_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"lists script threads");
 	cmdSystem->AddCommand("listEntities",			Cmd_EntityList_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"lists game entities");
 	cmdSystem->AddCommand("listActiveEntities",	Cmd_ActiveEntityList_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists active game entities");
@@ -2654,12 +2957,20 @@ void idGameLocal::InitConsoleCommands(void)
 	cmdSystem->AddCommand("prevFrame",				idTestModel::TestModelPrevFrame_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"shows previous animation frame on test model");
 	cmdSystem->AddCommand("testBlend",				idTestModel::TestBlend_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests animation blending");
 	cmdSystem->AddCommand("reloadScript",			Cmd_ReloadScript_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads scripts");
+	cmdSystem->AddCommand("testScriptCache",		Cmd_TestScriptCache_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"compares the compiled scripts with the ones restored from the script cache");
 	cmdSystem->AddCommand("script",				Cmd_Script_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"executes a line of script");
+	cmdSystem->AddCommand("testScriptSpeed",		Cmd_TestScriptSpeed_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"runs a synthetic script and reports the speed of the script interpreter");
+	cmdSystem->AddCommand("testEventSpeed",		Cmd_TestEventSpeed_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"calls script events on the world entity and reports the event dispatch speed");
+	cmdSystem->AddCommand("recordClipQueries",	Cmd_RecordClipQueries_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"records the bounds of the next clip model queries for testClipQueries");
+	cmdSystem->AddCommand("testClipQueries",		Cmd_TestClipQueries_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"replays the recorded clip model queries and reports their speed");
+	cmdSystem->AddCommand("testTranslations",		Cmd_TestTranslations_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"traces from the view one at a time and batched and compares the results");
+	cmdSystem->AddCommand("clipQueryCacheStats",	Cmd_ClipQueryCacheStats_f,	CMD_FL_GAME,				"prints and resets the clip query cache hits per type of pass entity");
 	cmdSystem->AddCommand("listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models");
 	cmdSystem->AddCommand("collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info");
 	cmdSystem->AddCommand("reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile);
 	cmdSystem->AddCommand("reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations");
 	cmdSystem->AddCommand("listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations");
+	cmdSystem->AddCommand("testAnimCompression",	Cmd_TestAnimCompression_f,	CMD_FL_GAME,				"compares compressed animations with their float frames");
 	cmdSystem->AddCommand("aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats");
 	cmdSystem->AddCommand("testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF>);
 	cmdSystem->AddCommand("weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"projects a blood splat on the player weapon");
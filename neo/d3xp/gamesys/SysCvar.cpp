@@ -133,8 +133,20 @@ idCVar g_skipFX("g_skipFX",					"0",			CVAR_GAME | CVAR_BOOL, "");
 idCVar g_skipParticles("g_skipParticles",			"0",			CVAR_GAME | CVAR_BOOL, "");
 
 idCVar g_disasm("g_disasm",					"0",			CVAR_GAME | CVAR_BOOL, "disassemble script into base/script/disasm.txt on the local drive when script is compiled");
+idCVar g_scriptCache("g_scriptCache",			"1",			CVAR_GAME | CVAR_BOOL, "load the compiled default script from base/scriptcache when none of its files changed");
+idCVar g_eventThunks("g_eventThunks",			"1",			CVAR_GAME | CVAR_BOOL, "call script events through the type specialized thunks instead of the generic formatspec switch");
 idCVar g_debugBounds("g_debugBounds",			"0",			CVAR_GAME | CVAR_BOOL, "checks for models with bounds > 2048");
+idCVar g_parallelThink("g_parallelThink",		"1",			CVAR_GAME | CVAR_BOOL, "build the animation frames of visible entities on the job threads at the end of the game frame");
+idCVar g_parallelThinkCheck("g_parallelThinkCheck",	"0",			CVAR_GAME | CVAR_BOOL, "redo the parallel entity think serially and report entities with different results");
 idCVar g_debugAnim("g_debugAnim",				"-1",			CVAR_GAME | CVAR_INTEGER, "displays information on which animations are playing on the specified entity number.  set to -1 to disable.");
+idCVar g_animLOD("g_animLOD",					"1",			CVAR_GAME | CVAR_BOOL, "blend fewer joints and update the pose less often for animated models far away from all players");
+idCVar g_animLODDistance("g_animLODDistance",		"512",			CVAR_GAME | CVAR_FLOAT, "distance beyond which only the essential joints of animated models are blended");
+idCVar g_animLODScreenSize("g_animLODScreenSize",	"0.04",			CVAR_GAME | CVAR_FLOAT, "ratio of model radius to distance below which the pose of animated models is updated at a reduced rate");
+idCVar g_animLODInterval("g_animLODInterval",		"100",			CVAR_GAME | CVAR_INTEGER, "milliseconds between pose updates of animated models at the lowest level of detail", 0, 1000);
+idCVar g_animLODBoneLength("g_animLODBoneLength",	"4",			CVAR_GAME | CVAR_FLOAT, "joints with only bones shorter than this in their sub-tree are not blended at a reduced level of detail, unless gameplay uses them");
+idCVar g_animCompress("g_animCompress",				"1",			CVAR_GAME | CVAR_BOOL, "store animation frames as 16 bit components quantized over the range of each component, takes effect on reloadanims");
+idCVar g_animCompressTranslationError("g_animCompressTranslationError",	"0.05",	CVAR_GAME | CVAR_FLOAT, "largest joint translation error allowed for a compressed animation, in units");
+idCVar g_animCompressRotationError("g_animCompressRotationError",	"0.1",	CVAR_GAME | CVAR_FLOAT, "largest joint rotation error allowed for a compressed animation, in degrees");
 idCVar g_debugMove("g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "");
 idCVar g_debugDamage("g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "");
 idCVar g_debugWeapon("g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "");
@@ -159,6 +171,15 @@ idCVar g_showTriggers("g_showTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "draws t
 idCVar g_showCollisionWorld("g_showCollisionWorld",		"0",			CVAR_GAME | CVAR_BOOL, "");
 idCVar g_showCollisionModels("g_showCollisionModels",	"0",			CVAR_GAME | CVAR_BOOL, "");
 idCVar g_showCollisionTraces("g_showCollisionTraces",	"0",			CVAR_GAME | CVAR_BOOL, "");
+idCVar g_clipQueryCache("g_clipQueryCache",		"0",			CVAR_GAME | CVAR_BOOL, "reuse the results of identical traces and contents tests until the end of the frame or until a clip model changes");
+idCVar g_physicsLOD("g_physicsLOD",				"0",			CVAR_GAME | CVAR_BOOL, "simulate rigid bodies and articulated figures far away from or invisible to all players at a reduced frequency");
+idCVar g_physicsLODDistance("g_physicsLODDistance",	"1024",			CVAR_GAME | CVAR_FLOAT, "distance beyond which physics objects in the player PVS are simulated at a reduced frequency");
+idCVar g_physicsLODFreezeDistance("g_physicsLODFreezeDistance", "2048",	CVAR_GAME | CVAR_FLOAT, "distance beyond which physics objects outside the player PVS are put to rest early");
+idCVar g_physicsLODFreezeVelocity("g_physicsLODFreezeVelocity", "16",	CVAR_GAME | CVAR_FLOAT, "linear velocity below which physics objects that are put to rest early come to rest");
+idCVar g_physicsLODFreezeAngularVelocity("g_physicsLODFreezeAngularVelocity", "0.5", CVAR_GAME | CVAR_FLOAT, "angular velocity below which physics objects that are put to rest early come to rest");
+idCVar g_physicsLODInterval("g_physicsLODInterval",	"50",			CVAR_GAME | CVAR_INTEGER, "milliseconds between simulation frames at a reduced physics level of detail", 0, 1000);
+idCVar g_physicsLODWakeTime("g_physicsLODWakeTime",	"1000",			CVAR_GAME | CVAR_INTEGER, "milliseconds a physics object is simulated at full rate after an impulse or collision");
+idCVar g_showPhysicsLOD("g_showPhysicsLOD",			"0",			CVAR_GAME | CVAR_BOOL, "print the number of physics objects at each level of detail every frame");
 idCVar g_maxShowDistance("g_maxShowDistance",		"128",			CVAR_GAME | CVAR_FLOAT, "");
 idCVar g_showEntityInfo("g_showEntityInfo",			"0",			CVAR_GAME | CVAR_BOOL, "");
 idCVar g_showviewpos("g_showviewpos",			"0",			CVAR_GAME | CVAR_BOOL, "");
@@ -198,6 +219,8 @@ idCVar ai_showCombatNodes("ai_showCombatNodes",		"0",			CVAR_GAME | CVAR_BOOL, "
 idCVar ai_showPaths("ai_showPaths",				"0",			CVAR_GAME | CVAR_BOOL, "draws path_* entities");
 idCVar ai_showObstacleAvoidance("ai_showObstacleAvoidance",	"0",			CVAR_GAME | CVAR_INTEGER, "draws obstacle avoidance information for monsters.  if 2, draws obstacles for player, as well", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2>);
 idCVar ai_blockedFailSafe("ai_blockedFailSafe",		"1",			CVAR_GAME | CVAR_BOOL, "enable blocked fail safe handling");
+idCVar ai_asyncPaths("ai_asyncPaths",				"1",			CVAR_GAME | CVAR_BOOL, "queue monster move paths for the job threads and reuse the result from the previous frame");
+idCVar ai_asyncPathMaxAge("ai_asyncPathMaxAge",		"100",			CVAR_GAME | CVAR_INTEGER, "age in milliseconds after which monsters queue their path again even when their areas did not change", 0, 1000);
 
 #ifdef _D3XP
 idCVar ai_showHealth("ai_showHealth",			"0",			CVAR_GAME | CVAR_BOOL, "Draws the AI's health above its head");
@@ -282,6 +305,7 @@ idCVar af_showInertia("af_showInertia",			"0",			CVAR_GAME | CVAR_BOOL, "show th
 idCVar af_showVelocity("af_showVelocity",			"0",			CVAR_GAME | CVAR_BOOL, "show the velocity of each body");
 idCVar af_showActive("af_showActive",			"0",			CVAR_GAME | CVAR_BOOL, "show tree-like structures of articulated figures not at rest");
 idCVar af_testSolid("af_testSolid",				"1",			CVAR_GAME | CVAR_BOOL, "test for bodies initially stuck in solid");
+idCVar af_testSolver("af_testSolver",			"0",			CVAR_GAME | CVAR_BOOL, "solve the auxiliary constraints of articulated figures again with the generic SIMD code and print the difference");
 
 idCVar rb_showTimings("rb_showTimings",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid body cpu usage");
 idCVar rb_showBodies("rb_showBodies",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid bodies");
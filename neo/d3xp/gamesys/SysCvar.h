@@ -49,8 +49,20 @@ extern idCVar	g_doubleVision;
 extern idCVar	g_muzzleFlash;
 
 extern idCVar	g_disasm;
+extern idCVar	g_scriptCache;
+extern idCVar	g_eventThunks;
 extern idCVar	g_debugBounds;
+extern idCVar	g_parallelThink;
+extern idCVar	g_parallelThinkCheck;
 extern idCVar	g_debugAnim;
+extern idCVar	g_animLOD;
+extern idCVar	g_animLODDistance;
+extern idCVar	g_animLODScreenSize;
+extern idCVar	g_animLODInterval;
+extern idCVar	g_animLODBoneLength;
+extern idCVar	g_animCompress;
+extern idCVar	g_animCompressTranslationError;
+extern idCVar	g_animCompressRotationError;
 extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
@@ -73,6 +85,15 @@ extern idCVar	g_showTriggers;
 extern idCVar	g_showCollisionWorld;
 extern idCVar	g_showCollisionModels;
 extern idCVar	g_showCollisionTraces;
+extern idCVar	g_clipQueryCache;
+extern idCVar	g_physicsLOD;
+extern idCVar	g_physicsLODDistance;
+extern idCVar	g_physicsLODFreezeDistance;
+extern idCVar	g_physicsLODFreezeVelocity;
+extern idCVar	g_physicsLODFreezeAngularVelocity;
+extern idCVar	g_physicsLODInterval;
+extern idCVar	g_physicsLODWakeTime;
+extern idCVar	g_showPhysicsLOD;
 extern idCVar	g_maxShowDistance;
 extern idCVar	g_showEntityInfo;
 extern idCVar	g_showviewpos;
@@ -92,6 +113,8 @@ extern idCVar	ai_showCombatNodes;
 extern idCVar	ai_showPaths;
 extern idCVar	ai_showObstacleAvoidance;
 extern idCVar	ai_blockedFailSafe;
+extern idCVar	ai_asyncPaths;
+extern idCVar	ai_asyncPathMaxAge;
 #ifdef _D3XP
 extern idCVar	ai_showHealth;
 #endif
@@ -158,6 +181,7 @@ extern idCVar	af_showInertia;
 extern idCVar	af_showVelocity;
 extern idCVar	af_showActive;
 extern idCVar	af_testSolid;
+extern idCVar	af_testSolver;
 
 extern idCVar	rb_showTimings;
 extern idCVar	rb_showBodies;
@@ -73,7 +73,7 @@ class idClipModel
 
 		void					Link(idClip &clp);				// must have been linked with an entity and id before
 		void					Link(idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1);
-		void					Unlink(void);						// unlink from sectors
+		void					Unlink(void);						// unlink from the clip tree
 		void					SetPosition(const idVec3 &newOrigin, const idMat3 &newAxis);	// unlinks the clip model
 		void					Translate(const idVec3 &translation);							// unlinks the clip model
 		void					Rotate(const idRotation &rotation);							// unlinks the clip model
@@ -124,11 +124,12 @@ class idClipModel
 		int						traceModelIndex;		// trace model used for collision detection
 		int						renderModelHandle;		// render model def handle
 
-		struct clipLink_s 		*clipLinks;				// links into sectors
-		int						touchCount;
+		idClip 					*clipTree;				// clip tree the model has a leaf in
+		int						clipNode;				// leaf in the clip tree, kept until the frame after an unlink so relinking nearby is cheap
+		bool					linked;					// true if the model is found by clip queries
 
 		void					Init(void);			// initialize
-		void					Link_r(struct clipSector_s *node);
+		void					QueryStateChanged(void);	// drops cached query results that may depend on this model
 
 		static int				AllocTraceModel(const idTraceModel &trm);
 		static void				FreeTraceModel(int traceModelIndex);
@@ -153,16 +154,19 @@ ID_INLINE void idClipModel::Rotate(const idRotation &rotation)
 ID_INLINE void idClipModel::Enable(void)
 {
 	enabled = true;
+	QueryStateChanged();
 }
 
 ID_INLINE void idClipModel::Disable(void)
 {
 	enabled = false;
+	QueryStateChanged();
 }
 
 ID_INLINE void idClipModel::SetMaterial(const idMaterial *m)
 {
 	material = m;
+	QueryStateChanged();
 }
 
 ID_INLINE const idMaterial *idClipModel::GetMaterial(void) const
@@ -173,6 +177,7 @@ ID_INLINE const idMaterial *idClipModel::GetMaterial(void) const
 ID_INLINE void idClipModel::SetContents(int newContents)
 {
 	contents = newContents;
+	QueryStateChanged();
 }
 
 ID_INLINE int idClipModel::GetContents(void) const
@@ -183,6 +188,7 @@ ID_INLINE int idClipModel::GetContents(void) const
 ID_INLINE void idClipModel::SetEntity(idEntity *newEntity)
 {
 	entity = newEntity;
+	QueryStateChanged();
 }
 
 ID_INLINE idEntity *idClipModel::GetEntity(void) const
@@ -193,6 +199,7 @@ ID_INLINE idEntity *idClipModel::GetEntity(void) const
 ID_INLINE void idClipModel::SetId(int newId)
 {
 	id = newId;
+	QueryStateChanged();
 }
 
 ID_INLINE int idClipModel::GetId(void) const
@@ -203,6 +210,7 @@ ID_INLINE int idClipModel::GetId(void) const
 ID_INLINE void idClipModel::SetOwner(idEntity *newOwner)
 {
 	owner = newOwner;
+	QueryStateChanged();
 }
 
 ID_INLINE idEntity *idClipModel::GetOwner(void) const
@@ -242,7 +250,7 @@ ID_INLINE bool idClipModel::IsTraceModel(void) const
 
 ID_INLINE bool idClipModel::IsLinked(void) const
 {
-	return (clipLinks != NULL);
+	return linked;
 }
 
 ID_INLINE bool idClipModel::IsEnabled(void) const
@@ -271,6 +279,51 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel(void) const
 //
 //===============================================================
 
+// node of the dynamic bounding box tree the clip models are linked into
+typedef struct clipNode_s {
+	idBounds				bounds;				// fattened bounds of the clip model, or the union of the children
+	int						parent;				// next free node while on the free list
+	int						children[2];		// -1 for leaves
+	int						height;				// 0 for leaves
+	idClipModel 			*clipModel;			// clip model of a leaf
+} clipNode_t;
+
+typedef struct clipQuery_s {
+	idBounds				bounds;
+	int						contentMask;
+} clipQuery_t;
+
+// Translation or Contents result kept until the end of the frame or until a clip model changes
+typedef struct clipCachedQuery_s {
+	idVec3					start;
+	idVec3					end;				// same as start for contents
+	const idTraceModel 		*trm;
+	idMat3					trmAxis;
+	int						contentMask;
+	const idEntity 			*passEntity;
+	bool					contents;			// true for a Contents query
+	trace_t					results;			// results.c.contents holds the result of a Contents query
+} clipCachedQuery_t;
+
+// query cache counters per type of pass entity
+typedef struct clipQueryCacheStats_s {
+	int						translations;
+	int						translationHits;
+	int						contents;
+	int						contentsHits;
+} clipQueryCacheStats_t;
+
+// translation for a batch
+typedef struct clipTranslation_s {
+	trace_t					results;
+	idVec3					start;
+	idVec3					end;
+	const idClipModel 		*mdl;				// NULL for a point
+	idMat3					trmAxis;
+	int						contentMask;
+	const idEntity 			*passEntity;
+} clipTranslation_t;
+
 class idClip
 {
 
@@ -293,6 +346,8 @@ class idClip
 		                const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity);
 		int						Contents(const idVec3 &start,
 		                const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity);
+		// same results as calling Translation for each, the collision tests are spread over the job threads
+		void					Translations(clipTranslation_t *translations, int numTranslations);
 
 		// special case translations versus the rest of the world
 		bool					TracePoint(trace_t &results, const idVec3 &start, const idVec3 &end,
@@ -324,22 +379,46 @@ class idClip
 		// get entities/clip models within or touching the given bounds
 		int						EntitiesTouchingBounds(const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount) const;
 		int						ClipModelsTouchingBounds(const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount) const;
+		// walks the tree once for all bounds, the clip models touching bounds[i] are stored at clipModelList[i*maxCount]
+		void					ClipModelsTouchingBoundsBatch(const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int maxCount, int *counts) const;
 
 		const idBounds 		&GetWorldBounds(void) const;
 		idClipModel 			*DefaultClipModel(void);
 
 		// stats and debug drawing
 		void					PrintStatistics(void);
+		void					RecordQueries(int count);			// records the bounds of the next count ClipModelsTouchingBounds calls
+		void					TestQueries(int runs) const;		// replays the recorded queries and prints the time they take
 		void					DrawClipModels(const idVec3 &eye, const float radius, const idEntity *passEntity);
 		bool					DrawModelContactFeature(const contactInfo_t &contact, const idClipModel *clipModel, int lifetime) const;
 
+		// removes the leaves of clip models that stayed unlinked since the last call, called once a frame
+		void					RemoveUnlinkedLeaves(void);
+
+		// per frame cache of Translation and Contents results, used with g_clipQueryCache
+		void					ClearQueryCache(void);
+		void					PrintQueryCacheStats(void);
+
 	private:
-		int						numClipSectors;
-		struct clipSector_s 	*clipSectors;
+		idList<clipNode_t>		clipNodes;
+		int						rootNode;
+		int						freeNode;
+		bool					unlinkedLeaves;			// set when a clip model with a leaf is unlinked
 		idBounds				worldBounds;
 		idClipModel				temporaryClipModel;
 		idClipModel				defaultClipModel;
-		mutable int				touchCount;
+		mutable idList<clipQuery_t>	recordedQueries;
+		mutable int				numQueriesToRecord;
+		// scratch space for batched translations
+		idList<cm_translation_t>	batchTranslations;
+		idList<idClipModel *>	batchClipModels;
+		idList<int>				batchClipIndex;
+		idList<int>				batchFirst;
+		idList<int>				batchCount;
+		// query cache
+		idList<clipCachedQuery_t>	cachedQueries;
+		idHashIndex				cachedQueryHash;
+		idList<clipQueryCacheStats_t>	queryCacheStats;	// indexed by pass entity type number + 1
 		// statistics
 		int						numTranslations;
 		int						numRotations;
@@ -347,13 +426,32 @@ class idClip
 		int						numRenderModelTraces;
 		int						numContents;
 		int						numContacts;
+		int						numRelinks;
+		int						numReinserts;
+		int						numCachedQueries;
+		int						numCacheHits;
 
 	private:
-		struct clipSector_s 	*CreateClipSectors_r(const int depth, const idBounds &bounds, idVec3 &maxSector);
-		void					ClipModelsTouchingBounds_r(const struct clipSector_s *node, struct listParms_s &parms) const;
+		int						AllocNode(void);
+		void					FreeNode(int nodeNum);
+		void					InsertLeaf(int leaf);
+		void					RemoveLeaf(int leaf);
+		int						Balance(int nodeNum);
+		void					LinkClipModel(idClipModel *clipModel);
+		void					RemoveClipModel(idClipModel *clipModel);
 		const idTraceModel 	*TraceModelForClipModel(const idClipModel *mdl) const;
 		int						GetTraceClipModels(const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList) const;
 		void					TraceRenderModel(trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch) const;
+		int						AddBatchTranslation(const clipTranslation_t &translation, const idTraceModel *trm, const idClipModel *touch);
+		bool					TranslationUncached(trace_t &results, const idVec3 &start, const idVec3 &end,
+		                const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity);
+		int						ContentsUncached(const idVec3 &start,
+		                const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity);
+		clipCachedQuery_t 		*FindCachedQuery(bool contents, const idVec3 &start, const idVec3 &end, const idTraceModel *trm,
+		                const idMat3 &trmAxis, int contentMask, const idEntity *passEntity);
+		void					AddCachedQuery(bool contents, const idVec3 &start, const idVec3 &end, const idTraceModel *trm,
+		                const idMat3 &trmAxis, int contentMask, const idEntity *passEntity, const trace_t &results);
+		clipQueryCacheStats_t 	&QueryCacheStats(const idEntity *passEntity);
 };
 
 
@@ -370,6 +468,21 @@ ID_INLINE bool idClip::TraceBounds(trace_t &results, const idVec3 &start, const
 	return (results.fraction < 1.0f);
 }
 
+ID_INLINE void idClip::ClearQueryCache(void)
+{
+	if (cachedQueries.Num()) {
+		cachedQueries.SetNum(0, false);
+		cachedQueryHash.Clear();
+	}
+}
+
+ID_INLINE void idClipModel::QueryStateChanged(void)
+{
+	if (linked) {
+		clipTree->ClearQueryCache();
+	}
+}
+
 ID_INLINE const idBounds &idClip::GetWorldBounds(void) const
 {
 	return worldBounds;
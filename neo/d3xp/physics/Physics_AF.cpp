@@ -5375,6 +5375,58 @@ void idPhysics_AF::PrimaryForces(float timeStep)
 	}
 }
 
+/*
+================
+AF_TestAuxiliarySolver
+
+  Solves the auxiliary constraint system again with both the active and the generic
+  SIMD processor and prints the timings and the largest difference between the solutions.
+  Other threads may briefly run generic code while the processor is swapped, which is harmless.
+================
+*/
+static void AF_TestAuxiliarySolver(const char *name, idLCP *lcp, const idMatX &jmk, const idVecX &rhs, const idVecX &lo, const idVecX &hi, const int *boxIndex)
+{
+	idSIMDProcessor *processor;
+	idTimer timerSIMD, timerGeneric;
+	idVecX simdLm, genericLm;
+	float diff, maxDiff;
+	bool simdOk, genericOk;
+	int i;
+
+	simdLm.SetData(rhs.GetSize(), VECX_ALLOCA(rhs.GetSize()));
+	genericLm.SetData(rhs.GetSize(), VECX_ALLOCA(rhs.GetSize()));
+
+	timerSIMD.Start();
+	simdOk = lcp->Solve(jmk, simdLm, rhs, lo, hi, boxIndex);
+	timerSIMD.Stop();
+
+	processor = SIMDProcessor;
+	SIMDProcessor = idSIMD::GetGenericProcessor();
+	timerGeneric.Start();
+	genericOk = lcp->Solve(jmk, genericLm, rhs, lo, hi, boxIndex);
+	timerGeneric.Stop();
+	SIMDProcessor = processor;
+
+	if (!simdOk || !genericOk) {
+		gameLocal.Printf("%12s: aux %2d %s %s generic %s\n", name, rhs.GetSize(),
+		                 processor->GetName(), simdOk ? "ok" : "failed", genericOk ? "ok" : "failed");
+		return;
+	}
+
+	maxDiff = 0.0f;
+
+	for (i = 0; i < rhs.GetSize(); i++) {
+		diff = idMath::Fabs(simdLm[i] - genericLm[i]) / Max(1.0f, idMath::Fabs(genericLm[i]));
+
+		if (diff > maxDiff) {
+			maxDiff = diff;
+		}
+	}
+
+	gameLocal.Printf("%12s: aux %2d %s %1.4f generic %1.4f max diff %e\n", name, rhs.GetSize(),
+	                 processor->GetName(), timerSIMD.Milliseconds(), timerGeneric.Milliseconds(), maxDiff);
+}
+
 /*
 ================
 idPhysics_AF::AuxiliaryForces
@@ -5582,6 +5634,10 @@ void idPhysics_AF::AuxiliaryForces(float timeStep)
 	timer_lcp.Stop();
 #endif
 
+	if (af_testSolver.GetBool()) {
+		AF_TestAuxiliarySolver(self->name.c_str(), lcp, jmk, rhs, lo, hi, boxIndex);
+	}
+
 	// calculate auxiliary constraint forces
 	for (k = 0, i = 0; i < auxiliaryConstraints.Num(); i++) {
 		constraint = auxiliaryConstraints[i];
@@ -6401,6 +6457,46 @@ bool idPhysics_AF::TestIfAtRest(float timeStep)
 	return true;
 }
 
+/*
+================
+idPhysics_AF::TestIfFrozen
+
+  returns true if the figure may be put to rest early because of the physics level of detail
+================
+*/
+bool idPhysics_AF::TestIfFrozen(void) const
+{
+	int i;
+	float linearSqr, maxLinearSqr, angularSqr, maxAngularSqr;
+	idAFBody *body;
+
+	// only put to rest when resting on something
+	if (lod.level != PHYSICS_LOD_FROZEN || !contacts.Num()) {
+		return false;
+	}
+
+	maxLinearSqr = 0.0f;
+	maxAngularSqr = 0.0f;
+
+	for (i = 0; i < bodies.Num(); i++) {
+		body = bodies[i];
+
+		linearSqr = body->current->spatialVelocity.SubVec3(0).LengthSqr();
+
+		if (linearSqr > maxLinearSqr) {
+			maxLinearSqr = linearSqr;
+		}
+
+		angularSqr = body->current->spatialVelocity.SubVec3(1).LengthSqr();
+
+		if (angularSqr > maxAngularSqr) {
+			maxAngularSqr = angularSqr;
+		}
+	}
+
+	return idPhysicsLOD::CanFreeze(lod, idMath::Sqrt(maxLinearSqr), idMath::Sqrt(maxAngularSqr));
+}
+
 /*
 ================
 idPhysics_AF::Rest
@@ -6434,6 +6530,8 @@ void idPhysics_AF::Activate(void)
 		AddGravity();
 		// reset the active time for the max move time
 		current.activateTime = 0.0f;
+		// simulate at full rate for a while
+		idPhysicsLOD::Wake(lod);
 	}
 
 	current.atRest = -1;
@@ -6655,6 +6753,7 @@ idPhysics_AF::Evaluate
 bool idPhysics_AF::Evaluate(int timeStepMSec, int endTimeMSec)
 {
 	float timeStep;
+	int lodTimeStepMSec;
 
 	if (timeScaleRampStart < MS2SEC(endTimeMSec) && timeScaleRampEnd > MS2SEC(endTimeMSec)) {
 		timeStep = MS2SEC(timeStepMSec) * (MS2SEC(endTimeMSec) - timeScaleRampStart) / (timeScaleRampEnd - timeScaleRampStart);
@@ -6694,6 +6793,19 @@ bool idPhysics_AF::Evaluate(int timeStepMSec, int endTimeMSec)
 		return false;
 	}
 
+	// simulate at a reduced frequency when far away from or invisible to all players
+	lodTimeStepMSec = gameLocal.physicsLOD.Evaluate(self, GetAbsBounds(), lod, timeStepMSec);
+
+	if (lodTimeStepMSec <= 0) {
+		DebugDraw();
+		return false;
+	}
+
+	if (lodTimeStepMSec != timeStepMSec) {
+		timeStep *= (float) lodTimeStepMSec / timeStepMSec;
+		current.lastTimeStep = timeStep;
+	}
+
 	// move the af velocity into the frame of a pusher
 	AddPushVelocity(-current.pushVelocity);
 
@@ -6799,6 +6911,9 @@ bool idPhysics_AF::Evaluate(int timeStepMSec, int endTimeMSec)
 	// test if the simulation can be suspended because the whole figure is at rest
 	if (comeToRest && TestIfAtRest(timeStep)) {
 		Rest();
+	} else if (comeToRest && TestIfFrozen()) {
+		// far away from all players the figure is put to rest as soon as it hardly moves
+		Rest();
 	} else {
 		ActivateContactEntities();
 	}
@@ -7064,6 +7179,7 @@ idPhysics_AF::idPhysics_AF(void)
 
 	memset(&current, 0, sizeof(current));
 	current.atRest = -1;
+	idPhysicsLOD::ClearState(lod);
 	current.lastTimeStep = USERCMD_MSEC;
 	saved = current;
 
@@ -7948,6 +8064,7 @@ void idPhysics_AF::ApplyImpulse(const int id, const idVec3 &point, const idVec3
 	idMat3 invWorldInertiaTensor = bodies[id]->current->worldAxis.Transpose() * bodies[id]->inverseInertiaTensor * bodies[id]->current->worldAxis;
 	bodies[id]->current->spatialVelocity.SubVec3(0) += bodies[id]->invMass * impulse;
 	bodies[id]->current->spatialVelocity.SubVec3(1) += invWorldInertiaTensor * (point - bodies[id]->current->worldOrigin).Cross(impulse);
+	idPhysicsLOD::Wake(lod);
 	Activate();
 }
 
@@ -7968,6 +8085,7 @@ void idPhysics_AF::AddForce(const int id, const idVec3 &point, const idVec3 &for
 
 	bodies[id]->current->externalForce.SubVec3(0) += force;
 	bodies[id]->current->externalForce.SubVec3(1) += (point - bodies[id]->current->worldOrigin).Cross(force);
+	idPhysicsLOD::Wake(lod);
 	Activate();
 }
 
@@ -8488,6 +8606,7 @@ void idPhysics_AF::WriteToSnapshot(idBitMsgDelta &msg) const
 	msg.WriteLong(current.atRest);
 	msg.WriteFloat(current.noMoveTime);
 	msg.WriteFloat(current.activateTime);
+	idPhysicsLOD::WriteToSnapshot(msg, lod);
 	msg.WriteDeltaFloat(0.0f, current.pushVelocity[0], AF_VELOCITY_EXPONENT_BITS, AF_VELOCITY_MANTISSA_BITS);
 	msg.WriteDeltaFloat(0.0f, current.pushVelocity[1], AF_VELOCITY_EXPONENT_BITS, AF_VELOCITY_MANTISSA_BITS);
 	msg.WriteDeltaFloat(0.0f, current.pushVelocity[2], AF_VELOCITY_EXPONENT_BITS, AF_VELOCITY_MANTISSA_BITS);
@@ -8536,6 +8655,7 @@ void idPhysics_AF::ReadFromSnapshot(const idBitMsgDelta &msg)
 	current.atRest = msg.ReadLong();
 	current.noMoveTime = msg.ReadFloat();
 	current.activateTime = msg.ReadFloat();
+	idPhysicsLOD::ReadFromSnapshot(msg, lod);
 	current.pushVelocity[0] = msg.ReadDeltaFloat(0.0f, AF_VELOCITY_EXPONENT_BITS, AF_VELOCITY_MANTISSA_BITS);
 	current.pushVelocity[1] = msg.ReadDeltaFloat(0.0f, AF_VELOCITY_EXPONENT_BITS, AF_VELOCITY_MANTISSA_BITS);
 	current.pushVelocity[2] = msg.ReadDeltaFloat(0.0f, AF_VELOCITY_EXPONENT_BITS, AF_VELOCITY_MANTISSA_BITS);
@@ -0,0 +1,85 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __PHYSICS_LOD_H__
+#define __PHYSICS_LOD_H__
+
+/*
+===============================================================================
+
+  Physics level of detail.
+
+  Rigid bodies and articulated figures far away from all players or outside
+  the merged PVS of all players are simulated at a reduced frequency, and put
+  to rest early once they hardly move. Any impulse, force or collision wakes a
+  body up to full rate immediately. The server decides the level of detail
+  and sends it with the physics snapshot so clients step the same frames.
+
+===============================================================================
+*/
+
+typedef enum {
+	PHYSICS_LOD_FULL,			// simulated every game frame
+	PHYSICS_LOD_REDUCED,		// simulated at a reduced frequency
+	PHYSICS_LOD_FROZEN,			// simulated at a reduced frequency and put to rest early
+	PHYSICS_LOD_NUM
+} physicsLOD_t;
+
+typedef struct physicsLODState_s {
+	physicsLOD_t			level;					// current level of detail
+	int						time;					// game time in milliseconds not simulated yet
+	int						wakeTime;				// last time the body was woken up
+} physicsLODState_t;
+
+class idPhysicsLOD
+{
+	public:
+		// clear the per frame counts
+		void			Clear(void);
+		// clear the level of detail state of a physics object
+		static void		ClearState(physicsLODState_t &state);
+		// select the level of detail for a physics object and return the time step in milliseconds
+		// to simulate this frame, or zero if the simulation should be skipped this frame
+		int				Evaluate(idEntity *ent, const idBounds &absBounds, physicsLODState_t &state, const int timeStepMSec);
+		// simulate the physics object at full rate for a while
+		static void		Wake(physicsLODState_t &state);
+		// returns true if the physics object may be put to rest early
+		static bool		CanFreeze(const physicsLODState_t &state, const float linearVelocity, const float angularVelocity);
+		// networking
+		static void		WriteToSnapshot(idBitMsgDelta &msg, const physicsLODState_t &state);
+		static void		ReadFromSnapshot(const idBitMsgDelta &msg, physicsLODState_t &state);
+		// print the number of physics objects at each level of detail this frame
+		void			PrintStatistics(void) const;
+
+	private:
+		int				counts[PHYSICS_LOD_NUM];
+
+		physicsLOD_t	Select(idEntity *ent, const idBounds &absBounds, const physicsLODState_t &state) const;
+};
+
+#endif /* !__PHYSICS_LOD_H__ */
@@ -157,6 +157,7 @@ class idPhysics_RigidBody : public idPhysics_Base
 		// state of the rigid body
 		rigidBodyPState_t		current;
 		rigidBodyPState_t		saved;
+		physicsLODState_t		lod;						// physics level of detail
 
 		// rigid body properties
 		float					linearFriction;				// translational friction
@@ -190,6 +191,7 @@ class idPhysics_RigidBody : public idPhysics_Base
 		void					ContactFriction(float deltaTime);
 		void					DropToFloorAndRest(void);
 		bool					TestIfAtRest(void) const;
+		bool					TestIfFrozen(void) const;
 		void					Rest(void);
 		void					DebugDraw(void);
 };
@@ -194,6 +194,22 @@ enum {
 	NUM_OPCODES
 };
 
+// superinstructions, only created when the statements are decoded for the interpreter
+enum {
+	OP_LT_IFNOT = NUM_OPCODES,
+	OP_LE_IFNOT,
+	OP_GT_IFNOT,
+	OP_GE_IFNOT,
+	OP_EQ_F_IFNOT,
+	OP_NE_F_IFNOT,
+	OP_INDIRECT_F_IFNOT,
+	OP_INDIRECT_BOOL_IFNOT,
+	OP_INDIRECT_F_PUSH_F,
+	OP_INDIRECT_ENT_PUSH_ENT,
+
+	NUM_DECODED_OPCODES
+};
+
 class idCompiler
 {
 	private:
@@ -274,6 +290,11 @@ class idCompiler
 
 		idCompiler();
 		void			CompileFile(const char *text, const char *filename, bool console);
+
+		// all the files read by the last compile, including the files that only hold defines
+		const idList<idStr> &GetLoadedFiles(void) const {
+			return parser.GetLoadedFiles();
+		}
 };
 
 #endif /* !__SCRIPT_COMPILER_H__ */
@@ -64,10 +64,12 @@ class idInterpreter
 		void				PushVector(const idVec3 &vector);
 		void				Push(intptr_t value);
 		const char			*FloatToString(float value);
-		void				AppendString(idVarDef *def, const char *from);
-		void				SetString(idVarDef *def, const char *from);
+		void				AppendString(const scriptOperand_t &operand, const char *from);
+		void				SetString(const scriptOperand_t &operand, const char *from);
 		const char			*GetString(idVarDef *def);
+		const char			*GetString(const scriptOperand_t &operand);
 		varEval_t			GetVariable(idVarDef *def);
+		varEval_t			GetVariable(const scriptOperand_t &operand);
 		idEntity			*GetEntity(int entnum) const;
 		idScriptObject		*GetScriptObject(int entnum) const;
 		void				NextInstruction(int position);
@@ -82,6 +84,8 @@ class idInterpreter
 		bool				terminateOnExit;
 		bool				debug;
 
+		static int			executedStatements;		// statements dispatched by all interpreters, superinstructions count once
+
 		idInterpreter();
 
 		// save games
@@ -201,13 +205,9 @@ ID_INLINE const char *idInterpreter::FloatToString(float value)
 idInterpreter::AppendString
 ====================
 */
-ID_INLINE void idInterpreter::AppendString(idVarDef *def, const char *from)
+ID_INLINE void idInterpreter::AppendString(const scriptOperand_t &operand, const char *from)
 {
-	if (def->initialized == idVarDef::stackVariable) {
-		idStr::Append((char *)&localstack[ localstackBase + def->value.stackOffset ], MAX_STRING_LEN, from);
-	} else {
-		idStr::Append(def->value.stringPtr, MAX_STRING_LEN, from);
-	}
+	idStr::Append(GetVariable(operand).stringPtr, MAX_STRING_LEN, from);
 }
 
 /*
@@ -215,13 +215,9 @@ ID_INLINE void idInterpreter::AppendString(idVarDef *def, const char *from)
 idInterpreter::SetString
 ====================
 */
-ID_INLINE void idInterpreter::SetString(idVarDef *def, const char *from)
+ID_INLINE void idInterpreter::SetString(const scriptOperand_t &operand, const char *from)
 {
-	if (def->initialized == idVarDef::stackVariable) {
-		idStr::Copynz((char *)&localstack[ localstackBase + def->value.stackOffset ], from, MAX_STRING_LEN);
-	} else {
-		idStr::Copynz(def->value.stringPtr, from, MAX_STRING_LEN);
-	}
+	idStr::Copynz(GetVariable(operand).stringPtr, from, MAX_STRING_LEN);
 }
 
 /*
@@ -238,6 +234,16 @@ ID_INLINE const char *idInterpreter::GetString(idVarDef *def)
 	}
 }
 
+/*
+====================
+idInterpreter::GetString
+====================
+*/
+ID_INLINE const char *idInterpreter::GetString(const scriptOperand_t &operand)
+{
+	return GetVariable(operand).stringPtr;
+}
+
 /*
 ====================
 idInterpreter::GetVariable
@@ -254,6 +260,22 @@ ID_INLINE varEval_t idInterpreter::GetVariable(idVarDef *def)
 	}
 }
 
+/*
+====================
+idInterpreter::GetVariable
+====================
+*/
+ID_INLINE varEval_t idInterpreter::GetVariable(const scriptOperand_t &operand)
+{
+	if (operand.onStack) {
+		varEval_t val;
+		val.intPtr = (int *)&localstack[ localstackBase + operand.value.stackOffset ];
+		return val;
+	} else {
+		return operand.value;
+	}
+}
+
 /*
 ================
 idInterpreter::GetEntity
@@ -105,6 +105,8 @@ Contains type information for variables and functions.
 
 class idTypeDef
 {
+		friend class idProgram;
+
 	private:
 		etype_t						type;
 		idStr 						name;
@@ -466,6 +468,20 @@ typedef struct statement_s {
 	unsigned short	file;
 } statement_t;
 
+// statement operand with the value of its def resolved, stack variables keep their offset in the local stack
+typedef struct scriptOperand_s {
+	varEval_t		value;
+	bool			onStack;
+} scriptOperand_t;
+
+// statement decoded for the interpreter, op can be a superinstruction covering the next statement as well
+typedef struct decodedStatement_s {
+	unsigned short	op;
+	scriptOperand_t	a;
+	scriptOperand_t	b;
+	scriptOperand_t	c;
+} decodedStatement_t;
+
 /***********************************************************************
 
 idProgram
@@ -475,12 +491,18 @@ would represent seperate programs with no knowledge of each other.  Scripts
 meant to access shared data and functions should all be compiled by a
 single idProgram.
 
+The program compiled from the default script is written to a cache file
+with the checksums of every file read to compile it, including included
+files which only hold defines, and restored from the cache
+instead of compiled again while the sources stay the same.
+
 ***********************************************************************/
 
 class idProgram
 {
 	private:
 		idStrList									fileList;
+		idStrList									sourceFiles;		// every file read by the compiler
 		idStr 										filename;
 		int											filenum;
 
@@ -493,6 +515,7 @@ class idProgram
 		idList<idVarDefName *>						varDefNames;
 		idHashIndex									varDefNameHash;
 		idList<idVarDef *>							varDefs;
+		idList<decodedStatement_t>					decodedStatements;
 
 		idVarDef									*sysDef;
 
@@ -504,6 +527,14 @@ class idProgram
 
 		void										CompileStats(void);
 
+		// compiled program cache
+		int											TypeIndex(const idTypeDef *type) const;
+		int											DefIndex(const idVarDef *def) const;
+		bool										WriteCache(const char *defaultScript) const;
+		bool										ReadCache(const char *defaultScript);
+		void										Disassemble(idFile *file) const;
+		void										Dump(const char *fileName) const;
+
 	public:
 		idVarDef									*returnDef;
 		idVarDef									*returnStringDef;
@@ -527,6 +558,8 @@ class idProgram
 		void										DisassembleStatement(idFile *file, int instructionPointer) const;
 		void										Disassemble(void) const;
 		void										FreeData(void);
+		// compiles the default script, caches it and checks the program restored from the cache matches
+		bool										TestCache(const char *defaultScript);
 
 		const char									*GetFilename(int num);
 		int											GetFilenum(const char *name);
@@ -561,6 +594,9 @@ class idProgram
 			return statements.Num();
 		}
 
+		void										DecodeStatements(void);
+		const decodedStatement_t					&GetDecodedStatement(int index) const;
+
 		int 										GetReturnedInteger(void);
 
 		void										ReturnFloat(float value);
@@ -584,6 +620,16 @@ ID_INLINE statement_t &idProgram::GetStatement(int index)
 	return statements[ index ];
 }
 
+/*
+================
+idProgram::GetDecodedStatement
+================
+*/
+ID_INLINE const decodedStatement_t &idProgram::GetDecodedStatement(int index) const
+{
+	return decodedStatements[ index ];
+}
+
 /*
 ================
 idProgram::GetFunction
@@ -76,6 +76,7 @@ idCVar com_allowConsole("com_allowConsole", "1", CVAR_BOOL | CVAR_SYSTEM | CVAR_
 idCVar com_speeds("com_speeds", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "show engine timings");
 idCVar com_showFPS("com_showFPS", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_ARCHIVE|CVAR_NOCHEAT, "show frames rendered per second");
 idCVar com_showMemoryUsage("com_showMemoryUsage", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "show total and per frame memory usage");
+idCVar com_logMemTags("com_logMemTags", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "write the memory use of every allocation tag to memtags.csv each frame");
 idCVar com_showAsyncStats("com_showAsyncStats", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "show async network stats");
 idCVar com_showSoundDecoders("com_showSoundDecoders", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "show sound decoders");
 idCVar com_timestampPrints("com_timestampPrints", "0", CVAR_SYSTEM, "print time with each console print, 1 = msec, 2 = sec", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2>);
@@ -1304,6 +1305,124 @@ static void PrintMemInfo_f(const idCmdArgs &args)
 	fileSystem->CloseFile(f);
 }
 
+/*
+===============================================================================
+
+	Allocation tags
+
+	Totals of the engine and game heaps are sampled every frame for the
+	peaks, the rates are averaged over a second.
+
+===============================================================================
+*/
+
+static memTagStats_t	com_memTagStats[MEMTAG_NUM];
+static int				com_memTagPeak[MEMTAG_NUM];
+static unsigned int		com_memTagRateSize[MEMTAG_NUM];	// bytes allocated per second
+static unsigned int		com_memTagRateNum[MEMTAG_NUM];
+static memTagStats_t	com_memTagRateStart[MEMTAG_NUM];
+static int				com_memTagRateTime;
+static idFile			*com_memTagLog;
+
+/*
+==================
+Com_UpdateMemTags
+==================
+*/
+static void Com_UpdateMemTags(void)
+{
+	int i, time;
+
+	Mem_GetTagStats(com_memTagStats);
+
+	if (game) {
+		game->GetMemTagStats(com_memTagStats);
+	}
+
+	for (i = 0; i < MEMTAG_NUM; i++) {
+		com_memTagPeak[i] = Max(com_memTagPeak[i], com_memTagStats[i].size);
+	}
+
+	time = Sys_Milliseconds();
+
+	if (time - com_memTagRateTime >= 1000) {
+		for (i = 0; i < MEMTAG_NUM; i++) {
+			com_memTagRateSize[i] = (unsigned int)((double)(com_memTagStats[i].totalSize - com_memTagRateStart[i].totalSize) * 1000 / (time - com_memTagRateTime));
+			com_memTagRateNum[i] = (unsigned int)((double)(com_memTagStats[i].totalNum - com_memTagRateStart[i].totalNum) * 1000 / (time - com_memTagRateTime));
+		}
+
+		memcpy(com_memTagRateStart, com_memTagStats, sizeof(com_memTagRateStart));
+		com_memTagRateTime = time;
+	}
+
+	if (!com_logMemTags.GetBool()) {
+		if (com_memTagLog) {
+			fileSystem->CloseFile(com_memTagLog);
+			com_memTagLog = NULL;
+		}
+
+		return;
+	}
+
+	if (!com_memTagLog) {
+		com_memTagLog = fileSystem->OpenFileWrite("memtags.csv");
+
+		if (!com_memTagLog) {
+			com_logMemTags.SetBool(false);
+			return;
+		}
+
+		com_memTagLog->Printf("frame,msec");
+
+		for (i = 0; i < MEMTAG_NUM; i++) {
+			com_memTagLog->Printf(",%s kB,%s allocs", Mem_GetTagName((memTag_t)i), Mem_GetTagName((memTag_t)i));
+		}
+
+		com_memTagLog->Printf("\n");
+	}
+
+	com_memTagLog->Printf("%d,%d", com_frameNumber, time);
+
+	for (i = 0; i < MEMTAG_NUM; i++) {
+		com_memTagLog->Printf(",%d,%d", com_memTagStats[i].size >> 10, com_memTagStats[i].num);
+	}
+
+	com_memTagLog->Printf("\n");
+}
+
+/*
+==================
+Com_MemTagStats_f
+==================
+*/
+static void Com_MemTagStats_f(const idCmdArgs &args)
+{
+	memTagStats_t total;
+	int i, totalPeak;
+
+	if (!idStr::Icmp(args.Argv(1), "resetPeaks")) {
+		memset(com_memTagPeak, 0, sizeof(com_memTagPeak));
+	}
+
+	Com_UpdateMemTags();
+
+	memset(&total, 0, sizeof(total));
+	totalPeak = 0;
+
+	common->Printf("tag          current kB   blocks    peak kB   kB/sec allocs/sec\n");
+	common->Printf("---------- ------------ -------- ---------- -------- ----------\n");
+
+	for (i = 0; i < MEMTAG_NUM; i++) {
+		common->Printf("%-10s %12d %8d %10d %8d %10d\n", Mem_GetTagName((memTag_t)i), com_memTagStats[i].size >> 10, com_memTagStats[i].num,
+		               com_memTagPeak[i] >> 10, com_memTagRateSize[i] >> 10, com_memTagRateNum[i]);
+		total.size += com_memTagStats[i].size;
+		total.num += com_memTagStats[i].num;
+		totalPeak += com_memTagPeak[i];
+	}
+
+	common->Printf("%-10s %12d %8d %10d\n", "total", total.size >> 10, total.num, totalPeak >> 10);
+}
+
 #ifdef ID_ALLOW_TOOLS
 /*
 ==================
@@ -2543,12 +2662,18 @@ void idCommonLocal::InitCommands(void)
 #endif
 
 	cmdSystem->AddCommand("printMemInfo", PrintMemInfo_f, CMD_FL_SYSTEM, "prints memory debugging data");
+	cmdSystem->AddCommand("memTagStats", Com_MemTagStats_f, CMD_FL_SYSTEM, "prints current, peak and allocation rate of memory per allocation tag, resetPeaks clears the peaks");
 
 	// idLib commands
 	cmdSystem->AddCommand("memoryDump", Mem_Dump_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a memory dump");
 	cmdSystem->AddCommand("memoryDumpCompressed", Mem_DumpCompressed_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a compressed memory dump");
+	cmdSystem->AddCommand("testHeap", Mem_TestHeap_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "measures allocation speed of the heaps from several threads");
+	cmdSystem->AddCommand("listLevelArenas", idLevelArena::List_f, CMD_FL_SYSTEM, "lists the level arenas with used and wasted memory and how long the last release took");
 	cmdSystem->AddCommand("showStringMemory", idStr::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by strings");
+	cmdSystem->AddCommand("testMoves", idStr::TestMoves_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "counts string allocations of list growth with strings, dicts and vertices");
 	cmdSystem->AddCommand("showDictMemory", idDict::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by dictionaries");
+	cmdSystem->AddCommand("testDictKeys", idDict::TestKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares dictionary lookups by text and by interned key");
+	cmdSystem->AddCommand("tokenCacheStats", idLexer::TokenCacheStats_f, CMD_FL_SYSTEM, "shows how many scripts were replayed from the token cache");
 	cmdSystem->AddCommand("listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries");
 	cmdSystem->AddCommand("listDictValues", idDict::ListValues_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all values used by dictionaries");
 	cmdSystem->AddCommand("testSIMD", idSIMD::Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "test SIMD code");
@@ -2669,6 +2794,8 @@ void idCommonLocal::Frame(void)
 			time_gameDraw = 0;
 		}
 
+		Com_UpdateMemTags();
+
 		com_frameNumber++;
 
 		// set idLib frame number for frame based memory dumps
@@ -3319,6 +3446,11 @@ void idCommonLocal::ShutdownGame(bool reloading)
 #ifdef DEBUG
 	DumpWarnings();
 #endif
+	if (com_memTagLog) {
+		fileSystem->CloseFile(com_memTagLog);
+		com_memTagLog = NULL;
+	}
+
 	// only shut down the log file after all output is done
 	CloseLogFile();
 
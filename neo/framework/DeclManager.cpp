@@ -210,6 +210,8 @@ class idDeclManagerLocal : public idDeclManager
 
 		virtual void				MediaPrint(const char *fmt, ...) id_attribute((format(printf,2,3)));
 		virtual void				WritePrecacheCommands(idFile *f);
+		virtual void				StartRecordingDecls(void);
+		virtual void				StopRecordingDecls(idList<const idDecl *> &decls);
 
 		virtual const idMaterial 		*FindMaterial(const char *name, bool makeDefault = true);
 		virtual const idDeclSkin 		*FindSkin(const char *name, bool makeDefault = true);
@@ -243,6 +245,8 @@ class idDeclManagerLocal : public idDeclManager
 		int							checksum;		// checksum of all loaded decl text
 		int							indent;			// for MediaPrint
 		bool						insideLevelLoad;
+		bool						recordingDecls;
+		idList<const idDecl *>		recordedDecls;	// first referenced this level, in order
 
 		static idCVar				decl_show;
 
@@ -653,6 +657,7 @@ int idDeclFile::LoadAndParse()
 	idStr		name;
 	idDeclLocal *newDecl;
 	bool		reparse;
+	idScopedMemTag	memTag(MEMTAG_DECLS);
 
 	// load the text
 	common->DPrintf("...loading '%s'\n", fileName.c_str());
@@ -845,6 +850,7 @@ void idDeclManagerLocal::Init(void)
 	common->Printf("----- Initializing Decls -----\n");
 
 	checksum = 0;
+	recordingDecls = false;
 
 #ifdef USE_COMPRESSED_DECLS
 	SetupHuffman();
@@ -925,6 +931,9 @@ void idDeclManagerLocal::Shutdown(void)
 	int			i, j;
 	idDeclLocal *decl;
 
+	recordedDecls.Clear();
+	recordingDecls = false;
+
 	// free decls
 	for (i = 0; i < DECL_MAX_TYPES; i++) {
 		for (j = 0; j < linearLists[i].Num(); j++) {
@@ -1209,6 +1218,10 @@ const idDecl *idDeclManagerLocal::FindType(declType_t type, const char *name, bo
 		decl->ParseLocal();
 	}
 
+	if (recordingDecls && !decl->referencedThisLevel) {
+		recordedDecls.Append(decl->self);
+	}
+
 	// mark it as referenced
 	decl->referencedThisLevel = true;
 	decl->everReferenced = true;
@@ -1628,6 +1641,29 @@ void idDeclManagerLocal::WritePrecacheCommands(idFile *f)
 	}
 }
 
+/*
+===================
+idDeclManagerLocal::StartRecordingDecls
+===================
+*/
+void idDeclManagerLocal::StartRecordingDecls(void)
+{
+	recordedDecls.Clear();
+	recordingDecls = true;
+}
+
+/*
+===================
+idDeclManagerLocal::StopRecordingDecls
+===================
+*/
+void idDeclManagerLocal::StopRecordingDecls(idList<const idDecl *> &decls)
+{
+	decls = recordedDecls;
+	recordedDecls.Clear();
+	recordingDecls = false;
+}
+
 /********************************************************************/
 
 const idMaterial *idDeclManagerLocal::FindMaterial(const char *name, bool makeDefault)
@@ -2326,6 +2362,7 @@ idDeclLocal::ParseLocal
 void idDeclLocal::ParseLocal(void)
 {
 	bool generatedDefaultText = false;
+	idScopedMemTag	memTag(MEMTAG_DECLS);
 
 	AllocateSelf();
 
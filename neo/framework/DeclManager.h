@@ -364,6 +364,11 @@ class idDeclManager
 
 		virtual void			WritePrecacheCommands(idFile *f) = 0;
 
+		// Notes every decl referenced for the first time this level until StopRecordingDecls,
+		// the decls are listed in the order they were first referenced.
+		virtual void			StartRecordingDecls(void) = 0;
+		virtual void			StopRecordingDecls(idList<const idDecl *> &decls) = 0;
+
 		// Convenience functions for specific types.
 		virtual	const idMaterial 		*FindMaterial(const char *name, bool makeDefault = true) = 0;
 		virtual const idDeclSkin 		*FindSkin(const char *name, bool makeDefault = true) = 0;
@@ -957,6 +957,38 @@ void idFile_Memory::SetData(const char *data, int length)
 }
 
 
+/*
+=================================================================================
+
+idFile_Mapped
+
+=================================================================================
+*/
+
+/*
+=================
+idFile_Mapped::idFile_Mapped
+=================
+*/
+idFile_Mapped::idFile_Mapped(const char *name, const char *fullPath, const char *data, int length) : idFile_Memory(name, data, length)
+{
+	this->fullPath = fullPath;
+	ownsMapping = true;
+}
+
+/*
+=================
+idFile_Mapped::~idFile_Mapped
+=================
+*/
+idFile_Mapped::~idFile_Mapped(void)
+{
+	if (ownsMapping) {
+		Sys_UnmapFile(GetDataPtr(), Length());
+	}
+}
+
+
 /*
 =================================================================================
 
@@ -1347,6 +1379,8 @@ idFile_InZip::idFile_InZip(void)
 	zipFilePos = 0;
 	fileSize = 0;
 	memset(&z, 0, sizeof(z));
+	mappedSource = NULL;
+	mappedSourceLength = 0;
 }
 
 /*
@@ -1358,6 +1392,7 @@ idFile_InZip::~idFile_InZip(void)
 {
 	unzCloseCurrentFile(z);
 	unzClose(z);
+	Sys_UnmapFile(mappedSource, mappedSourceLength);
 }
 
 /*
@@ -168,6 +168,24 @@ class idFile_Memory : public idFile
 };
 
 
+class idFile_Mapped : public idFile_Memory
+{
+		friend class			idFileSystemLocal;
+
+	public:
+		idFile_Mapped(const char *name, const char *fullPath, const char *data, int length);	// takes over the mapping
+		virtual					~idFile_Mapped(void);
+
+		virtual const char 	*GetFullPath(void) {
+			return fullPath.c_str();
+		}
+
+	private:
+		idStr					fullPath;		// full file path including pak file name
+		bool					ownsMapping;	// unmapped when the file is closed
+};
+
+
 class idFile_BitMsg : public idFile
 {
 		friend class			idFileSystemLocal;
@@ -266,6 +284,8 @@ class idFile_InZip : public idFile
 		int						zipFilePos;		// zip file info position in pak
 		int						fileSize;		// size of the file
 		void 					*z;				// unzip info
+		const void 			*mappedSource;	// mapping of the compressed data, NULL if read from the pak
+		int						mappedSourceLength;
 };
 
 #endif /* !__FILE_H__ */
@@ -262,10 +262,16 @@ static idInitExclusions	initExclusions;
 
 #define MAX_ZIPPED_FILE_NAME	2048
 #define FILE_HASH_SIZE			1024
+#define FS_MAP_MIN_SIZE			( 32 * 1024 )	// pak entries with less data than this are read instead of mapped
 
 typedef struct fileInPack_s {
 	idStr				name;						// name of the file
 	unsigned long		pos;						// file info position in zip
+	unsigned long		offset;						// local header position in zip
+	int					size;						// uncompressed size
+	int					compressedSize;
+	int					compression;				// 0 if stored, Z_DEFLATED otherwise
+	bool				encrypted;
 	struct fileInPack_s *next;						// next file in the hash
 } fileInPack_t;
 
@@ -315,6 +321,66 @@ typedef struct searchpath_s {
 	struct searchpath_s *next;
 } searchpath_t;
 
+// one pak holding a file, the same file in later paks is chained through next
+typedef struct {
+	fileInPack_t 		*pakFile;
+	searchpath_t 		*search;
+	int					order;						// position of the search path
+	int					next;						// -1 if no other pak holds the file
+} fileIndexEntry_t;
+
+typedef struct {
+	const char 		*name;						// lower case, as stored in the paks
+	int					first;						// first entry in search order
+} fileIndexName_t;
+
+// each async read thread sleeps on its own event
+#define MAX_ASYNC_READ_THREADS	3
+
+static const int asyncReadEvents[MAX_ASYNC_READ_THREADS] = { TRIGGER_EVENT_TWO, TRIGGER_EVENT_FOUR, TRIGGER_EVENT_FIVE };
+static const char *asyncReadThreadNames[MAX_ASYNC_READ_THREADS] = { "asyncRead0", "asyncRead1", "asyncRead2" };
+
+typedef enum {
+	ASYNCREAD_QUEUED,
+	ASYNCREAD_READING,
+	ASYNCREAD_DONE
+} asyncReadState_t;
+
+// a read handed to the async read thread, the file is opened and the buffer
+// allocated on the issuing thread since neither the search paths nor the heap are thread safe
+typedef struct asyncRead_s {
+	struct asyncRead_s	*next;
+	int					handle;
+	asyncReadPriority_t	priority;
+	void 				*userData;
+	idStr				path;
+	bool				prefetch;					// handed over to the next read of the same path
+	bool				cancelled;					// thrown away once the read thread is done with it
+	idFile 			*file;
+	byte 				*buffer;
+	int					length;						// -1 if the read failed
+	ID_TIME_T			timestamp;
+	bool				mapped;						// buffer is the mapping of an idFile_Mapped, only needs paging in
+	int					reserved;					// heap bytes counted against the prefetch budget
+	pack_t 			*readAheadPack;				// WarmFiles reads length bytes of this pak ahead, NULL for file reads
+	int					readAheadOffset;
+	volatile asyncReadState_t state;
+} asyncRead_t;
+
+// a mapping handed out by ReadFileMapped or GetCompletedRead, unmapped by FreeFileMapped
+typedef struct {
+	const void 		*data;
+	int					length;
+} mappedFile_t;
+
+// a stretch of a pak to read ahead, files lying close together share one
+typedef struct {
+	pack_t 			*pack;
+	int					order;						// position of the search path
+	unsigned long		start;
+	unsigned long		end;
+} warmRange_t;
+
 // search flags when opening a file
 #define FSFLAG_SEARCH_DIRS		( 1 << 0 )
 #define FSFLAG_SEARCH_PAKS		( 1 << 1 )
@@ -376,6 +442,8 @@ class idFileSystemLocal : public idFileSystem
 		virtual int				GetOSMask(void);
 		virtual int				ReadFile(const char *relativePath, void **buffer, ID_TIME_T *timestamp);
 		virtual void			FreeFile(void *buffer);
+		virtual int				ReadFileMapped(const char *relativePath, const void **buffer, bool *mapped = NULL, ID_TIME_T *timestamp = NULL, idStr *fullPath = NULL);
+		virtual void			FreeFileMapped(const void *buffer);
 		virtual int				WriteFile(const char *relativePath, const void *buffer, int size, const char *basePath = "fs_savepath");
 		virtual void			RemoveFile(const char *relativePath);
 		virtual idFile 		*OpenFileReadFlags(const char *relativePath, int searchFlags, pack_t **foundInPak = NULL, bool allowCopyFiles = true, const char *gamedir = NULL);
@@ -387,6 +455,14 @@ class idFileSystemLocal : public idFileSystem
 		virtual idFile 		*OpenExplicitFileWrite(const char *OSPath);
 		virtual void			CloseFile(idFile *f);
 		virtual void			BackgroundDownload(backgroundDownload_t *bgl);
+		virtual int				ReadFileAsync(const char *relativePath, asyncReadPriority_t priority = ASYNCREAD_PRIORITY_NORMAL, void *userData = NULL);
+		virtual void			CancelReadAsync(int handle);
+		virtual bool			GetCompletedRead(asyncReadResult_t &result);
+		virtual bool			PrefetchFile(const char *relativePath);
+		virtual void			ClearPrefetchedFiles(void);
+		virtual void			WarmFiles(const idStrList &relativePaths);
+		virtual void			StartRecordingFiles(void);
+		virtual void			StopRecordingFiles(idStrList &relativePaths);
 		virtual void			ResetReadCount(void) {
 			readCount = 0;
 		}
@@ -415,14 +491,24 @@ class idFileSystemLocal : public idFileSystem
 		static void				Path_f(const idCmdArgs &args);
 		static void				TouchFile_f(const idCmdArgs &args);
 		static void				TouchFileList_f(const idCmdArgs &args);
+		static void				TestInflate_f(const idCmdArgs &args);
 
 	private:
 		friend void			*BackgroundDownloadThread(void *parms);
+		friend void			*AsyncReadThread(void *parms);
 
 		searchpath_t 			*searchPaths;
 		int						readCount;			// total bytes read
 		int						loadCount;			// total files read
 		int						loadStack;			// total files in memory
+		int						mappedReadCount;	// files served straight from a mapping
+		int						mappedReadBytes;	// bytes that didn't have to be copied out of a mapping
+		idList<mappedFile_t>	mappedFiles;		// mappings that are handed out
+		int						prefetchCount;		// files prefetched
+		int						prefetchHitCount;	// prefetched files that were picked up
+		int						prefetchBytes;		// heap memory held by outstanding prefetches
+		int						warmCount;			// files whose pak data was paged in ahead of time
+		int						warmBytes;
 		idStr					gameFolder;			// this will be a single name without separators
 
 		searchpath_t			*addonPaks;			// not loaded up, but we saw them
@@ -440,11 +526,31 @@ class idFileSystemLocal : public idFileSystem
 		static idCVar			fs_game_base;
 		static idCVar			fs_caseSensitiveOS;
 		static idCVar			fs_searchAddons;
+		static idCVar			fs_mapPaks;
+		static idCVar			fs_prefetchMB;
+		static idCVar			fs_warmMB;
+		static idCVar			fs_asyncReadThreads;
+		static idCVar			fs_fileIndex;
 
 		backgroundDownload_t 	*backgroundDownloads;
 		backgroundDownload_t	defaultBackgroundDownload;
 		xthreadInfo				backgroundThread;
 
+		// every file in the searched paks, built on the first lookup after the search paths change
+		idList<fileIndexEntry_t> fileIndex;
+		idList<int>				fileIndexHash;		// open addressed over the names, first entry or -1
+		idList<fileIndexName_t>	fileIndexNames;		// sorted, for walking a directory
+		bool					fileIndexValid;
+
+		asyncRead_t 			*asyncReads;		// guarded by CRITICAL_SECTION_TWO
+		int						asyncReadHandle;	// last handle given out
+		xthreadInfo				asyncReadThreads[MAX_ASYNC_READ_THREADS];
+		int						numAsyncReadThreads;
+
+		bool					recordingFiles;
+		idStrList				recordedFiles;		// in the order they were first opened
+		idHashIndex				recordedFileHash;
+
 		idList<pack_t *>		serverPaks;
 		bool					loadedFileFromDir;		// set to true once a file was loaded from a directory - can't switch to pure anymore
 		idList<int>				restartChecksums;		// used during a restart to set things in right order
@@ -485,7 +591,24 @@ class idFileSystemLocal : public idFileSystem
 		pack_t 				*GetPackForChecksum(int checksum, bool searchAddons = false);
 		// searches all the paks, no pure check
 		pack_t 				*FindPakForFileChecksum(const char *relativePath, int fileChecksum, bool bReference);
-		idFile_InZip 			*ReadFileFromZip(pack_t *pak, fileInPack_t *pakFile, const char *relativePath);
+		idFile 				*ReadFileFromZip(pack_t *pak, fileInPack_t *pakFile, const char *relativePath);
+		const void 			*KeepMapping(idFile_Mapped *file);
+		void					StartAsyncReadThreads(void);
+		void					WakeAsyncReadThreads(void);
+		asyncRead_t 			*QueueAsyncRead(const char *relativePath, asyncReadPriority_t priority, void *userData, bool prefetch);
+		void					PerformAsyncRead(asyncRead_t *read);
+		void					FreeAsyncRead(asyncRead_t *read);
+		void					FreeAsyncReads(asyncRead_t *reads);
+		void					UnlinkAsyncRead(asyncRead_t *read);
+		asyncRead_t 			*TakePrefetchedRead(const char *relativePath);
+		int						ClaimPrefetchedFile(const char *relativePath, const void **buffer, bool *mapped, ID_TIME_T *timestamp, idStr *fullPath = NULL);
+		void					CancelAllAsyncReads(void);
+		void					RecordOpenedFile(const char *relativePath);
+		void					InvalidateFileIndex(void);
+		void					BuildFileIndex(void);
+		int						FindIndexedFile(const char *relativePath);
+		void					GetIndexedFileList(const char *relativePath, const idStrList &extensions, idList<fileIndexEntry_t> &entries);
+		void					AddFileListName(const char *name, const char *relativePath, int pathLength, bool fullRelativePath, idStrList &list, idHashIndex &hashIndex) const;
 		int						GetFileChecksum(idFile *file);
 		pureStatus_t			GetPackStatus(pack_t *pak);
 		addonInfo_t 			*ParseAddonDef(const char *buf, const int len);
@@ -511,6 +634,11 @@ idCVar	idFileSystemLocal::fs_caseSensitiveOS("fs_caseSensitiveOS", "0", CVAR_SYS
 idCVar	idFileSystemLocal::fs_caseSensitiveOS("fs_caseSensitiveOS", "1", CVAR_SYSTEM | CVAR_BOOL, "");
 #endif
 idCVar	idFileSystemLocal::fs_searchAddons("fs_searchAddons", "0", CVAR_SYSTEM | CVAR_BOOL, "search all addon pk4s ( disables addon functionality )");
+idCVar	idFileSystemLocal::fs_mapPaks("fs_mapPaks", "1", CVAR_SYSTEM | CVAR_BOOL, "memory map large pk4 entries, stored ones are read without copying and deflated ones are inflated from the mapping");
+idCVar	idFileSystemLocal::fs_fileIndex("fs_fileIndex", "1", CVAR_SYSTEM | CVAR_BOOL, "look files up in one global index of the pak contents instead of every pak in turn");
+idCVar	idFileSystemLocal::fs_prefetchMB("fs_prefetchMB", "32", CVAR_SYSTEM | CVAR_INTEGER, "megabytes of heap prefetched files may hold before they are picked up", 0, 512);
+idCVar	idFileSystemLocal::fs_asyncReadThreads("fs_asyncReadThreads", "2", CVAR_SYSTEM | CVAR_INIT | CVAR_INTEGER, "threads reading and inflating files in the background", 1, MAX_ASYNC_READ_THREADS);
+idCVar	idFileSystemLocal::fs_warmMB("fs_warmMB", "256", CVAR_SYSTEM | CVAR_INTEGER, "megabytes of pak data paged in ahead of a level load", 0, 1024);
 
 idFileSystemLocal	fileSystemLocal;
 idFileSystem 		*fileSystem = &fileSystemLocal;
@@ -526,12 +654,25 @@ idFileSystemLocal::idFileSystemLocal(void)
 	readCount = 0;
 	loadCount = 0;
 	loadStack = 0;
+	mappedReadCount = 0;
+	mappedReadBytes = 0;
+	prefetchCount = 0;
+	prefetchHitCount = 0;
+	prefetchBytes = 0;
+	warmCount = 0;
+	warmBytes = 0;
+	fileIndexValid = false;
+	recordingFiles = false;
+	asyncReads = NULL;
+	asyncReadHandle = 0;
 	dir_cache_index = 0;
 	dir_cache_count = 0;
 	d3xp = 0;
 	loadedFileFromDir = false;
 	restartGamePakChecksum = 0;
 	memset(&backgroundThread, 0, sizeof(backgroundThread));
+	memset(asyncReadThreads, 0, sizeof(asyncReadThreads));
+	numAsyncReadThreads = 0;
 	addonPaks = NULL;
 }
 
@@ -1083,6 +1224,25 @@ bool idFileSystemLocal::FileIsInPAK(const char *relativePath)
 	// search through the path, one element at a time
 	//
 
+	if (fs_fileIndex.GetBool()) {
+		for (int i = FindIndexedFile(relativePath); i != -1; i = fileIndex[i].next) {
+			pak = fileIndex[i].search->pack;
+
+			// disregard if it doesn't match one of the allowed pure pak files - or is a localization file
+			if (serverPaks.Num()) {
+				GetPackStatus(pak);
+
+				if (pak->pureStatus != PURE_NEVER && !serverPaks.Find(pak)) {
+					continue; // not on the pure server pak list
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
 	hash = HashFileName(relativePath);
 
 	for (search = searchPaths; search; search = search->next) {
@@ -1187,6 +1347,16 @@ int idFileSystemLocal::ReadFile(const char *relativePath, void **buffer, ID_TIME
 		isConfig = false;
 	}
 
+	// pick up a prefetched copy
+	if (buffer && !isConfig) {
+		len = ClaimPrefetchedFile(relativePath, (const void **)buffer, NULL, timestamp);
+
+		if (len >= 0) {
+			loadStack++;
+			return len;
+		}
+	}
+
 	// look for it in the filesystem or pack files
 	f = OpenFileRead(relativePath, (buffer != NULL));
 
@@ -1252,6 +1422,140 @@ void idFileSystemLocal::FreeFile(void *buffer)
 	Mem_Free(buffer);
 }
 
+/*
+============
+idFileSystemLocal::KeepMapping
+
+Takes the mapping over from a mapped file before it is closed.
+============
+*/
+const void *idFileSystemLocal::KeepMapping(idFile_Mapped *file)
+{
+	mappedFile_t mapping;
+
+	assert(file->ownsMapping);
+
+	mapping.data = file->GetDataPtr();
+	mapping.length = file->Length();
+	mappedFiles.Append(mapping);
+	file->ownsMapping = false;
+
+	mappedReadCount++;
+	mappedReadBytes += mapping.length;
+	return mapping.data;
+}
+
+/*
+============
+idFileSystemLocal::ReadFileMapped
+
+Large stored pak entries are handed out as their mapping, compressed entries
+and loose files are read straight into the returned buffer.
+============
+*/
+int idFileSystemLocal::ReadFileMapped(const char *relativePath, const void **buffer, bool *mapped, ID_TIME_T *timestamp, idStr *fullPath)
+{
+	idFile 			*f;
+	idFile_Mapped 	*m;
+	byte 			*buf;
+	int				len;
+	bool			isMapped;
+
+	if (!searchPaths) {
+		common->FatalError("Filesystem call made without initialization\n");
+	}
+
+	if (!relativePath || !relativePath[0]) {
+		common->FatalError("idFileSystemLocal::ReadFileMapped with empty name\n");
+	}
+
+	*buffer = NULL;
+
+	if (mapped) {
+		*mapped = false;
+	}
+
+	if (timestamp) {
+		*timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	}
+
+	len = ClaimPrefetchedFile(relativePath, buffer, &isMapped, timestamp, fullPath);
+
+	if (len >= 0) {
+		if (mapped) {
+			*mapped = isMapped;
+		}
+
+		return len;
+	}
+
+	f = OpenFileRead(relativePath);
+
+	if (f == NULL) {
+		return -1;
+	}
+
+	len = f->Length();
+
+	if (timestamp) {
+		*timestamp = f->Timestamp();
+	}
+
+	if (fullPath) {
+		*fullPath = f->GetFullPath();
+	}
+
+	loadCount++;
+
+	m = dynamic_cast<idFile_Mapped *>(f);
+
+	if (m) {
+		*buffer = KeepMapping(m);
+
+		if (mapped) {
+			*mapped = true;
+		}
+
+		CloseFile(f);
+		return len;
+	}
+
+	buf = (byte *)Mem_Alloc(len + 1);
+	f->Read(buf, len);
+	// guarantee that it will have a trailing 0 for string operations
+	buf[len] = 0;
+	CloseFile(f);
+
+	*buffer = buf;
+	return len;
+}
+
+/*
+=============
+idFileSystemLocal::FreeFileMapped
+=============
+*/
+void idFileSystemLocal::FreeFileMapped(const void *buffer)
+{
+	if (!searchPaths) {
+		common->FatalError("Filesystem call made without initialization\n");
+	}
+
+	if (!buffer) {
+		common->FatalError("idFileSystemLocal::FreeFileMapped( NULL )");
+	}
+
+	for (int i = mappedFiles.Num() - 1; i >= 0; i--) {
+		if (mappedFiles[i].data == buffer) {
+			Sys_UnmapFile(mappedFiles[i].data, mappedFiles[i].length);
+			mappedFiles.RemoveIndex(i);
+			return;
+		}
+	}
+
+	Mem_Free(const_cast<void *>(buffer));
+}
+
 /*
 ============
 idFileSystemLocal::WriteFile
@@ -1485,6 +1789,12 @@ pack_t *idFileSystemLocal::LoadZipFile(const char *zipfile)
 		buildBuffer[i].name.BackSlashesToSlashes();
 		// store the file position in the zip
 		unzGetCurrentFileInfoPosition(uf, &buildBuffer[i].pos);
+		// and where the data lives so it can be found without going through the central directory
+		buildBuffer[i].offset = ((unz_s *)uf)->cur_file_info_internal.offset_curfile;
+		buildBuffer[i].size = file_info.uncompressed_size;
+		buildBuffer[i].compressedSize = file_info.compressed_size;
+		buildBuffer[i].compression = file_info.compression_method;
+		buildBuffer[i].encrypted = (file_info.flag & 1) != 0;
 		// add the file to the hash
 		buildBuffer[i].next = pack->hashTable[hash];
 		pack->hashTable[hash] = &buildBuffer[i];
@@ -1499,7 +1809,7 @@ pack_t *idFileSystemLocal::LoadZipFile(const char *zipfile)
 	for (pakFile = pack->hashTable[confHash]; pakFile; pakFile = pakFile->next) {
 		if (!FilenameCompare(pakFile->name, ADDON_CONFIG)) {
 			pack->addon = true;
-			idFile_InZip *file = ReadFileFromZip(pack, pakFile, ADDON_CONFIG);
+			idFile *file = ReadFileFromZip(pack, pakFile, ADDON_CONFIG);
 
 			// may be just an empty file if you don't bother about the mapDef
 			if (file && file->Length()) {
@@ -1561,6 +1871,7 @@ int idFileSystemLocal::AddZipFile(const char *path)
 	}
 
 	last->next = search;
+	InvalidateFileIndex();
 	common->Printf("Appended pk4 %s with checksum 0x%x\n", pak->pakFilename.c_str(), pak->checksum);
 	return pak->checksum;
 }
@@ -1612,6 +1923,55 @@ void idFileSystemLocal::GetExtensionList(const char *extension, idStrList &exten
 	}
 }
 
+/*
+===============
+PakFileListed
+
+Tells if a pak entry is directly in relativePath and has one of the extensions.
+===============
+*/
+static bool PakFileListed(const char *name, const char *relativePath, int pathLength, const idStrList &extensions)
+{
+	int j, length;
+
+	length = strlen(name);
+
+	// if the name is not long anough to at least contain the path
+	if (length <= pathLength) {
+		return false;
+	}
+
+	// check for a path match without the trailing '/'
+	if (pathLength && idStr::Icmpn(name, relativePath, pathLength - 1) != 0) {
+		return false;
+	}
+
+	// ensure we have a path, and not just a filename containing the path
+	if (name[ pathLength ] == '\0' || name[pathLength - 1] != '/') {
+		return false;
+	}
+
+	// make sure the file is not in a subdirectory
+	for (j = pathLength; name[j+1] != '\0'; j++) {
+		if (name[j] == '/') {
+			break;
+		}
+	}
+
+	if (name[j+1]) {
+		return false;
+	}
+
+	// check for extension match
+	for (j = 0; j < extensions.Num(); j++) {
+		if (length >= extensions[j].Length() && extensions[j].Icmp(name + length - extensions[j].Length()) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /*
 ===============
 idFileSystemLocal::GetFileList
@@ -1626,10 +1986,12 @@ int idFileSystemLocal::GetFileList(const char *relativePath, const idStrList &ex
 	fileInPack_t 	*buildBuffer;
 	int				i, j;
 	int				pathLength;
-	int				length;
 	const char 	*name;
 	pack_t 		*pak;
 	idStr			work;
+	bool			useIndex;
+	idList<fileIndexEntry_t> indexed;
+	int				firstIndexed, nextIndexed;
 
 	if (!searchPaths) {
 		common->FatalError("Filesystem call made without initialization\n");
@@ -1649,6 +2011,14 @@ int idFileSystemLocal::GetFileList(const char *relativePath, const idStrList &ex
 		pathLength++;	// for the trailing '/'
 	}
 
+	// the index hands out the pak entries in the order the search below visits them
+	useIndex = fs_fileIndex.GetBool();
+	nextIndexed = 0;
+
+	if (useIndex) {
+		GetIndexedFileList(relativePath, extensions, indexed);
+	}
+
 	// search through the path, one element at a time, adding to list
 	for (search = searchPaths; search != NULL; search = search->next) {
 		if (search->dir) {
@@ -1688,6 +2058,11 @@ int idFileSystemLocal::GetFileList(const char *relativePath, const idStrList &ex
 			}
 		} else if (search->pack) {
 			// look through all the pak file elements
+			firstIndexed = nextIndexed;
+
+			while (nextIndexed < indexed.Num() && indexed[nextIndexed].search == search) {
+				nextIndexed++;
+			}
 
 			// exclude any extra packs if we have server paks to search
 			if (serverPaks.Num()) {
@@ -1698,65 +2073,25 @@ int idFileSystemLocal::GetFileList(const char *relativePath, const idStrList &ex
 				}
 			}
 
+			if (useIndex) {
+				for (i = firstIndexed; i < nextIndexed; i++) {
+					AddFileListName(indexed[i].pakFile->name, relativePath, pathLength, fullRelativePath, list, hashIndex);
+				}
+
+				continue;
+			}
+
 			pak = search->pack;
 			buildBuffer = pak->buildBuffer;
 
 			for (i = 0; i < pak->numfiles; i++) {
-
-				length = buildBuffer[i].name.Length();
-
-				// if the name is not long anough to at least contain the path
-				if (length <= pathLength) {
-					continue;
-				}
-
 				name = buildBuffer[i].name;
 
-
-				// check for a path match without the trailing '/'
-				if (pathLength && idStr::Icmpn(name, relativePath, pathLength - 1) != 0) {
-					continue;
-				}
-
-				// ensure we have a path, and not just a filename containing the path
-				if (name[ pathLength ] == '\0' || name[pathLength - 1] != '/') {
-					continue;
-				}
-
-				// make sure the file is not in a subdirectory
-				for (j = pathLength; name[j+1] != '\0'; j++) {
-					if (name[j] == '/') {
-						break;
-					}
-				}
-
-				if (name[j+1]) {
-					continue;
-				}
-
-				// check for extension match
-				for (j = 0; j < extensions.Num(); j++) {
-					if (length >= extensions[j].Length() && extensions[j].Icmp(name + length - extensions[j].Length()) == 0) {
-						break;
-					}
-				}
-
-				if (j >= extensions.Num()) {
+				if (!PakFileListed(name, relativePath, pathLength, extensions)) {
 					continue;
 				}
 
-				// unique the match
-				if (fullRelativePath) {
-					work = relativePath;
-					work += "/";
-					work += name + pathLength;
-					work.StripTrailing('/');
-					AddUnique(work, list, hashIndex);
-				} else {
-					work = name + pathLength;
-					work.StripTrailing('/');
-					AddUnique(work, list, hashIndex);
-				}
+				AddFileListName(name, relativePath, pathLength, fullRelativePath, list, hashIndex);
 			}
 		}
 	}
@@ -1766,106 +2101,359 @@ int idFileSystemLocal::GetFileList(const char *relativePath, const idStrList &ex
 
 /*
 ===============
-idFileSystemLocal::ListFiles
+idFileSystemLocal::AddFileListName
 ===============
 */
-idFileList *idFileSystemLocal::ListFiles(const char *relativePath, const char *extension, bool sort, bool fullRelativePath, const char *gamedir)
+void idFileSystemLocal::AddFileListName(const char *name, const char *relativePath, int pathLength, bool fullRelativePath, idStrList &list, idHashIndex &hashIndex) const
 {
-	idHashIndex hashIndex(4096, 4096);
-	idStrList extensionList;
-
-	idFileList *fileList = new idFileList;
-	fileList->basePath = relativePath;
-
-	GetExtensionList(extension, extensionList);
-
-	GetFileList(relativePath, extensionList, fileList->list, hashIndex, fullRelativePath, gamedir);
+	idStr work;
 
-	if (sort) {
-		idStrListSortPaths(fileList->list);
+	// unique the match
+	if (fullRelativePath) {
+		work = relativePath;
+		work += "/";
+		work += name + pathLength;
+	} else {
+		work = name + pathLength;
 	}
 
-	return fileList;
+	work.StripTrailing('/');
+	AddUnique(work, list, hashIndex);
 }
 
 /*
 ===============
-idFileSystemLocal::GetFileListTree
+FileIndexHash
+
+Case and separator insensitive like FilenameCompare.
 ===============
 */
-int idFileSystemLocal::GetFileListTree(const char *relativePath, const idStrList &extensions, idStrList &list, idHashIndex &hashIndex, const char *gamedir)
+static unsigned int FileIndexHash(const char *fname)
 {
-	int i;
-	idStrList slash, folders(128);
-	idHashIndex folderHashIndex(1024, 128);
+	unsigned int	hash;
+	int				c;
 
-	// recurse through the subdirectories
-	slash.Append("/");
-	GetFileList(relativePath, slash, folders, folderHashIndex, true, gamedir);
+	hash = 2166136261u;
 
-	for (i = 0; i < folders.Num(); i++) {
-		if (folders[i][0] == '.') {
-			continue;
-		}
+	for (; *fname; fname++) {
+		c = *fname;
 
-		if (folders[i].Icmp(relativePath) == 0) {
-			continue;
+		if (c >= 'A' && c <= 'Z') {
+			c += 'a' - 'A';
+		} else if (c == '\\' || c == ':') {
+			c = '/';
 		}
 
-		GetFileListTree(folders[i], extensions, list, hashIndex, gamedir);
+		hash = (hash ^ (byte)c) * 16777619u;
 	}
 
-	// list files in the current directory
-	GetFileList(relativePath, extensions, list, hashIndex, true, gamedir);
-
-	return list.Num();
+	return hash;
 }
 
-/*
-===============
-idFileSystemLocal::ListFilesTree
-===============
-*/
-idFileList *idFileSystemLocal::ListFilesTree(const char *relativePath, const char *extension, bool sort, const char *gamedir)
+static int FileIndexNameCompare(const fileIndexName_t *a, const fileIndexName_t *b)
 {
-	idHashIndex hashIndex(4096, 4096);
-	idStrList extensionList;
-
-	idFileList *fileList = new idFileList();
-	fileList->basePath = relativePath;
-	fileList->list.SetGranularity(4096);
-
-	GetExtensionList(extension, extensionList);
-
-	GetFileListTree(relativePath, extensionList, fileList->list, hashIndex, gamedir);
+	return strcmp(a->name, b->name);
+}
 
-	if (sort) {
-		idStrListSortPaths(fileList->list);
+static int FileIndexEntryCompare(const fileIndexEntry_t *a, const fileIndexEntry_t *b)
+{
+	if (a->order != b->order) {
+		return a->order - b->order;
 	}
 
-	return fileList;
+	// pak entries are in one array in zip order
+	return (a->pakFile > b->pakFile) - (a->pakFile < b->pakFile);
 }
 
 /*
 ===============
-idFileSystemLocal::FreeFileList
+idFileSystemLocal::InvalidateFileIndex
 ===============
 */
-void idFileSystemLocal::FreeFileList(idFileList *fileList)
+void idFileSystemLocal::InvalidateFileIndex(void)
 {
-	delete fileList;
+	fileIndex.Clear();
+	fileIndexHash.Clear();
+	fileIndexNames.Clear();
+	fileIndexValid = false;
 }
 
 /*
 ===============
-idFileSystemLocal::ListMods
+idFileSystemLocal::BuildFileIndex
+
+Indexes every file of the paks in the search paths, a file found in more than
+one pak gets one entry per pak, chained in search order.
 ===============
 */
-idModList *idFileSystemLocal::ListMods(void)
+void idFileSystemLocal::BuildFileIndex(void)
 {
-	int 		i;
-	const int 	MAX_DESCRIPTION = 256;
-	char 		desc[ MAX_DESCRIPTION ];
+	searchpath_t 		*search;
+	fileInPack_t 		*pakFile;
+	fileIndexEntry_t 	entry;
+	fileIndexName_t 	indexName;
+	idList<int>			last;
+	int					numFiles, size, order, i, slot, first, index;
+
+	numFiles = 0;
+
+	for (search = searchPaths; search; search = search->next) {
+		if (search->pack) {
+			numFiles += search->pack->numfiles;
+		}
+	}
+
+	// keep the hash at most half full
+	for (size = 16; size < numFiles * 2; size <<= 1) {
+	}
+
+	fileIndex.Clear();
+	fileIndex.Resize(numFiles);
+	fileIndexNames.Clear();
+	fileIndexNames.Resize(numFiles);
+	fileIndexHash.SetNum(size, false);
+
+	for (i = 0; i < size; i++) {
+		fileIndexHash[i] = -1;
+	}
+
+	last.SetNum(numFiles, false);
+
+	for (order = 0, search = searchPaths; search; search = search->next, order++) {
+		if (!search->pack) {
+			continue;
+		}
+
+		for (i = 0; i < search->pack->numfiles; i++) {
+			pakFile = &search->pack->buildBuffer[i];
+
+			// LoadZipFile stops at the first broken entry
+			if (!pakFile->name.Length()) {
+				continue;
+			}
+
+			for (slot = FileIndexHash(pakFile->name) & (size - 1); fileIndexHash[slot] != -1; slot = (slot + 1) & (size - 1)) {
+				if (!FilenameCompare(fileIndex[fileIndexHash[slot]].pakFile->name, pakFile->name)) {
+					break;
+				}
+			}
+
+			first = fileIndexHash[slot];
+
+			if (first != -1 && fileIndex[last[first]].search == search) {
+				// the same name twice in one pak, the pak hash finds the later one
+				fileIndex[last[first]].pakFile = pakFile;
+				continue;
+			}
+
+			entry.pakFile = pakFile;
+			entry.search = search;
+			entry.order = order;
+			entry.next = -1;
+			index = fileIndex.Append(entry);
+
+			if (first == -1) {
+				fileIndexHash[slot] = index;
+				last[index] = index;
+				indexName.name = pakFile->name.c_str();
+				indexName.first = index;
+				fileIndexNames.Append(indexName);
+			} else {
+				fileIndex[last[first]].next = index;
+				last[first] = index;
+			}
+		}
+	}
+
+	fileIndexNames.Sort(FileIndexNameCompare);
+	fileIndexValid = true;
+
+	if (fs_debug.GetInteger()) {
+		common->Printf("file index: %d names, %d pak entries\n", fileIndexNames.Num(), fileIndex.Num());
+	}
+}
+
+/*
+===============
+idFileSystemLocal::FindIndexedFile
+
+Returns the first pak entry for the file, -1 if no searched pak has it.
+===============
+*/
+int idFileSystemLocal::FindIndexedFile(const char *relativePath)
+{
+	int slot, mask;
+
+	if (!fileIndexValid) {
+		BuildFileIndex();
+	}
+
+	mask = fileIndexHash.Num() - 1;
+
+	for (slot = FileIndexHash(relativePath) & mask; fileIndexHash[slot] != -1; slot = (slot + 1) & mask) {
+		if (!FilenameCompare(fileIndex[fileIndexHash[slot]].pakFile->name, relativePath)) {
+			return fileIndexHash[slot];
+		}
+	}
+
+	return -1;
+}
+
+/*
+===============
+idFileSystemLocal::GetIndexedFileList
+
+Collects the pak entries GetFileList would list, in search path and zip order.
+Only the names under relativePath are looked at.
+===============
+*/
+void idFileSystemLocal::GetIndexedFileList(const char *relativePath, const idStrList &extensions, idList<fileIndexEntry_t> &entries)
+{
+	idStr	prefix;
+	int		pathLength, low, high, mid, i, e;
+
+	if (!fileIndexValid) {
+		BuildFileIndex();
+	}
+
+	prefix = relativePath;
+	prefix.ToLower();
+
+	if (prefix.Length()) {
+		prefix += "/";
+	}
+
+	pathLength = prefix.Length();
+
+	// first name not sorting before the directory
+	low = 0;
+	high = fileIndexNames.Num();
+
+	while (low < high) {
+		mid = (low + high) >> 1;
+
+		if (strcmp(fileIndexNames[mid].name, prefix) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (i = low; i < fileIndexNames.Num() && !idStr::Cmpn(fileIndexNames[i].name, prefix, pathLength); i++) {
+		if (!PakFileListed(fileIndexNames[i].name, relativePath, pathLength, extensions)) {
+			continue;
+		}
+
+		for (e = fileIndexNames[i].first; e != -1; e = fileIndex[e].next) {
+			entries.Append(fileIndex[e]);
+		}
+	}
+
+	entries.Sort(FileIndexEntryCompare);
+}
+
+/*
+===============
+idFileSystemLocal::ListFiles
+===============
+*/
+idFileList *idFileSystemLocal::ListFiles(const char *relativePath, const char *extension, bool sort, bool fullRelativePath, const char *gamedir)
+{
+	idHashIndex hashIndex(4096, 4096);
+	idStrList extensionList;
+
+	idFileList *fileList = new idFileList;
+	fileList->basePath = relativePath;
+
+	GetExtensionList(extension, extensionList);
+
+	GetFileList(relativePath, extensionList, fileList->list, hashIndex, fullRelativePath, gamedir);
+
+	if (sort) {
+		idStrListSortPaths(fileList->list);
+	}
+
+	return fileList;
+}
+
+/*
+===============
+idFileSystemLocal::GetFileListTree
+===============
+*/
+int idFileSystemLocal::GetFileListTree(const char *relativePath, const idStrList &extensions, idStrList &list, idHashIndex &hashIndex, const char *gamedir)
+{
+	int i;
+	idStrList slash, folders(128);
+	idHashIndex folderHashIndex(1024, 128);
+
+	// recurse through the subdirectories
+	slash.Append("/");
+	GetFileList(relativePath, slash, folders, folderHashIndex, true, gamedir);
+
+	for (i = 0; i < folders.Num(); i++) {
+		if (folders[i][0] == '.') {
+			continue;
+		}
+
+		if (folders[i].Icmp(relativePath) == 0) {
+			continue;
+		}
+
+		GetFileListTree(folders[i], extensions, list, hashIndex, gamedir);
+	}
+
+	// list files in the current directory
+	GetFileList(relativePath, extensions, list, hashIndex, true, gamedir);
+
+	return list.Num();
+}
+
+/*
+===============
+idFileSystemLocal::ListFilesTree
+===============
+*/
+idFileList *idFileSystemLocal::ListFilesTree(const char *relativePath, const char *extension, bool sort, const char *gamedir)
+{
+	idHashIndex hashIndex(4096, 4096);
+	idStrList extensionList;
+
+	idFileList *fileList = new idFileList();
+	fileList->basePath = relativePath;
+	fileList->list.SetGranularity(4096);
+
+	GetExtensionList(extension, extensionList);
+
+	GetFileListTree(relativePath, extensionList, fileList->list, hashIndex, gamedir);
+
+	if (sort) {
+		idStrListSortPaths(fileList->list);
+	}
+
+	return fileList;
+}
+
+/*
+===============
+idFileSystemLocal::FreeFileList
+===============
+*/
+void idFileSystemLocal::FreeFileList(idFileList *fileList)
+{
+	delete fileList;
+}
+
+/*
+===============
+idFileSystemLocal::ListMods
+===============
+*/
+idModList *idFileSystemLocal::ListMods(void)
+{
+	int 		i;
+	const int 	MAX_DESCRIPTION = 256;
+	char 		desc[ MAX_DESCRIPTION ];
 
 	idStrList	dirs;
 	idStrList	pk4s;
@@ -2152,7 +2740,7 @@ idFileSystemLocal::Path_f
 void idFileSystemLocal::Path_f(const idCmdArgs &args)
 {
 	searchpath_t *sp;
-	int i;
+	int i, mappedBytes;
 	idStr status;
 
 	common->Printf("Current search path:\n");
@@ -2185,6 +2773,19 @@ void idFileSystemLocal::Path_f(const idCmdArgs &args)
 		}
 	}
 
+	mappedBytes = 0;
+
+	for (i = 0; i < fileSystemLocal.mappedFiles.Num(); i++) {
+		mappedBytes += fileSystemLocal.mappedFiles[i].length;
+	}
+
+	common->Printf("%d files / %dkB read from mappings without copying, %d mappings / %dkB still held\n", fileSystemLocal.mappedReadCount, fileSystemLocal.mappedReadBytes >> 10, fileSystemLocal.mappedFiles.Num(), mappedBytes >> 10);
+	common->Printf("%d of %d prefetched files used\n", fileSystemLocal.prefetchHitCount, fileSystemLocal.prefetchCount);
+	common->Printf("%d files / %dkB of pak data paged in ahead of level loads\n", fileSystemLocal.warmCount, fileSystemLocal.warmBytes >> 10);
+
+	if (fileSystemLocal.fileIndexValid) {
+		common->Printf("%d files indexed from %d pak entries\n", fileSystemLocal.fileIndexNames.Num(), fileSystemLocal.fileIndex.Num());
+	}
 	common->Printf("game DLL: 0x%x in pak: 0x%x\n", fileSystemLocal.gameDLLChecksum, fileSystemLocal.gamePakChecksum);
 #if ID_FAKE_PURE
 	common->Printf("Note: ID_FAKE_PURE is enabled\n");
@@ -2293,74 +2894,227 @@ void idFileSystemLocal::TouchFileList_f(const idCmdArgs &args)
 
 }
 
+/*
+============
+PrintInflateRate
+============
+*/
+static void PrintInflateRate(const char *method, int numFiles, int bytes, int msec)
+{
+	common->Printf("%-10s %5d files %7.1f MB %6d msec %7.1f MB/s\n", method, numFiles, bytes / (1024.0f * 1024.0f), msec, msec ? bytes / (1024.0f * 1024.0f) / (msec / 1000.0f) : 0.0f);
+}
 
 /*
-================
-idFileSystemLocal::AddGameDirectory
+============
+idFileSystemLocal::TestInflate_f
 
-Sets gameFolder, adds the directory to the head of the search paths, then loads any pk4 files.
-================
+Inflates the compressed files of the searched paks three ways: through zlib a
+buffer at a time, in one go out of the pak mapping, and as one batch spread
+over the async read threads. The first pass also pulls the paks into the OS
+cache, run it twice for numbers that don't include the disk.
+============
 */
-void idFileSystemLocal::AddGameDirectory(const char *path, const char *dir)
+void idFileSystemLocal::TestInflate_f(const idCmdArgs &args)
 {
-	int				i;
-	searchpath_t 	*search;
-	pack_t 		*pak;
-	idStr			pakfile;
-	idStrList		pakfiles;
-
-	// check if the search path already exists
-	for (search = searchPaths; search; search = search->next) {
-		// if this element is a pak file
-		if (!search->dir) {
+	idList<fileIndexEntry_t>	entries;
+	fileIndexEntry_t			entry;
+	searchpath_t 				*search;
+	fileInPack_t 				*pakFile;
+	idFile_InZip 				*file;
+	asyncReadResult_t			result;
+	byte 						*buffer;
+	int							limit, total, maxSize, order, index, start, next, inFlight, failed, i;
+
+	limit = (args.Argc() > 1 ? atoi(args.Argv(1)) : 64) << 20;
+	total = 0;
+	maxSize = 0;
+
+	for (order = 0, search = fileSystemLocal.searchPaths; search && total < limit; search = search->next, order++) {
+		if (!search->pack) {
 			continue;
 		}
 
-		if (search->dir->path.Cmp(path) == 0 && search->dir->gamedir.Cmp(dir) == 0) {
-			return;
+		for (i = 0; i < search->pack->numfiles && total < limit; i++) {
+			pakFile = &search->pack->buildBuffer[i];
+
+			if (!pakFile->name.Length() || pakFile->compression == 0 || pakFile->encrypted || pakFile->size <= 0) {
+				continue;
+			}
+
+			// the batch opens files by name, leave out the ones a pak earlier in the search path hides
+			index = fileSystemLocal.FindIndexedFile(pakFile->name);
+
+			if (index == -1 || fileSystemLocal.fileIndex[index].pakFile != pakFile) {
+				continue;
+			}
+
+			entry.pakFile = pakFile;
+			entry.search = search;
+			entry.order = order;
+			entry.next = -1;
+			entries.Append(entry);
+
+			total += pakFile->size;
+			maxSize = Max(maxSize, pakFile->size);
 		}
 	}
 
-	gameFolder = dir;
-
-	//
-	// add the directory to the search path
-	//
-	search = new searchpath_t;
-	search->dir = new directory_t;
-	search->pack = NULL;
+	if (!entries.Num()) {
+		common->Printf("no compressed files in the searched paks\n");
+		return;
+	}
 
-	search->dir->path = path;
-	search->dir->gamedir = dir;
-	search->next = searchPaths;
-	searchPaths = search;
+	buffer = (byte *)Mem_Alloc(maxSize + 1);
+	failed = 0;
 
-	// find all pak files in this directory
-	pakfile = BuildOSPath(path, dir, "");
-	pakfile[ pakfile.Length() - 1 ] = 0;	// strip the trailing slash
+	// a buffer at a time, reading the compressed data through the file
+	start = Sys_Milliseconds();
 
-	ListOSFiles(pakfile, ".pk4", pakfiles);
+	for (i = 0; i < entries.Num(); i++) {
+		file = static_cast<idFile_InZip *>(fileSystemLocal.ReadFileFromZip(entries[i].search->pack, entries[i].pakFile, entries[i].pakFile->name));
+		((unz_s *)file->z)->pfile_in_zip_read->source = NULL;
 
-	// sort them so that later alphabetic matches override
-	// earlier ones. This makes pak1.pk4 override pak0.pk4
-	pakfiles.Sort();
+		for (next = 0; next < file->fileSize;) {
+			index = unzReadCurrentFile(file->z, buffer, Min(file->fileSize - next, 16384));
 
-	for (i = 0; i < pakfiles.Num(); i++) {
-		pakfile = BuildOSPath(path, dir, pakfiles[i]);
-		pak = LoadZipFile(pakfile);
+			if (index <= 0) {
+				failed++;
+				break;
+			}
 
-		if (!pak) {
-			continue;
+			next += index;
 		}
 
-		// insert the pak after the directory it comes from
-		search = new searchpath_t;
-		search->dir = NULL;
-		search->pack = pak;
+		delete file;
+	}
+
+	PrintInflateRate("zlib", entries.Num(), total, Sys_Milliseconds() - start);
+
+	// whole files, inflated straight out of the mapping when the entry is large enough to be mapped
+	start = Sys_Milliseconds();
+
+	for (i = 0; i < entries.Num(); i++) {
+		file = static_cast<idFile_InZip *>(fileSystemLocal.ReadFileFromZip(entries[i].search->pack, entries[i].pakFile, entries[i].pakFile->name));
+
+		if (unzReadCurrentFile(file->z, buffer, file->fileSize) != file->fileSize) {
+			failed++;
+		}
+
+		delete file;
+	}
+
+	PrintInflateRate("one shot", entries.Num(), total, Sys_Milliseconds() - start);
+
+	Mem_Free(buffer);
+
+	// a batch on the async read threads, with a few files in flight at a time
+	start = Sys_Milliseconds();
+	inFlight = 0;
+
+	for (i = 0, next = 0; next < entries.Num();) {
+		while (i < entries.Num() && inFlight < fileSystemLocal.numAsyncReadThreads * 4) {
+			if (fileSystemLocal.ReadFileAsync(entries[i].pakFile->name)) {
+				inFlight++;
+			} else {
+				failed++;
+				next++;
+			}
+
+			i++;
+		}
+
+		if (!fileSystemLocal.GetCompletedRead(result)) {
+			Sys_WaitForEvent(TRIGGER_EVENT_THREE);
+			continue;
+		}
+
+		if (result.buffer) {
+			fileSystemLocal.FreeFileMapped(result.buffer);
+		} else {
+			failed++;
+		}
+
+		inFlight--;
+		next++;
+	}
+
+	PrintInflateRate(va("%d threads", fileSystemLocal.numAsyncReadThreads), entries.Num(), total, Sys_Milliseconds() - start);
+
+	if (failed) {
+		common->Printf("%d reads failed\n", failed);
+	}
+}
+
+
+/*
+================
+idFileSystemLocal::AddGameDirectory
+
+Sets gameFolder, adds the directory to the head of the search paths, then loads any pk4 files.
+================
+*/
+void idFileSystemLocal::AddGameDirectory(const char *path, const char *dir)
+{
+	int				i;
+	searchpath_t 	*search;
+	pack_t 		*pak;
+	idStr			pakfile;
+	idStrList		pakfiles;
+
+	// check if the search path already exists
+	for (search = searchPaths; search; search = search->next) {
+		// if this element is a pak file
+		if (!search->dir) {
+			continue;
+		}
+
+		if (search->dir->path.Cmp(path) == 0 && search->dir->gamedir.Cmp(dir) == 0) {
+			return;
+		}
+	}
+
+	gameFolder = dir;
+
+	//
+	// add the directory to the search path
+	//
+	search = new searchpath_t;
+	search->dir = new directory_t;
+	search->pack = NULL;
+
+	search->dir->path = path;
+	search->dir->gamedir = dir;
+	search->next = searchPaths;
+	searchPaths = search;
+
+	// find all pak files in this directory
+	pakfile = BuildOSPath(path, dir, "");
+	pakfile[ pakfile.Length() - 1 ] = 0;	// strip the trailing slash
+
+	ListOSFiles(pakfile, ".pk4", pakfiles);
+
+	// sort them so that later alphabetic matches override
+	// earlier ones. This makes pak1.pk4 override pak0.pk4
+	pakfiles.Sort();
+
+	for (i = 0; i < pakfiles.Num(); i++) {
+		pakfile = BuildOSPath(path, dir, pakfiles[i]);
+		pak = LoadZipFile(pakfile);
+
+		if (!pak) {
+			continue;
+		}
+
+		// insert the pak after the directory it comes from
+		search = new searchpath_t;
+		search->dir = NULL;
+		search->pack = pak;
 		search->next = searchPaths->next;
 		searchPaths->next = search;
 		common->Printf("Loaded pk4 %s with checksum 0x%x\n", pakfile.c_str(), pak->checksum);
 	}
+
+	InvalidateFileIndex();
 }
 
 /*
@@ -2631,12 +3385,16 @@ void idFileSystemLocal::Startup(void)
 		gamePakChecksum = restartGamePakChecksum;
 	}
 
+	// the search paths are settled, index them on the next lookup
+	InvalidateFileIndex();
+
 	// add our commands
 	cmdSystem->AddCommand("dir", Dir_f, CMD_FL_SYSTEM, "lists a folder", idCmdSystem::ArgCompletion_FileName);
 	cmdSystem->AddCommand("dirtree", DirTree_f, CMD_FL_SYSTEM, "lists a folder with subfolders");
 	cmdSystem->AddCommand("path", Path_f, CMD_FL_SYSTEM, "lists search paths");
 	cmdSystem->AddCommand("touchFile", TouchFile_f, CMD_FL_SYSTEM, "touches a file");
 	cmdSystem->AddCommand("touchFileList", TouchFileList_f, CMD_FL_SYSTEM, "touches a list of files");
+	cmdSystem->AddCommand("testInflate", TestInflate_f, CMD_FL_SYSTEM, "measures how fast the compressed files in the paks inflate");
 
 	// print the current search paths
 	Path_f(idCmdArgs());
@@ -3207,6 +3965,9 @@ void idFileSystemLocal::Init(void)
 	// spawn a thread to handle background file reads
 	StartBackgroundDownloadThread();
 
+	// and one for asynchronous reads and prefetching
+	StartAsyncReadThreads();
+
 	// if we can't find default.cfg, assume that the paths are
 	// busted and error out now, rather than getting an unreadable
 	// graphics screen when the font fails to load
@@ -3252,6 +4013,11 @@ void idFileSystemLocal::Shutdown(bool reloading)
 
 	gameFolder.Clear();
 
+	// the async read thread may still be reading from the paks
+	CancelAllAsyncReads();
+
+	InvalidateFileIndex();
+
 	serverPaks.Clear();
 
 	if (!reloading) {
@@ -3298,6 +4064,7 @@ void idFileSystemLocal::Shutdown(bool reloading)
 	cmdSystem->RemoveCommand("dir");
 	cmdSystem->RemoveCommand("dirtree");
 	cmdSystem->RemoveCommand("touchFile");
+	cmdSystem->RemoveCommand("testInflate");
 
 	mapDict.Clear();
 }
@@ -3443,10 +4210,13 @@ pureStatus_t idFileSystemLocal::GetPackStatus(pack_t *pak)
 idFileSystemLocal::ReadFileFromZip
 ===========
 */
-idFile_InZip *idFileSystemLocal::ReadFileFromZip(pack_t *pak, fileInPack_t *pakFile, const char *relativePath)
+idFile *idFileSystemLocal::ReadFileFromZip(pack_t *pak, fileInPack_t *pakFile, const char *relativePath)
 {
 	unz_s 			*zfi;
 	FILE 			*fp;
+	unsigned long	offset, length;
+	const void 		*mapped;
+
 	idFile_InZip *file = new idFile_InZip();
 
 	// open a new file on the pakfile
@@ -3471,6 +4241,34 @@ idFile_InZip *idFileSystemLocal::ReadFileFromZip(pack_t *pak, fileInPack_t *pakF
 	unzOpenCurrentFile(file->z);
 	file->zipFilePos = pakFile->pos;
 	file->fileSize = zfi->cur_file_info.uncompressed_size;
+
+	// only the data of large entries is mapped, smaller ones are cheaper to read than to map
+	if (!fs_mapPaks.GetBool() || (zfi->cur_file_info.flag & 1) || unzGetCurrentFileDataRange(file->z, &offset, &length) != UNZ_OK ||
+	    length < FS_MAP_MIN_SIZE || offset + length > (unsigned long)pak->length) {
+		return file;
+	}
+
+	mapped = Sys_MapFile(fp, offset, length);
+
+	if (!mapped) {
+		return file;
+	}
+
+	// stored entries become a view of the mapping
+	if (zfi->cur_file_info.compression_method == 0 && length == zfi->cur_file_info.uncompressed_size) {
+		idFile_Mapped *m = new idFile_Mapped(relativePath, file->fullPath, (const char *)mapped, length);
+		delete file;
+		return m;
+	}
+
+	// deflated entries are inflated from the mapping
+	if (unzSetCurrentFileSource(file->z, mapped) == UNZ_OK) {
+		file->mappedSource = mapped;
+		file->mappedSourceLength = length;
+	} else {
+		Sys_UnmapFile(mapped, length);
+	}
+
 	return file;
 }
 
@@ -3493,6 +4291,8 @@ idFile *idFileSystemLocal::OpenFileReadFlags(const char *relativePath, int searc
 	directory_t 	*dir;
 	long			hash;
 	FILE 			*fp;
+	bool			useIndex;
+	int				indexed;
 
 	if (!searchPaths) {
 		common->FatalError("Filesystem call made without initialization\n");
@@ -3535,6 +4335,10 @@ idFile *idFileSystemLocal::OpenFileReadFlags(const char *relativePath, int searc
 
 	hash = HashFileName(relativePath);
 
+	// the index knows which paks hold the file, in search order
+	useIndex = fs_fileIndex.GetBool();
+	indexed = useIndex ? FindIndexedFile(relativePath) : -1;
+
 	for (search = searchPaths; search; search = search->next) {
 		if (search->dir && (searchFlags & FSFLAG_SEARCH_DIRS)) {
 			// check a file in the directory tree
@@ -3573,6 +4377,8 @@ idFile *idFileSystemLocal::OpenFileReadFlags(const char *relativePath, int searc
 				common->Printf("idFileSystem::OpenFileRead: %s (found in '%s/%s')\n", relativePath, dir->path.c_str(), dir->gamedir.c_str());
 			}
 
+			RecordOpenedFile(relativePath);
+
 			if (!loadedFileFromDir && !FileAllowedFromDir(relativePath)) {
 				if (restartChecksums.Num()) {
 					common->FatalError("'%s' loaded from directory: Failed to restart with pure mode restrictions for server connect", relativePath);
@@ -3653,7 +4459,14 @@ idFile *idFileSystemLocal::OpenFileReadFlags(const char *relativePath, int searc
 			return file;
 		} else if (search->pack && (searchFlags & FSFLAG_SEARCH_PAKS)) {
 
-			if (!search->pack->hashTable[hash]) {
+			if (useIndex) {
+				if (indexed == -1 || fileIndex[indexed].search != search) {
+					continue;
+				}
+
+				pakFile = fileIndex[indexed].pakFile;
+				indexed = fileIndex[indexed].next;
+			} else if (!search->pack->hashTable[hash]) {
 				continue;
 			}
 
@@ -3690,31 +4503,41 @@ idFile *idFileSystemLocal::OpenFileReadFlags(const char *relativePath, int searc
 				}
 			}
 
-			for (pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next) {
-				// case and separator insensitive comparisons
-				if (!FilenameCompare(pakFile->name, relativePath)) {
-					idFile_InZip *file = ReadFileFromZip(pak, pakFile, relativePath);
-
-					if (foundInPak) {
-						*foundInPak = pak;
+			if (!useIndex) {
+				for (pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next) {
+					// case and separator insensitive comparisons
+					if (!FilenameCompare(pakFile->name, relativePath)) {
+						break;
 					}
+				}
 
-					if (!pak->referenced && !(searchFlags & FSFLAG_PURE_NOREF)) {
-						// mark this pak referenced
-						if (fs_debug.GetInteger()) {
-							common->Printf("idFileSystem::OpenFileRead: %s -> adding %s to referenced paks\n", relativePath, pak->pakFilename.c_str());
-						}
+				if (!pakFile) {
+					continue;
+				}
+			}
 
-						pak->referenced = true;
-					}
+			idFile *file = ReadFileFromZip(pak, pakFile, relativePath);
 
-					if (fs_debug.GetInteger()) {
-						common->Printf("idFileSystem::OpenFileRead: %s (found in '%s')\n", relativePath, pak->pakFilename.c_str());
-					}
+			if (foundInPak) {
+				*foundInPak = pak;
+			}
 
-					return file;
+			if (!pak->referenced && !(searchFlags & FSFLAG_PURE_NOREF)) {
+				// mark this pak referenced
+				if (fs_debug.GetInteger()) {
+					common->Printf("idFileSystem::OpenFileRead: %s -> adding %s to referenced paks\n", relativePath, pak->pakFilename.c_str());
 				}
+
+				pak->referenced = true;
+			}
+
+			if (fs_debug.GetInteger()) {
+				common->Printf("idFileSystem::OpenFileRead: %s (found in '%s')\n", relativePath, pak->pakFilename.c_str());
 			}
+
+			RecordOpenedFile(relativePath);
+
+			return file;
 		}
 	}
 
@@ -3726,7 +4549,7 @@ idFile *idFileSystemLocal::OpenFileReadFlags(const char *relativePath, int searc
 
 			for (pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next) {
 				if (!FilenameCompare(pakFile->name, relativePath)) {
-					idFile_InZip *file = ReadFileFromZip(pak, pakFile, relativePath);
+					idFile *file = ReadFileFromZip(pak, pakFile, relativePath);
 
 					if (foundInPak) {
 						*foundInPak = pak;
@@ -3757,6 +4580,39 @@ idFileSystemLocal::OpenFileRead
 */
 idFile *idFileSystemLocal::OpenFileRead(const char *relativePath, bool allowCopyFiles, const char *gamedir)
 {
+	asyncRead_t 	*read;
+	idFile 			*f;
+	idFile_Memory 	*m;
+
+	// a prefetched copy becomes a memory file that owns the buffer, a mapped file is handed over as it is
+	if (allowCopyFiles && !gamedir) {
+		read = TakePrefetchedRead(relativePath);
+
+		if (read && read->length >= 0 && read->mapped) {
+			f = read->file;
+			read->file = NULL;
+			read->buffer = NULL;
+			prefetchHitCount++;
+			FreeAsyncRead(read);
+			return f;
+		}
+
+		if (read && read->length >= 0) {
+			m = new idFile_Memory(relativePath, (const char *)read->buffer, read->length);
+			m->allocated = read->length + 1;
+			read->buffer = NULL;
+			AddToReadCount(read->length);
+
+			prefetchHitCount++;
+			FreeAsyncRead(read);
+			return m;
+		}
+
+		if (read) {
+			FreeAsyncRead(read);
+		}
+	}
+
 	return OpenFileReadFlags(relativePath, FSFLAG_SEARCH_DIRS | FSFLAG_SEARCH_PAKS, NULL, allowCopyFiles, gamedir);
 }
 
@@ -4208,6 +5064,826 @@ void idFileSystemLocal::BackgroundDownload(backgroundDownload_t *bgl)
 	}
 }
 
+/*
+===================
+AsyncReadThread
+
+Performs the queued reads, highest priority first. Any number of these can
+work through the queue, parms is the event the thread sleeps on.
+===================
+*/
+void *AsyncReadThread(void *parms)
+{
+	asyncRead_t	*read, *r;
+	int			event = (int)(size_t)parms;
+
+	while (1) {
+		Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+		read = NULL;
+
+		for (r = fileSystemLocal.asyncReads; r; r = r->next) {
+			if (r->state == ASYNCREAD_QUEUED && (!read || r->priority > read->priority)) {
+				read = r;
+			}
+		}
+
+		if (!read) {
+			Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+			Sys_WaitForEvent(event);
+			continue;
+		}
+
+		read->state = ASYNCREAD_READING;
+		Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+		fileSystemLocal.PerformAsyncRead(read);
+
+		Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+		read->state = ASYNCREAD_DONE;
+		Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+		Sys_TriggerEvent(TRIGGER_EVENT_THREE);
+	}
+
+	return NULL;
+}
+
+/*
+=================
+idFileSystemLocal::StartAsyncReadThreads
+
+More than one thread lets a batch of compressed files inflate side by side.
+=================
+*/
+void idFileSystemLocal::StartAsyncReadThreads(void)
+{
+	int num = idMath::ClampInt(1, MAX_ASYNC_READ_THREADS, fs_asyncReadThreads.GetInteger());
+
+	while (numAsyncReadThreads < num) {
+		xthreadInfo &info = asyncReadThreads[numAsyncReadThreads];
+
+		Sys_CreateThread(AsyncReadThread, (void *)(size_t)asyncReadEvents[numAsyncReadThreads], THREAD_NORMAL, info, asyncReadThreadNames[numAsyncReadThreads], g_threads, &g_thread_count);
+
+		if (!info.threadHandle) {
+			break;
+		}
+
+		numAsyncReadThreads++;
+	}
+
+	if (!numAsyncReadThreads) {
+		common->Warning("idFileSystemLocal::StartAsyncReadThreads: failed, reads will be synchronous");
+	}
+}
+
+/*
+=================
+idFileSystemLocal::WakeAsyncReadThreads
+=================
+*/
+void idFileSystemLocal::WakeAsyncReadThreads(void)
+{
+	for (int i = 0; i < numAsyncReadThreads; i++) {
+		Sys_TriggerEvent(asyncReadEvents[i]);
+	}
+}
+
+/*
+=================
+idFileSystemLocal::PerformAsyncRead
+
+Runs on the async read thread, so it must not touch the heap or the search paths.
+=================
+*/
+void idFileSystemLocal::PerformAsyncRead(asyncRead_t *read)
+{
+	idFile_Permanent 	*permanent;
+	idFile_InZip 		*inZip;
+
+	if (read->readAheadPack) {
+		Sys_ReadAhead(((unz_s *)read->readAheadPack->handle)->file, read->readAheadOffset, read->length);
+		return;
+	}
+
+	if (read->mapped) {
+		// fault the pages in ahead of the reader
+		for (int i = 0; i < read->length; i += 4096) {
+			*(volatile const byte *)(read->buffer + i);
+		}
+
+		return;
+	}
+
+	permanent = dynamic_cast<idFile_Permanent *>(read->file);
+
+	if (permanent) {
+		if (read->length > 0 && fread(read->buffer, read->length, 1, permanent->GetFilePtr()) != 1) {
+			read->length = -1;
+		}
+
+		return;
+	}
+
+	inZip = dynamic_cast<idFile_InZip *>(read->file);
+
+	if (inZip) {
+		if (unzReadCurrentFile(inZip->z, read->buffer, read->length) != read->length) {
+			read->length = -1;
+		}
+
+		return;
+	}
+
+	if (read->file->Read(read->buffer, read->length) != read->length) {
+		read->length = -1;
+	}
+}
+
+/*
+=================
+idFileSystemLocal::QueueAsyncRead
+
+Opens the file and hands it to the async read thread.
+=================
+*/
+asyncRead_t *idFileSystemLocal::QueueAsyncRead(const char *relativePath, asyncReadPriority_t priority, void *userData, bool prefetch)
+{
+	idFile 			*f;
+	idFile_Mapped 	*m;
+	idFile_InZip 	*inZip;
+	asyncRead_t 	*read, **link;
+	bool			queued;
+
+	f = OpenFileReadFlags(relativePath, FSFLAG_SEARCH_DIRS | FSFLAG_SEARCH_PAKS);
+
+	if (!f) {
+		return NULL;
+	}
+
+	if (++asyncReadHandle <= 0) {
+		asyncReadHandle = 1;
+	}
+
+	read = new asyncRead_t;
+	read->next = NULL;
+	read->handle = asyncReadHandle;
+	read->priority = priority;
+	read->userData = userData;
+	read->path = relativePath;
+	read->prefetch = prefetch;
+	read->cancelled = false;
+	read->file = f;
+	read->length = f->Length();
+	read->timestamp = f->Timestamp();
+	read->reserved = 0;
+	read->readAheadPack = NULL;
+	read->readAheadOffset = 0;
+
+	m = dynamic_cast<idFile_Mapped *>(f);
+
+	if (m) {
+		read->buffer = (byte *)m->GetDataPtr();
+		read->mapped = true;
+	} else {
+		read->buffer = (byte *)Mem_Alloc(read->length + 1);
+		// guarantee that it will have a trailing 0 for string operations
+		read->buffer[read->length] = 0;
+		read->mapped = false;
+
+		if (prefetch) {
+			read->reserved = read->length;
+			prefetchBytes += read->reserved;
+		}
+	}
+
+	queued = (numAsyncReadThreads != 0);
+	inZip = dynamic_cast<idFile_InZip *>(f);
+
+	if (inZip) {
+		// inflate allocates while decoding
+		queued = queued && unzSetCurrentFileThreadSafe(inZip->z) == UNZ_OK;
+	} else if (!read->mapped && !dynamic_cast<idFile_Permanent *>(f)) {
+		queued = false;
+	}
+
+	if (queued) {
+		read->state = ASYNCREAD_QUEUED;
+	} else {
+		PerformAsyncRead(read);
+		read->state = ASYNCREAD_DONE;
+	}
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (link = &asyncReads; *link; link = &(*link)->next) {
+	}
+
+	*link = read;
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	if (queued) {
+		WakeAsyncReadThreads();
+	}
+
+	return read;
+}
+
+/*
+=================
+idFileSystemLocal::UnlinkAsyncRead
+
+The caller must hold CRITICAL_SECTION_TWO.
+=================
+*/
+void idFileSystemLocal::UnlinkAsyncRead(asyncRead_t *read)
+{
+	asyncRead_t **link;
+
+	for (link = &asyncReads; *link; link = &(*link)->next) {
+		if (*link == read) {
+			*link = read->next;
+			break;
+		}
+	}
+
+	read->next = NULL;
+}
+
+/*
+=================
+idFileSystemLocal::FreeAsyncRead
+=================
+*/
+void idFileSystemLocal::FreeAsyncRead(asyncRead_t *read)
+{
+	prefetchBytes -= read->reserved;
+
+	if (!read->mapped && read->buffer) {
+		Mem_Free(read->buffer);
+	}
+
+	if (read->file) {
+		CloseFile(read->file);
+	}
+
+	delete read;
+}
+
+/*
+=================
+idFileSystemLocal::FreeAsyncReads
+
+Frees a chain of reads that have been unlinked from the queue, after the lock is released.
+=================
+*/
+void idFileSystemLocal::FreeAsyncReads(asyncRead_t *reads)
+{
+	asyncRead_t *next;
+
+	for (; reads; reads = next) {
+		next = reads->next;
+		FreeAsyncRead(reads);
+	}
+}
+
+/*
+=================
+idFileSystemLocal::TakePrefetchedRead
+
+Removes a prefetch of the given file from the queue and makes sure it has been read,
+returns NULL if the file wasn't prefetched.
+=================
+*/
+asyncRead_t *idFileSystemLocal::TakePrefetchedRead(const char *relativePath)
+{
+	asyncRead_t 		*read;
+	asyncReadState_t	state;
+
+	if (!asyncReads) {
+		return NULL;
+	}
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (read = asyncReads; read; read = read->next) {
+		if (read->prefetch && !read->cancelled && !FilenameCompare(read->path, relativePath)) {
+			break;
+		}
+	}
+
+	if (!read) {
+		Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+		return NULL;
+	}
+
+	UnlinkAsyncRead(read);
+	state = read->state;
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	if (state == ASYNCREAD_QUEUED) {
+		// the read thread hasn't got to it yet, it's quicker to read it right here
+		PerformAsyncRead(read);
+		read->state = state = ASYNCREAD_DONE;
+	}
+
+	while (state != ASYNCREAD_DONE) {
+		Sys_WaitForEvent(TRIGGER_EVENT_THREE);
+
+		Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+		state = read->state;
+		Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+	}
+
+	return read;
+}
+
+/*
+=================
+idFileSystemLocal::ClaimPrefetchedFile
+
+Hands a prefetched file over as if it was read with ReadFileMapped, returns -1 if
+it wasn't prefetched. Mappings are copied if mapped is NULL.
+=================
+*/
+int idFileSystemLocal::ClaimPrefetchedFile(const char *relativePath, const void **buffer, bool *mapped, ID_TIME_T *timestamp, idStr *fullPath)
+{
+	asyncRead_t *read;
+	byte 		*buf;
+	int			len;
+
+	read = TakePrefetchedRead(relativePath);
+
+	if (!read) {
+		return -1;
+	}
+
+	len = read->length;
+
+	if (len < 0) {
+		FreeAsyncRead(read);
+		return -1;
+	}
+
+	if (mapped) {
+		*mapped = read->mapped;
+	}
+
+	if (!read->mapped) {
+		*buffer = read->buffer;
+		read->buffer = NULL;
+		AddToReadCount(len);
+	} else if (mapped) {
+		*buffer = KeepMapping(static_cast<idFile_Mapped *>(read->file));
+	} else {
+		buf = (byte *)Mem_Alloc(len + 1);
+		memcpy(buf, read->buffer, len);
+		buf[len] = 0;
+		*buffer = buf;
+	}
+
+	if (timestamp) {
+		*timestamp = read->timestamp;
+	}
+
+	if (fullPath) {
+		*fullPath = read->file->GetFullPath();
+	}
+
+	loadCount++;
+	prefetchHitCount++;
+	FreeAsyncRead(read);
+	return len;
+}
+
+/*
+=================
+idFileSystemLocal::ReadFileAsync
+=================
+*/
+int idFileSystemLocal::ReadFileAsync(const char *relativePath, asyncReadPriority_t priority, void *userData)
+{
+	asyncRead_t *read;
+
+	if (!searchPaths) {
+		common->FatalError("Filesystem call made without initialization\n");
+	}
+
+	if (!relativePath || !relativePath[0]) {
+		common->FatalError("idFileSystemLocal::ReadFileAsync with empty name\n");
+	}
+
+	// a prefetch of the same file simply becomes this read
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (read = asyncReads; read; read = read->next) {
+		if (read->prefetch && !read->cancelled && !FilenameCompare(read->path, relativePath)) {
+			read->prefetch = false;
+			read->priority = priority;
+			read->userData = userData;
+			break;
+		}
+	}
+
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	if (read) {
+		prefetchHitCount++;
+		prefetchBytes -= read->reserved;
+		read->reserved = 0;
+		return read->handle;
+	}
+
+	read = QueueAsyncRead(relativePath, priority, userData, false);
+
+	return read ? read->handle : 0;
+}
+
+/*
+=================
+idFileSystemLocal::CancelReadAsync
+=================
+*/
+void idFileSystemLocal::CancelReadAsync(int handle)
+{
+	asyncRead_t *read;
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (read = asyncReads; read; read = read->next) {
+		if (read->handle == handle) {
+			break;
+		}
+	}
+
+	if (read && read->state == ASYNCREAD_READING) {
+		// picked up by GetCompletedRead once the thread is done with it
+		read->cancelled = true;
+		read = NULL;
+	} else if (read) {
+		UnlinkAsyncRead(read);
+	}
+
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	if (read) {
+		FreeAsyncRead(read);
+	}
+}
+
+/*
+=================
+idFileSystemLocal::GetCompletedRead
+=================
+*/
+bool idFileSystemLocal::GetCompletedRead(asyncReadResult_t &result)
+{
+	asyncRead_t *read, *next, *freed;
+
+	freed = NULL;
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (read = asyncReads; read; read = next) {
+		next = read->next;
+
+		if (read->state != ASYNCREAD_DONE) {
+			continue;
+		}
+
+		if (read->cancelled) {
+			UnlinkAsyncRead(read);
+			read->next = freed;
+			freed = read;
+			continue;
+		}
+
+		if (!read->prefetch) {
+			UnlinkAsyncRead(read);
+			break;
+		}
+	}
+
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	FreeAsyncReads(freed);
+
+	if (!read) {
+		return false;
+	}
+
+	result.handle = read->handle;
+	result.userData = read->userData;
+	result.buffer = NULL;
+	result.length = read->length;
+	result.timestamp = read->timestamp;
+	result.mapped = read->mapped;
+
+	if (read->length >= 0) {
+		if (read->mapped) {
+			result.buffer = KeepMapping(static_cast<idFile_Mapped *>(read->file));
+		} else {
+			result.buffer = read->buffer;
+			AddToReadCount(read->length);
+		}
+
+		read->buffer = NULL;
+
+		loadCount++;
+	}
+
+	FreeAsyncRead(read);
+	return true;
+}
+
+/*
+=================
+idFileSystemLocal::PrefetchFile
+=================
+*/
+bool idFileSystemLocal::PrefetchFile(const char *relativePath)
+{
+	asyncRead_t *read;
+
+	if (!searchPaths) {
+		common->FatalError("Filesystem call made without initialization\n");
+	}
+
+	if (prefetchBytes >= fs_prefetchMB.GetInteger() << 20) {
+		return false;
+	}
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (read = asyncReads; read; read = read->next) {
+		if (read->prefetch && !read->cancelled && !FilenameCompare(read->path, relativePath)) {
+			break;
+		}
+	}
+
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	if (read) {
+		return true;
+	}
+
+	read = QueueAsyncRead(relativePath, ASYNCREAD_PRIORITY_NORMAL, NULL, true);
+
+	if (!read) {
+		return false;
+	}
+
+	prefetchCount++;
+	return true;
+}
+
+/*
+=================
+idFileSystemLocal::ClearPrefetchedFiles
+=================
+*/
+void idFileSystemLocal::ClearPrefetchedFiles(void)
+{
+	asyncRead_t *read, *next, *freed;
+
+	freed = NULL;
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (read = asyncReads; read; read = next) {
+		next = read->next;
+
+		if (!read->prefetch && !read->cancelled) {
+			continue;
+		}
+
+		if (read->state == ASYNCREAD_READING) {
+			read->cancelled = true;
+			continue;
+		}
+
+		UnlinkAsyncRead(read);
+		read->next = freed;
+		freed = read;
+	}
+
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	FreeAsyncReads(freed);
+}
+
+static const int	WARM_EXTRA_FIELD = 64;			// allowance for the local header extra field
+static const int	WARM_MERGE_GAP = 64 * 1024;		// reading over a gap this small beats seeking past it
+
+static int WarmRangeCompare(const warmRange_t *a, const warmRange_t *b)
+{
+	if (a->order != b->order) {
+		return a->order - b->order;
+	}
+
+	return (a->start > b->start) - (a->start < b->start);
+}
+
+/*
+=================
+idFileSystemLocal::WarmFiles
+
+Most files in the paks are compressed, so ahead of time the best that can be done
+is to get their compressed data into the OS file cache. Going through the paks in
+offset order turns the scattered reads of a level load into mostly sequential ones.
+The read ahead is started from the async read thread at low priority.
+=================
+*/
+void idFileSystemLocal::WarmFiles(const idStrList &relativePaths)
+{
+	idList<warmRange_t>	ranges;
+	warmRange_t			range;
+	fileIndexEntry_t 	*entry;
+	pack_t 				*pak;
+	asyncRead_t 		*read, *first, **link;
+	int					i, index, budget;
+
+	if (!searchPaths) {
+		common->FatalError("Filesystem call made without initialization\n");
+	}
+
+	if (!numAsyncReadThreads) {
+		return;
+	}
+
+	ranges.Resize(relativePaths.Num());
+
+	for (i = 0; i < relativePaths.Num(); i++) {
+		index = FindIndexedFile(relativePaths[i]);
+
+		// loose files are left to the OS
+		if (index == -1) {
+			continue;
+		}
+
+		entry = &fileIndex[index];
+		pak = entry->search->pack;
+
+		// the extra field length is in the local header, which would have to be paged in to read it
+		range.pack = pak;
+		range.order = entry->order;
+		range.start = entry->pakFile->offset + ((unz_s *)pak->handle)->byte_before_the_zipfile;
+		range.end = range.start + 30 + entry->pakFile->name.Length() + WARM_EXTRA_FIELD + entry->pakFile->compressedSize;
+
+		if (range.end > (unsigned long)pak->length) {
+			range.end = pak->length;
+		}
+
+		if (range.start >= range.end) {
+			continue;
+		}
+
+		ranges.Append(range);
+	}
+
+	ranges.Sort(WarmRangeCompare);
+
+	first = NULL;
+	link = &first;
+	budget = fs_warmMB.GetInteger() << 20;
+
+	for (i = 0; i < ranges.Num() && budget > 0; i++) {
+		range = ranges[i];
+		warmCount++;
+
+		while (i + 1 < ranges.Num() && ranges[i + 1].pack == range.pack && ranges[i + 1].start <= range.end + WARM_MERGE_GAP) {
+			i++;
+			warmCount++;
+
+			if (ranges[i].end > range.end) {
+				range.end = ranges[i].end;
+			}
+		}
+
+		if (++asyncReadHandle <= 0) {
+			asyncReadHandle = 1;
+		}
+
+		// a prefetch without a path is never handed out, ClearPrefetchedFiles drops it
+		read = new asyncRead_t;
+		read->next = NULL;
+		read->handle = asyncReadHandle;
+		read->priority = ASYNCREAD_PRIORITY_LOW;
+		read->userData = NULL;
+		read->prefetch = true;
+		read->cancelled = false;
+		read->file = NULL;
+		read->buffer = NULL;
+		read->length = range.end - range.start;
+		read->timestamp = 0;
+		read->mapped = false;
+		read->reserved = 0;
+		read->readAheadPack = range.pack;
+		read->readAheadOffset = range.start;
+		read->state = ASYNCREAD_QUEUED;
+
+		budget -= read->length;
+		warmBytes += read->length;
+
+		*link = read;
+		link = &read->next;
+	}
+
+	if (!first) {
+		return;
+	}
+
+	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+	for (link = &asyncReads; *link; link = &(*link)->next) {
+	}
+
+	*link = first;
+	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+	WakeAsyncReadThreads();
+}
+
+/*
+=================
+idFileSystemLocal::StartRecordingFiles
+=================
+*/
+void idFileSystemLocal::StartRecordingFiles(void)
+{
+	recordedFiles.Clear();
+	recordedFileHash.Clear();
+	recordingFiles = true;
+}
+
+/*
+=================
+idFileSystemLocal::StopRecordingFiles
+=================
+*/
+void idFileSystemLocal::StopRecordingFiles(idStrList &relativePaths)
+{
+	relativePaths = recordedFiles;
+
+	recordedFiles.Clear();
+	recordedFileHash.Clear();
+	recordingFiles = false;
+}
+
+/*
+=================
+idFileSystemLocal::RecordOpenedFile
+=================
+*/
+void idFileSystemLocal::RecordOpenedFile(const char *relativePath)
+{
+	if (recordingFiles) {
+		AddUnique(relativePath, recordedFiles, recordedFileHash);
+	}
+}
+
+/*
+=================
+idFileSystemLocal::CancelAllAsyncReads
+
+Throws away every outstanding read, waiting for the one in progress.
+=================
+*/
+void idFileSystemLocal::CancelAllAsyncReads(void)
+{
+	asyncRead_t *read, *next, *freed;
+	bool		reading;
+
+	do {
+		reading = false;
+		freed = NULL;
+
+		Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
+
+		for (read = asyncReads; read; read = next) {
+			next = read->next;
+
+			if (read->state == ASYNCREAD_READING) {
+				read->cancelled = true;
+				reading = true;
+				continue;
+			}
+
+			UnlinkAsyncRead(read);
+			read->next = freed;
+			freed = read;
+		}
+
+		Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
+
+		FreeAsyncReads(freed);
+
+		if (reading) {
+			Sys_WaitForEvent(TRIGGER_EVENT_THREE);
+		}
+	} while (reading);
+}
+
 /*
 =================
 idFileSystemLocal::PerformingCopyFiles
@@ -4238,7 +5914,7 @@ pack_t *idFileSystemLocal::FindPakForFileChecksum(const char *relativePath, int
 
 			for (pakFile = pak->hashTable[ hash ]; pakFile; pakFile = pakFile->next) {
 				if (!FilenameCompare(pakFile->name, relativePath)) {
-					idFile_InZip *file = ReadFileFromZip(pak, pakFile, relativePath);
+					idFile *file = ReadFileFromZip(pak, pakFile, relativePath);
 
 					if (findChecksum == GetFileChecksum(file)) {
 						if (fs_debug.GetBool()) {
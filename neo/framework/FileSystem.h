@@ -118,6 +118,21 @@ typedef struct backgroundDownload_s {
 	volatile bool		completed;
 } backgroundDownload_t;
 
+typedef enum {
+	ASYNCREAD_PRIORITY_LOW,				// paging in pak data ahead of time
+	ASYNCREAD_PRIORITY_NORMAL,
+	ASYNCREAD_PRIORITY_HIGH
+} asyncReadPriority_t;
+
+typedef struct asyncReadResult_s {
+	int					handle;			// as returned by ReadFileAsync
+	void 				*userData;		// as passed to ReadFileAsync
+	const void 		*buffer;		// NULL if the read failed, release with FreeFileMapped
+	int					length;			// -1 if the read failed
+	ID_TIME_T			timestamp;
+	bool				mapped;			// buffer is a memory mapping and is not 0 terminated
+} asyncReadResult_t;
+
 // file list for directory listings
 class idFileList
 {
@@ -237,6 +252,15 @@ class idFileSystem
 		virtual int				ReadFile(const char *relativePath, void **buffer, ID_TIME_T *timestamp = NULL) = 0;
 		// Frees the memory allocated by ReadFile.
 		virtual void			FreeFile(void *buffer) = 0;
+		// Reads a complete file without copying it when possible.
+		// Large entries stored uncompressed in a pak are returned as a read-only memory mapping
+		// and *mapped is set to true, such a buffer is NOT 0 terminated.
+		// Anything else is read into a Mem_Alloc'ed 0 terminated buffer like ReadFile.
+		// fullPath is set to what idFile::GetFullPath would return for the file.
+		// Returns the length of the file, or -1 on failure.
+		virtual int				ReadFileMapped(const char *relativePath, const void **buffer, bool *mapped = NULL, ID_TIME_T *timestamp = NULL, idStr *fullPath = NULL) = 0;
+		// Frees the buffer returned by ReadFileMapped or GetCompletedRead, mappings are unmapped.
+		virtual void			FreeFileMapped(const void *buffer) = 0;
 		// Writes a complete file, will create any needed subdirectories.
 		// Returns the length of the file, or -1 on failure.
 		virtual int				WriteFile(const char *relativePath, const void *buffer, int size, const char *basePath = "fs_savepath") = 0;
@@ -258,6 +282,28 @@ class idFileSystem
 		virtual void			CloseFile(idFile *f) = 0;
 		// Returns immediately, performing the read from a background thread.
 		virtual void			BackgroundDownload(backgroundDownload_t *bgl) = 0;
+		// Queues a complete file read on the asynchronous read thread. The file is looked up right away,
+		// only the actual reading and inflating is done in the background.
+		// Returns a handle for the read, or 0 if the file doesn't exist.
+		virtual int				ReadFileAsync(const char *relativePath, asyncReadPriority_t priority = ASYNCREAD_PRIORITY_NORMAL, void *userData = NULL) = 0;
+		// Cancels a read, its result will never be returned by GetCompletedRead.
+		virtual void			CancelReadAsync(int handle) = 0;
+		// Polls for a finished read, returns false when there is nothing to pick up.
+		// Should be called from the thread that issued the reads.
+		virtual bool			GetCompletedRead(asyncReadResult_t &result) = 0;
+		// Reads a file ahead of time on the asynchronous read thread, the result is handed over
+		// to the next ReadFile, ReadFileMapped or OpenFileRead of the same path.
+		// Returns false if the file doesn't exist or the prefetch budget is used up.
+		virtual bool			PrefetchFile(const char *relativePath) = 0;
+		// Drops all prefetched files that haven't been picked up.
+		virtual void			ClearPrefetchedFiles(void) = 0;
+		// Reads the pak data of the files into the OS file cache from the async read thread, in pak order.
+		// Nothing is held on the heap, ClearPrefetchedFiles drops what hasn't been started yet.
+		virtual void			WarmFiles(const idStrList &relativePaths) = 0;
+		// Notes the name of every file opened for reading until StopRecordingFiles.
+		virtual void			StartRecordingFiles(void) = 0;
+		// Each file is listed once, in the order it was first opened.
+		virtual void			StopRecordingFiles(idStrList &relativePaths) = 0;
 		// resets the bytes read counter
 		virtual void			ResetReadCount(void) = 0;
 		// retrieves the current read count
@@ -44,6 +44,8 @@ idCVar	idSessionLocal::com_aviDemoHeight("com_aviDemoHeight", "256", CVAR_SYSTEM
 idCVar	idSessionLocal::com_aviDemoTics("com_aviDemoTics", "2", CVAR_SYSTEM | CVAR_INTEGER, "", 1, 60);
 idCVar	idSessionLocal::com_wipeSeconds("com_wipeSeconds", "1", CVAR_SYSTEM, "");
 idCVar	idSessionLocal::com_guid("com_guid", "", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_ROM, "");
+idCVar	idSessionLocal::com_levelManifest("com_levelManifest", "1", CVAR_SYSTEM | CVAR_BOOL, "record the files and decls each level touches and page them in on the next load");
+idCVar	idSessionLocal::com_levelManifestSeconds("com_levelManifestSeconds", "30", CVAR_SYSTEM | CVAR_INTEGER, "seconds of play after a level load that go into its manifest", 0, 600);
 
 idSessionLocal		sessLocal;
 idSession			*session = &sessLocal;
@@ -334,6 +336,9 @@ void idSessionLocal::Clear()
 	savegameVersion = 0;
 
 	currentMapName.Clear();
+	manifestMapName.Clear();
+	manifestStopTime = 0;
+	manifestFiles.Clear();
 	aviDemoShortName.Clear();
 	msgFireBack[ 0 ].Clear();
 	msgFireBack[ 1 ].Clear();
@@ -1545,9 +1550,129 @@ void idSessionLocal::UnloadMap()
 		StopRecordingRenderDemo();
 	}
 
+	if (manifestMapName.Length()) {
+		EndLevelManifest();
+	}
+
 	mapSpawned = false;
 }
 
+/*
+===============
+idSessionLocal::BeginLevelManifest
+
+The manifest lists the files and decls the level touched the last time it was
+loaded. The files are paged in ahead of the load and the decls touched, then
+recording starts over. What gets replayed is recorded again, so a manifest
+only ever grows by what the level touches.
+===============
+*/
+void idSessionLocal::BeginLevelManifest(const char *mapName)
+{
+	idLexer		src(LEXFL_NOFATALERRORS | LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES);
+	idToken		token, typeName, declName;
+	idStrList	declTypes, declNames;
+	declType_t	type;
+	int			i;
+
+	manifestMapName = mapName;
+	manifestStopTime = 0;
+	manifestFiles.Clear();
+
+	if (src.LoadFile(manifestMapName + ".manifest")) {
+		while (src.ReadToken(&token)) {
+			if (token == "file") {
+				if (!src.ReadToken(&token)) {
+					break;
+				}
+
+				manifestFiles.Append(token);
+			} else if (token == "decl") {
+				if (!src.ReadToken(&typeName) || !src.ReadToken(&declName)) {
+					break;
+				}
+
+				declTypes.Append(typeName);
+				declNames.Append(declName);
+			} else {
+				src.Warning("unknown manifest entry '%s'", token.c_str());
+				break;
+			}
+		}
+
+		common->Printf("level manifest: %d files, %d decls\n", manifestFiles.Num(), declNames.Num());
+	}
+
+	fileSystem->StartRecordingFiles();
+	declManager->StartRecordingDecls();
+
+	fileSystem->WarmFiles(manifestFiles);
+
+	for (i = 0; i < declNames.Num(); i++) {
+		type = declManager->GetDeclTypeFromName(declTypes[i]);
+
+		if (type != DECL_MAX_TYPES) {
+			declManager->FindType(type, declNames[i], false);
+		}
+	}
+}
+
+/*
+===============
+idSessionLocal::EndLevelManifest
+
+Writes out what the level touched and reports how much of it the old manifest knew about.
+===============
+*/
+void idSessionLocal::EndLevelManifest()
+{
+	idStrList				files;
+	idList<const idDecl *>	decls;
+	idHashIndex				hash;
+	idFile					*f;
+	int						i, j, hits;
+
+	fileSystem->StopRecordingFiles(files);
+	declManager->StopRecordingDecls(decls);
+
+	for (i = 0; i < manifestFiles.Num(); i++) {
+		hash.Add(hash.GenerateKey(manifestFiles[i], false), i);
+	}
+
+	hits = 0;
+
+	for (i = 0; i < files.Num(); i++) {
+		for (j = hash.First(hash.GenerateKey(files[i], false)); j != -1; j = hash.Next(j)) {
+			if (!manifestFiles[j].Icmp(files[i])) {
+				hits++;
+				break;
+			}
+		}
+	}
+
+	common->Printf("level manifest: %d of %d files read were listed (%d%% hit rate)\n", hits, files.Num(), files.Num() ? hits * 100 / files.Num() : 100);
+
+	f = fileSystem->OpenFileWrite(manifestMapName + ".manifest");
+
+	if (f) {
+		f->Printf("// files and decls touched while loading %s and shortly after\n\n", manifestMapName.c_str());
+
+		for (i = 0; i < files.Num(); i++) {
+			f->Printf("file \"%s\"\n", files[i].c_str());
+		}
+
+		for (i = 0; i < decls.Num(); i++) {
+			f->Printf("decl %s \"%s\"\n", declManager->GetDeclNameFromType(decls[i]->GetType()), decls[i]->GetName());
+		}
+
+		fileSystem->CloseFile(f);
+	}
+
+	manifestMapName.Clear();
+	manifestStopTime = 0;
+	manifestFiles.Clear();
+}
+
 /*
 ===============
 idSessionLocal::LoadLoadingGui
@@ -1681,7 +1806,13 @@ void idSessionLocal::ExecuteMapChange(bool noFadeWipe)
 	fullMapName.StripFileExtension();
 
 	// shut down the existing game if it is running
-	UnloadMap();
+	if (mapSpawned) {
+		int unloadStart = Sys_Milliseconds();
+		UnloadMap();
+		common->Printf("%6d msec to unload %s\n", Sys_Milliseconds() - unloadStart, currentMapName.c_str());
+	} else {
+		UnloadMap();
+	}
 
 	// don't do the deferred caching if we are reloading the same map
 	if (fullMapName == currentMapName) {
@@ -1696,6 +1827,11 @@ void idSessionLocal::ExecuteMapChange(bool noFadeWipe)
 		declManager->BeginLevelLoad();
 		renderSystem->BeginLevelLoad();
 		soundSystem->BeginLevelLoad();
+
+		// page in what the level touched last time, and note what it touches this time
+		if (com_levelManifest.GetBool()) {
+			BeginLevelManifest(fullMapName);
+		}
 	}
 
 	uiManager->BeginLevelLoad();
@@ -1736,6 +1872,7 @@ void idSessionLocal::ExecuteMapChange(bool noFadeWipe)
 	}
 
 	int start = Sys_Milliseconds();
+	int stringAllocs = idStr::GetNumAllocs();
 
 	common->Printf("--------- Map Initialization ---------\n");
 	common->Printf("Map: %s\n", mapString.c_str());
@@ -1789,6 +1926,9 @@ void idSessionLocal::ExecuteMapChange(bool noFadeWipe)
 
 	uiManager->EndLevelLoad();
 
+	// prefetched files nobody asked for are just holding memory
+	fileSystem->ClearPrefetchedFiles();
+
 	if (!idAsyncNetwork::IsActive() && !loadingSaveGame) {
 		// run a few frames to allow everything to settle
 		for (i = 0; i < 10; i++) {
@@ -1800,6 +1940,12 @@ void idSessionLocal::ExecuteMapChange(bool noFadeWipe)
 
 	int	msec = Sys_Milliseconds() - start;
 	common->Printf("%6d msec to load %s\n", msec, mapString.c_str());
+	common->Printf("%6d string allocations\n", idStr::GetNumAllocs() - stringAllocs);
+
+	// keep recording into the first seconds of play
+	if (manifestMapName.Length()) {
+		manifestStopTime = Sys_Milliseconds() + com_levelManifestSeconds.GetInteger() * 1000;
+	}
 
 	// let the renderSystem generate interactions now that everything is spawned
 	rw->GenerateAllInteractions();
@@ -2715,6 +2861,10 @@ void idSessionLocal::Frame()
 		return;
 	}
 
+	if (manifestStopTime && Sys_Milliseconds() >= manifestStopTime) {
+		EndLevelManifest();
+	}
+
 	// if the console is down, we don't need to hold
 	// the mouse cursor
 	if (console->Active() || com_editorActive) {
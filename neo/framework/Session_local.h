@@ -174,6 +174,8 @@ class idSessionLocal : public idSession
 		static idCVar		com_aviDemoTics;
 		static idCVar		com_wipeSeconds;
 		static idCVar		com_guid;
+		static idCVar		com_levelManifest;
+		static idCVar		com_levelManifestSeconds;
 
 		static idCVar		gui_configServerRate;
 
@@ -196,6 +198,10 @@ class idSessionLocal : public idSession
 		idStr				currentMapName;			// for checking reload on same level
 		bool				mapSpawned;				// cleared on Stop()
 
+		idStr				manifestMapName;		// level whose files and decls are being recorded
+		int					manifestStopTime;		// when to stop recording, 0 while the level loads
+		idStrList			manifestFiles;			// listed by the manifest the level was loaded with
+
 		int					numClients;				// from serverInfo
 
 		int					logIndex;
@@ -305,6 +311,9 @@ class idSessionLocal : public idSession
 		void				ExecuteMapChange(bool noFadeWipe = false);
 		void				UnloadMap();
 
+		void				BeginLevelManifest(const char *mapName);
+		void				EndLevelManifest();
+
 		// return true if we actually waiting on an auth reply
 		bool				MaybeWaitOnCDKey(void);
 
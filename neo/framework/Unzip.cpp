@@ -1966,11 +1966,105 @@ extern int unzOpenCurrentFile(unzFile file)
 
 	pfile_in_zip_read_info->stream.avail_in = (uInt)0;
 
+	pfile_in_zip_read_info->source = NULL;
 
 	s->pfile_in_zip_read = pfile_in_zip_read_info;
 	return UNZ_OK;
 }
 
+extern int unzGetCurrentFileDataRange(unzFile file, unsigned long *offset, unsigned long *length)
+{
+	unz_s *s;
+	file_in_zip_read_info_s *pfile_in_zip_read_info;
+
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+
+	s=(unz_s *)file;
+	pfile_in_zip_read_info=s->pfile_in_zip_read;
+
+	if (pfile_in_zip_read_info==NULL)
+		return UNZ_PARAMERROR;
+
+	*offset = pfile_in_zip_read_info->pos_in_zipfile + s->byte_before_the_zipfile;
+	*length = s->cur_file_info.compressed_size;
+	return UNZ_OK;
+}
+
+extern int unzSetCurrentFileSource(unzFile file, const void *source)
+{
+	unz_s *s;
+	file_in_zip_read_info_s *pfile_in_zip_read_info;
+
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+
+	s=(unz_s *)file;
+	pfile_in_zip_read_info=s->pfile_in_zip_read;
+
+	if (pfile_in_zip_read_info==NULL)
+		return UNZ_PARAMERROR;
+
+	if (pfile_in_zip_read_info->stream.total_out!=0 ||
+	    pfile_in_zip_read_info->rest_read_compressed!=s->cur_file_info.compressed_size)
+		return UNZ_PARAMERROR;
+
+	pfile_in_zip_read_info->source = (const unsigned char *)source;
+	return UNZ_OK;
+}
+
+static voidp unz_threadsafe_alloc(voidp opaque, unsigned items, unsigned size)
+{
+	return (voidp)calloc(items, size);
+}
+
+static void unz_threadsafe_free(voidp opaque, voidp ptr)
+{
+	free(ptr);
+}
+
+/*
+  Restart the inflate stream of the current file on the C runtime allocator,
+  inflate allocates while decoding and the engine heap isn't thread safe.
+  Must be called before anything is read from the current file.
+*/
+extern int unzSetCurrentFileThreadSafe(unzFile file)
+{
+	int err;
+	unz_s *s;
+	file_in_zip_read_info_s *pfile_in_zip_read_info;
+
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+
+	s=(unz_s *)file;
+	pfile_in_zip_read_info=s->pfile_in_zip_read;
+
+	if (pfile_in_zip_read_info==NULL)
+		return UNZ_PARAMERROR;
+
+	if (!pfile_in_zip_read_info->stream_initialised)
+		return UNZ_OK;
+
+	if (pfile_in_zip_read_info->stream.total_out != 0)
+		return UNZ_PARAMERROR;
+
+	inflateEnd(&pfile_in_zip_read_info->stream);
+	pfile_in_zip_read_info->stream_initialised=0;
+
+	pfile_in_zip_read_info->stream.zalloc = (alloc_func)unz_threadsafe_alloc;
+	pfile_in_zip_read_info->stream.zfree = (free_func)unz_threadsafe_free;
+	pfile_in_zip_read_info->stream.opaque = (voidp)0;
+
+	err=inflateInit2(&pfile_in_zip_read_info->stream, -MAX_WBITS);
+
+	if (err != Z_OK)
+		return UNZ_INTERNALERROR;
+
+	pfile_in_zip_read_info->stream_initialised=1;
+	return UNZ_OK;
+}
+
 
 /*
   Read bytes from the current file.
@@ -2013,7 +2107,43 @@ extern int unzReadCurrentFile(unzFile file, void *buf, unsigned len)
 		pfile_in_zip_read_info->stream.avail_out =
 		        (uInt)pfile_in_zip_read_info->rest_read_uncompressed;
 
+	/* the whole file in one go, straight out of the mapping */
+	if ((pfile_in_zip_read_info->source != NULL) &&
+	    (pfile_in_zip_read_info->compression_method==Z_DEFLATED) &&
+	    (pfile_in_zip_read_info->stream.total_out==0) &&
+	    (pfile_in_zip_read_info->rest_read_compressed==s->cur_file_info.compressed_size) &&
+	    (pfile_in_zip_read_info->stream.avail_out==s->cur_file_info.uncompressed_size) &&
+	    (s->cur_file_info.uncompressed_size>0)) {
+		iRead = unzInflateRaw(buf, pfile_in_zip_read_info->stream.avail_out,
+		                      pfile_in_zip_read_info->source,
+		                      pfile_in_zip_read_info->rest_read_compressed);
+
+		if (iRead == s->cur_file_info.uncompressed_size) {
+			/* the crc isn't checked on close by anyone, don't spend the time on it */
+			pfile_in_zip_read_info->crc32 = pfile_in_zip_read_info->crc32_wait;
+			pfile_in_zip_read_info->rest_read_compressed = 0;
+			pfile_in_zip_read_info->rest_read_uncompressed = 0;
+			pfile_in_zip_read_info->stream.avail_out = 0;
+			pfile_in_zip_read_info->stream.total_out = iRead;
+			return iRead;
+		}
+
+		/* let inflate find out what's wrong with it */
+		iRead = 0;
+	}
+
 	while (pfile_in_zip_read_info->stream.avail_out>0) {
+		if ((pfile_in_zip_read_info->stream.avail_in==0) &&
+		    (pfile_in_zip_read_info->rest_read_compressed>0) &&
+		    (pfile_in_zip_read_info->source != NULL)) {
+			/* everything that is left, no copying */
+			pfile_in_zip_read_info->stream.next_in = (Byte *)pfile_in_zip_read_info->source +
+			        (s->cur_file_info.compressed_size - pfile_in_zip_read_info->rest_read_compressed);
+			pfile_in_zip_read_info->stream.avail_in = (uInt)pfile_in_zip_read_info->rest_read_compressed;
+			pfile_in_zip_read_info->pos_in_zipfile += pfile_in_zip_read_info->rest_read_compressed;
+			pfile_in_zip_read_info->rest_read_compressed = 0;
+		}
+
 		if ((pfile_in_zip_read_info->stream.avail_in==0) &&
 		    (pfile_in_zip_read_info->rest_read_compressed>0)) {
 			uInt uReadThis = UNZ_BUFSIZE;
@@ -4638,3 +4768,314 @@ void  zcfree(voidp opaque, voidp ptr)
 
 	if (opaque) return; /* make compiler happy */
 }
+
+
+/* one shot inflate
+ * With the whole stream and the whole output in memory there is no window to
+ * maintain and nothing to flush, literals go straight to the output and matches
+ * are copied from what was already written. Codes up to UNZ_FAST_BITS long are
+ * decoded with a single table lookup, longer ones a bit at a time.
+ */
+
+#define UNZ_FAST_BITS	10
+
+typedef struct {
+	unsigned short fast[1 << UNZ_FAST_BITS]; /* symbol << 4 | code length, 0 for longer codes */
+	unsigned short count[16];          /* number of codes of each length */
+	unsigned short symbol[288];        /* symbols ordered by code */
+} unz_huffman_t;
+
+typedef struct {
+	const unsigned char *in;
+	const unsigned char *in_end;
+	unsigned int bitbuf;
+	int bitcnt;
+	int pad;                           /* zero bytes fed in past the end of the input */
+} unz_bitstream_t;
+
+static void unz_refill(unz_bitstream_t *b)
+{
+	while (b->bitcnt <= 24) {
+		if (b->in < b->in_end)
+			b->bitbuf |= (unsigned int)*b->in++ << b->bitcnt;
+		else
+			b->pad++;
+
+		b->bitcnt += 8;
+	}
+}
+
+static int unz_getbits(unz_bitstream_t *b, int n)
+{
+	int v;
+
+	unz_refill(b);
+	v = b->bitbuf & ((1u << n) - 1);
+	b->bitbuf >>= n;
+	b->bitcnt -= n;
+	return v;
+}
+
+static int unz_build_huffman(unz_huffman_t *h, const unsigned char *lengths, int n)
+{
+	unsigned short offs[16];
+	int left, len, sym, code, i, j, k, rev;
+
+	memset(h->count, 0, sizeof(h->count));
+
+	for (sym = 0; sym < n; sym++)
+		h->count[lengths[sym]]++;
+
+	/* over subscribed sets can't be decoded, incomplete ones fail when a missing code shows up */
+	left = 1;
+
+	for (len = 1; len < 16; len++) {
+		left <<= 1;
+		left -= h->count[len];
+
+		if (left < 0)
+			return Z_DATA_ERROR;
+	}
+
+	offs[1] = 0;
+
+	for (len = 1; len < 15; len++)
+		offs[len + 1] = offs[len] + h->count[len];
+
+	for (sym = 0; sym < n; sym++)
+		if (lengths[sym] != 0)
+			h->symbol[offs[lengths[sym]]++] = (unsigned short)sym;
+
+	/* canonical codes are handed out in symbol order, and stored bit reversed */
+	memset(h->fast, 0, sizeof(h->fast));
+	code = 0;
+	i = 0;
+
+	for (len = 1; len <= UNZ_FAST_BITS; len++) {
+		for (k = 0; k < h->count[len]; k++, i++, code++) {
+			for (rev = 0, j = 0; j < len; j++)
+				rev |= ((code >> j) & 1) << (len - 1 - j);
+
+			for (j = rev; j < (1 << UNZ_FAST_BITS); j += 1 << len)
+				h->fast[j] = (unsigned short)((h->symbol[i] << 4) | len);
+		}
+
+		code <<= 1;
+	}
+
+	return Z_OK;
+}
+
+static int unz_decode(unz_bitstream_t *b, const unz_huffman_t *h)
+{
+	int entry, code, first, index, count, len;
+
+	unz_refill(b);
+	entry = h->fast[b->bitbuf & ((1 << UNZ_FAST_BITS) - 1)];
+
+	if (entry != 0) {
+		b->bitbuf >>= entry & 15;
+		b->bitcnt -= entry & 15;
+		return entry >> 4;
+	}
+
+	code = first = index = 0;
+
+	for (len = 1; len < 16; len++) {
+		code |= b->bitbuf & 1;
+		b->bitbuf >>= 1;
+		b->bitcnt--;
+		count = h->count[len];
+
+		if (code - count < first)
+			return h->symbol[index + (code - first)];
+
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+	}
+
+	return -1;
+}
+
+extern int unzInflateRaw(void *dest, unsigned destLen, const void *source, unsigned sourceLen)
+{
+	unz_bitstream_t b;
+	unz_huffman_t lencode, distcode;
+	unsigned char lengths[320];
+	unsigned char *out, *out_end, *from;
+	int last, type, sym, len, dist, i, n, nlen, ndist, ncode;
+
+	b.in = (const unsigned char *)source;
+	b.in_end = b.in + sourceLen;
+	b.bitbuf = 0;
+	b.bitcnt = 0;
+	b.pad = 0;
+
+	out = (unsigned char *)dest;
+	out_end = out + destLen;
+
+	do {
+		last = unz_getbits(&b, 1);
+		type = unz_getbits(&b, 2);
+
+		if (type == 0) {
+			/* stored, the whole bytes left in the bit buffer go back to the input */
+			b.bitbuf >>= b.bitcnt & 7;
+			b.bitcnt &= ~7;
+
+			if (b.pad * 8 > b.bitcnt)
+				return Z_DATA_ERROR;
+
+			b.in -= (b.bitcnt >> 3) - b.pad;
+			b.bitbuf = 0;
+			b.bitcnt = 0;
+			b.pad = 0;
+
+			if (b.in_end - b.in < 4)
+				return Z_DATA_ERROR;
+
+			len = b.in[0] | (b.in[1] << 8);
+
+			if ((b.in[2] | (b.in[3] << 8)) != (~len & 0xffff))
+				return Z_DATA_ERROR;
+
+			b.in += 4;
+
+			if (len > b.in_end - b.in || len > out_end - out)
+				return Z_DATA_ERROR;
+
+			memcpy(out, b.in, len);
+			b.in += len;
+			out += len;
+			continue;
+		}
+
+		if (type == 1) {
+			for (i = 0; i < 144; i++)
+				lengths[i] = 8;
+
+			for (; i < 256; i++)
+				lengths[i] = 9;
+
+			for (; i < 280; i++)
+				lengths[i] = 7;
+
+			for (; i < 288; i++)
+				lengths[i] = 8;
+
+			for (; i < 288 + 30; i++)
+				lengths[i] = 5;
+
+			nlen = 288;
+			ndist = 30;
+		} else if (type == 2) {
+			nlen = unz_getbits(&b, 5) + 257;
+			ndist = unz_getbits(&b, 5) + 1;
+			ncode = unz_getbits(&b, 4) + 4;
+
+			if (nlen > 286 || ndist > 30)
+				return Z_DATA_ERROR;
+
+			memset(lengths, 0, 19);
+
+			for (i = 0; i < ncode; i++)
+				lengths[border[i]] = (unsigned char)unz_getbits(&b, 3);
+
+			if (unz_build_huffman(&lencode, lengths, 19) != Z_OK)
+				return Z_DATA_ERROR;
+
+			for (i = 0; i < nlen + ndist;) {
+				sym = unz_decode(&b, &lencode);
+
+				if (sym < 0)
+					return Z_DATA_ERROR;
+
+				if (sym < 16) {
+					lengths[i++] = (unsigned char)sym;
+					continue;
+				}
+
+				len = 0;
+
+				if (sym == 16) {
+					if (i == 0)
+						return Z_DATA_ERROR;
+
+					len = lengths[i - 1];
+					n = 3 + unz_getbits(&b, 2);
+				} else if (sym == 17) {
+					n = 3 + unz_getbits(&b, 3);
+				} else {
+					n = 11 + unz_getbits(&b, 7);
+				}
+
+				if (i + n > nlen + ndist)
+					return Z_DATA_ERROR;
+
+				while (n--)
+					lengths[i++] = (unsigned char)len;
+			}
+
+			if (lengths[256] == 0)
+				return Z_DATA_ERROR;
+		} else {
+			return Z_DATA_ERROR;
+		}
+
+		if (unz_build_huffman(&lencode, lengths, nlen) != Z_OK ||
+		    unz_build_huffman(&distcode, lengths + nlen, ndist) != Z_OK)
+			return Z_DATA_ERROR;
+
+		for (;;) {
+			sym = unz_decode(&b, &lencode);
+
+			if (sym < 256) {
+				if (sym < 0 || out == out_end)
+					return Z_DATA_ERROR;
+
+				*out++ = (unsigned char)sym;
+				continue;
+			}
+
+			if (sym == 256)
+				break;
+
+			sym -= 257;
+
+			if (sym >= 29)
+				return Z_DATA_ERROR;
+
+			len = cplens[sym] + unz_getbits(&b, cplext[sym]);
+			sym = unz_decode(&b, &distcode);
+
+			if (sym < 0 || sym >= 30)
+				return Z_DATA_ERROR;
+
+			dist = cpdist[sym] + unz_getbits(&b, cpdext[sym]);
+
+			if (dist > out - (unsigned char *)dest || len > out_end - out)
+				return Z_DATA_ERROR;
+
+			from = out - dist;
+
+			if (dist >= len) {
+				memcpy(out, from, len);
+				out += len;
+			} else {
+				while (len--)
+					*out++ = *from++;
+			}
+		}
+
+		/* bail out of streams that only decode by running off the end */
+		if (b.pad > 4)
+			return Z_DATA_ERROR;
+	} while (!last);
+
+	if (b.pad * 8 > b.bitcnt)
+		return Z_DATA_ERROR;
+
+	return (int)(out - (unsigned char *)dest);
+}
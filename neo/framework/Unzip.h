@@ -134,6 +134,7 @@ typedef struct {
 	FILE *file;                 /* io structore of the zipfile */
 	unsigned long compression_method;   /* compression method (0==store) */
 	unsigned long byte_before_the_zipfile;/* unsigned char before the zipfile, (>0 for sfx)*/
+	const unsigned char *source;        /* compressed data in memory, NULL to read it from file */
 } file_in_zip_read_info_s;
 
 
@@ -291,6 +292,38 @@ extern int unzOpenCurrentFile(unzFile file);
   If there is no error, the return value is UNZ_OK.
 */
 
+extern int unzSetCurrentFileThreadSafe(unzFile file);
+
+/*
+  Switch the inflate state of the current file over to the C runtime allocator,
+  so the file can be read from another thread.
+  Must be called before anything is read from the current file.
+*/
+
+extern int unzGetCurrentFileDataRange(unzFile file, unsigned long *offset, unsigned long *length);
+
+/*
+  Get the offset in the zipfile and the length of the compressed data of the
+  current file opened with unzOpenCurrentFile.
+*/
+
+extern int unzSetCurrentFileSource(unzFile file, const void *source);
+
+/*
+  Tell the unzip package the compressed data of the current file is in memory,
+  it is then read straight from there instead of the zipfile, and a read of a
+  whole deflated file is inflated in one go with unzInflateRaw.
+  Must be called before anything is read from the current file.
+*/
+
+extern int unzInflateRaw(void *dest, unsigned destLen, const void *source, unsigned sourceLen);
+
+/*
+  Inflate a complete raw deflate stream into dest in one call.
+  Doesn't use the heap, so it can be called from any thread.
+  Returns the number of bytes written, or Z_DATA_ERROR.
+*/
+
 extern int unzCloseCurrentFile(unzFile file);
 
 /*
@@ -36,8 +36,9 @@ DOOM III gold:	33
 1.2 XP:			36-39
 1.3 patch:		40
 1.3.1:			41
+physics LOD:	42
 */
-const int ASYNC_PROTOCOL_MINOR		= 41;
+const int ASYNC_PROTOCOL_MINOR		= 42;
 const int ASYNC_PROTOCOL_VERSION	= (ASYNC_PROTOCOL_MAJOR << 16) + ASYNC_PROTOCOL_MINOR;
 #define MAJOR_VERSION(v) ( v >> 16 )
 
@@ -225,7 +225,7 @@ void idGameEdit::ParseSpawnArgsToRenderEntity(const idDict *args, renderEntity_t
 
 	memset(renderEntity, 0, sizeof(*renderEntity));
 
-	temp = args->GetString("model");
+	temp = args->GetString(KEY_Model);
 
 	modelDef = NULL;
 
@@ -261,11 +261,11 @@ void idGameEdit::ParseSpawnArgsToRenderEntity(const idDict *args, renderEntity_t
 		renderEntity->customShader = declManager->FindMaterial(temp);
 	}
 
-	args->GetVector("origin", "0 0 0", renderEntity->origin);
+	args->GetVector(KEY_Origin, "0 0 0", renderEntity->origin);
 
 	// get the rotation matrix in either full form, or single angle form
-	if (!args->GetMatrix("rotation", "1 0 0 0 1 0 0 0 1", renderEntity->axis)) {
-		angle = args->GetFloat("angle");
+	if (!args->GetMatrix(KEY_Rotation, "1 0 0 0 1 0 0 0 1", renderEntity->axis)) {
+		angle = args->GetFloat(KEY_Angle);
 
 		if (angle != 0.0f) {
 			renderEntity->axis = idAngles(0.0f, angle, 0.0f).ToMat3();
@@ -480,7 +480,7 @@ void idEntity::Spawn(void)
 
 	gameLocal.RegisterEntity(this);
 
-	spawnArgs.GetString("classname", NULL, &classname);
+	spawnArgs.GetString(KEY_Classname, NULL, &classname);
 	const idDeclEntityDef *def = gameLocal.FindEntityDef(classname, false);
 
 	if (def) {
@@ -521,7 +521,7 @@ void idEntity::Spawn(void)
 
 	fl.solidForTeam = spawnArgs.GetBool("solidForTeam", "0");
 	fl.neverDormant = spawnArgs.GetBool("neverDormant", "0");
-	fl.hidden = spawnArgs.GetBool("hide", "0");
+	fl.hidden = spawnArgs.GetBool(KEY_Hide, "0");
 
 	if (fl.hidden) {
 		// make sure we're hidden, since a spawn function might not set it up right
@@ -540,7 +540,7 @@ void idEntity::Spawn(void)
 
 	if (!gameLocal.isClient) {
 		// common->DPrintf( "NET: DBG %s - %s is synced: %s\n", spawnArgs.GetString( "classname", "" ), GetType()->classname, fl.networkSync ? "true" : "false" );
-		if (spawnArgs.GetString("classname", "")[ 0 ] == '\0' && !fl.networkSync) {
+		if (spawnArgs.GetString(KEY_Classname, "")[ 0 ] == '\0' && !fl.networkSync) {
 			common->DPrintf("NET: WRN %s entity, no classname, and no networkSync?\n", GetType()->classname);
 		}
 	}
@@ -548,7 +548,7 @@ void idEntity::Spawn(void)
 #endif
 
 	// every object will have a unique name
-	temp = spawnArgs.GetString("name", va("%s_%s_%d", GetClassname(), spawnArgs.GetString("classname"), entityNumber));
+	temp = spawnArgs.GetString(KEY_Name, va("%s_%s_%d", GetClassname(), spawnArgs.GetString(KEY_Classname), entityNumber));
 	SetName(temp);
 
 	// if we have targets, wait until all entities are spawned to get them
@@ -561,20 +561,20 @@ void idEntity::Spawn(void)
 		}
 	}
 
-	health = spawnArgs.GetInt("health");
+	health = spawnArgs.GetInt(KEY_Health);
 
 	InitDefaultPhysics(origin, axis);
 
 	SetOrigin(origin);
 	SetAxis(axis);
 
-	temp = spawnArgs.GetString("model");
+	temp = spawnArgs.GetString(KEY_Model);
 
 	if (temp && *temp) {
 		SetModel(temp);
 	}
 
-	if (spawnArgs.GetString("bind", "", &temp)) {
+	if (spawnArgs.GetString(KEY_Bind, "", &temp)) {
 		PostEventMS(&EV_SpawnBind, 0);
 	}
 
@@ -881,6 +881,35 @@ void idEntity::Think(void)
 	Present();
 }
 
+/*
+================
+idEntity::NeedsParallelThink
+================
+*/
+bool idEntity::NeedsParallelThink(void) const
+{
+	return false;
+}
+
+/*
+================
+idEntity::ParallelThink
+================
+*/
+void idEntity::ParallelThink(void)
+{
+}
+
+/*
+================
+idEntity::CheckParallelThink
+================
+*/
+bool idEntity::CheckParallelThink(void)
+{
+	return true;
+}
+
 /*
 ================
 idEntity::DoDormantTests
@@ -5356,6 +5385,62 @@ void idAnimatedEntity::Think(void)
 	UpdateDamageEffects();
 }
 
+/*
+================
+idAnimatedEntity::NeedsParallelThink
+
+Only visible animating models, anything else keeps building its frame on demand.
+================
+*/
+bool idAnimatedEntity::NeedsParallelThink(void) const
+{
+	if (!(thinkFlags & TH_ANIMATE) || fl.hidden || modelDefHandle == -1) {
+		return false;
+	}
+
+	return animator.ModelHandle() && animator.IsAnimating(gameLocal.time);
+}
+
+/*
+================
+idAnimatedEntity::ParallelThink
+
+Builds the joints for the current frame so that the render callback and joint
+queries find them up to date.  The pose only depends on the animator's state,
+so building it early gives the same joints as building it on demand.
+================
+*/
+void idAnimatedEntity::ParallelThink(void)
+{
+	animator.CreateFrame(gameLocal.time, false);
+}
+
+/*
+================
+idAnimatedEntity::CheckParallelThink
+================
+*/
+bool idAnimatedEntity::CheckParallelThink(void)
+{
+	idJointMat	*joints;
+	idJointMat	*parallelJoints;
+	int			numJoints;
+
+	animator.GetJoints(&numJoints, &joints);
+
+	// the pose of small models far away is not rebuilt every frame
+	if (!numJoints || !animator.FrameIsCurrent(gameLocal.time)) {
+		return true;
+	}
+
+	parallelJoints = (idJointMat *)_alloca16(numJoints * sizeof(parallelJoints[0]));
+	memcpy(parallelJoints, joints, numJoints * sizeof(parallelJoints[0]));
+
+	animator.CreateFrame(gameLocal.time, true);
+
+	return memcmp(parallelJoints, joints, numJoints * sizeof(parallelJoints[0])) == 0;
+}
+
 /*
 ================
 idAnimatedEntity::UpdateAnimation
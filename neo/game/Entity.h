@@ -172,6 +172,9 @@ class idEntity : public idClass
 
 		// thinking
 		virtual void			Think(void);
+		virtual bool			NeedsParallelThink(void) const;	// ParallelThink runs on the job threads after the serial think and events of the frame
+		virtual void			ParallelThink(void);			// may only touch the entity's own state, no events, spawns or clip model links
+		virtual bool			CheckParallelThink(void);		// redoes the parallel think serially, false when the result differs
 		bool					CheckDormant(void);	// dormant == on the active list, but out of PVS
 		virtual	void			DormantBegin(void);	// called when entity becomes dormant
 		virtual	void			DormantEnd(void);		// called when entity wakes from being dormant
@@ -489,6 +492,9 @@ class idAnimatedEntity : public idEntity
 
 		virtual void			ClientPredictionThink(void);
 		virtual void			Think(void);
+		virtual bool			NeedsParallelThink(void) const;
+		virtual void			ParallelThink(void);
+		virtual bool			CheckParallelThink(void);
 
 		void					UpdateAnimation(void);
 
@@ -191,6 +191,9 @@ class idGame
 		virtual bool				DownloadRequest(const char *IP, const char *guid, const char *paks, char urls[ MAX_STRING_CHARS ]) = 0;
 
 		virtual void				GetMapLoadingGUI(char gui[ MAX_STRING_CHARS ]) = 0;
+
+		// Adds the memory the game module allocated under each allocation tag to stats.
+		virtual void				GetMemTagStats(memTagStats_t stats[MEMTAG_NUM]) = 0;
 };
 
 extern idGame 					*game;
@@ -320,7 +323,7 @@ extern idGameEdit 				*gameEdit;
 ===============================================================================
 */
 
-const int GAME_API_VERSION		= 8;
+const int GAME_API_VERSION		= 9;
 
 typedef struct {
 
@@ -64,6 +64,18 @@ idAnimManager				animationLib;
 idGameLocal					gameLocal;
 idGame 					*game = &gameLocal;	// statically pointed at an idGameLocal
 
+const idDictKey				KEY_Classname("classname");
+const idDictKey				KEY_Name("name");
+const idDictKey				KEY_SpawnClass("spawnclass");
+const idDictKey				KEY_SpawnFunc("spawnfunc");
+const idDictKey				KEY_Model("model");
+const idDictKey				KEY_Origin("origin");
+const idDictKey				KEY_Rotation("rotation");
+const idDictKey				KEY_Angle("angle");
+const idDictKey				KEY_Health("health");
+const idDictKey				KEY_Hide("hide");
+const idDictKey				KEY_Bind("bind");
+
 const char *idGameLocal::sufaceTypeNames[ MAX_SURFACE_TYPES ] = {
 	"none",	"metal", "stone", "flesh", "wood", "cardboard", "liquid", "glass", "plastic",
 	"ricochet", "surftype10", "surftype11", "surftype12", "surftype13", "surftype14", "surftype15"
@@ -183,6 +195,7 @@ void idGameLocal::Clear(void)
 	spawnedEntities.Clear();
 	activeEntities.Clear();
 	numEntitiesToDeactivate = 0;
+	physicsLOD.Clear();
 	sortPushers = false;
 	sortTeamMasters = false;
 	persistentLevelInfo.Clear();
@@ -200,6 +213,7 @@ void idGameLocal::Clear(void)
 	editEntities = NULL;
 	entityHash.Clear(1024, MAX_GENTITIES);
 	inCinematic = false;
+	inParallelThink = false;
 	cinematicSkipTime = 0;
 	cinematicStopTime = 0;
 	cinematicMaxSkipTime = 0;
@@ -950,6 +964,7 @@ void idGameLocal::LoadMap(const char *mapName, int randseed)
 
 	skipCinematic = false;
 	inCinematic = false;
+	inParallelThink = false;
 	cinematicSkipTime = 0;
 	cinematicStopTime = 0;
 	cinematicMaxSkipTime = 0;
@@ -2307,6 +2322,65 @@ void idGameLocal::SortActiveEntityList(void)
 	sortPushers = false;
 }
 
+/*
+================
+idGameLocal::ParallelThinkJob
+================
+*/
+void idGameLocal::ParallelThinkJob(void *data, int index)
+{
+	static_cast<idGameLocal *>(data)->parallelThinkEntities[ index ]->ParallelThink();
+}
+
+/*
+================
+idGameLocal::RunParallelThink
+
+  Runs the parallel part of the entity think on the job threads once the serial
+  think and the events of the frame are done.  The results have to be the same
+  as running it serially in the order of the active entity list, which
+  g_parallelThinkCheck verifies by redoing the work on the main thread.
+================
+*/
+void idGameLocal::RunParallelThink(void)
+{
+	idEntity	*ent;
+	int			i;
+
+	if (!g_parallelThink.GetBool()) {
+		return;
+	}
+
+	for (ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next()) {
+		if (ent->NeedsParallelThink()) {
+			parallelThinkEntities.Append(ent);
+		}
+	}
+
+	inParallelThink = true;
+
+	if (g_debugAnim.GetInteger() != -1) {
+		// keep the debug output in order
+		for (i = 0; i < parallelThinkEntities.Num(); i++) {
+			parallelThinkEntities[ i ]->ParallelThink();
+		}
+	} else {
+		sys->ParallelJobs(ParallelThinkJob, this, parallelThinkEntities.Num());
+	}
+
+	inParallelThink = false;
+
+	if (g_parallelThinkCheck.GetBool()) {
+		for (i = 0; i < parallelThinkEntities.Num(); i++) {
+			if (!parallelThinkEntities[ i ]->CheckParallelThink()) {
+				Warning("%d: entity '%s' differs from the serial think", time, parallelThinkEntities[ i ]->name.c_str());
+			}
+		}
+	}
+
+	parallelThinkEntities.SetNum(0, false);
+}
+
 /*
 ================
 idGameLocal::RunFrame
@@ -2317,7 +2391,7 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t *clientCmds)
 	idEntity 	*ent;
 	int			num;
 	float		ms;
-	idTimer		timer_think, timer_events, timer_singlethink;
+	idTimer		timer_think, timer_events, timer_singlethink, timer_parallel, timer_paths;
 	gameReturn_t ret;
 	idPlayer	*player;
 	const renderView_t *view;
@@ -2349,6 +2423,15 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t *clientCmds)
 			time += msec;
 			realClientTime = time;
 
+			// cached clip queries are only valid within a frame
+			clip.ClearQueryCache();
+
+			// drop the clip models that were unlinked last frame from the clip tree
+			clip.RemoveUnlinkedLeaves();
+
+			// count the physics level of detail of this frame
+			physicsLOD.Clear();
+
 #ifdef GAME_DLL
 
 			// allow changing SIMD usage on the fly
@@ -2469,6 +2552,22 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t *clientCmds)
 			idEvent::ServiceEvents();
 
 			timer_events.Stop();
+			timer_paths.Clear();
+			timer_paths.Start();
+
+			// run the path queries the AI queued during the think on the job threads
+			for (int i = 0; i < aasList.Num(); i++) {
+				aasList[ i ]->ServicePathQueries();
+			}
+
+			timer_paths.Stop();
+			timer_parallel.Clear();
+			timer_parallel.Start();
+
+			// let entities do the work without side effects on the job threads
+			RunParallelThink();
+
+			timer_parallel.Stop();
 
 			// free the player pvs
 			FreePlayerPVS();
@@ -2478,11 +2577,16 @@ gameReturn_t idGameLocal::RunFrame(const usercmd_t *clientCmds)
 				mpGame.Run();
 			}
 
+			// display how many physics objects were simulated at each level of detail
+			if (g_showPhysicsLOD.GetBool()) {
+				physicsLOD.PrintStatistics();
+			}
+
 			// display how long it took to calculate the current game frame
 			if (g_frametime.GetBool()) {
-				Printf("game %d: all:%.1f th:%.1f ev:%.1f %d ents \n",
-				       time, timer_think.Milliseconds() + timer_events.Milliseconds(),
-				       timer_think.Milliseconds(), timer_events.Milliseconds(), num);
+				Printf("game %d: all:%.1f th:%.1f ev:%.1f pq:%.1f pt:%.1f %d ents \n",
+				       time, timer_think.Milliseconds() + timer_events.Milliseconds() + timer_paths.Milliseconds() + timer_parallel.Milliseconds(),
+				       timer_think.Milliseconds(), timer_events.Milliseconds(), timer_paths.Milliseconds(), timer_parallel.Milliseconds(), num);
 			}
 
 			// build the return value
@@ -3253,6 +3357,9 @@ bool idGameLocal::SpawnEntityDef(const idDict &args, idEntity **ent, bool setDef
 	idClass		*obj;
 	idStr		error;
 	const char  *name;
+	idScopedMemTag	memTag(MEMTAG_ENTITIES);
+
+	assert(!inParallelThink);
 
 	if (ent) {
 		*ent = NULL;
@@ -3260,11 +3367,11 @@ bool idGameLocal::SpawnEntityDef(const idDict &args, idEntity **ent, bool setDef
 
 	spawnArgs = args;
 
-	if (spawnArgs.GetString("name", "", &name)) {
+	if (spawnArgs.GetString(KEY_Name, "", &name)) {
 		sprintf(error, " on '%s'", name);
 	}
 
-	spawnArgs.GetString("classname", NULL, &classname);
+	spawnArgs.GetString(KEY_Classname, NULL, &classname);
 
 	const idDeclEntityDef *def = FindEntityDef(classname, false);
 
@@ -3276,7 +3383,7 @@ bool idGameLocal::SpawnEntityDef(const idDict &args, idEntity **ent, bool setDef
 	spawnArgs.SetDefaults(&def->dict);
 
 	// check if we should spawn a class object
-	spawnArgs.GetString("spawnclass", NULL, &spawn);
+	spawnArgs.GetString(KEY_SpawnClass, NULL, &spawn);
 
 	if (spawn) {
 
@@ -3304,7 +3411,7 @@ bool idGameLocal::SpawnEntityDef(const idDict &args, idEntity **ent, bool setDef
 	}
 
 	// check if we should call a script function to spawn
-	spawnArgs.GetString("spawnfunc", NULL, &spawn);
+	spawnArgs.GetString(KEY_SpawnFunc, NULL, &spawn);
 
 	if (spawn) {
 		const function_t *func = program.FindFunction(spawn);
@@ -3378,7 +3485,7 @@ bool idGameLocal::InhibitEntitySpawn(idDict &spawnArgs)
 
 #ifndef ID_DEMO_BUILD
 	if (g_skill.GetInteger() == 3) {
-		name = spawnArgs.GetString("classname");
+		name = spawnArgs.GetString(KEY_Classname);
 
 		if (idStr::Icmp(name, "item_medkit") == 0 || idStr::Icmp(name, "item_medkit_small") == 0) {
 			result = true;
@@ -3388,7 +3495,7 @@ bool idGameLocal::InhibitEntitySpawn(idDict &spawnArgs)
 #endif
 
 	if (gameLocal.isMultiplayer) {
-		name = spawnArgs.GetString("classname");
+		name = spawnArgs.GetString(KEY_Classname);
 
 		if (idStr::Icmp(name, "weapon_bfg") == 0 || idStr::Icmp(name, "weapon_soulcube") == 0) {
 			result = true;
@@ -4733,3 +4840,24 @@ idGameLocal::GetMapLoadingGUI
 */
 void idGameLocal::GetMapLoadingGUI(char gui[ MAX_STRING_CHARS ]) { }
 
+/*
+===============
+idGameLocal::GetMemTagStats
+
+  the game module has a heap of its own
+===============
+*/
+void idGameLocal::GetMemTagStats(memTagStats_t stats[MEMTAG_NUM])
+{
+	memTagStats_t gameStats[MEMTAG_NUM];
+
+	Mem_GetTagStats(gameStats);
+
+	for (int i = 0; i < MEMTAG_NUM; i++) {
+		stats[i].size += gameStats[i].size;
+		stats[i].num += gameStats[i].num;
+		stats[i].totalSize += gameStats[i].totalSize;
+		stats[i].totalNum += gameStats[i].totalNum;
+	}
+}
+
@@ -55,9 +55,11 @@ idAAS::~idAAS(void)
 idAASLocal::idAASLocal
 ============
 */
-idAASLocal::idAASLocal(void)
+idAASLocal::idAASLocal(void) : routingArena("aasRouting", MEMTAG_AAS)
 {
 	file = NULL;
+	routingCacheShared = false;
+	ClearPathQueries();
 }
 
 /*
@@ -80,6 +82,7 @@ bool idAASLocal::Init(const idStr &mapName, unsigned int mapFileCRC)
 	if (file && mapName.Icmp(file->GetName()) == 0 && mapFileCRC == file->GetCRC()) {
 		common->Printf("Keeping %s\n", file->GetName());
 		RemoveAllObstacles();
+		ClearPathQueries();
 	} else {
 		Shutdown();
 
@@ -109,6 +112,8 @@ void idAASLocal::Shutdown(void)
 		AASFileManager->FreeAAS(file);
 		file = NULL;
 	}
+
+	ClearPathQueries();
 }
 
 /*
@@ -125,6 +130,7 @@ void idAASLocal::Stats(void) const
 	common->Printf("[%s]\n", file->GetName());
 	file->PrintInfo();
 	RoutingStats();
+	PathQueryStats();
 }
 
 /*
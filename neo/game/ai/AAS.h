@@ -73,6 +73,14 @@ class idAASCallback
 
 typedef int aasHandle_t;
 
+typedef int aasPathHandle_t;
+
+typedef enum {
+	PATHQUERY_INVALID,			// unknown handle
+	PATHQUERY_PENDING,			// waiting for ServicePathQueries
+	PATHQUERY_DONE				// the path is available
+} aasPathQueryStatus_t;
+
 class idAAS
 {
 	public:
@@ -138,6 +146,14 @@ class idAAS
 		virtual void				ShowFlyPath(const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin) const = 0;
 		// Find the nearest goal which satisfies the callback.
 		virtual bool				FindNearestGoal(aasGoal_t &goal, int areaNum, const idVec3 origin, const idVec3 &target, int travelFlags, aasObstacle_t *obstacles, int numObstacles, idAASCallback &callback) const = 0;
+		// Queue a walk or fly path query, the path is created on the job threads by the next ServicePathQueries.
+		virtual aasPathHandle_t		QueuePathQuery(bool fly, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags) = 0;
+		// Get the path of a queued query, found is set to the return value of Walk/FlyPathToGoal.
+		virtual aasPathQueryStatus_t GetPathQueryResult(aasPathHandle_t handle, aasPath_t &path, bool &found) const = 0;
+		// Free a queued query, whether it has been serviced or not.
+		virtual void				FreePathQuery(aasPathHandle_t handle) = 0;
+		// Create the paths of all queued queries.
+		virtual void				ServicePathQueries(void) = 0;
 };
 
 #endif /* !__AAS_H__ */
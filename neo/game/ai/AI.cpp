@@ -300,6 +300,17 @@ idAI::idAI()
 	aas					= NULL;
 	travelFlags			= TFL_WALK|TFL_AIR;
 
+	pathQuery			= 0;
+	pathQueryAreaNum	= 0;
+	pathQueryGoalAreaNum = 0;
+	pathQueryFly		= false;
+	pathQueryTime		= 0;
+	asyncPathFound		= false;
+	asyncPathAreaNum	= 0;
+	asyncPathGoalAreaNum = 0;
+	asyncPathFly		= false;
+	asyncPathTime		= 0;
+
 	kickForce			= 2048.0f;
 	ignore_obstacles	= false;
 	blockedRadius		= 0.0f;
@@ -404,6 +415,7 @@ idAI::~idAI
 */
 idAI::~idAI()
 {
+	FreeAsyncPath();
 	delete projectileClipModel;
 	DeconstructScriptObject();
 	scriptObject.Free();
@@ -1360,6 +1372,8 @@ void idAI::SetAAS(void)
 {
 	idStr use_aas;
 
+	FreeAsyncPath();
+
 	spawnArgs.GetString("use_aas", NULL, use_aas);
 	aas = gameLocal.GetAAS(use_aas);
 
@@ -1494,6 +1508,108 @@ bool idAI::PathToGoal(aasPath_t &path, int areaNum, const idVec3 &origin, int go
 	}
 }
 
+/*
+=====================
+idAI::AsyncPathToGoal
+
+Queues the path on the job threads and returns the result of the previous
+query while it was made from the same areas.  A new query is only queued when
+the areas changed or the result is older than ai_asyncPathMaxAge, and while it
+is pending the last path to the same goal area is reused while the monster has
+not left the areas of that path.  Falls back to
+PathToGoal when there is no usable result yet.
+=====================
+*/
+bool idAI::AsyncPathToGoal(aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin)
+{
+	idVec3 org;
+	idVec3 goal;
+	bool fly;
+	bool found;
+	bool sameGoal;
+	bool current;
+
+	if (!aas || !ai_asyncPaths.GetBool()) {
+		FreeAsyncPath();
+		return PathToGoal(path, areaNum, origin, goalAreaNum, goalOrigin);
+	}
+
+	fly = (move.moveType == MOVETYPE_FLY);
+
+	if (pathQuery) {
+		switch (aas->GetPathQueryResult(pathQuery, asyncPath, found)) {
+			case PATHQUERY_DONE:
+				asyncPathFound			= found;
+				asyncPathAreaNum		= pathQueryAreaNum;
+				asyncPathGoalAreaNum	= pathQueryGoalAreaNum;
+				asyncPathFly			= pathQueryFly;
+				asyncPathTime			= pathQueryTime;
+				aas->FreePathQuery(pathQuery);
+				pathQuery = 0;
+				break;
+			case PATHQUERY_INVALID:
+				pathQuery = 0;
+				break;
+			default:
+				break;
+		}
+	}
+
+	// a pending query to another goal is of no use anymore
+	if (pathQuery && (pathQueryGoalAreaNum != goalAreaNum || pathQueryFly != fly)) {
+		aas->FreePathQuery(pathQuery);
+		pathQuery = 0;
+	}
+
+	sameGoal = (asyncPathGoalAreaNum && asyncPathGoalAreaNum == goalAreaNum && asyncPathFly == fly);
+	current = (sameGoal && asyncPathAreaNum == areaNum && gameLocal.time - asyncPathTime <= ai_asyncPathMaxAge.GetInteger());
+
+	if (!pathQuery && !current && areaNum && goalAreaNum) {
+		org = origin;
+		aas->PushPointIntoAreaNum(areaNum, org);
+		goal = goalOrigin;
+		aas->PushPointIntoAreaNum(goalAreaNum, goal);
+
+		pathQuery = aas->QueuePathQuery(fly, areaNum, org, goalAreaNum, goal, travelFlags);
+
+		if (pathQuery) {
+			pathQueryAreaNum		= areaNum;
+			pathQueryGoalAreaNum	= goalAreaNum;
+			pathQueryFly			= fly;
+			pathQueryTime			= gameLocal.time;
+		}
+	}
+
+	if (current) {
+		path = asyncPath;
+		return asyncPathFound;
+	}
+
+	// keep following the last path to the goal until the new query is serviced, as long as
+	// the monster is still in the area the path starts in or has reached the area it leads to
+	if (pathQuery && sameGoal && asyncPathFound && (asyncPathAreaNum == areaNum || asyncPath.moveAreaNum == areaNum)) {
+		path = asyncPath;
+		return true;
+	}
+
+	return PathToGoal(path, areaNum, origin, goalAreaNum, goalOrigin);
+}
+
+/*
+=====================
+idAI::FreeAsyncPath
+=====================
+*/
+void idAI::FreeAsyncPath(void)
+{
+	if (aas && pathQuery) {
+		aas->FreePathQuery(pathQuery);
+	}
+
+	pathQuery = 0;
+	asyncPathGoalAreaNum = 0;
+}
+
 /*
 =====================
 idAI::TravelDistance
@@ -2374,7 +2490,7 @@ bool idAI::GetMovePos(idVec3 &seekPos)
 		if (aas && move.toAreaNum) {
 			areaNum	= PointReachableAreaNum(org);
 
-			if (PathToGoal(path, areaNum, org, move.toAreaNum, move.moveDest)) {
+			if (AsyncPathToGoal(path, areaNum, org, move.toAreaNum, move.moveDest)) {
 				seekPos = path.moveGoal;
 				result = true;
 				move.nextWanderTime = 0;
@@ -283,6 +283,19 @@ class idAI : public idActor
 		idMoveState				move;
 		idMoveState				savedMove;
 
+		// queued move path, serviced on the job threads and read back the next frame
+		aasPathHandle_t			pathQuery;
+		int						pathQueryAreaNum;
+		int						pathQueryGoalAreaNum;
+		bool					pathQueryFly;
+		int						pathQueryTime;
+		aasPath_t				asyncPath;
+		bool					asyncPathFound;
+		int						asyncPathAreaNum;
+		int						asyncPathGoalAreaNum;
+		bool					asyncPathFly;
+		int						asyncPathTime;
+
 		float					kickForce;
 		bool					ignore_obstacles;
 		float					blockedRadius;
@@ -464,6 +477,8 @@ class idAI : public idActor
 		float					TravelDistance(const idVec3 &start, const idVec3 &end) const;
 		int						PointReachableAreaNum(const idVec3 &pos, const float boundsScale = 2.0f) const;
 		bool					PathToGoal(aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin) const;
+		bool					AsyncPathToGoal(aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin);
+		void					FreeAsyncPath(void);
 		void					DrawRoute(void) const;
 		bool					GetMovePos(idVec3 &seekPos);
 		bool					MoveDone(void) const;
@@ -73,6 +73,7 @@ idTypeInfo::idTypeInfo(const char *classname, const char *superclass, idEventFun
 	this->superclass		= superclass;
 	this->eventCallbacks	= eventCallbacks;
 	this->eventMap			= NULL;
+	this->eventInvokers		= NULL;
 	this->Spawn				= Spawn;
 	this->Save				= Save;
 	this->Restore			= Restore;
@@ -161,6 +162,7 @@ void idTypeInfo::Init(void)
 	// if we're not adding any new event callbacks, we can just use our superclass's table
 	if ((!eventCallbacks || !eventCallbacks->event) && super) {
 		eventMap = super->eventMap;
+		eventInvokers = super->eventInvokers;
 		return;
 	}
 
@@ -175,6 +177,10 @@ void idTypeInfo::Init(void)
 	memset(eventMap, 0, sizeof(eventCallback_t) * num);
 	eventCallbackMemory += sizeof(eventCallback_t) * num;
 
+	eventInvokers = new eventInvoke_t[ num ];
+	memset(eventInvokers, 0, sizeof(eventInvoke_t) * num);
+	eventCallbackMemory += sizeof(eventInvoke_t) * num;
+
 	// allocate temporary memory for flags so that the subclass's event callbacks
 	// override the superclass's event callback
 	set = new bool[ num ];
@@ -200,6 +206,14 @@ void idTypeInfo::Init(void)
 
 			set[ ev ] = true;
 			eventMap[ ev ] = def[ i ].function;
+
+			// only use the thunk when the callback signature agrees with the event's formatspec,
+			// mismatches keep going through the generic switch like they always did
+			if (def[ i ].thunk.invoke && def[ i ].thunk.formatspecIndex == def[ i ].event->GetFormatspecIndex()) {
+				eventInvokers[ ev ] = def[ i ].thunk.invoke;
+			} else {
+				gameLocal.DWarning("%s::%s: callback arguments don't match formatspec '%s'", c->classname, def[ i ].event->GetName(), def[ i ].event->GetArgFormat());
+			}
 		}
 	}
 
@@ -221,9 +235,11 @@ void idTypeInfo::Shutdown()
 	if (eventMap) {
 		if (freeEventMap) {
 			delete[] eventMap;
+			delete[] eventInvokers;
 		}
 
 		eventMap = NULL;
+		eventInvokers = NULL;
 	}
 
 	typeNum = 0;
@@ -675,6 +691,7 @@ bool idClass::PostEventArgs(const idEventDef *ev, int time, int numargs, ...)
 	va_list		args;
 
 	assert(ev);
+	assert(!gameLocal.inParallelThink);
 
 	if (!idEvent::initialized) {
 		return false;
@@ -1015,6 +1032,7 @@ bool idClass::ProcessEventArgPtr(const idEventDef *ev, intptr_t *data)
 	idTypeInfo	*c;
 	int			num;
 	eventCallback_t	callback;
+	eventInvoke_t	invoke;
 
 	assert(ev);
 	assert(idEvent::initialized);
@@ -1033,6 +1051,12 @@ bool idClass::ProcessEventArgPtr(const idEventDef *ev, intptr_t *data)
 	}
 
 	callback = c->eventMap[ num ];
+	invoke = c->eventInvokers[ num ];
+
+	if (invoke && g_eventThunks.GetBool()) {
+		invoke(this, callback, data);
+		return true;
+	}
 
 	switch (ev->GetFormatspecIndex()) {
 		case 1 << D_EVENT_MAXARGS :
@@ -31,23 +31,9 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
-#define	MAX_SECTOR_DEPTH				12
-#define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
-
-typedef struct clipSector_s {
-	int						axis;		// -1 = leaf node
-	float					dist;
-	struct clipSector_s 	*children[2];
-	struct clipLink_s 		*clipLinks;
-} clipSector_t;
-
-typedef struct clipLink_s {
-	idClipModel 			*clipModel;
-	struct clipSector_s 	*sector;
-	struct clipLink_s 		*prevInSector;
-	struct clipLink_s 		*nextInSector;
-	struct clipLink_s 		*nextLink;
-} clipLink_t;
+#define CLIP_NODE_MARGIN				8.0f		// leaves are this much larger than the clip model so small moves keep their node
+#define MAX_CLIP_TREE_DEPTH				256
+#define MAX_BATCH_BOUNDS				32
 
 typedef struct trmCache_s {
 	idTraceModel			trm;
@@ -59,8 +45,6 @@ typedef struct trmCache_s {
 
 idVec3 vec3_boxEpsilon(CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON);
 
-idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
-
 
 /*
 ===============================================================
@@ -306,8 +290,9 @@ void idClipModel::Init(void)
 	collisionModelHandle = 0;
 	renderModelHandle = -1;
 	traceModelIndex = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	clipTree = NULL;
+	clipNode = -1;
+	linked = false;
 }
 
 /*
@@ -379,8 +364,9 @@ idClipModel::idClipModel(const idClipModel *model)
 	}
 
 	renderModelHandle = model->renderModelHandle;
-	clipLinks = NULL;
-	touchCount = -1;
+	clipTree = NULL;
+	clipNode = -1;
+	linked = false;
 }
 
 /*
@@ -390,8 +376,10 @@ idClipModel::~idClipModel
 */
 idClipModel::~idClipModel(void)
 {
-	// make sure the clip model is no longer linked
-	Unlink();
+	// make sure the clip model is no longer in the clip tree
+	if (clipTree) {
+		clipTree->RemoveClipModel(this);
+	}
 
 	if (traceModelIndex != -1) {
 		FreeTraceModel(traceModelIndex);
@@ -424,8 +412,8 @@ void idClipModel::Save(idSaveGame *savefile) const
 
 	savefile->WriteInt(traceModelIndex);
 	savefile->WriteInt(renderModelHandle);
-	savefile->WriteBool(clipLinks != NULL);
-	savefile->WriteInt(touchCount);
+	savefile->WriteBool(linked);
+	savefile->WriteInt(-1);		// was the touch count of the clip sectors
 }
 
 /*
@@ -436,7 +424,8 @@ idClipModel::Restore
 void idClipModel::Restore(idRestoreGame *savefile)
 {
 	idStr collisionModelName;
-	bool linked;
+	bool wasLinked;
+	int unused;
 
 	savefile->ReadBool(enabled);
 	savefile->ReadObject(reinterpret_cast<idClass * &>(entity));
@@ -463,15 +452,16 @@ void idClipModel::Restore(idRestoreGame *savefile)
 	}
 
 	savefile->ReadInt(renderModelHandle);
-	savefile->ReadBool(linked);
-	savefile->ReadInt(touchCount);
+	savefile->ReadBool(wasLinked);
+	savefile->ReadInt(unused);
 
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	if (clipTree) {
+		clipTree->RemoveClipModel(this);
+	}
 
-	if (linked) {
+	if (wasLinked) {
 		Link(gameLocal.clip, entity, id, origin, axis, renderModelHandle);
 	}
 }
@@ -483,7 +473,7 @@ idClipModel::SetPosition
 */
 void idClipModel::SetPosition(const idVec3 &newOrigin, const idMat3 &newAxis)
 {
-	if (clipLinks) {
+	if (linked) {
 		Unlink();	// unlink from old position
 	}
 
@@ -531,62 +521,21 @@ void idClipModel::GetMassProperties(const float density, float &mass, idVec3 &ce
 /*
 ===============
 idClipModel::Unlink
-===============
-*/
-void idClipModel::Unlink(void)
-{
-	clipLink_t *link;
 
-	for (link = clipLinks; link; link = clipLinks) {
-		clipLinks = link->nextLink;
-
-		if (link->prevInSector) {
-			link->prevInSector->nextInSector = link->nextInSector;
-		} else {
-			link->sector->clipLinks = link->nextInSector;
-		}
-
-		if (link->nextInSector) {
-			link->nextInSector->prevInSector = link->prevInSector;
-		}
-
-		clipLinkAllocator.Free(link);
-	}
-}
-
-/*
-===============
-idClipModel::Link_r
+The leaf stays in the clip tree for the rest of the frame, so a model unlinked
+while it's moved is relinked cheaply.  RemoveUnlinkedLeaves takes it out at the
+start of the next frame if the model wasn't linked again.
 ===============
 */
-void idClipModel::Link_r(struct clipSector_s *node)
+void idClipModel::Unlink(void)
 {
-	clipLink_t *link;
+	QueryStateChanged();
 
-	while (node->axis != -1) {
-		if (absBounds[0][node->axis] > node->dist) {
-			node = node->children[0];
-		} else if (absBounds[1][node->axis] < node->dist) {
-			node = node->children[1];
-		} else {
-			Link_r(node->children[0]);
-			node = node->children[1];
-		}
-	}
-
-	link = clipLinkAllocator.Alloc();
-	link->clipModel = this;
-	link->sector = node;
-	link->nextInSector = node->clipLinks;
-	link->prevInSector = NULL;
-
-	if (node->clipLinks) {
-		node->clipLinks->prevInSector = link;
+	if (clipTree) {
+		clipTree->unlinkedLeaves = true;
 	}
 
-	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
+	linked = false;
 }
 
 /*
@@ -598,12 +547,13 @@ void idClipModel::Link(idClip &clp)
 {
 
 	assert(idClipModel::entity);
+	assert(!gameLocal.inParallelThink);
 
 	if (!idClipModel::entity) {
 		return;
 	}
 
-	if (clipLinks) {
+	if (linked) {
 		Unlink();	// unlink from old position
 	}
 
@@ -626,7 +576,7 @@ void idClipModel::Link(idClip &clp)
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r(clp.clipSectors);
+	clp.LinkClipModel(this);
 }
 
 /*
@@ -680,216 +630,748 @@ idClip::idClip
 */
 idClip::idClip(void)
 {
-	numClipSectors = 0;
-	clipSectors = NULL;
+	rootNode = -1;
+	freeNode = -1;
+	unlinkedLeaves = false;
 	worldBounds.Zero();
+	numQueriesToRecord = 0;
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numRelinks = numReinserts = 0;
+	numCachedQueries = numCacheHits = 0;
+	cachedQueryHash.Clear(256, 256);
 }
 
 /*
 ===============
-idClip::CreateClipSectors_r
+idClip::Init
+===============
+*/
+void idClip::Init(void)
+{
+	cmHandle_t h;
+	idVec3 size;
+
+	// clear the clip tree
+	clipNodes.SetGranularity(1024);
+	clipNodes.Clear();
+	rootNode = -1;
+	freeNode = -1;
+	unlinkedLeaves = false;
+	// get world map bounds
+	h = collisionModelManager->LoadModel("worldMap", false);
+	collisionModelManager->GetModelBounds(h, worldBounds);
+
+	size = worldBounds[1] - worldBounds[0];
+	gameLocal.Printf("map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2]);
+
+	// initialize a default clip model
+	defaultClipModel.LoadModel(idTraceModel(idBounds(idVec3(0, 0, 0)).Expand(8)));
 
-Builds a uniformly subdivided tree for the given world size
+	// set counters to zero
+	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numRelinks = numReinserts = 0;
+	numCachedQueries = numCacheHits = 0;
+
+	ClearQueryCache();
+	cachedQueries.SetGranularity(256);
+}
+
+/*
+===============
+idClip::Shutdown
 ===============
 */
-clipSector_t *idClip::CreateClipSectors_r(const int depth, const idBounds &bounds, idVec3 &maxSector)
+void idClip::Shutdown(void)
 {
-	int				i;
-	clipSector_t	*anode;
-	idVec3			size;
-	idBounds		front, back;
+	int i;
 
-	anode = &clipSectors[idClip::numClipSectors];
-	idClip::numClipSectors++;
+	// detach any clip model that outlives the tree
+	for (i = 0; i < clipNodes.Num(); i++) {
+		if (clipNodes[i].height == 0 && clipNodes[i].clipModel) {
+			clipNodes[i].clipModel->clipTree = NULL;
+			clipNodes[i].clipModel->clipNode = -1;
+			clipNodes[i].clipModel->linked = false;
+		}
+	}
 
-	if (depth == MAX_SECTOR_DEPTH) {
-		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
+	clipNodes.Clear();
+	rootNode = -1;
+	freeNode = -1;
+	unlinkedLeaves = false;
+	recordedQueries.Clear();
+	numQueriesToRecord = 0;
+	batchTranslations.Clear();
+	batchClipModels.Clear();
+	batchClipIndex.Clear();
+	batchFirst.Clear();
+	batchCount.Clear();
+	cachedQueries.Clear();
+	cachedQueryHash.Clear(256, 256);
+	queryCacheStats.Clear();
 
-		for (i = 0; i < 3; i++) {
-			if (bounds[1][i] - bounds[0][i] > maxSector[i]) {
-				maxSector[i] = bounds[1][i] - bounds[0][i];
-			}
+	// free the trace model used for the temporaryClipModel
+	if (temporaryClipModel.traceModelIndex != -1) {
+		idClipModel::FreeTraceModel(temporaryClipModel.traceModelIndex);
+		temporaryClipModel.traceModelIndex = -1;
+	}
+
+	// free the trace model used for the defaultClipModel
+	if (defaultClipModel.traceModelIndex != -1) {
+		idClipModel::FreeTraceModel(defaultClipModel.traceModelIndex);
+		defaultClipModel.traceModelIndex = -1;
+	}
+}
+
+/*
+===============================================================
+
+	dynamic bounding box tree
+
+	Every linked clip model has a leaf with slightly fattened bounds.  Leaves
+	are inserted next to the sibling that grows the tree's surface area the
+	least and the tree is kept balanced with rotations on the way back up.
+	Queries walk the tree instead of a fixed grid of sectors, so large or fast
+	moving models don't end up in long lists near the root.  The leaves of
+	models which stay unlinked until the next frame are removed, so hidden
+	models aren't walked by every query.
+
+	The shape of the tree depends on the order the models were linked in,
+	which is different after a savegame restore.  Traces keep the first of
+	equally close results and touch code runs in list order, so query results
+	are sorted on entity number and clip model id instead of returned in tree
+	order.
+
+===============================================================
+*/
+
+/*
+===============
+ClipNodeCost
+
+Half the surface area of the bounds.
+===============
+*/
+static ID_INLINE float ClipNodeCost(const idBounds &bounds)
+{
+	idVec3 size = bounds[1] - bounds[0];
+	return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+}
+
+/*
+===============
+ClipNodeUnion
+===============
+*/
+static ID_INLINE idBounds ClipNodeUnion(const idBounds &a, const idBounds &b)
+{
+	idBounds u;
+
+	u[0][0] = Min(a[0][0], b[0][0]);
+	u[0][1] = Min(a[0][1], b[0][1]);
+	u[0][2] = Min(a[0][2], b[0][2]);
+	u[1][0] = Max(a[1][0], b[1][0]);
+	u[1][1] = Max(a[1][1], b[1][1]);
+	u[1][2] = Max(a[1][2], b[1][2]);
+	return u;
+}
+
+/*
+===============
+ClipNodeContains
+===============
+*/
+static ID_INLINE bool ClipNodeContains(const idBounds &outer, const idBounds &inner)
+{
+	return (inner[0][0] >= outer[0][0] && inner[0][1] >= outer[0][1] && inner[0][2] >= outer[0][2] &&
+	        inner[1][0] <= outer[1][0] && inner[1][1] <= outer[1][1] && inner[1][2] <= outer[1][2]);
+}
+
+/*
+===============
+ClipNodeOverlaps
+===============
+*/
+static ID_INLINE bool ClipNodeOverlaps(const idBounds &a, const idBounds &b)
+{
+	return !(a[0][0] > b[1][0] || a[1][0] < b[0][0] ||
+	         a[0][1] > b[1][1] || a[1][1] < b[0][1] ||
+	         a[0][2] > b[1][2] || a[1][2] < b[0][2]);
+}
+
+/*
+===============
+ClipModelCompare
+===============
+*/
+static ID_INLINE int ClipModelCompare(const idClipModel *a, const idClipModel *b)
+{
+	if (a->GetEntity() != b->GetEntity()) {
+		return a->GetEntity()->entityNumber - b->GetEntity()->entityNumber;
+	}
+
+	return a->GetId() - b->GetId();
+}
+
+/*
+===============
+ClipModelSortCompare
+===============
+*/
+static int ClipModelSortCompare(const void *a, const void *b)
+{
+	return ClipModelCompare(*(const idClipModel * const *)a, *(const idClipModel * const *)b);
+}
+
+/*
+===============
+SortClipModels
+
+Most queries touch a handful of models, those are insertion sorted.
+===============
+*/
+static void SortClipModels(idClipModel **list, int count)
+{
+	int i, j;
+
+	if (count > 16) {
+		qsort(list, count, sizeof(list[0]), ClipModelSortCompare);
+		return;
+	}
+
+	for (i = 1; i < count; i++) {
+		idClipModel *check = list[i];
+
+		for (j = i; j > 0 && ClipModelCompare(list[j - 1], check) > 0; j--) {
+			list[j] = list[j - 1];
 		}
 
-		return anode;
+		list[j] = check;
 	}
+}
 
-	size = bounds[1] - bounds[0];
+/*
+===============
+idClip::AllocNode
+===============
+*/
+int idClip::AllocNode(void)
+{
+	int nodeNum;
 
-	if (size[0] >= size[1] && size[0] >= size[2]) {
-		anode->axis = 0;
-	} else if (size[1] >= size[0] && size[1] >= size[2]) {
-		anode->axis = 1;
+	if (freeNode != -1) {
+		nodeNum = freeNode;
+		freeNode = clipNodes[nodeNum].parent;
 	} else {
-		anode->axis = 2;
+		nodeNum = clipNodes.Num();
+		clipNodes.SetNum(nodeNum + 1, false);
 	}
 
-	anode->dist = 0.5f * (bounds[1][anode->axis] + bounds[0][anode->axis]);
+	clipNode_t &node = clipNodes[nodeNum];
+	node.parent = -1;
+	node.children[0] = node.children[1] = -1;
+	node.height = 0;
+	node.clipModel = NULL;
+	return nodeNum;
+}
 
-	front = bounds;
-	back = bounds;
+/*
+===============
+idClip::FreeNode
+===============
+*/
+void idClip::FreeNode(int nodeNum)
+{
+	clipNodes[nodeNum].parent = freeNode;
+	clipNodes[nodeNum].height = -1;
+	clipNodes[nodeNum].clipModel = NULL;
+	freeNode = nodeNum;
+}
+
+/*
+===============
+idClip::Balance
+
+Rotates the higher child of an unbalanced node up, returns the node now in its place.
+===============
+*/
+int idClip::Balance(int iA)
+{
+	clipNode_t *nodes = clipNodes.Ptr();
+	clipNode_t *A = &nodes[iA];
+
+	if (A->height < 2) {
+		return iA;
+	}
 
-	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
+	int iB = A->children[0];
+	int iC = A->children[1];
+	clipNode_t *B = &nodes[iB];
+	clipNode_t *C = &nodes[iC];
+	int balance = C->height - B->height;
+
+	if (balance > 1) {
+		// rotate C up
+		int iF = C->children[0];
+		int iG = C->children[1];
+		clipNode_t *F = &nodes[iF];
+		clipNode_t *G = &nodes[iG];
+
+		C->children[0] = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		if (C->parent != -1) {
+			clipNode_t *P = &nodes[C->parent];
+			P->children[P->children[0] == iA ? 0 : 1] = iC;
+		} else {
+			rootNode = iC;
+		}
+
+		if (F->height > G->height) {
+			C->children[1] = iF;
+			A->children[1] = iG;
+			G->parent = iA;
+			A->bounds = ClipNodeUnion(B->bounds, G->bounds);
+			C->bounds = ClipNodeUnion(A->bounds, F->bounds);
+			A->height = 1 + Max(B->height, G->height);
+			C->height = 1 + Max(A->height, F->height);
+		} else {
+			C->children[1] = iG;
+			A->children[1] = iF;
+			F->parent = iA;
+			A->bounds = ClipNodeUnion(B->bounds, F->bounds);
+			C->bounds = ClipNodeUnion(A->bounds, G->bounds);
+			A->height = 1 + Max(B->height, F->height);
+			C->height = 1 + Max(A->height, G->height);
+		}
+
+		return iC;
+	}
 
-	anode->children[0] = CreateClipSectors_r(depth+1, front, maxSector);
-	anode->children[1] = CreateClipSectors_r(depth+1, back, maxSector);
+	if (balance < -1) {
+		// rotate B up
+		int iD = B->children[0];
+		int iE = B->children[1];
+		clipNode_t *D = &nodes[iD];
+		clipNode_t *E = &nodes[iE];
 
-	return anode;
+		B->children[0] = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		if (B->parent != -1) {
+			clipNode_t *P = &nodes[B->parent];
+			P->children[P->children[0] == iA ? 0 : 1] = iB;
+		} else {
+			rootNode = iB;
+		}
+
+		if (D->height > E->height) {
+			B->children[1] = iD;
+			A->children[0] = iE;
+			E->parent = iA;
+			A->bounds = ClipNodeUnion(C->bounds, E->bounds);
+			B->bounds = ClipNodeUnion(A->bounds, D->bounds);
+			A->height = 1 + Max(C->height, E->height);
+			B->height = 1 + Max(A->height, D->height);
+		} else {
+			B->children[1] = iE;
+			A->children[0] = iD;
+			D->parent = iA;
+			A->bounds = ClipNodeUnion(C->bounds, D->bounds);
+			B->bounds = ClipNodeUnion(A->bounds, E->bounds);
+			A->height = 1 + Max(C->height, D->height);
+			B->height = 1 + Max(A->height, E->height);
+		}
+
+		return iB;
+	}
+
+	return iA;
 }
 
 /*
 ===============
-idClip::Init
+idClip::InsertLeaf
 ===============
 */
-void idClip::Init(void)
+void idClip::InsertLeaf(int leaf)
 {
-	cmHandle_t h;
-	idVec3 size, maxSector = vec3_origin;
+	int index, sibling, oldParent, newParent, child0, child1;
+	float cost, inheritCost, cost0, cost1;
+	idBounds leafBounds;
 
-	// clear clip sectors
-	clipSectors = new clipSector_t[MAX_SECTORS];
-	memset(clipSectors, 0, MAX_SECTORS * sizeof(clipSector_t));
-	numClipSectors = 0;
-	touchCount = -1;
-	// get world map bounds
-	h = collisionModelManager->LoadModel("worldMap", false);
-	collisionModelManager->GetModelBounds(h, worldBounds);
-	// create world sectors
-	CreateClipSectors_r(0, worldBounds, maxSector);
+	if (rootNode == -1) {
+		rootNode = leaf;
+		clipNodes[leaf].parent = -1;
+		return;
+	}
 
-	size = worldBounds[1] - worldBounds[0];
-	gameLocal.Printf("map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2]);
-	gameLocal.Printf("max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2]);
+	// find the sibling that increases the surface area of the tree the least
+	leafBounds = clipNodes[leaf].bounds;
+	index = rootNode;
 
-	// initialize a default clip model
-	defaultClipModel.LoadModel(idTraceModel(idBounds(idVec3(0, 0, 0)).Expand(8)));
+	while (clipNodes[index].height > 0) {
+		const clipNode_t &node = clipNodes[index];
 
-	// set counters to zero
-	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+		child0 = node.children[0];
+		child1 = node.children[1];
+
+		cost = 2.0f * ClipNodeCost(ClipNodeUnion(node.bounds, leafBounds));
+		inheritCost = cost - 2.0f * ClipNodeCost(node.bounds);
+
+		cost0 = ClipNodeCost(ClipNodeUnion(clipNodes[child0].bounds, leafBounds)) + inheritCost;
+
+		if (clipNodes[child0].height > 0) {
+			cost0 -= ClipNodeCost(clipNodes[child0].bounds);
+		}
+
+		cost1 = ClipNodeCost(ClipNodeUnion(clipNodes[child1].bounds, leafBounds)) + inheritCost;
+
+		if (clipNodes[child1].height > 0) {
+			cost1 -= ClipNodeCost(clipNodes[child1].bounds);
+		}
+
+		if (cost < cost0 && cost < cost1) {
+			break;
+		}
+
+		index = (cost0 < cost1) ? child0 : child1;
+	}
+
+	sibling = index;
+
+	// create a new parent for the sibling and the leaf
+	oldParent = clipNodes[sibling].parent;
+	newParent = AllocNode();
+
+	clipNode_t &parent = clipNodes[newParent];
+	parent.parent = oldParent;
+	parent.bounds = ClipNodeUnion(leafBounds, clipNodes[sibling].bounds);
+	parent.height = clipNodes[sibling].height + 1;
+	parent.children[0] = sibling;
+	parent.children[1] = leaf;
+
+	if (oldParent != -1) {
+		clipNode_t &old = clipNodes[oldParent];
+		old.children[old.children[0] == sibling ? 0 : 1] = newParent;
+	} else {
+		rootNode = newParent;
+	}
+
+	clipNodes[sibling].parent = newParent;
+	clipNodes[leaf].parent = newParent;
+
+	// walk back up fixing the heights and bounds
+	for (index = clipNodes[leaf].parent; index != -1; index = clipNodes[index].parent) {
+		index = Balance(index);
+
+		clipNode_t &node = clipNodes[index];
+		node.height = 1 + Max(clipNodes[node.children[0]].height, clipNodes[node.children[1]].height);
+		node.bounds = ClipNodeUnion(clipNodes[node.children[0]].bounds, clipNodes[node.children[1]].bounds);
+	}
 }
 
 /*
 ===============
-idClip::Shutdown
+idClip::RemoveLeaf
 ===============
 */
-void idClip::Shutdown(void)
+void idClip::RemoveLeaf(int leaf)
 {
-	delete[] clipSectors;
-	clipSectors = NULL;
+	int parent, grandParent, sibling, index;
 
-	// free the trace model used for the temporaryClipModel
-	if (temporaryClipModel.traceModelIndex != -1) {
-		idClipModel::FreeTraceModel(temporaryClipModel.traceModelIndex);
-		temporaryClipModel.traceModelIndex = -1;
+	if (leaf == rootNode) {
+		rootNode = -1;
+		return;
 	}
 
-	// free the trace model used for the defaultClipModel
-	if (defaultClipModel.traceModelIndex != -1) {
-		idClipModel::FreeTraceModel(defaultClipModel.traceModelIndex);
-		defaultClipModel.traceModelIndex = -1;
+	parent = clipNodes[leaf].parent;
+	grandParent = clipNodes[parent].parent;
+	sibling = clipNodes[parent].children[clipNodes[parent].children[0] == leaf ? 1 : 0];
+
+	FreeNode(parent);
+
+	if (grandParent == -1) {
+		rootNode = sibling;
+		clipNodes[sibling].parent = -1;
+		return;
 	}
 
-	clipLinkAllocator.Shutdown();
+	// replace the parent with the sibling
+	clipNode_t &grand = clipNodes[grandParent];
+	grand.children[grand.children[0] == parent ? 0 : 1] = sibling;
+	clipNodes[sibling].parent = grandParent;
+
+	for (index = grandParent; index != -1; index = clipNodes[index].parent) {
+		index = Balance(index);
+
+		clipNode_t &node = clipNodes[index];
+		node.height = 1 + Max(clipNodes[node.children[0]].height, clipNodes[node.children[1]].height);
+		node.bounds = ClipNodeUnion(clipNodes[node.children[0]].bounds, clipNodes[node.children[1]].bounds);
+	}
 }
 
 /*
-====================
-idClip::ClipModelsTouchingBounds_r
-====================
+===============
+idClip::LinkClipModel
+===============
 */
-typedef struct listParms_s {
-	idBounds		bounds;
-	int				contentMask;
-	idClipModel		**list;
-	int				count;
-	int				maxCount;
-} listParms_t;
+void idClip::LinkClipModel(idClipModel *clipModel)
+{
+	int leaf;
+
+	ClearQueryCache();
+
+	// if the model still fits its leaf there's nothing to update in the tree
+	if (clipModel->clipTree == this && ClipNodeContains(clipNodes[clipModel->clipNode].bounds, clipModel->absBounds)) {
+		clipModel->linked = true;
+		numRelinks++;
+		return;
+	}
+
+	if (clipModel->clipTree) {
+		clipModel->clipTree->RemoveClipModel(clipModel);
+	}
+
+	leaf = AllocNode();
+	clipNodes[leaf].bounds = clipModel->absBounds.Expand(CLIP_NODE_MARGIN);
+	clipNodes[leaf].clipModel = clipModel;
+	InsertLeaf(leaf);
+
+	clipModel->clipTree = this;
+	clipModel->clipNode = leaf;
+	clipModel->linked = true;
+	numReinserts++;
+}
+
+/*
+===============
+idClip::RemoveUnlinkedLeaves
 
-void idClip::ClipModelsTouchingBounds_r(const struct clipSector_s *node, listParms_t &parms) const
+Removes the leaves of the clip models that were unlinked and not linked again.
+===============
+*/
+void idClip::RemoveUnlinkedLeaves(void)
 {
+	int i;
 
-	while (node->axis != -1) {
-		if (parms.bounds[0][node->axis] > node->dist) {
-			node = node->children[0];
-		} else if (parms.bounds[1][node->axis] < node->dist) {
-			node = node->children[1];
-		} else {
-			ClipModelsTouchingBounds_r(node->children[0], parms);
-			node = node->children[1];
+	if (!unlinkedLeaves) {
+		return;
+	}
+
+	unlinkedLeaves = false;
+
+	// removing leaves frees nodes but never moves them
+	for (i = 0; i < clipNodes.Num(); i++) {
+		if (clipNodes[i].height == 0 && clipNodes[i].clipModel && !clipNodes[i].clipModel->linked) {
+			RemoveClipModel(clipNodes[i].clipModel);
 		}
 	}
+}
 
-	for (clipLink_t *link = node->clipLinks; link; link = link->nextInSector) {
-		idClipModel	*check = link->clipModel;
+/*
+===============
+idClip::RemoveClipModel
+===============
+*/
+void idClip::RemoveClipModel(idClipModel *clipModel)
+{
+	assert(clipModel->clipTree == this);
+
+	ClearQueryCache();
+	RemoveLeaf(clipModel->clipNode);
+	FreeNode(clipModel->clipNode);
+
+	clipModel->clipTree = NULL;
+	clipModel->clipNode = -1;
+	clipModel->linked = false;
+}
+
+/*
+================
+idClip::ClipModelsTouchingBounds
+================
+*/
+int idClip::ClipModelsTouchingBounds(const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount) const
+{
+	int				stack[MAX_CLIP_TREE_DEPTH];
+	int				stackDepth, count;
+	idBounds		checkBounds;
+	const clipNode_t *nodes;
+
+	if (bounds[0][0] > bounds[1][0] ||
+	    bounds[0][1] > bounds[1][1] ||
+	    bounds[0][2] > bounds[1][2]) {
+		// we should not go through the tree for degenerate or backwards bounds
+		assert(false);
+		return 0;
+	}
+
+	if (numQueriesToRecord > 0) {
+		clipQuery_t &query = recordedQueries.Alloc();
+		query.bounds = bounds;
+		query.contentMask = contentMask;
+		numQueriesToRecord--;
+	}
+
+	checkBounds[0] = bounds[0] - vec3_boxEpsilon;
+	checkBounds[1] = bounds[1] + vec3_boxEpsilon;
+
+	if (rootNode == -1) {
+		return 0;
+	}
+
+	nodes = clipNodes.Ptr();
+	count = 0;
+	stack[0] = rootNode;
+	stackDepth = 1;
+
+	while (stackDepth > 0) {
+		const clipNode_t *node = &nodes[stack[--stackDepth]];
+
+		if (!ClipNodeOverlaps(node->bounds, checkBounds)) {
+			continue;
+		}
 
-		// if the clip model is enabled
-		if (!check->enabled) {
+		if (node->height > 0) {
+			// the tree is balanced so the stack only overflows on a corrupt tree
+			assert(stackDepth + 2 <= MAX_CLIP_TREE_DEPTH);
+			stack[stackDepth++] = node->children[1];
+			stack[stackDepth++] = node->children[0];
 			continue;
 		}
 
-		// avoid duplicates in the list
-		if (check->touchCount == touchCount) {
+		idClipModel *check = node->clipModel;
+
+		// if the clip model is linked and enabled
+		if (!check->linked || !check->enabled) {
 			continue;
 		}
 
 		// if the clip model does not have any contents we are looking for
-		if (!(check->contents & parms.contentMask)) {
+		if (!(check->contents & contentMask)) {
 			continue;
 		}
 
 		// if the bounds really do overlap
-		if (check->absBounds[0][0] > parms.bounds[1][0] ||
-		    check->absBounds[1][0] < parms.bounds[0][0] ||
-		    check->absBounds[0][1] > parms.bounds[1][1] ||
-		    check->absBounds[1][1] < parms.bounds[0][1] ||
-		    check->absBounds[0][2] > parms.bounds[1][2] ||
-		    check->absBounds[1][2] < parms.bounds[0][2]) {
+		if (!ClipNodeOverlaps(check->absBounds, checkBounds)) {
 			continue;
 		}
 
-		if (parms.count >= parms.maxCount) {
-			gameLocal.Warning("idClip::ClipModelsTouchingBounds_r: max count");
-			return;
+		if (count >= maxCount) {
+			gameLocal.Warning("idClip::ClipModelsTouchingBounds: max count");
+			break;
 		}
 
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
-	}
-}
+		clipModelList[count++] = check;
+	}
+
+	SortClipModels(clipModelList, count);
+
+	return count;
+}
+
+/*
+================
+idClip::ClipModelsTouchingBoundsBatch
+
+Walks the tree once for up to 32 bounds at a time, every stack entry
+keeps a bit for each of the bounds that still overlap the node.
+================
+*/
+void idClip::ClipModelsTouchingBoundsBatch(const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelList, int maxCount, int *counts) const
+{
+	int				stack[MAX_CLIP_TREE_DEPTH];
+	unsigned int	stackMasks[MAX_CLIP_TREE_DEPTH];
+	idBounds		checkBounds[MAX_BATCH_BOUNDS];
+	int				i, first, num, stackDepth;
+	unsigned int	mask, allMask;
+	const clipNode_t *nodes;
+
+	for (i = 0; i < numBounds; i++) {
+		counts[i] = 0;
+	}
+
+	if (rootNode == -1) {
+		return;
+	}
+
+	nodes = clipNodes.Ptr();
+
+	for (first = 0; first < numBounds; first += MAX_BATCH_BOUNDS) {
+		num = Min(numBounds - first, MAX_BATCH_BOUNDS);
+		allMask = 0;
+
+		for (i = 0; i < num; i++) {
+			const idBounds &b = bounds[first + i];
+
+			if (b[0][0] > b[1][0] || b[0][1] > b[1][1] || b[0][2] > b[1][2]) {
+				assert(false);
+				continue;
+			}
+
+			checkBounds[i][0] = b[0] - vec3_boxEpsilon;
+			checkBounds[i][1] = b[1] + vec3_boxEpsilon;
+			allMask |= 1u << i;
+		}
+
+		stack[0] = rootNode;
+		stackMasks[0] = allMask;
+		stackDepth = allMask ? 1 : 0;
+
+		while (stackDepth > 0) {
+			stackDepth--;
+			const clipNode_t *node = &nodes[stack[stackDepth]];
+
+			mask = 0;
+
+			for (i = 0; i < num; i++) {
+				if ((stackMasks[stackDepth] & (1u << i)) && ClipNodeOverlaps(node->bounds, checkBounds[i])) {
+					mask |= 1u << i;
+				}
+			}
+
+			if (!mask) {
+				continue;
+			}
+
+			if (node->height > 0) {
+				assert(stackDepth + 2 <= MAX_CLIP_TREE_DEPTH);
+				stack[stackDepth] = node->children[1];
+				stackMasks[stackDepth++] = mask;
+				stack[stackDepth] = node->children[0];
+				stackMasks[stackDepth++] = mask;
+				continue;
+			}
+
+			idClipModel *check = node->clipModel;
+
+			if (!check->linked || !check->enabled || !(check->contents & contentMask)) {
+				continue;
+			}
 
-/*
-================
-idClip::ClipModelsTouchingBounds
-================
-*/
-int idClip::ClipModelsTouchingBounds(const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount) const
-{
-	listParms_t parms;
+			for (i = 0; i < num; i++) {
+				if (!(mask & (1u << i)) || !ClipNodeOverlaps(check->absBounds, checkBounds[i])) {
+					continue;
+				}
 
-	if (bounds[0][0] > bounds[1][0] ||
-	    bounds[0][1] > bounds[1][1] ||
-	    bounds[0][2] > bounds[1][2]) {
-		// we should not go through the tree for degenerate or backwards bounds
-		assert(false);
-		return 0;
-	}
+				int &count = counts[first + i];
 
-	parms.bounds[0] = bounds[0] - vec3_boxEpsilon;
-	parms.bounds[1] = bounds[1] + vec3_boxEpsilon;
-	parms.contentMask = contentMask;
-	parms.list = clipModelList;
-	parms.count = 0;
-	parms.maxCount = maxCount;
+				if (count >= maxCount) {
+					gameLocal.Warning("idClip::ClipModelsTouchingBoundsBatch: max count");
+					continue;
+				}
 
-	touchCount++;
-	ClipModelsTouchingBounds_r(clipSectors, parms);
+				clipModelList[(first + i) * maxCount + count] = check;
+				count++;
+			}
+		}
 
-	return parms.count;
+		for (i = 0; i < num; i++) {
+			SortClipModels(&clipModelList[(first + i) * maxCount], counts[first + i]);
+		}
+	}
 }
 
 /*
@@ -1125,11 +1607,11 @@ void idClip::TranslationEntities(trace_t &results, const idVec3 &start, const id
 
 /*
 ============
-idClip::Translation
+idClip::TranslationUncached
 ============
 */
-bool idClip::Translation(trace_t &results, const idVec3 &start, const idVec3 &end,
-                         const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
+bool idClip::TranslationUncached(trace_t &results, const idVec3 &start, const idVec3 &end,
+                                 const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
 {
 	int i, num;
 	idClipModel *touch, *clipModelList[MAX_GENTITIES];
@@ -1200,6 +1682,188 @@ bool idClip::Translation(trace_t &results, const idVec3 &start, const idVec3 &en
 	return (results.fraction < 1.0f);
 }
 
+/*
+============
+idClip::AddBatchTranslation
+
+  adds a collision model translation against the clip model, or the world if touch is NULL
+============
+*/
+int idClip::AddBatchTranslation(const clipTranslation_t &translation, const idTraceModel *trm, const idClipModel *touch)
+{
+	cm_translation_t &ct = batchTranslations.Alloc();
+
+	ct.start = translation.start;
+	ct.end = translation.end;
+	ct.trm = trm;
+	ct.trmAxis = translation.trmAxis;
+	ct.contentMask = translation.contentMask;
+	ct.modelTrm = NULL;
+	ct.modelMaterial = NULL;
+
+	if (!touch) {
+		ct.model = 0;
+		ct.modelOrigin = vec3_origin;
+		ct.modelAxis = mat3_default;
+	} else {
+		// trace models are converted on the thread running the translation
+		if (!touch->collisionModelHandle && touch->traceModelIndex != -1) {
+			ct.model = 0;
+			ct.modelTrm = idClipModel::GetCachedTraceModel(touch->traceModelIndex);
+			ct.modelMaterial = touch->material;
+		} else {
+			ct.model = touch->Handle();
+		}
+
+		ct.modelOrigin = touch->origin;
+		ct.modelAxis = touch->axis;
+	}
+
+	idClip::numTranslations++;
+
+	return batchTranslations.Num() - 1;
+}
+
+/*
+============
+idClip::Translations
+
+  The world is tested first for all translations, the entities are gathered
+  against the shortened traces and tested next. The results are reduced in
+  the same order as Translation so they come out identical.
+============
+*/
+void idClip::Translations(clipTranslation_t *translations, int numTranslations)
+{
+	int i, j, num, first;
+	clipTranslation_t *t;
+	idClipModel *touch, *clipModelList[MAX_GENTITIES];
+	const idTraceModel *trm;
+	idBounds traceBounds;
+	float radius;
+	trace_t trace;
+
+	batchTranslations.SetNum(0, false);
+	batchClipModels.SetNum(0, false);
+	batchClipIndex.SetNum(0, false);
+	batchFirst.SetNum(numTranslations, false);
+	batchCount.SetNum(numTranslations, false);
+
+	// test the world
+	for (i = 0; i < numTranslations; i++) {
+		t = &translations[i];
+
+		if (TestHugeTranslation(t->results, t->mdl, t->start, t->end, t->trmAxis)) {
+			batchFirst[i] = -2;
+			continue;
+		}
+
+		if (!t->passEntity || t->passEntity->entityNumber != ENTITYNUM_WORLD) {
+			batchFirst[i] = AddBatchTranslation(*t, TraceModelForClipModel(t->mdl), NULL);
+		} else {
+			memset(&t->results, 0, sizeof(t->results));
+			t->results.fraction = 1.0f;
+			t->results.endpos = t->end;
+			t->results.endAxis = t->trmAxis;
+			batchFirst[i] = -1;
+		}
+	}
+
+	collisionModelManager->Translations(batchTranslations.Ptr(), batchTranslations.Num());
+
+	for (i = 0; i < numTranslations; i++) {
+		t = &translations[i];
+
+		if (batchFirst[i] < 0) {
+			continue;
+		}
+
+		t->results = batchTranslations[batchFirst[i]].results;
+		t->results.c.entityNum = t->results.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+
+		if (t->results.fraction == 0.0f) {
+			batchFirst[i] = -2;		// blocked immediately by the world
+		}
+	}
+
+	// gather the entities along the part of the traces not blocked by the world
+	batchTranslations.SetNum(0, false);
+
+	for (i = 0; i < numTranslations; i++) {
+		t = &translations[i];
+
+		if (batchFirst[i] == -2) {
+			continue;
+		}
+
+		trm = TraceModelForClipModel(t->mdl);
+
+		if (!trm) {
+			traceBounds.FromPointTranslation(t->start, t->results.endpos - t->start);
+		} else {
+			traceBounds.FromBoundsTranslation(trm->bounds, t->start, t->trmAxis, t->results.endpos - t->start);
+		}
+
+		num = GetTraceClipModels(traceBounds, t->contentMask, t->passEntity, clipModelList);
+
+		batchFirst[i] = batchClipModels.Num();
+		batchCount[i] = 0;
+
+		for (j = 0; j < num; j++) {
+			touch = clipModelList[j];
+
+			if (!touch) {
+				continue;
+			}
+
+			batchClipModels.Append(touch);
+			batchCount[i]++;
+
+			if (touch->renderModelHandle != -1) {
+				batchClipIndex.Append(-1);
+			} else {
+				batchClipIndex.Append(AddBatchTranslation(*t, trm, touch));
+			}
+		}
+	}
+
+	collisionModelManager->Translations(batchTranslations.Ptr(), batchTranslations.Num());
+
+	// keep the closest hit like Translation does
+	for (i = 0; i < numTranslations; i++) {
+		t = &translations[i];
+		first = batchFirst[i];
+
+		if (first == -2) {
+			continue;
+		}
+
+		trm = TraceModelForClipModel(t->mdl);
+		radius = trm ? trm->bounds.GetRadius() : 0.0f;
+
+		for (j = first; j < first + batchCount[i]; j++) {
+			touch = batchClipModels[j];
+
+			if (batchClipIndex[j] == -1) {
+				idClip::numRenderModelTraces++;
+				TraceRenderModel(trace, t->start, t->end, radius, t->trmAxis, touch);
+			} else {
+				trace = batchTranslations[batchClipIndex[j]].results;
+			}
+
+			if (trace.fraction < t->results.fraction) {
+				t->results = trace;
+				t->results.c.entityNum = touch->entity->entityNumber;
+				t->results.c.id = touch->id;
+
+				if (t->results.fraction == 0.0f) {
+					break;
+				}
+			}
+		}
+	}
+}
+
 /*
 ============
 idClip::Rotation
@@ -1508,10 +2172,10 @@ int idClip::Contacts(contactInfo_t *contacts, const int maxContacts, const idVec
 
 /*
 ============
-idClip::Contents
+idClip::ContentsUncached
 ============
 */
-int idClip::Contents(const idVec3 &start, const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
+int idClip::ContentsUncached(const idVec3 &start, const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
 {
 	int i, num, contents;
 	idClipModel *touch, *clipModelList[MAX_GENTITIES];
@@ -1572,6 +2236,194 @@ int idClip::Contents(const idVec3 &start, const idClipModel *mdl, const idMat3 &
 	return contents;
 }
 
+/*
+============
+ClipQueryHashKey
+============
+*/
+static ID_INLINE int ClipQueryHashKey(const idVec3 &start, const idVec3 &end, int contentMask)
+{
+	return ((int) start[0]) + ((int) start[1]) * 7 + ((int) start[2]) * 13 +
+	       ((int) end[0]) * 17 + ((int) end[1]) * 23 + ((int) end[2]) * 29 + contentMask;
+}
+
+/*
+============
+idClip::FindCachedQuery
+============
+*/
+clipCachedQuery_t *idClip::FindCachedQuery(bool contents, const idVec3 &start, const idVec3 &end, const idTraceModel *trm,
+                const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
+{
+	int i;
+	clipCachedQuery_t *query;
+
+	for (i = cachedQueryHash.First(ClipQueryHashKey(start, end, contentMask)); i != -1; i = cachedQueryHash.Next(i)) {
+		query = &cachedQueries[i];
+
+		if (query->contents == contents && query->trm == trm && query->contentMask == contentMask && query->passEntity == passEntity &&
+		    query->start == start && query->end == end && query->trmAxis == trmAxis) {
+			return query;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+============
+idClip::AddCachedQuery
+============
+*/
+void idClip::AddCachedQuery(bool contents, const idVec3 &start, const idVec3 &end, const idTraceModel *trm,
+                            const idMat3 &trmAxis, int contentMask, const idEntity *passEntity, const trace_t &results)
+{
+	clipCachedQuery_t &query = cachedQueries.Alloc();
+
+	query.start = start;
+	query.end = end;
+	query.trm = trm;
+	query.trmAxis = trmAxis;
+	query.contentMask = contentMask;
+	query.passEntity = passEntity;
+	query.contents = contents;
+	query.results = results;
+	cachedQueryHash.Add(ClipQueryHashKey(start, end, contentMask), cachedQueries.Num() - 1);
+	numCachedQueries++;
+}
+
+/*
+============
+idClip::QueryCacheStats
+============
+*/
+clipQueryCacheStats_t &idClip::QueryCacheStats(const idEntity *passEntity)
+{
+	int i, index;
+
+	index = passEntity ? passEntity->GetType()->typeNum + 1 : 0;
+
+	if (index >= queryCacheStats.Num()) {
+		i = queryCacheStats.Num();
+		queryCacheStats.SetNum(index + 1);
+
+		for (; i < queryCacheStats.Num(); i++) {
+			memset(&queryCacheStats[i], 0, sizeof(queryCacheStats[i]));
+		}
+	}
+
+	return queryCacheStats[index];
+}
+
+/*
+============
+idClip::Translation
+
+  Results of translations that do not trace render models are cached until
+  the end of the frame or until any clip model is linked, unlinked or changed.
+============
+*/
+bool idClip::Translation(trace_t &results, const idVec3 &start, const idVec3 &end,
+                         const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
+{
+	const idTraceModel *trm;
+	clipCachedQuery_t *query;
+
+	if (!g_clipQueryCache.GetBool() || (contentMask & CONTENTS_RENDERMODEL)) {
+		return TranslationUncached(results, start, end, mdl, trmAxis, contentMask, passEntity);
+	}
+
+	trm = TraceModelForClipModel(mdl);
+	clipQueryCacheStats_t &stats = QueryCacheStats(passEntity);
+	stats.translations++;
+
+	query = FindCachedQuery(false, start, end, trm, trmAxis, contentMask, passEntity);
+
+	if (query) {
+		stats.translationHits++;
+		numCacheHits++;
+		results = query->results;
+		return (results.fraction < 1.0f);
+	}
+
+	TranslationUncached(results, start, end, mdl, trmAxis, contentMask, passEntity);
+	AddCachedQuery(false, start, end, trm, trmAxis, contentMask, passEntity, results);
+
+	return (results.fraction < 1.0f);
+}
+
+/*
+============
+idClip::Contents
+============
+*/
+int idClip::Contents(const idVec3 &start, const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity)
+{
+	const idTraceModel *trm;
+	clipCachedQuery_t *query;
+	trace_t results;
+
+	if (!g_clipQueryCache.GetBool()) {
+		return ContentsUncached(start, mdl, trmAxis, contentMask, passEntity);
+	}
+
+	trm = TraceModelForClipModel(mdl);
+	clipQueryCacheStats_t &stats = QueryCacheStats(passEntity);
+	stats.contents++;
+
+	query = FindCachedQuery(true, start, start, trm, trmAxis, contentMask, passEntity);
+
+	if (query) {
+		stats.contentsHits++;
+		numCacheHits++;
+		return query->results.c.contents;
+	}
+
+	results.c.contents = ContentsUncached(start, mdl, trmAxis, contentMask, passEntity);
+	AddCachedQuery(true, start, start, trm, trmAxis, contentMask, passEntity, results);
+
+	return results.c.contents;
+}
+
+/*
+============
+idClip::PrintQueryCacheStats
+============
+*/
+void idClip::PrintQueryCacheStats(void)
+{
+	int i, translations, translationHits, contents, contentsHits;
+	const char *name;
+
+	translations = translationHits = contents = contentsHits = 0;
+
+	gameLocal.Printf("pass entity type                  translations         hits     contents         hits\n");
+
+	for (i = 0; i < queryCacheStats.Num(); i++) {
+		const clipQueryCacheStats_t &stats = queryCacheStats[i];
+
+		if (!stats.translations && !stats.contents) {
+			continue;
+		}
+
+		name = i ? idClass::GetType(i - 1)->classname : "<none>";
+		gameLocal.Printf("%-32s %13d %8d %3d%% %12d %8d %3d%%\n", name,
+		                 stats.translations, stats.translationHits, stats.translations ? stats.translationHits * 100 / stats.translations : 0,
+		                 stats.contents, stats.contentsHits, stats.contents ? stats.contentsHits * 100 / stats.contents : 0);
+
+		translations += stats.translations;
+		translationHits += stats.translationHits;
+		contents += stats.contents;
+		contentsHits += stats.contentsHits;
+	}
+
+	gameLocal.Printf("%-32s %13d %8d %3d%% %12d %8d %3d%%\n", "total",
+	                 translations, translationHits, translations ? translationHits * 100 / translations : 0,
+	                 contents, contentsHits, contents ? contentsHits * 100 / contents : 0);
+
+	queryCacheStats.Clear();
+}
+
 /*
 ============
 idClip::TranslationModel
@@ -1697,9 +2549,98 @@ idClip::PrintStatistics
 */
 void idClip::PrintStatistics(void)
 {
-	gameLocal.Printf("t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
-	                 numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts);
+	gameLocal.Printf("t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d, relinks = %-3d, reinserts = %-3d, tree height = %d, cached = %-3d, cache hits = %-3d\n",
+	                 numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts,
+	                 numRelinks, numReinserts, (rootNode != -1) ? clipNodes[rootNode].height : 0, numCachedQueries, numCacheHits);
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numRelinks = numReinserts = 0;
+	numCachedQueries = numCacheHits = 0;
+}
+
+/*
+============
+idClip::RecordQueries
+============
+*/
+void idClip::RecordQueries(int count)
+{
+	recordedQueries.Clear();
+	recordedQueries.SetGranularity(Max(count, 16));
+	numQueriesToRecord = count;
+}
+
+/*
+============
+idClip::TestQueries
+============
+*/
+void idClip::TestQueries(int runs) const
+{
+	idClipModel		**clipModelList;
+	idBounds		batchBounds[MAX_BATCH_BOUNDS];
+	int				batchCounts[MAX_BATCH_BOUNDS];
+	int				i, j, run, num, recording, single, batched;
+	idTimer			timer;
+	double			singleTime, batchTime;
+
+	if (!recordedQueries.Num()) {
+		gameLocal.Printf("no clip queries recorded, use recordClipQueries first\n");
+		return;
+	}
+
+	// don't record our own queries
+	recording = numQueriesToRecord;
+	numQueriesToRecord = 0;
+
+	clipModelList = (idClipModel **)Mem_Alloc(MAX_BATCH_BOUNDS * MAX_GENTITIES * sizeof(clipModelList[0]));
+
+	single = 0;
+	timer.Clear();
+	timer.Start();
+
+	for (run = 0; run < runs; run++) {
+		for (i = 0; i < recordedQueries.Num(); i++) {
+			single += ClipModelsTouchingBounds(recordedQueries[i].bounds, recordedQueries[i].contentMask, clipModelList, MAX_GENTITIES);
+		}
+	}
+
+	timer.Stop();
+	singleTime = timer.Milliseconds();
+
+	// batch up runs of queries with the same content mask
+	batched = 0;
+	timer.Clear();
+	timer.Start();
+
+	for (run = 0; run < runs; run++) {
+		for (i = 0; i < recordedQueries.Num(); i += num) {
+			for (num = 0; num < MAX_BATCH_BOUNDS && i + num < recordedQueries.Num(); num++) {
+				if (recordedQueries[i + num].contentMask != recordedQueries[i].contentMask) {
+					break;
+				}
+
+				batchBounds[num] = recordedQueries[i + num].bounds;
+			}
+
+			ClipModelsTouchingBoundsBatch(batchBounds, num, recordedQueries[i].contentMask, clipModelList, MAX_GENTITIES, batchCounts);
+
+			for (j = 0; j < num; j++) {
+				batched += batchCounts[j];
+			}
+		}
+	}
+
+	timer.Stop();
+	batchTime = timer.Milliseconds();
+
+	Mem_Free(clipModelList);
+
+	numQueriesToRecord = recording;
+
+	num = recordedQueries.Num() * runs;
+	gameLocal.Printf("%d queries, %.2f clip models per query: single %.1f msec (%.0f per msec), batched %.1f msec (%.0f per msec)%s\n",
+	                 num, (float)single / num, singleTime, num / Max(singleTime, 0.001), batchTime, num / Max(batchTime, 0.001),
+	                 (single != batched) ? ", RESULTS DIFFER" : "");
 }
 
 /*
@@ -1149,6 +1149,7 @@ class idPhysics_AF : public idPhysics_Base
 		// physics state
 		AFPState_t				current;
 		AFPState_t				saved;
+		physicsLODState_t		lod;							// physics level of detail
 
 		idAFBody 				*masterBody;						// master body
 		idLCP 					*lcp;							// linear complementarity problem solver
@@ -1176,6 +1177,7 @@ class idPhysics_AF : public idPhysics_Base
 		void					AddGravity(void);
 		void					SwapStates(void);
 		bool					TestIfAtRest(float timeStep);
+		bool					TestIfFrozen(void) const;
 		void					Rest(void);
 		void					AddPushVelocity(const idVec6 &pushVelocity);
 		void					DebugDraw(void);
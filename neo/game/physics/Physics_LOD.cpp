@@ -0,0 +1,216 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "../Game_local.h"
+
+const int PHYSICS_LOD_TIME_BITS		= 16;
+
+/*
+============
+idPhysicsLOD::Clear
+============
+*/
+void idPhysicsLOD::Clear(void)
+{
+	memset(counts, 0, sizeof(counts));
+}
+
+/*
+============
+idPhysicsLOD::ClearState
+============
+*/
+void idPhysicsLOD::ClearState(physicsLODState_t &state)
+{
+	state.level = PHYSICS_LOD_FULL;
+	state.time = 0;
+	state.wakeTime = 0;
+}
+
+/*
+============
+idPhysicsLOD::Select
+============
+*/
+physicsLOD_t idPhysicsLOD::Select(idEntity *ent, const idBounds &absBounds, const physicsLODState_t &state) const
+{
+	int i, j;
+	float d, distSqr, minDistSqr;
+	idEntity *player;
+
+	if (!g_physicsLOD.GetBool()) {
+		return PHYSICS_LOD_FULL;
+	}
+
+	// recently woken up by an impulse or collision
+	if (gameLocal.time - state.wakeTime < g_physicsLODWakeTime.GetInteger()) {
+		return PHYSICS_LOD_FULL;
+	}
+
+	// find the distance to the closest player
+	minDistSqr = idMath::INFINITY;
+
+	for (i = 0; i < gameLocal.numClients; i++) {
+		player = gameLocal.entities[i];
+
+		if (!player || !player->IsType(idPlayer::Type)) {
+			continue;
+		}
+
+		const idVec3 &origin = player->GetPhysics()->GetOrigin();
+
+		distSqr = 0.0f;
+
+		for (j = 0; j < 3; j++) {
+			if (origin[j] < absBounds[0][j]) {
+				d = absBounds[0][j] - origin[j];
+			} else if (origin[j] > absBounds[1][j]) {
+				d = origin[j] - absBounds[1][j];
+			} else {
+				continue;
+			}
+
+			distSqr += d * d;
+		}
+
+		if (distSqr < minDistSqr) {
+			minDistSqr = distSqr;
+		}
+	}
+
+	// without players there is nothing to base the level of detail on
+	if (minDistSqr == idMath::INFINITY) {
+		return PHYSICS_LOD_FULL;
+	}
+
+	if (gameLocal.InPlayerPVS(ent)) {
+		if (minDistSqr < Square(g_physicsLODDistance.GetFloat())) {
+			return PHYSICS_LOD_FULL;
+		}
+
+		return PHYSICS_LOD_REDUCED;
+	}
+
+	if (minDistSqr < Square(g_physicsLODFreezeDistance.GetFloat())) {
+		return PHYSICS_LOD_REDUCED;
+	}
+
+	return PHYSICS_LOD_FROZEN;
+}
+
+/*
+============
+idPhysicsLOD::Evaluate
+============
+*/
+int idPhysicsLOD::Evaluate(idEntity *ent, const idBounds &absBounds, physicsLODState_t &state, const int timeStepMSec)
+{
+	int timeStep;
+
+	// clients use the level of detail from the server snapshot
+	if (!gameLocal.isClient) {
+		state.level = Select(ent, absBounds, state);
+	}
+
+	counts[state.level]++;
+
+	state.time += timeStepMSec;
+
+	if (state.level != PHYSICS_LOD_FULL && state.time < g_physicsLODInterval.GetInteger()) {
+		return 0;
+	}
+
+	timeStep = state.time;
+	state.time = 0;
+
+	return timeStep;
+}
+
+/*
+============
+idPhysicsLOD::Wake
+============
+*/
+void idPhysicsLOD::Wake(physicsLODState_t &state)
+{
+	state.wakeTime = gameLocal.time;
+
+	if (!gameLocal.isClient) {
+		state.level = PHYSICS_LOD_FULL;
+	}
+}
+
+/*
+============
+idPhysicsLOD::CanFreeze
+============
+*/
+bool idPhysicsLOD::CanFreeze(const physicsLODState_t &state, const float linearVelocity, const float angularVelocity)
+{
+	if (state.level != PHYSICS_LOD_FROZEN) {
+		return false;
+	}
+
+	return (linearVelocity < g_physicsLODFreezeVelocity.GetFloat() && angularVelocity < g_physicsLODFreezeAngularVelocity.GetFloat());
+}
+
+/*
+============
+idPhysicsLOD::WriteToSnapshot
+============
+*/
+void idPhysicsLOD::WriteToSnapshot(idBitMsgDelta &msg, const physicsLODState_t &state)
+{
+	msg.WriteBits(state.level, 2);
+	msg.WriteBits(state.time, PHYSICS_LOD_TIME_BITS);
+}
+
+/*
+============
+idPhysicsLOD::ReadFromSnapshot
+============
+*/
+void idPhysicsLOD::ReadFromSnapshot(const idBitMsgDelta &msg, physicsLODState_t &state)
+{
+	state.level = (physicsLOD_t) msg.ReadBits(2);
+	state.time = msg.ReadBits(PHYSICS_LOD_TIME_BITS);
+}
+
+/*
+============
+idPhysicsLOD::PrintStatistics
+============
+*/
+void idPhysicsLOD::PrintStatistics(void) const
+{
+	gameLocal.Printf("physics lod %d: full %d reduced %d frozen %d\n",
+	                 gameLocal.time, counts[PHYSICS_LOD_FULL], counts[PHYSICS_LOD_REDUCED], counts[PHYSICS_LOD_FROZEN]);
+}
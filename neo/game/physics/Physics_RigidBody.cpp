@@ -464,6 +464,7 @@ idPhysics_RigidBody::idPhysics_RigidBody(void)
 	memset(&current, 0, sizeof(current));
 
 	current.atRest = -1;
+	idPhysicsLOD::ClearState(lod);
 	current.lastTimeStep = USERCMD_MSEC;
 
 	current.i.position.Zero();
@@ -751,6 +752,29 @@ void idPhysics_RigidBody::SetBouncyness(const float b)
 	bouncyness = b;
 }
 
+/*
+================
+idPhysics_RigidBody::TestIfFrozen
+
+  returns true if the body may be put to rest early because of the physics level of detail
+================
+*/
+bool idPhysics_RigidBody::TestIfFrozen(void) const
+{
+	idVec3 av;
+	idMat3 inverseWorldInertiaTensor;
+
+	// only put to rest when resting on something
+	if (lod.level != PHYSICS_LOD_FROZEN || !contacts.Num()) {
+		return false;
+	}
+
+	inverseWorldInertiaTensor = current.i.orientation.Transpose() * inverseInertiaTensor * current.i.orientation;
+	av = inverseWorldInertiaTensor * current.i.angularMomentum;
+
+	return idPhysicsLOD::CanFreeze(lod, inverseMass * current.i.linearMomentum.Length(), av.Length());
+}
+
 /*
 ================
 idPhysics_RigidBody::Rest
@@ -792,6 +816,11 @@ idPhysics_RigidBody::Activate
 */
 void idPhysics_RigidBody::Activate(void)
 {
+	// simulate at full rate for a while when woken up
+	if (current.atRest >= 0) {
+		idPhysicsLOD::Wake(lod);
+	}
+
 	current.atRest = -1;
 	self->BecomeActive(TH_PHYSICS);
 }
@@ -887,6 +916,7 @@ bool idPhysics_RigidBody::Evaluate(int timeStepMSec, int endTimeMSec)
 	idVec3 oldOrigin, masterOrigin;
 	idMat3 oldAxis, masterAxis;
 	float timeStep;
+	int lodTimeStepMSec;
 	bool collided, cameToRest = false;
 
 	timeStep = MS2SEC(timeStepMSec);
@@ -927,6 +957,17 @@ bool idPhysics_RigidBody::Evaluate(int timeStepMSec, int endTimeMSec)
 		return true;
 	}
 
+	// simulate at a reduced frequency when far away from or invisible to all players
+	lodTimeStepMSec = gameLocal.physicsLOD.Evaluate(self, GetAbsBounds(), lod, timeStepMSec);
+
+	if (lodTimeStepMSec <= 0) {
+		DebugDraw();
+		return false;
+	}
+
+	timeStep = MS2SEC(lodTimeStepMSec);
+	current.lastTimeStep = timeStep;
+
 #ifdef RB_TIMINGS
 	timer_total.Start();
 #endif
@@ -985,6 +1026,10 @@ bool idPhysics_RigidBody::Evaluate(int timeStepMSec, int endTimeMSec)
 			// put to rest
 			Rest();
 			cameToRest = true;
+		} else if (TestIfFrozen()) {
+			// far away from all players the body is put to rest as soon as it hardly moves
+			Rest();
+			cameToRest = true;
 		}  else {
 			// apply contact friction
 			ContactFriction(timeStep);
@@ -1102,6 +1147,7 @@ void idPhysics_RigidBody::ApplyImpulse(const int id, const idVec3 &point, const
 
 	current.i.linearMomentum += impulse;
 	current.i.angularMomentum += (point - (current.i.position + centerOfMass * current.i.orientation)).Cross(impulse);
+	idPhysicsLOD::Wake(lod);
 	Activate();
 }
 
@@ -1118,6 +1164,7 @@ void idPhysics_RigidBody::AddForce(const int id, const idVec3 &point, const idVe
 
 	current.externalForce += force;
 	current.externalTorque += (point - (current.i.position + centerOfMass * current.i.orientation)).Cross(force);
+	idPhysicsLOD::Wake(lod);
 	Activate();
 }
 
@@ -1547,6 +1594,7 @@ void idPhysics_RigidBody::WriteToSnapshot(idBitMsgDelta &msg) const
 	localQuat = current.localAxis.ToCQuat();
 
 	msg.WriteLong(current.atRest);
+	idPhysicsLOD::WriteToSnapshot(msg, lod);
 	msg.WriteFloat(current.i.position[0]);
 	msg.WriteFloat(current.i.position[1]);
 	msg.WriteFloat(current.i.position[2]);
@@ -1586,6 +1634,7 @@ void idPhysics_RigidBody::ReadFromSnapshot(const idBitMsgDelta &msg)
 	idCQuat quat, localQuat;
 
 	current.atRest = msg.ReadLong();
+	idPhysicsLOD::ReadFromSnapshot(msg, lod);
 	current.i.position[0] = msg.ReadFloat();
 	current.i.position[1] = msg.ReadFloat();
 	current.i.position[2] = msg.ReadFloat();
@@ -2889,7 +2889,7 @@ void idCompiler::CompileFile(const char *text, const char *filename, bool toCons
 
 	memset(&immediate, 0, sizeof(immediate));
 
-	parser.SetFlags(LEXFL_ALLOWMULTICHARLITERALS);
+	parser.SetFlags(LEXFL_ALLOWMULTICHARLITERALS | LEXFL_TOKENCACHE);
 	parser.LoadMemory(text, strlen(text), filename);
 	parserPtr = &parser;
 
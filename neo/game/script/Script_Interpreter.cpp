@@ -31,6 +31,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
+int idInterpreter::executedStatements = 0;
+
 /*
 ================
 idInterpreter::idInterpreter()
@@ -1006,6 +1008,30 @@ void idInterpreter::CallSysEvent(const function_t *func, int argsize)
 	popParms = 0;
 }
 
+// gcc can jump straight from one statement to the next through a table of
+// label addresses, which predicts a lot better than the single jump of a switch
+#ifdef __GNUC__
+#define SCRIPT_THREADED_DISPATCH
+#endif
+
+#define SCRIPT_RUNAWAY		5000000
+
+#ifdef SCRIPT_THREADED_DISPATCH
+#define SCRIPT_OP( op )		label_##op:
+#define SCRIPT_NEXT			if ( doneProcessing || threadDying ) {							\
+								goto done;												\
+							}															\
+							instructionPointer++;										\
+							if ( !--runaway ) {											\
+								Error( "runaway loop error" );							\
+							}															\
+							st = &gameLocal.program.GetDecodedStatement( instructionPointer );	\
+							goto *dispatchTable[ st->op ]
+#else
+#define SCRIPT_OP( op )		case op:
+#define SCRIPT_NEXT			break
+#endif
+
 /*
 ====================
 idInterpreter::Execute
@@ -1017,23 +1043,166 @@ bool idInterpreter::Execute(void)
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t	*st;
+	const decodedStatement_t *st;
 	int 		runaway;
 	idThread	*newThread;
 	float		floatVal;
 	idScriptObject *obj;
 	const function_t *func;
 
+#ifdef SCRIPT_THREADED_DISPATCH
+	static void *const dispatchTable[] = {
+		&&label_OP_RETURN,
+		&&label_OP_UINC_F,
+		&&label_OP_UINCP_F,
+		&&label_OP_UDEC_F,
+		&&label_OP_UDECP_F,
+		&&label_OP_COMP_F,
+		&&label_OP_MUL_F,
+		&&label_OP_MUL_V,
+		&&label_OP_MUL_FV,
+		&&label_OP_MUL_VF,
+		&&label_OP_DIV_F,
+		&&label_OP_MOD_F,
+		&&label_OP_ADD_F,
+		&&label_OP_ADD_V,
+		&&label_OP_ADD_S,
+		&&label_OP_ADD_FS,
+		&&label_OP_ADD_SF,
+		&&label_OP_ADD_VS,
+		&&label_OP_ADD_SV,
+		&&label_OP_SUB_F,
+		&&label_OP_SUB_V,
+		&&label_OP_EQ_F,
+		&&label_OP_EQ_V,
+		&&label_OP_EQ_S,
+		&&label_OP_EQ_E,
+		&&label_OP_EQ_EO,
+		&&label_OP_EQ_OE,
+		&&label_OP_EQ_OO,
+		&&label_OP_NE_F,
+		&&label_OP_NE_V,
+		&&label_OP_NE_S,
+		&&label_OP_NE_E,
+		&&label_OP_NE_EO,
+		&&label_OP_NE_OE,
+		&&label_OP_NE_OO,
+		&&label_OP_LE,
+		&&label_OP_GE,
+		&&label_OP_LT,
+		&&label_OP_GT,
+		&&label_OP_INDIRECT_F,
+		&&label_OP_INDIRECT_V,
+		&&label_OP_INDIRECT_S,
+		&&label_OP_INDIRECT_ENT,
+		&&label_OP_INDIRECT_BOOL,
+		&&label_OP_INDIRECT_OBJ,
+		&&label_OP_ADDRESS,
+		&&label_OP_EVENTCALL,
+		&&label_OP_OBJECTCALL,
+		&&label_OP_SYSCALL,
+		&&label_OP_STORE_F,
+		&&label_OP_STORE_V,
+		&&label_OP_STORE_S,
+		&&label_OP_STORE_ENT,
+		&&label_OP_STORE_BOOL,
+		&&label_OP_STORE_OBJENT,
+		&&label_OP_STORE_OBJ,
+		&&label_OP_STORE_ENTOBJ,
+		&&label_OP_STORE_FTOS,
+		&&label_OP_STORE_BTOS,
+		&&label_OP_STORE_VTOS,
+		&&label_OP_STORE_FTOBOOL,
+		&&label_OP_STORE_BOOLTOF,
+		&&label_OP_STOREP_F,
+		&&label_OP_STOREP_V,
+		&&label_OP_STOREP_S,
+		&&label_OP_STOREP_ENT,
+		&&label_OP_STOREP_FLD,
+		&&label_OP_STOREP_BOOL,
+		&&label_OP_STOREP_OBJ,
+		&&label_OP_STOREP_OBJENT,
+		&&label_OP_STOREP_FTOS,
+		&&label_OP_STOREP_BTOS,
+		&&label_OP_STOREP_VTOS,
+		&&label_OP_STOREP_FTOBOOL,
+		&&label_OP_STOREP_BOOLTOF,
+		&&label_OP_UMUL_F,
+		&&label_OP_UMUL_V,
+		&&label_OP_UDIV_F,
+		&&label_OP_UDIV_V,
+		&&label_OP_UMOD_F,
+		&&label_OP_UADD_F,
+		&&label_OP_UADD_V,
+		&&label_OP_USUB_F,
+		&&label_OP_USUB_V,
+		&&label_OP_UAND_F,
+		&&label_OP_UOR_F,
+		&&label_OP_NOT_BOOL,
+		&&label_OP_NOT_F,
+		&&label_OP_NOT_V,
+		&&label_OP_NOT_S,
+		&&label_OP_NOT_ENT,
+		&&label_OP_NEG_F,
+		&&label_OP_NEG_V,
+		&&label_OP_INT_F,
+		&&label_OP_IF,
+		&&label_OP_IFNOT,
+		&&label_OP_CALL,
+		&&label_OP_THREAD,
+		&&label_OP_OBJTHREAD,
+		&&label_OP_PUSH_F,
+		&&label_OP_PUSH_V,
+		&&label_OP_PUSH_S,
+		&&label_OP_PUSH_ENT,
+		&&label_OP_PUSH_OBJ,
+		&&label_OP_PUSH_OBJENT,
+		&&label_OP_PUSH_FTOS,
+		&&label_OP_PUSH_BTOF,
+		&&label_OP_PUSH_FTOB,
+		&&label_OP_PUSH_VTOS,
+		&&label_OP_PUSH_BTOS,
+		&&label_OP_GOTO,
+		&&label_OP_AND,
+		&&label_OP_AND_BOOLF,
+		&&label_OP_AND_FBOOL,
+		&&label_OP_AND_BOOLBOOL,
+		&&label_OP_OR,
+		&&label_OP_OR_BOOLF,
+		&&label_OP_OR_FBOOL,
+		&&label_OP_OR_BOOLBOOL,
+		&&label_OP_BITAND,
+		&&label_OP_BITOR,
+		&&label_OP_BREAK,
+		&&label_OP_CONTINUE,
+		&&label_OP_LT_IFNOT,
+		&&label_OP_LE_IFNOT,
+		&&label_OP_GT_IFNOT,
+		&&label_OP_GE_IFNOT,
+		&&label_OP_EQ_F_IFNOT,
+		&&label_OP_NE_F_IFNOT,
+		&&label_OP_INDIRECT_F_IFNOT,
+		&&label_OP_INDIRECT_BOOL_IFNOT,
+		&&label_OP_INDIRECT_F_PUSH_F,
+		&&label_OP_INDIRECT_ENT_PUSH_ENT,
+	};
+
+	assert((sizeof(dispatchTable) / sizeof(dispatchTable[ 0 ])) == NUM_DECODED_OPCODES);
+#endif
+
 	if (threadDying || !currentFunction) {
 		return true;
 	}
 
+	// decode any statements compiled since the last time
+	gameLocal.program.DecodeStatements();
+
 	if (multiFrameEvent) {
 		// move to previous instruction and call it again
 		instructionPointer--;
 	}
 
-	runaway = 5000000;
+	runaway = SCRIPT_RUNAWAY;
 
 	doneProcessing = false;
 
@@ -1045,29 +1214,34 @@ bool idInterpreter::Execute(void)
 		}
 
 		// next statement
-		st = &gameLocal.program.GetStatement(instructionPointer);
+		st = &gameLocal.program.GetDecodedStatement(instructionPointer);
 
+#ifdef SCRIPT_THREADED_DISPATCH
+		goto *dispatchTable[ st->op ];
+		{
+#else
 		switch (st->op) {
-			case OP_RETURN:
-				LeaveFunction(st->a);
-				break;
+#endif
+			SCRIPT_OP(OP_RETURN)
+				LeaveFunction(gameLocal.program.GetStatement(instructionPointer).a);
+				SCRIPT_NEXT;
 
-			case OP_THREAD:
-				newThread = new idThread(this, st->a->value.functionPtr, st->b->value.argSize);
+			SCRIPT_OP(OP_THREAD)
+				newThread = new idThread(this, st->a.value.functionPtr, st->b.value.argSize);
 				newThread->Start();
 
 				// return the thread number to the script
 				gameLocal.program.ReturnFloat(newThread->GetThreadNum());
-				PopParms(st->b->value.argSize);
-				break;
+				PopParms(st->b.value.argSize);
+				SCRIPT_NEXT;
 
-			case OP_OBJTHREAD:
+			SCRIPT_OP(OP_OBJTHREAD)
 				var_a = GetVariable(st->a);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					func = obj->GetTypeDef()->GetFunction(st->b->value.virtualFunction);
-					assert(st->c->value.argSize == func->parmTotal);
+					func = obj->GetTypeDef()->GetFunction(st->b.value.virtualFunction);
+					assert(st->c.value.argSize == func->parmTotal);
 					newThread = new idThread(this, GetEntity(*var_a.entityNumberPtr), func, func->parmTotal);
 					newThread->Start();
 
@@ -1078,145 +1252,150 @@ bool idInterpreter::Execute(void)
 					gameLocal.program.ReturnFloat(0.0f);
 				}
 
-				PopParms(st->c->value.argSize);
-				break;
+				PopParms(st->c.value.argSize);
+				SCRIPT_NEXT;
 
-			case OP_CALL:
-				EnterFunction(st->a->value.functionPtr, false);
-				break;
+			SCRIPT_OP(OP_CALL)
+				EnterFunction(st->a.value.functionPtr, false);
+				SCRIPT_NEXT;
 
-			case OP_EVENTCALL:
-				CallEvent(st->a->value.functionPtr, st->b->value.argSize);
-				break;
+			SCRIPT_OP(OP_EVENTCALL)
+				CallEvent(st->a.value.functionPtr, st->b.value.argSize);
+				SCRIPT_NEXT;
 
-			case OP_OBJECTCALL:
+			SCRIPT_OP(OP_OBJECTCALL)
 				var_a = GetVariable(st->a);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					func = obj->GetTypeDef()->GetFunction(st->b->value.virtualFunction);
+					func = obj->GetTypeDef()->GetFunction(st->b.value.virtualFunction);
 					EnterFunction(func, false);
 				} else {
 					// return a 'safe' value
 					gameLocal.program.ReturnVector(vec3_zero);
 					gameLocal.program.ReturnString("");
-					PopParms(st->c->value.argSize);
+					PopParms(st->c.value.argSize);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_SYSCALL:
-				CallSysEvent(st->a->value.functionPtr, st->b->value.argSize);
-				break;
+			SCRIPT_OP(OP_SYSCALL)
+				CallSysEvent(st->a.value.functionPtr, st->b.value.argSize);
+				SCRIPT_NEXT;
+
+fusedIfNot:
+				// continue with the statement fused with the previous one
+				instructionPointer++;
+				st++;
 
-			case OP_IFNOT:
+			SCRIPT_OP(OP_IFNOT)
 				var_a = GetVariable(st->a);
 
 				if (*var_a.intPtr == 0) {
-					NextInstruction(instructionPointer + st->b->value.jumpOffset);
+					NextInstruction(instructionPointer + st->b.value.jumpOffset);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_IF:
+			SCRIPT_OP(OP_IF)
 				var_a = GetVariable(st->a);
 
 				if (*var_a.intPtr != 0) {
-					NextInstruction(instructionPointer + st->b->value.jumpOffset);
+					NextInstruction(instructionPointer + st->b.value.jumpOffset);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_GOTO:
-				NextInstruction(instructionPointer + st->a->value.jumpOffset);
-				break;
+			SCRIPT_OP(OP_GOTO)
+				NextInstruction(instructionPointer + st->a.value.jumpOffset);
+				SCRIPT_NEXT;
 
-			case OP_ADD_F:
+			SCRIPT_OP(OP_ADD_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADD_V:
+			SCRIPT_OP(OP_ADD_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADD_S:
+			SCRIPT_OP(OP_ADD_S)
 				SetString(st->c, GetString(st->a));
 				AppendString(st->c, GetString(st->b));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADD_FS:
+			SCRIPT_OP(OP_ADD_FS)
 				var_a = GetVariable(st->a);
 				SetString(st->c, FloatToString(*var_a.floatPtr));
 				AppendString(st->c, GetString(st->b));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADD_SF:
+			SCRIPT_OP(OP_ADD_SF)
 				var_b = GetVariable(st->b);
 				SetString(st->c, GetString(st->a));
 				AppendString(st->c, FloatToString(*var_b.floatPtr));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADD_VS:
+			SCRIPT_OP(OP_ADD_VS)
 				var_a = GetVariable(st->a);
 				SetString(st->c, var_a.vectorPtr->ToString());
 				AppendString(st->c, GetString(st->b));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADD_SV:
+			SCRIPT_OP(OP_ADD_SV)
 				var_b = GetVariable(st->b);
 				SetString(st->c, GetString(st->a));
 				AppendString(st->c, var_b.vectorPtr->ToString());
-				break;
+				SCRIPT_NEXT;
 
-			case OP_SUB_F:
+			SCRIPT_OP(OP_SUB_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_SUB_V:
+			SCRIPT_OP(OP_SUB_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_MUL_F:
+			SCRIPT_OP(OP_MUL_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_MUL_V:
+			SCRIPT_OP(OP_MUL_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_MUL_FV:
+			SCRIPT_OP(OP_MUL_FV)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_MUL_VF:
+			SCRIPT_OP(OP_MUL_VF)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_DIV_F:
+			SCRIPT_OP(OP_DIV_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
@@ -1228,9 +1407,9 @@ bool idInterpreter::Execute(void)
 					*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_MOD_F:
+			SCRIPT_OP(OP_MOD_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
@@ -1242,250 +1421,250 @@ bool idInterpreter::Execute(void)
 					*var_c.floatPtr = static_cast<int>(*var_a.floatPtr) % static_cast<int>(*var_b.floatPtr);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_BITAND:
+			SCRIPT_OP(OP_BITAND)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = static_cast<int>(*var_a.floatPtr) & static_cast<int>(*var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_BITOR:
+			SCRIPT_OP(OP_BITOR)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = static_cast<int>(*var_a.floatPtr) | static_cast<int>(*var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_GE:
+			SCRIPT_OP(OP_GE)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr >= *var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_LE:
+			SCRIPT_OP(OP_LE)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr <= *var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_GT:
+			SCRIPT_OP(OP_GT)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr > *var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_LT:
+			SCRIPT_OP(OP_LT)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr < *var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_AND:
+			SCRIPT_OP(OP_AND)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr != 0.0f) && (*var_b.floatPtr != 0.0f);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_AND_BOOLF:
+			SCRIPT_OP(OP_AND_BOOLF)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.intPtr != 0) && (*var_b.floatPtr != 0.0f);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_AND_FBOOL:
+			SCRIPT_OP(OP_AND_FBOOL)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr != 0.0f) && (*var_b.intPtr != 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_AND_BOOLBOOL:
+			SCRIPT_OP(OP_AND_BOOLBOOL)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.intPtr != 0) && (*var_b.intPtr != 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_OR:
+			SCRIPT_OP(OP_OR)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr != 0.0f) || (*var_b.floatPtr != 0.0f);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_OR_BOOLF:
+			SCRIPT_OP(OP_OR_BOOLF)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.intPtr != 0) || (*var_b.floatPtr != 0.0f);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_OR_FBOOL:
+			SCRIPT_OP(OP_OR_FBOOL)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr != 0.0f) || (*var_b.intPtr != 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_OR_BOOLBOOL:
+			SCRIPT_OP(OP_OR_BOOLBOOL)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.intPtr != 0) || (*var_b.intPtr != 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NOT_BOOL:
+			SCRIPT_OP(OP_NOT_BOOL)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.intPtr == 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NOT_F:
+			SCRIPT_OP(OP_NOT_F)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr == 0.0f);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NOT_V:
+			SCRIPT_OP(OP_NOT_V)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.vectorPtr == vec3_zero);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NOT_S:
+			SCRIPT_OP(OP_NOT_S)
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (strlen(GetString(st->a)) == 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NOT_ENT:
+			SCRIPT_OP(OP_NOT_ENT)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (GetEntity(*var_a.entityNumberPtr) == NULL);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NEG_F:
+			SCRIPT_OP(OP_NEG_F)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = -*var_a.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NEG_V:
+			SCRIPT_OP(OP_NEG_V)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.vectorPtr = -*var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INT_F:
+			SCRIPT_OP(OP_INT_F)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = static_cast<int>(*var_a.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_EQ_F:
+			SCRIPT_OP(OP_EQ_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr == *var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_EQ_V:
+			SCRIPT_OP(OP_EQ_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.vectorPtr == *var_b.vectorPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_EQ_S:
+			SCRIPT_OP(OP_EQ_S)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (idStr::Cmp(GetString(st->a), GetString(st->b)) == 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_EQ_E:
-			case OP_EQ_EO:
-			case OP_EQ_OE:
-			case OP_EQ_OO:
+			SCRIPT_OP(OP_EQ_E)
+			SCRIPT_OP(OP_EQ_EO)
+			SCRIPT_OP(OP_EQ_OE)
+			SCRIPT_OP(OP_EQ_OO)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.entityNumberPtr == *var_b.entityNumberPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NE_F:
+			SCRIPT_OP(OP_NE_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.floatPtr != *var_b.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NE_V:
+			SCRIPT_OP(OP_NE_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.vectorPtr != *var_b.vectorPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NE_S:
+			SCRIPT_OP(OP_NE_S)
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (idStr::Cmp(GetString(st->a), GetString(st->b)) != 0);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_NE_E:
-			case OP_NE_EO:
-			case OP_NE_OE:
-			case OP_NE_OO:
+			SCRIPT_OP(OP_NE_E)
+			SCRIPT_OP(OP_NE_EO)
+			SCRIPT_OP(OP_NE_OE)
+			SCRIPT_OP(OP_NE_OO)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = (*var_a.entityNumberPtr != *var_b.entityNumberPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UADD_F:
+			SCRIPT_OP(OP_UADD_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr += *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UADD_V:
+			SCRIPT_OP(OP_UADD_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.vectorPtr += *var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_USUB_F:
+			SCRIPT_OP(OP_USUB_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr -= *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_USUB_V:
+			SCRIPT_OP(OP_USUB_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.vectorPtr -= *var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UMUL_F:
+			SCRIPT_OP(OP_UMUL_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr *= *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UMUL_V:
+			SCRIPT_OP(OP_UMUL_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.vectorPtr *= *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UDIV_F:
+			SCRIPT_OP(OP_UDIV_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 
@@ -1496,9 +1675,9 @@ bool idInterpreter::Execute(void)
 					*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UDIV_V:
+			SCRIPT_OP(OP_UDIV_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 
@@ -1509,9 +1688,9 @@ bool idInterpreter::Execute(void)
 					*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UMOD_F:
+			SCRIPT_OP(OP_UMOD_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 
@@ -1522,125 +1701,125 @@ bool idInterpreter::Execute(void)
 					*var_b.floatPtr = static_cast<int>(*var_b.floatPtr) % static_cast<int>(*var_a.floatPtr);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UOR_F:
+			SCRIPT_OP(OP_UOR_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr = static_cast<int>(*var_b.floatPtr) | static_cast<int>(*var_a.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UAND_F:
+			SCRIPT_OP(OP_UAND_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr = static_cast<int>(*var_b.floatPtr) & static_cast<int>(*var_a.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UINC_F:
+			SCRIPT_OP(OP_UINC_F)
 				var_a = GetVariable(st->a);
 				(*var_a.floatPtr)++;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UINCP_F:
+			SCRIPT_OP(OP_UINCP_F)
 				var_a = GetVariable(st->a);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					(*var.floatPtr)++;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UDEC_F:
+			SCRIPT_OP(OP_UDEC_F)
 				var_a = GetVariable(st->a);
 				(*var_a.floatPtr)--;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_UDECP_F:
+			SCRIPT_OP(OP_UDECP_F)
 				var_a = GetVariable(st->a);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					(*var.floatPtr)--;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_COMP_F:
+			SCRIPT_OP(OP_COMP_F)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				*var_c.floatPtr = ~static_cast<int>(*var_a.floatPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_F:
+			SCRIPT_OP(OP_STORE_F)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr = *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_ENT:
+			SCRIPT_OP(OP_STORE_ENT)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_BOOL:
+			SCRIPT_OP(OP_STORE_BOOL)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.intPtr = *var_a.intPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_OBJENT:
+			SCRIPT_OP(OP_STORE_OBJENT)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (!obj) {
 					*var_b.entityNumberPtr = 0;
-				} else if (!obj->GetTypeDef()->Inherits(st->b->TypeDef())) {
+				} else if (!obj->GetTypeDef()->Inherits(gameLocal.program.GetStatement(instructionPointer).b->TypeDef())) {
 					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
 					*var_b.entityNumberPtr = 0;
 				} else {
 					*var_b.entityNumberPtr = *var_a.entityNumberPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_OBJ:
-			case OP_STORE_ENTOBJ:
+			SCRIPT_OP(OP_STORE_OBJ)
+			SCRIPT_OP(OP_STORE_ENTOBJ)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_S:
+			SCRIPT_OP(OP_STORE_S)
 				SetString(st->b, GetString(st->a));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_V:
+			SCRIPT_OP(OP_STORE_V)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.vectorPtr = *var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_FTOS:
+			SCRIPT_OP(OP_STORE_FTOS)
 				var_a = GetVariable(st->a);
 				SetString(st->b, FloatToString(*var_a.floatPtr));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_BTOS:
+			SCRIPT_OP(OP_STORE_BTOS)
 				var_a = GetVariable(st->a);
 				SetString(st->b, *var_a.intPtr ? "true" : "false");
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_VTOS:
+			SCRIPT_OP(OP_STORE_VTOS)
 				var_a = GetVariable(st->a);
 				SetString(st->b, var_a.vectorPtr->ToString());
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_FTOBOOL:
+			SCRIPT_OP(OP_STORE_FTOBOOL)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 
@@ -1650,15 +1829,15 @@ bool idInterpreter::Execute(void)
 					*var_b.intPtr = 0;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STORE_BOOLTOF:
+			SCRIPT_OP(OP_STORE_BOOLTOF)
 				var_a = GetVariable(st->a);
 				var_b = GetVariable(st->b);
 				*var_b.floatPtr = static_cast<float>(*var_a.intPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_F:
+			SCRIPT_OP(OP_STOREP_F)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->floatPtr) {
@@ -1666,9 +1845,9 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->floatPtr = *var_a.floatPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_ENT:
+			SCRIPT_OP(OP_STOREP_ENT)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->entityNumberPtr) {
@@ -1676,9 +1855,9 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_FLD:
+			SCRIPT_OP(OP_STOREP_FLD)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->intPtr) {
@@ -1686,9 +1865,9 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->intPtr = *var_a.intPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_BOOL:
+			SCRIPT_OP(OP_STOREP_BOOL)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->intPtr) {
@@ -1696,18 +1875,18 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->intPtr = *var_a.intPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_S:
+			SCRIPT_OP(OP_STOREP_S)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->stringPtr) {
 					idStr::Copynz(var_b.evalPtr->stringPtr, GetString(st->a), MAX_STRING_LEN);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_V:
+			SCRIPT_OP(OP_STOREP_V)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->vectorPtr) {
@@ -1715,9 +1894,9 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_FTOS:
+			SCRIPT_OP(OP_STOREP_FTOS)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->stringPtr) {
@@ -1725,9 +1904,9 @@ bool idInterpreter::Execute(void)
 					idStr::Copynz(var_b.evalPtr->stringPtr, FloatToString(*var_a.floatPtr), MAX_STRING_LEN);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_BTOS:
+			SCRIPT_OP(OP_STOREP_BTOS)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->stringPtr) {
@@ -1740,9 +1919,9 @@ bool idInterpreter::Execute(void)
 					}
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_VTOS:
+			SCRIPT_OP(OP_STOREP_VTOS)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->stringPtr) {
@@ -1750,9 +1929,9 @@ bool idInterpreter::Execute(void)
 					idStr::Copynz(var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_FTOBOOL:
+			SCRIPT_OP(OP_STOREP_FTOBOOL)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->intPtr) {
@@ -1765,9 +1944,9 @@ bool idInterpreter::Execute(void)
 					}
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_BOOLTOF:
+			SCRIPT_OP(OP_STOREP_BOOLTOF)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->floatPtr) {
@@ -1775,9 +1954,9 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->floatPtr = static_cast<float>(*var_a.intPtr);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_OBJ:
+			SCRIPT_OP(OP_STOREP_OBJ)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->entityNumberPtr) {
@@ -1785,9 +1964,9 @@ bool idInterpreter::Execute(void)
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_STOREP_OBJENT:
+			SCRIPT_OP(OP_STOREP_OBJENT)
 				var_b = GetVariable(st->b);
 
 				if (var_b.evalPtr && var_b.evalPtr->entityNumberPtr) {
@@ -1800,7 +1979,7 @@ bool idInterpreter::Execute(void)
 						// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
 						// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
 						// comes from an entity
-					} else if (!obj->GetTypeDef()->Inherits(st->c->TypeDef())) {
+					} else if (!obj->GetTypeDef()->Inherits(gameLocal.program.GetStatement(instructionPointer).c->TypeDef())) {
 						//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
 						*var_b.evalPtr->entityNumberPtr = 0;
 					} else {
@@ -1808,91 +1987,91 @@ bool idInterpreter::Execute(void)
 					}
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_ADDRESS:
+			SCRIPT_OP(OP_ADDRESS)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var_c.evalPtr->bytePtr = &obj->data[ st->b.value.ptrOffset ];
 				} else {
 					var_c.evalPtr->bytePtr = NULL;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INDIRECT_F:
+			SCRIPT_OP(OP_INDIRECT_F)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					*var_c.floatPtr = *var.floatPtr;
 				} else {
 					*var_c.floatPtr = 0.0f;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INDIRECT_ENT:
+			SCRIPT_OP(OP_INDIRECT_ENT)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					*var_c.entityNumberPtr = *var.entityNumberPtr;
 				} else {
 					*var_c.entityNumberPtr = 0;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INDIRECT_BOOL:
+			SCRIPT_OP(OP_INDIRECT_BOOL)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					*var_c.intPtr = *var.intPtr;
 				} else {
 					*var_c.intPtr = 0;
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INDIRECT_S:
+			SCRIPT_OP(OP_INDIRECT_S)
 				var_a = GetVariable(st->a);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					SetString(st->c, var.stringPtr);
 				} else {
 					SetString(st->c, "");
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INDIRECT_V:
+			SCRIPT_OP(OP_INDIRECT_V)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
 
 				if (obj) {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					*var_c.vectorPtr = *var.vectorPtr;
 				} else {
 					var_c.vectorPtr->Zero();
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_INDIRECT_OBJ:
+			SCRIPT_OP(OP_INDIRECT_OBJ)
 				var_a = GetVariable(st->a);
 				var_c = GetVariable(st->c);
 				obj = GetScriptObject(*var_a.entityNumberPtr);
@@ -1900,29 +2079,33 @@ bool idInterpreter::Execute(void)
 				if (!obj) {
 					*var_c.entityNumberPtr = 0;
 				} else {
-					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
 					*var_c.entityNumberPtr = *var.entityNumberPtr;
 				}
 
-				break;
+				SCRIPT_NEXT;
+
+fusedPushF:
+				instructionPointer++;
+				st++;
 
-			case OP_PUSH_F:
+			SCRIPT_OP(OP_PUSH_F)
 				var_a = GetVariable(st->a);
 				Push(*var_a.intPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_FTOS:
+			SCRIPT_OP(OP_PUSH_FTOS)
 				var_a = GetVariable(st->a);
 				PushString(FloatToString(*var_a.floatPtr));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_BTOF:
+			SCRIPT_OP(OP_PUSH_BTOF)
 				var_a = GetVariable(st->a);
 				floatVal = *var_a.intPtr;
 				Push(*reinterpret_cast<int *>(&floatVal));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_FTOB:
+			SCRIPT_OP(OP_PUSH_FTOB)
 				var_a = GetVariable(st->a);
 
 				if (*var_a.floatPtr != 0.0f) {
@@ -1931,49 +2114,150 @@ bool idInterpreter::Execute(void)
 					Push(0);
 				}
 
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_VTOS:
+			SCRIPT_OP(OP_PUSH_VTOS)
 				var_a = GetVariable(st->a);
 				PushString(var_a.vectorPtr->ToString());
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_BTOS:
+			SCRIPT_OP(OP_PUSH_BTOS)
 				var_a = GetVariable(st->a);
 				PushString(*var_a.intPtr ? "true" : "false");
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_ENT:
+fusedPushEnt:
+				instructionPointer++;
+				st++;
+
+			SCRIPT_OP(OP_PUSH_ENT)
 				var_a = GetVariable(st->a);
 				Push(*var_a.entityNumberPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_S:
+			SCRIPT_OP(OP_PUSH_S)
 				PushString(GetString(st->a));
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_V:
+			SCRIPT_OP(OP_PUSH_V)
 				var_a = GetVariable(st->a);
 				PushVector(*var_a.vectorPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_OBJ:
+			SCRIPT_OP(OP_PUSH_OBJ)
 				var_a = GetVariable(st->a);
 				Push(*var_a.entityNumberPtr);
-				break;
+				SCRIPT_NEXT;
 
-			case OP_PUSH_OBJENT:
+			SCRIPT_OP(OP_PUSH_OBJENT)
 				var_a = GetVariable(st->a);
 				Push(*var_a.entityNumberPtr);
-				break;
+				SCRIPT_NEXT;
+
+			// superinstructions, the first statement of the pair followed by the second one
+			SCRIPT_OP(OP_LT_IFNOT)
+				var_a = GetVariable(st->a);
+				var_b = GetVariable(st->b);
+				var_c = GetVariable(st->c);
+				*var_c.floatPtr = (*var_a.floatPtr < *var_b.floatPtr);
+				goto fusedIfNot;
+
+			SCRIPT_OP(OP_LE_IFNOT)
+				var_a = GetVariable(st->a);
+				var_b = GetVariable(st->b);
+				var_c = GetVariable(st->c);
+				*var_c.floatPtr = (*var_a.floatPtr <= *var_b.floatPtr);
+				goto fusedIfNot;
+
+			SCRIPT_OP(OP_GT_IFNOT)
+				var_a = GetVariable(st->a);
+				var_b = GetVariable(st->b);
+				var_c = GetVariable(st->c);
+				*var_c.floatPtr = (*var_a.floatPtr > *var_b.floatPtr);
+				goto fusedIfNot;
+
+			SCRIPT_OP(OP_GE_IFNOT)
+				var_a = GetVariable(st->a);
+				var_b = GetVariable(st->b);
+				var_c = GetVariable(st->c);
+				*var_c.floatPtr = (*var_a.floatPtr >= *var_b.floatPtr);
+				goto fusedIfNot;
 
-			case OP_BREAK:
-			case OP_CONTINUE:
+			SCRIPT_OP(OP_EQ_F_IFNOT)
+				var_a = GetVariable(st->a);
+				var_b = GetVariable(st->b);
+				var_c = GetVariable(st->c);
+				*var_c.floatPtr = (*var_a.floatPtr == *var_b.floatPtr);
+				goto fusedIfNot;
+
+			SCRIPT_OP(OP_NE_F_IFNOT)
+				var_a = GetVariable(st->a);
+				var_b = GetVariable(st->b);
+				var_c = GetVariable(st->c);
+				*var_c.floatPtr = (*var_a.floatPtr != *var_b.floatPtr);
+				goto fusedIfNot;
+
+			SCRIPT_OP(OP_INDIRECT_F_IFNOT)
+			SCRIPT_OP(OP_INDIRECT_F_PUSH_F)
+				var_a = GetVariable(st->a);
+				var_c = GetVariable(st->c);
+				obj = GetScriptObject(*var_a.entityNumberPtr);
+
+				if (obj) {
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
+					*var_c.floatPtr = *var.floatPtr;
+				} else {
+					*var_c.floatPtr = 0.0f;
+				}
+
+				if (st->op == OP_INDIRECT_F_IFNOT) {
+					goto fusedIfNot;
+				}
+
+				goto fusedPushF;
+
+			SCRIPT_OP(OP_INDIRECT_BOOL_IFNOT)
+				var_a = GetVariable(st->a);
+				var_c = GetVariable(st->c);
+				obj = GetScriptObject(*var_a.entityNumberPtr);
+
+				if (obj) {
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
+					*var_c.intPtr = *var.intPtr;
+				} else {
+					*var_c.intPtr = 0;
+				}
+
+				goto fusedIfNot;
+
+			SCRIPT_OP(OP_INDIRECT_ENT_PUSH_ENT)
+				var_a = GetVariable(st->a);
+				var_c = GetVariable(st->c);
+				obj = GetScriptObject(*var_a.entityNumberPtr);
+
+				if (obj) {
+					var.bytePtr = &obj->data[ st->b.value.ptrOffset ];
+					*var_c.entityNumberPtr = *var.entityNumberPtr;
+				} else {
+					*var_c.entityNumberPtr = 0;
+				}
+
+				goto fusedPushEnt;
+
+			SCRIPT_OP(OP_BREAK)
+			SCRIPT_OP(OP_CONTINUE)
+#ifndef SCRIPT_THREADED_DISPATCH
 			default:
+#endif
 				Error("Bad opcode %i", st->op);
-				break;
+				SCRIPT_NEXT;
 		}
 	}
 
+#ifdef SCRIPT_THREADED_DISPATCH
+done:
+#endif
+	executedStatements += SCRIPT_RUNAWAY - runaway;
+
 	return threadDying;
 }
@@ -1837,13 +1837,26 @@ idProgram::Disassemble
 ==============
 */
 void idProgram::Disassemble(void) const
+{
+	idFile *file;
+
+	file = fileSystem->OpenFileByMode("script/disasm.txt", FS_WRITE);
+
+	Disassemble(file);
+
+	fileSystem->CloseFile(file);
+}
+
+/*
+==============
+idProgram::Disassemble
+==============
+*/
+void idProgram::Disassemble(idFile *file) const
 {
 	int					i;
 	int					instructionPointer;
 	const function_t	*func;
-	idFile				*file;
-
-	file = fileSystem->OpenFileByMode("script/disasm.txt", FS_WRITE);
 
 	for (i = 0; i < functions.Num(); i++) {
 		func = &functions[ i ];
@@ -1861,8 +1874,6 @@ void idProgram::Disassemble(void) const
 
 		file->Printf("}\n");
 	}
-
-	fileSystem->CloseFile(file);
 }
 
 /*
@@ -1961,6 +1972,7 @@ bool idProgram::CompileText(const char *source, const char *text, bool console)
 	int			i;
 	idVarDef	*def;
 	idStr		ospath;
+	idScopedMemTag	memTag(MEMTAG_SCRIPT);
 
 	// use a full os path for GetFilenum since it calls OSPathToRelativePath to convert filenames from the parser
 	ospath = fileSystem->RelativePathToOSPath(source);
@@ -1969,6 +1981,10 @@ bool idProgram::CompileText(const char *source, const char *text, bool console)
 	try {
 		compiler.CompileFile(text, filename, console);
 
+		for (i = 0; i < compiler.GetLoadedFiles().Num(); i++) {
+			sourceFiles.AddUnique(compiler.GetLoadedFiles()[ i ]);
+		}
+
 		// check to make sure all functions prototyped have code
 		for (i = 0; i < varDefs.Num(); i++) {
 			def = varDefs[ i ];
@@ -2033,6 +2049,8 @@ void idProgram::CompileFile(const char *filename)
 		gameLocal.Error("Couldn't load %s\n", filename);
 	}
 
+	sourceFiles.AddUnique(filename);
+
 	result = CompileText(filename, src, false);
 
 	fileSystem->FreeFile(src);
@@ -2046,6 +2064,103 @@ void idProgram::CompileFile(const char *filename)
 	}
 }
 
+/*
+================
+DecodeOperand
+================
+*/
+static void DecodeOperand(const idVarDef *def, scriptOperand_t &operand)
+{
+	if (!def) {
+		memset(&operand.value, 0, sizeof(operand.value));
+		operand.onStack = false;
+	} else {
+		operand.value = def->value;
+		operand.onStack = (def->initialized == idVarDef::stackVariable);
+	}
+}
+
+/*
+================
+idProgram::DecodeStatements
+
+Resolves the operands of the statements added since the last call so the
+interpreter doesn't have to go through the defs, and replaces common pairs
+of statements with superinstructions.  The second statement of a pair is
+still decoded on its own for jumps that land on it.
+================
+*/
+void idProgram::DecodeStatements(void)
+{
+	idScopedMemTag	memTag(MEMTAG_SCRIPT);
+	int				i, first;
+
+	first = decodedStatements.Num();
+
+	if (first == statements.Num()) {
+		return;
+	}
+
+	if (first > statements.Num()) {
+		first = 0;
+	}
+
+	decodedStatements.SetGranularity(1024);
+	decodedStatements.SetNum(statements.Num(), false);
+
+	for (i = first; i < statements.Num(); i++) {
+		const statement_t &statement = statements[ i ];
+		decodedStatement_t &decoded = decodedStatements[ i ];
+
+		decoded.op = statement.op;
+		DecodeOperand(statement.a, decoded.a);
+		DecodeOperand(statement.b, decoded.b);
+		DecodeOperand(statement.c, decoded.c);
+	}
+
+	for (i = first; i < statements.Num() - 1; i++) {
+		const statement_t &statement = statements[ i ];
+		const statement_t &next = statements[ i + 1 ];
+
+		if (!statement.c || next.a != statement.c) {
+			continue;
+		}
+
+		if (next.op == OP_IFNOT) {
+			switch (statement.op) {
+				case OP_LT:
+					decodedStatements[ i ].op = OP_LT_IFNOT;
+					break;
+				case OP_LE:
+					decodedStatements[ i ].op = OP_LE_IFNOT;
+					break;
+				case OP_GT:
+					decodedStatements[ i ].op = OP_GT_IFNOT;
+					break;
+				case OP_GE:
+					decodedStatements[ i ].op = OP_GE_IFNOT;
+					break;
+				case OP_EQ_F:
+					decodedStatements[ i ].op = OP_EQ_F_IFNOT;
+					break;
+				case OP_NE_F:
+					decodedStatements[ i ].op = OP_NE_F_IFNOT;
+					break;
+				case OP_INDIRECT_F:
+					decodedStatements[ i ].op = OP_INDIRECT_F_IFNOT;
+					break;
+				case OP_INDIRECT_BOOL:
+					decodedStatements[ i ].op = OP_INDIRECT_BOOL_IFNOT;
+					break;
+			}
+		} else if (next.op == OP_PUSH_F && statement.op == OP_INDIRECT_F) {
+			decodedStatements[ i ].op = OP_INDIRECT_F_PUSH_F;
+		} else if (next.op == OP_PUSH_ENT && statement.op == OP_INDIRECT_ENT) {
+			decodedStatements[ i ].op = OP_INDIRECT_ENT_PUSH_ENT;
+		}
+	}
+}
+
 /*
 ================
 idProgram::FreeData
@@ -2067,6 +2182,8 @@ void idProgram::FreeData(void)
 	// free any special types we've created
 	types.DeleteContents(true);
 
+	decodedStatements.Clear();
+
 	filenum = 0;
 
 	numVariables = 0;
@@ -2079,6 +2196,7 @@ void idProgram::FreeData(void)
 
 	filename.Clear();
 	fileList.Clear();
+	sourceFiles.Clear();
 	statements.Clear();
 	functions.Clear();
 
@@ -2091,6 +2209,872 @@ void idProgram::FreeData(void)
 	filename = "";
 }
 
+/***********************************************************************
+
+  Compiled program cache
+
+***********************************************************************/
+
+#define SCRIPT_CACHE_IDENT		(('C'<<24)+('P'<<16)+('R'<<8)+'S')
+#define SCRIPT_CACHE_VERSION	2				// increase when the compiler output changes
+
+// values of var defs which are not stored as plain integers
+typedef enum {
+	CACHEVALUE_INT,
+	CACHEVALUE_FUNCTION,
+	CACHEVALUE_GLOBAL
+} cacheValue_t;
+
+static idTypeDef *const builtinTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef *const builtinDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+static const int numBuiltinTypes = sizeof(builtinTypes) / sizeof(builtinTypes[ 0 ]);
+static const int numBuiltinDefs = sizeof(builtinDefs) / sizeof(builtinDefs[ 0 ]);
+
+/*
+================
+ScriptCacheName
+================
+*/
+static const char *ScriptCacheName(const char *defaultScript)
+{
+	return va("scriptcache/%s.bin", defaultScript);
+}
+
+/*
+================
+ScriptCacheGameChecksum
+
+  checksum of the game code the compiled program depends on
+================
+*/
+static int ScriptCacheGameChecksum(void)
+{
+	unsigned long crc;
+	const idEventDef *ev;
+	char returnType;
+	int i;
+
+	CRC32_InitChecksum(crc);
+
+	for (i = 0; i < idEventDef::NumEventCommands(); i++) {
+		ev = idEventDef::GetEventCommand(i);
+		returnType = ev->GetReturnType();
+		CRC32_UpdateChecksum(crc, ev->GetName(), strlen(ev->GetName()) + 1);
+		CRC32_UpdateChecksum(crc, ev->GetArgFormat(), strlen(ev->GetArgFormat()) + 1);
+		CRC32_UpdateChecksum(crc, &returnType, 1);
+	}
+
+	for (i = 0; idCompiler::opcodes[ i ].opname; i++) {
+		CRC32_UpdateChecksum(crc, idCompiler::opcodes[ i ].opname, strlen(idCompiler::opcodes[ i ].opname) + 1);
+	}
+
+	CRC32_FinishChecksum(crc);
+
+	return crc;
+}
+
+/*
+================
+ScriptCacheValueType
+================
+*/
+static cacheValue_t ScriptCacheValueType(const idVarDef *def)
+{
+	if (def->initialized == idVarDef::stackVariable) {
+		return CACHEVALUE_INT;
+	}
+
+	switch (def->Type()) {
+		case ev_function:
+			return CACHEVALUE_FUNCTION;
+		case ev_virtualfunction:
+		case ev_jumpoffset:
+		case ev_argsize:
+			return CACHEVALUE_INT;
+		default:
+			break;
+	}
+
+	if (def->scope && def->scope->TypeDef()->Inherits(&type_object)) {
+		// offset in the object
+		return CACHEVALUE_INT;
+	}
+
+	return CACHEVALUE_GLOBAL;
+}
+
+/*
+================
+idScriptCacheReader
+================
+*/
+class idScriptCacheReader
+{
+	public:
+		idScriptCacheReader(const byte *data, int length) {
+			this->data = data;
+			this->length = length;
+			this->offset = 0;
+			this->overflowed = false;
+		}
+
+		int ReadInt(void) {
+			int value = 0;
+			ReadData(&value, sizeof(value));
+			return LittleLong(value);
+		}
+
+		void ReadString(idStr &string) {
+			int len = ReadInt();
+
+			if (len < 0 || len > length - offset) {
+				overflowed = true;
+				string.Clear();
+				return;
+			}
+
+			string.Empty();
+			string.Append((const char *)data + offset, len);
+			offset += len;
+		}
+
+		void ReadData(void *buffer, int size) {
+			if (size > length - offset) {
+				overflowed = true;
+				memset(buffer, 0, size);
+				return;
+			}
+
+			memcpy(buffer, data + offset, size);
+			offset += size;
+		}
+
+		bool Overflowed(void) const {
+			return overflowed;
+		}
+
+	private:
+		const byte 	*data;
+		int			length;
+		int			offset;
+		bool		overflowed;
+};
+
+/*
+================
+idProgram::TypeIndex
+================
+*/
+int idProgram::TypeIndex(const idTypeDef *type) const
+{
+	int i;
+
+	if (!type) {
+		return -1;
+	}
+
+	for (i = 0; i < numBuiltinTypes; i++) {
+		if (builtinTypes[ i ] == type) {
+			return -2 - i;
+		}
+	}
+
+	return types.FindIndex(const_cast<idTypeDef *>(type));
+}
+
+/*
+================
+idProgram::DefIndex
+================
+*/
+int idProgram::DefIndex(const idVarDef *def) const
+{
+	int i;
+
+	if (!def) {
+		return -1;
+	}
+
+	for (i = 0; i < numBuiltinDefs; i++) {
+		if (builtinDefs[ i ] == def) {
+			return -2 - i;
+		}
+	}
+
+	if (def->num < 0 || def->num >= varDefs.Num() || varDefs[ def->num ] != def) {
+		return -1;
+	}
+
+	return def->num;
+}
+
+/*
+================
+idProgram::WriteCache
+
+  writes the program compiled from the default script to the cache
+================
+*/
+bool idProgram::WriteCache(const char *defaultScript) const
+{
+	idList<int>	checksums;
+	idFile		*f;
+	void		*buffer;
+	int			i, j, length;
+
+	// the checksums of all the files the compiler read, not only the ones which produced code
+	for (i = 0; i < sourceFiles.Num(); i++) {
+		length = fileSystem->ReadFile(sourceFiles[ i ], &buffer);
+
+		if (length < 0) {
+			gameLocal.DPrintf("not caching script program, couldn't read '%s'\n", sourceFiles[ i ].c_str());
+			return false;
+		}
+
+		checksums.Append(MD5_BlockChecksum(buffer, length));
+		fileSystem->FreeFile(buffer);
+	}
+
+	// builtin types only change their aux type during compilation
+	for (i = 0; i < numBuiltinTypes; i++) {
+		if (builtinTypes[ i ]->parmTypes.Num() || builtinTypes[ i ]->functions.Num() ||
+		    (builtinTypes[ i ]->auxType && TypeIndex(builtinTypes[ i ]->auxType) == -1)) {
+			gameLocal.DPrintf("not caching script program, builtin type '%s' was changed\n", builtinTypes[ i ]->Name());
+			return false;
+		}
+	}
+
+	// everything referenced has to be part of the program
+#define CACHE_KNOWN_TYPE( type )	( !( type ) || TypeIndex( type ) != -1 )
+#define CACHE_KNOWN_DEF( def )		( !( def ) || DefIndex( def ) != -1 )
+
+	for (i = 0; i < types.Num(); i++) {
+		const idTypeDef *type = types[ i ];
+		bool known = CACHE_KNOWN_TYPE(type->auxType) && CACHE_KNOWN_DEF(type->def);
+
+		for (j = 0; j < type->parmTypes.Num(); j++) {
+			known &= CACHE_KNOWN_TYPE(type->parmTypes[ j ]);
+		}
+
+		for (j = 0; j < type->functions.Num(); j++) {
+			known &= (type->functions[ j ] >= &functions[ 0 ] && type->functions[ j ] < &functions[ 0 ] + functions.Num());
+		}
+
+		if (!known) {
+			gameLocal.DPrintf("not caching script program, type '%s' references unknown data\n", type->Name());
+			return false;
+		}
+	}
+
+	for (i = 0; i < functions.Num(); i++) {
+		if (!CACHE_KNOWN_DEF(functions[ i ].def) || !CACHE_KNOWN_TYPE(functions[ i ].type)) {
+			gameLocal.DPrintf("not caching script program, function '%s' references unknown data\n", functions[ i ].Name());
+			return false;
+		}
+	}
+
+	for (i = 0; i < statements.Num(); i++) {
+		if (!CACHE_KNOWN_DEF(statements[ i ].a) || !CACHE_KNOWN_DEF(statements[ i ].b) || !CACHE_KNOWN_DEF(statements[ i ].c)) {
+			gameLocal.DPrintf("not caching script program, statement %d references unknown data\n", i);
+			return false;
+		}
+	}
+
+	if (!CACHE_KNOWN_DEF(returnDef) || !CACHE_KNOWN_DEF(returnStringDef) || !CACHE_KNOWN_DEF(sysDef)) {
+		return false;
+	}
+
+	// only pointers into the globals and the functions can be stored
+	for (i = 0; i < varDefs.Num(); i++) {
+		const idVarDef *def = varDefs[ i ];
+
+		if (def->num != i || !CACHE_KNOWN_TYPE(def->TypeDef()) || !CACHE_KNOWN_DEF(def->scope)) {
+			gameLocal.DPrintf("not caching script program, def '%s' references unknown data\n", def->GlobalName());
+			return false;
+		}
+
+		switch (ScriptCacheValueType(def)) {
+			case CACHEVALUE_FUNCTION:
+				if (def->value.functionPtr && (def->value.functionPtr < &functions[ 0 ] || def->value.functionPtr >= &functions[ 0 ] + functions.Num())) {
+					gameLocal.DPrintf("not caching script program, '%s' has no function\n", def->GlobalName());
+					return false;
+				}
+
+				break;
+			case CACHEVALUE_GLOBAL:
+				if (def->value.bytePtr && (def->value.bytePtr < variables || def->value.bytePtr > variables + numVariables)) {
+					gameLocal.DPrintf("not caching script program, '%s' has no global\n", def->GlobalName());
+					return false;
+				}
+
+				break;
+			default:
+				break;
+		}
+	}
+
+#undef CACHE_KNOWN_TYPE
+#undef CACHE_KNOWN_DEF
+
+	f = fileSystem->OpenFileWrite(ScriptCacheName(defaultScript));
+
+	if (!f) {
+		return false;
+	}
+
+	f->WriteInt(SCRIPT_CACHE_IDENT);
+	f->WriteInt(SCRIPT_CACHE_VERSION);
+	f->WriteInt(sizeof(intptr_t));
+	f->WriteInt(ScriptCacheGameChecksum());
+
+	f->WriteInt(sourceFiles.Num());
+
+	for (i = 0; i < sourceFiles.Num(); i++) {
+		f->WriteString(sourceFiles[ i ]);
+		f->WriteInt(checksums[ i ]);
+	}
+
+	f->WriteInt(fileList.Num());
+
+	for (i = 0; i < fileList.Num(); i++) {
+		f->WriteString(fileList[ i ]);
+	}
+
+	f->WriteInt(types.Num());
+	f->WriteInt(varDefs.Num());
+	f->WriteInt(varDefNames.Num());
+	f->WriteInt(functions.Num());
+	f->WriteInt(statements.Num());
+	f->WriteInt(numVariables);
+
+	for (i = 0; i < numBuiltinTypes; i++) {
+		f->WriteInt(TypeIndex(builtinTypes[ i ]->auxType));
+	}
+
+	for (i = 0; i < types.Num(); i++) {
+		const idTypeDef *type = types[ i ];
+
+		f->WriteInt(type->type);
+		f->WriteString(type->name);
+		f->WriteInt(type->size);
+		f->WriteInt(TypeIndex(type->auxType));
+		f->WriteInt(DefIndex(type->def));
+		f->WriteInt(type->parmTypes.Num());
+
+		for (j = 0; j < type->parmTypes.Num(); j++) {
+			f->WriteInt(TypeIndex(type->parmTypes[ j ]));
+			f->WriteString(type->parmNames[ j ]);
+		}
+
+		f->WriteInt(type->functions.Num());
+
+		for (j = 0; j < type->functions.Num(); j++) {
+			f->WriteInt(type->functions[ j ] - &functions[ 0 ]);
+		}
+	}
+
+	for (i = 0; i < varDefs.Num(); i++) {
+		const idVarDef *def = varDefs[ i ];
+
+		f->WriteInt(TypeIndex(def->TypeDef()));
+		f->WriteInt(DefIndex(def->scope));
+		f->WriteInt(def->numUsers);
+		f->WriteInt(def->initialized);
+		f->WriteInt(ScriptCacheValueType(def));
+
+		switch (ScriptCacheValueType(def)) {
+			case CACHEVALUE_FUNCTION:
+				f->WriteInt(def->value.functionPtr ? def->value.functionPtr - &functions[ 0 ] : -1);
+				break;
+			case CACHEVALUE_GLOBAL:
+				f->WriteInt(def->value.bytePtr ? def->value.bytePtr - variables : -1);
+				break;
+			default:
+				f->WriteInt(def->value.stackOffset);
+				break;
+		}
+	}
+
+	for (i = 0; i < varDefNames.Num(); i++) {
+		const idVarDef *def;
+
+		f->WriteString(varDefNames[ i ]->Name());
+
+		for (j = 0, def = varDefNames[ i ]->GetDefs(); def; def = def->Next()) {
+			j++;
+		}
+
+		f->WriteInt(j);
+
+		for (def = varDefNames[ i ]->GetDefs(); def; def = def->Next()) {
+			f->WriteInt(DefIndex(def));
+		}
+	}
+
+	for (i = 0; i < functions.Num(); i++) {
+		const function_t *func = &functions[ i ];
+
+		f->WriteString(func->Name());
+		f->WriteString(func->eventdef ? func->eventdef->GetName() : "");
+		f->WriteInt(DefIndex(func->def));
+		f->WriteInt(TypeIndex(func->type));
+		f->WriteInt(func->firstStatement);
+		f->WriteInt(func->numStatements);
+		f->WriteInt(func->parmTotal);
+		f->WriteInt(func->locals);
+		f->WriteInt(func->filenum);
+		f->WriteInt(func->parmSize.Num());
+
+		for (j = 0; j < func->parmSize.Num(); j++) {
+			f->WriteInt(func->parmSize[ j ]);
+		}
+	}
+
+	for (i = 0; i < statements.Num(); i++) {
+		const statement_t *statement = &statements[ i ];
+
+		f->WriteInt(statement->op);
+		f->WriteInt(DefIndex(statement->a));
+		f->WriteInt(DefIndex(statement->b));
+		f->WriteInt(DefIndex(statement->c));
+		f->WriteInt(statement->linenumber);
+		f->WriteInt(statement->file);
+	}
+
+	f->Write(variables, numVariables);
+
+	f->WriteInt(DefIndex(returnDef));
+	f->WriteInt(DefIndex(returnStringDef));
+	f->WriteInt(DefIndex(sysDef));
+
+	f->WriteInt(SCRIPT_CACHE_IDENT);
+
+	fileSystem->CloseFile(f);
+
+	return true;
+}
+
+/*
+================
+idProgram::ReadCache
+
+  restores the program compiled from the default script from the cache,
+  returns false if there is no cache or any of the sources changed
+================
+*/
+bool idProgram::ReadCache(const char *defaultScript)
+{
+	idTypeDef	*builtinAuxTypes[ numBuiltinTypes ];
+	idStrList	sources;
+	byte		*buffer;
+	void		*source;
+	idStr		str;
+	int			i, j, num, length, sourceLength, index;
+	int			numTypes, numDefs, numNames, numFunctions, numStatements;
+	idTypeDef	*type;
+	idVarDef	*def;
+	bool		valid;
+
+	length = fileSystem->ReadFile(ScriptCacheName(defaultScript), (void **)&buffer);
+
+	if (length < 0) {
+		return false;
+	}
+
+	idScriptCacheReader reader(buffer, length);
+
+	// a file cut short doesn't end with the ident
+	if (length >= 4) {
+		memcpy(&index, buffer + length - 4, sizeof(index));
+	}
+
+	if (length < 4 || LittleLong(index) != SCRIPT_CACHE_IDENT ||
+	    reader.ReadInt() != SCRIPT_CACHE_IDENT || reader.ReadInt() != SCRIPT_CACHE_VERSION ||
+	    reader.ReadInt() != (int)sizeof(intptr_t) || reader.ReadInt() != ScriptCacheGameChecksum()) {
+		fileSystem->FreeFile(buffer);
+		return false;
+	}
+
+	// check the sources before throwing away the current program
+	num = reader.ReadInt();
+	valid = !reader.Overflowed();
+
+	for (i = 0; i < num && valid; i++) {
+		reader.ReadString(str);
+		sources.Append(str);
+		sourceLength = fileSystem->ReadFile(str, &source);
+
+		if (sourceLength < 0) {
+			valid = false;
+			break;
+		}
+
+		valid = (reader.ReadInt() == (int)MD5_BlockChecksum(source, sourceLength)) && !reader.Overflowed();
+		fileSystem->FreeFile(source);
+	}
+
+	if (!valid) {
+		fileSystem->FreeFile(buffer);
+		return false;
+	}
+
+	FreeData();
+
+	sourceFiles = sources;
+
+	num = reader.ReadInt();
+
+	for (i = 0; i < num && !reader.Overflowed(); i++) {
+		reader.ReadString(str);
+		fileList.Append(str);
+	}
+
+	numTypes = reader.ReadInt();
+	numDefs = reader.ReadInt();
+	numNames = reader.ReadInt();
+	numFunctions = reader.ReadInt();
+	numStatements = reader.ReadInt();
+	numVariables = reader.ReadInt();
+
+	if (reader.Overflowed() || numTypes < 0 || numDefs < 0 || numNames < 0 ||
+	    numFunctions < 0 || numFunctions > functions.Max() || numStatements < 0 || numStatements > statements.Max() ||
+	    numVariables < 0 || numVariables > (int)sizeof(variables)) {
+		FreeData();
+		fileSystem->FreeFile(buffer);
+		return false;
+	}
+
+	// allocate everything first so references can be resolved in any order
+	for (i = 0; i < numTypes; i++) {
+		types.Append(new idTypeDef(ev_void, NULL, "", 0, NULL));
+	}
+
+	for (i = 0; i < numDefs; i++) {
+		def = new idVarDef();
+		def->num = varDefs.Append(def);
+	}
+
+	functions.SetNum(numFunctions);
+	statements.SetNum(numStatements);
+
+#define CACHE_TYPE( index )	( ( index ) >= 0 && ( index ) < numTypes ? types[ index ] : ( ( index ) <= -2 && ( index ) > -2 - numBuiltinTypes ? builtinTypes[ -2 - ( index ) ] : NULL ) )
+#define CACHE_DEF( index )	( ( index ) >= 0 && ( index ) < numDefs ? varDefs[ index ] : ( ( index ) <= -2 && ( index ) > -2 - numBuiltinDefs ? builtinDefs[ -2 - ( index ) ] : NULL ) )
+
+	// the compiler changes the aux type of some of the builtin types
+	for (i = 0; i < numBuiltinTypes; i++) {
+		builtinAuxTypes[ i ] = builtinTypes[ i ]->auxType;
+		index = reader.ReadInt();
+		builtinTypes[ i ]->auxType = CACHE_TYPE(index);
+	}
+
+	for (i = 0; i < numTypes && !reader.Overflowed(); i++) {
+		type = types[ i ];
+		type->type = (etype_t)reader.ReadInt();
+		reader.ReadString(type->name);
+		type->size = reader.ReadInt();
+		index = reader.ReadInt();
+		type->auxType = CACHE_TYPE(index);
+		index = reader.ReadInt();
+		type->def = CACHE_DEF(index);
+
+		num = reader.ReadInt();
+
+		for (j = 0; j < num && !reader.Overflowed(); j++) {
+			index = reader.ReadInt();
+			type->parmTypes.Append(CACHE_TYPE(index));
+			reader.ReadString(str);
+			type->parmNames.Append(str);
+		}
+
+		num = reader.ReadInt();
+
+		for (j = 0; j < num && !reader.Overflowed(); j++) {
+			index = reader.ReadInt();
+			type->functions.Append((index >= 0 && index < numFunctions) ? &functions[ index ] : NULL);
+		}
+	}
+
+	for (i = 0; i < numDefs && !reader.Overflowed(); i++) {
+		def = varDefs[ i ];
+		index = reader.ReadInt();
+		def->SetTypeDef(CACHE_TYPE(index));
+		index = reader.ReadInt();
+		def->scope = CACHE_DEF(index);
+		def->numUsers = reader.ReadInt();
+		def->initialized = (idVarDef::initialized_t)reader.ReadInt();
+		j = reader.ReadInt();
+		index = reader.ReadInt();
+
+		switch (j) {
+			case CACHEVALUE_FUNCTION:
+				def->value.functionPtr = (index >= 0 && index < numFunctions) ? &functions[ index ] : NULL;
+				break;
+			case CACHEVALUE_GLOBAL:
+				def->value.bytePtr = (index >= 0 && index <= numVariables) ? &variables[ index ] : NULL;
+				break;
+			default:
+				def->value.stackOffset = index;
+				break;
+		}
+	}
+
+	for (i = 0; i < numNames && !reader.Overflowed(); i++) {
+		idList<idVarDef *> defs;
+
+		reader.ReadString(str);
+		num = reader.ReadInt();
+
+		for (j = 0; j < num && !reader.Overflowed(); j++) {
+			index = reader.ReadInt();
+
+			if (index < 0 || index >= numDefs || varDefs[ index ]->Next() || defs.FindIndex(varDefs[ index ]) != -1) {
+				valid = false;
+				continue;
+			}
+
+			defs.Append(varDefs[ index ]);
+		}
+
+		varDefNameHash.Add(varDefNameHash.GenerateKey(str, true), varDefNames.Append(new idVarDefName(str)));
+
+		// defs are added to the start of the chain
+		for (j = defs.Num() - 1; j >= 0; j--) {
+			varDefNames[ i ]->AddDef(defs[ j ]);
+		}
+	}
+
+	for (i = 0; i < numFunctions && !reader.Overflowed(); i++) {
+		function_t *func = &functions[ i ];
+
+		func->Clear();
+		reader.ReadString(str);
+		func->SetName(str);
+		reader.ReadString(str);
+
+		if (str.Length()) {
+			func->eventdef = idEventDef::FindEvent(str);
+
+			if (!func->eventdef) {
+				valid = false;
+			}
+		}
+
+		index = reader.ReadInt();
+		func->def = CACHE_DEF(index);
+		index = reader.ReadInt();
+		func->type = CACHE_TYPE(index);
+		func->firstStatement = reader.ReadInt();
+		func->numStatements = reader.ReadInt();
+		func->parmTotal = reader.ReadInt();
+		func->locals = reader.ReadInt();
+		func->filenum = reader.ReadInt();
+
+		num = reader.ReadInt();
+
+		for (j = 0; j < num && !reader.Overflowed(); j++) {
+			func->parmSize.Append(reader.ReadInt());
+		}
+	}
+
+	for (i = 0; i < numStatements && !reader.Overflowed(); i++) {
+		statement_t *statement = &statements[ i ];
+
+		statement->op = reader.ReadInt();
+		index = reader.ReadInt();
+		statement->a = CACHE_DEF(index);
+		index = reader.ReadInt();
+		statement->b = CACHE_DEF(index);
+		index = reader.ReadInt();
+		statement->c = CACHE_DEF(index);
+		statement->linenumber = reader.ReadInt();
+		statement->file = reader.ReadInt();
+	}
+
+	reader.ReadData(variables, numVariables);
+
+	index = reader.ReadInt();
+	returnDef = CACHE_DEF(index);
+	index = reader.ReadInt();
+	returnStringDef = CACHE_DEF(index);
+	index = reader.ReadInt();
+	sysDef = CACHE_DEF(index);
+
+#undef CACHE_TYPE
+#undef CACHE_DEF
+
+	if (reader.ReadInt() != SCRIPT_CACHE_IDENT || reader.Overflowed() || !valid) {
+		for (i = 0; i < numBuiltinTypes; i++) {
+			builtinTypes[ i ]->auxType = builtinAuxTypes[ i ];
+		}
+
+		FreeData();
+		fileSystem->FreeFile(buffer);
+		return false;
+	}
+
+	fileSystem->FreeFile(buffer);
+
+	return true;
+}
+
+/*
+================
+idProgram::Dump
+
+  writes everything the compiler produced
+================
+*/
+void idProgram::Dump(const char *fileName) const
+{
+	idFile *file;
+	int i, j;
+
+	file = fileSystem->OpenFileWrite(fileName);
+
+	if (!file) {
+		return;
+	}
+
+	Disassemble(file);
+
+	file->Printf("\nfiles:\n");
+
+	for (i = 0; i < fileList.Num(); i++) {
+		file->Printf("%d: %s\n", i, fileList[ i ].c_str());
+	}
+
+	file->Printf("\ntypes:\n");
+
+	for (i = -numBuiltinTypes; i < types.Num(); i++) {
+		const idTypeDef *type = (i < 0) ? builtinTypes[ -1 - i ] : types[ i ];
+
+		file->Printf("%d: %s type %d size %d aux %d def %d parms", i, type->Name(), type->Type(), type->Size(), TypeIndex(type->auxType), DefIndex(type->def));
+
+		for (j = 0; j < type->parmTypes.Num(); j++) {
+			file->Printf(" %d %s", TypeIndex(type->parmTypes[ j ]), type->parmNames[ j ].c_str());
+		}
+
+		file->Printf(" functions");
+
+		for (j = 0; j < type->functions.Num(); j++) {
+			file->Printf(" %d", (int)(type->functions[ j ] - &functions[ 0 ]));
+		}
+
+		file->Printf("\n");
+	}
+
+	file->Printf("\ndefs:\n");
+
+	for (i = 0; i < varDefs.Num(); i++) {
+		const idVarDef *def = varDefs[ i ];
+
+		file->Printf("%d: %s type %d scope %d users %d initialized %d value ", i, def->GlobalName(), TypeIndex(def->TypeDef()), DefIndex(def->scope), def->numUsers, def->initialized);
+
+		switch (ScriptCacheValueType(def)) {
+			case CACHEVALUE_FUNCTION:
+				file->Printf("function %d\n", def->value.functionPtr ? (int)(def->value.functionPtr - &functions[ 0 ]) : -1);
+				break;
+			case CACHEVALUE_GLOBAL:
+				file->Printf("global %d\n", def->value.bytePtr ? (int)(def->value.bytePtr - variables) : -1);
+				break;
+			default:
+				file->Printf("%d\n", def->value.stackOffset);
+				break;
+		}
+	}
+
+	file->Printf("\nnames:\n");
+
+	for (i = 0; i < varDefNames.Num(); i++) {
+		file->Printf("%s", varDefNames[ i ]->Name());
+
+		for (const idVarDef *def = varDefNames[ i ]->GetDefs(); def; def = def->Next()) {
+			file->Printf(" %d", def->num);
+		}
+
+		file->Printf("\n");
+	}
+
+	file->Printf("\nfunctions:\n");
+
+	for (i = 0; i < functions.Num(); i++) {
+		const function_t *func = &functions[ i ];
+
+		file->Printf("%d: %s event %s def %d type %d statements %d %d parms %d locals %d file %d parmsize", i, func->Name(), func->eventdef ? func->eventdef->GetName() : "none",
+		             DefIndex(func->def), TypeIndex(func->type), func->firstStatement, func->numStatements, func->parmTotal, func->locals, func->filenum);
+
+		for (j = 0; j < func->parmSize.Num(); j++) {
+			file->Printf(" %d", func->parmSize[ j ]);
+		}
+
+		file->Printf("\n");
+	}
+
+	file->Printf("\nstatements %d checksum %d\n", statements.Num(), CalculateChecksum());
+	file->Printf("variables %d checksum %d\n", numVariables, (int)MD5_BlockChecksum(variables, numVariables));
+	file->Printf("return %d %d sys %d\n", DefIndex(returnDef), DefIndex(returnStringDef), DefIndex(sysDef));
+
+	fileSystem->CloseFile(file);
+}
+
+/*
+================
+idProgram::TestCache
+================
+*/
+bool idProgram::TestCache(const char *defaultScript)
+{
+	void *compiled, *cached;
+	int compiledLength, cachedLength;
+	bool result;
+
+	idThread::Restart();
+
+	BeginCompilation();
+	CompileFile(defaultScript);
+	FinishCompilation();
+	Dump("script/dump_compiled.txt");
+
+	if (!WriteCache(defaultScript)) {
+		gameLocal.Printf("couldn't write the script cache\n");
+		return false;
+	}
+
+	if (!ReadCache(defaultScript)) {
+		gameLocal.Printf("couldn't read the script cache\n");
+		Startup(defaultScript);
+		return false;
+	}
+
+	FinishCompilation();
+	Dump("script/dump_cached.txt");
+
+	compiledLength = fileSystem->ReadFile("script/dump_compiled.txt", &compiled);
+	cachedLength = fileSystem->ReadFile("script/dump_cached.txt", &cached);
+
+	result = (compiledLength > 0 && compiledLength == cachedLength && memcmp(compiled, cached, compiledLength) == 0);
+
+	if (compiledLength >= 0) {
+		fileSystem->FreeFile(compiled);
+	}
+
+	if (cachedLength >= 0) {
+		fileSystem->FreeFile(cached);
+	}
+
+	gameLocal.Printf("program restored from the cache %s the compiled program\n", result ? "matches" : "DOES NOT match");
+
+	return result;
+}
+
 /*
 ================
 idProgram::Startup
@@ -2103,6 +3087,13 @@ void idProgram::Startup(const char *defaultScript)
 	// make sure all data is freed up
 	idThread::Restart();
 
+	// skip the compiler if the default script didn't change since it was last compiled
+	if (defaultScript && *defaultScript && g_scriptCache.GetBool() && ReadCache(defaultScript)) {
+		gameLocal.Printf("Loaded compiled '%s' from the script cache\n", defaultScript);
+		FinishCompilation();
+		return;
+	}
+
 	// get ready for loading scripts
 	BeginCompilation();
 
@@ -2112,6 +3103,10 @@ void idProgram::Startup(const char *defaultScript)
 	}
 
 	FinishCompilation();
+
+	if (defaultScript && *defaultScript && g_scriptCache.GetBool()) {
+		WriteCache(defaultScript);
+	}
 }
 
 /*
@@ -2287,6 +3282,7 @@ void idProgram::Restart(void)
 
 	statements.SetNum(top_statements);
 	fileList.SetNum(top_files, false);
+	decodedStatements.Clear();
 	filename.Clear();
 
 	// reset the variables to their default values
@@ -31,6 +31,24 @@ If you have questions concerning this license or the applicable additional terms
 
 idStrPool		idDict::globalKeys;
 idStrPool		idDict::globalValues;
+const idDictKey *idDictKey::interned;
+
+/*
+================
+idDictKey::GetPoolStr
+================
+*/
+const idPoolStr *idDictKey::GetPoolStr(void) const
+{
+	if (poolStr == NULL) {
+		poolStr = idDict::globalKeys.AllocString(name);
+		hash = idStr::IHash(name);
+		next = interned;
+		interned = this;
+	}
+
+	return poolStr;
+}
 
 /*
 ================
@@ -61,6 +79,32 @@ idDict &idDict::operator=(const idDict &other)
 	return *this;
 }
 
+#if __cplusplus >= 201103L
+/*
+================
+idDict::operator=
+
+  clear existing key/value pairs and take over the key/value pairs of other
+================
+*/
+idDict &idDict::operator=(idDict &&other)
+{
+	// check for assignment to self
+	if (this == &other) {
+		return *this;
+	}
+
+	// the pooled strings can't be handed over across a DLL boundary
+	if (other.args.Num() && other.args[0].key->GetPool() != &globalKeys) {
+		return *this = static_cast<const idDict &>(other);
+	}
+
+	TransferKeyValues(other);
+
+	return *this;
+}
+#endif
+
 /*
 ================
 idDict::Copy
@@ -113,8 +157,6 @@ idDict::TransferKeyValues
 */
 void idDict::TransferKeyValues(idDict &other)
 {
-	int i, n;
-
 	if (this == &other) {
 		return;
 	}
@@ -126,18 +168,8 @@ void idDict::TransferKeyValues(idDict &other)
 
 	Clear();
 
-	n = other.args.Num();
-	args.SetNum(n);
-
-	for (i = 0; i < n; i++) {
-		args[i].key = other.args[i].key;
-		args[i].value = other.args[i].value;
-	}
-
-	argHash = other.argHash;
-
-	other.args.Clear();
-	other.argHash.Free();
+	args.Swap(other.args);
+	argHash.Swap(other.argHash);
 }
 
 /*
@@ -316,6 +348,30 @@ void idDict::Set(const char *key, const char *value)
 	}
 }
 
+/*
+================
+idDict::Set
+================
+*/
+void idDict::Set(const idDictKey &key, const char *value)
+{
+	int i;
+	idKeyValue kv;
+
+	i = FindKeyIndex(key);
+
+	if (i != -1) {
+		// first set the new value and then free the old value to allow proper self copying
+		const idPoolStr *oldValue = args[i].value;
+		args[i].value = globalValues.AllocString(value);
+		globalValues.FreeString(oldValue);
+	} else {
+		kv.key = globalKeys.CopyString(key.GetPoolStr());
+		kv.value = globalValues.AllocString(value);
+		argHash.Add(argHash.GenerateKey(key.hash, 0), args.Append(kv));
+	}
+}
+
 /*
 ================
 idDict::GetFloat
@@ -461,6 +517,46 @@ bool idDict::GetMatrix(const char *key, const char *defaultString, idMat3 &out)
 	return found;
 }
 
+/*
+================
+idDict::GetVector
+================
+*/
+bool idDict::GetVector(const idDictKey &key, const char *defaultString, idVec3 &out) const
+{
+	bool		found;
+	const char	*s;
+
+	if (!defaultString) {
+		defaultString = "0 0 0";
+	}
+
+	found = GetString(key, defaultString, &s);
+	out.Zero();
+	sscanf(s, "%f %f %f", &out.x, &out.y, &out.z);
+	return found;
+}
+
+/*
+================
+idDict::GetMatrix
+================
+*/
+bool idDict::GetMatrix(const idDictKey &key, const char *defaultString, idMat3 &out) const
+{
+	const char	*s;
+	bool		found;
+
+	if (!defaultString) {
+		defaultString = "1 0 0 0 1 0 0 0 1";
+	}
+
+	found = GetString(key, defaultString, &s);
+	out.Identity();
+	sscanf(s, "%f %f %f %f %f %f %f %f %f", &out[0].x, &out[0].y, &out[0].z, &out[1].x, &out[1].y, &out[1].z, &out[2].x, &out[2].y, &out[2].z);
+	return found;
+}
+
 /*
 ================
 WriteString
@@ -526,6 +622,39 @@ int idDict::FindKeyIndex(const char *key) const
 	return -1;
 }
 
+/*
+================
+idDict::FindKeyIndex
+
+  compares interned pool strings instead of the key text,
+  only keys added by another module with its own pool are compared by text
+================
+*/
+int idDict::FindKeyIndex(const idDictKey &key) const
+{
+	const idPoolStr *poolStr, *keyStr;
+
+	if (args.Num() == 0) {
+		return -1;
+	}
+
+	poolStr = key.GetPoolStr();
+
+	for (int i = argHash.First(argHash.GenerateKey(key.hash, 0)); i != -1; i = argHash.Next(i)) {
+		keyStr = args[i].key;
+
+		if (keyStr == poolStr) {
+			return i;
+		}
+
+		if (keyStr->GetPool() != &globalKeys && keyStr->Icmp(key.name) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 /*
 ================
 idDict::Delete
@@ -693,6 +822,17 @@ idDict::Shutdown
 */
 void idDict::Shutdown(void)
 {
+	const idDictKey *key, *next;
+
+	// the interned keys are freed with the pool
+	for (key = idDictKey::interned; key; key = next) {
+		next = key->next;
+		key->poolStr = NULL;
+		key->next = NULL;
+	}
+
+	idDictKey::interned = NULL;
+
 	globalKeys.Clear();
 	globalValues.Clear();
 }
@@ -706,6 +846,22 @@ void idDict::ShowMemoryUsage_f(const idCmdArgs &args)
 {
 	idLib::common->Printf("%5zd KB in %d keys\n", globalKeys.Size() >> 10, globalKeys.Num());
 	idLib::common->Printf("%5zd KB in %d values\n", globalValues.Size() >> 10, globalValues.Num());
+
+	int i, numRefs = 0, numInterned = 0;
+	size_t shared = 0;
+	const idDictKey *key;
+
+	for (i = 0; i < globalKeys.Num(); i++) {
+		numRefs += globalKeys[i]->GetNumUsers();
+		shared += (globalKeys[i]->GetNumUsers() - 1) * globalKeys[i]->Size();
+	}
+
+	for (key = idDictKey::interned; key; key = key->next) {
+		numInterned++;
+	}
+
+	idLib::common->Printf("%5d key references to %d keys, %zd KB saved by sharing\n", numRefs, globalKeys.Num(), shared >> 10);
+	idLib::common->Printf("%5d interned keys\n", numInterned);
 }
 
 /*
@@ -765,3 +921,57 @@ void idDict::ListValues_f(const idCmdArgs &args)
 
 	idLib::common->Printf("%5d values\n", valueStrings.Num());
 }
+
+/*
+================
+idDict::TestKeys_f
+
+  compares key lookups by text with lookups by interned key on a dictionary like the spawn args of an entity
+================
+*/
+void idDict::TestKeys_f(const idCmdArgs &args)
+{
+	static const idDictKey classnameKey("classname"), nameKey("name"), modelKey("model"), originKey("origin");
+	static const idDictKey rotationKey("rotation"), angleKey("angle"), spawnclassKey("spawnclass"), healthKey("health");
+	static const idDictKey *keys[] = {
+		&classnameKey, &nameKey, &modelKey, &originKey, &rotationKey, &angleKey, &spawnclassKey, &healthKey
+	};
+	const int numKeys = sizeof(keys) / sizeof(keys[0]);
+	const int numLoops = 100000;
+	idDict dict;
+	idTimer timer;
+	int i, j, found;
+
+	for (i = 0; i < 24; i++) {
+		dict.Set(va("editor_var%d", i), "1");
+	}
+
+	for (i = 0; i < numKeys; i++) {
+		dict.Set(keys[i]->GetName(), va("%d", i));
+	}
+
+	found = 0;
+	timer.Start();
+
+	for (i = 0; i < numLoops; i++) {
+		for (j = 0; j < numKeys; j++) {
+			found += (dict.FindKey(keys[j]->GetName()) != NULL);
+		}
+	}
+
+	timer.Stop();
+	idLib::common->Printf("%7.2f msec for %d lookups by text (%d found)\n", timer.Milliseconds(), numLoops * numKeys, found);
+
+	found = 0;
+	timer.Clear();
+	timer.Start();
+
+	for (i = 0; i < numLoops; i++) {
+		for (j = 0; j < numKeys; j++) {
+			found += (dict.FindKey(*keys[j]) != NULL);
+		}
+	}
+
+	timer.Stop();
+	idLib::common->Printf("%7.2f msec for %d lookups by interned key (%d found)\n", timer.Milliseconds(), numLoops * numKeys, found);
+}
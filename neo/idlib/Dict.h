@@ -73,11 +73,62 @@ class idKeyValue
 		const idPoolStr 	*value;
 };
 
+/*
+===============================================================================
+
+Interned dictionary key
+
+A handle to a key string in the key pool of the dictionaries. The key is
+interned on first use and looked up by comparing pool string pointers and
+a precomputed hash instead of hashing and comparing the full string.
+Handles are meant to be declared once as globals for frequently used keys.
+
+===============================================================================
+*/
+
+class idDictKey
+{
+		friend class idDict;
+
+	public:
+		explicit			idDictKey(const char *name);
+
+		const char 		*GetName(void) const {
+			return name;
+		}
+		// returns the interned pool string, interning the key if necessary
+		const idPoolStr 	*GetPoolStr(void) const;
+
+	private:
+		const char 		*name;
+		mutable int			hash;
+		mutable const idPoolStr *poolStr;
+		mutable const idDictKey *next;
+
+		static const idDictKey *interned;
+
+		idDictKey(const idDictKey &);			// not copyable, the handle is linked into the interned list
+		void				operator=(const idDictKey &);
+};
+
+ID_INLINE idDictKey::idDictKey(const char *name)
+{
+	this->name = name;
+	hash = 0;
+	poolStr = NULL;
+	next = NULL;
+}
+
 class idDict
 {
+		friend class idDictKey;
+
 	public:
 		idDict(void);
 		idDict(const idDict &other);	// allow declaration with assignment
+#if __cplusplus >= 201103L
+		idDict(idDict &&other);
+#endif
 		~idDict(void);
 
 		// set the granularity for the index
@@ -86,6 +137,10 @@ class idDict
 		void				SetHashSize(int hashSize);
 		// clear existing key/value pairs and copy all key/value pairs from other
 		idDict 			&operator=(const idDict &other);
+#if __cplusplus >= 201103L
+		// clear existing key/value pairs and take over the key/value pairs of other
+		idDict 			&operator=(idDict &&other);
+#endif
 		// copy from other while leaving existing key/value pairs in place
 		void				Copy(const idDict &other);
 		// clear existing key/value pairs and transfer key/value pairs from other
@@ -113,6 +168,7 @@ class idDict
 		void				SetVec4(const char *key, const idVec4 &val);
 		void				SetAngles(const char *key, const idAngles &val);
 		void				SetMatrix(const char *key, const idMat3 &val);
+		void				Set(const idDictKey &key, const char *value);
 
 		// these return default values of 0.0, 0 and false
 		const char 		*GetString(const char *key, const char *defaultString = "") const;
@@ -136,6 +192,18 @@ class idDict
 		bool				GetAngles(const char *key, const char *defaultString, idAngles &out) const;
 		bool				GetMatrix(const char *key, const char *defaultString, idMat3 &out) const;
 
+		// lookups with an interned key
+		const char 		*GetString(const idDictKey &key, const char *defaultString = "") const;
+		float				GetFloat(const idDictKey &key, const char *defaultString = "0") const;
+		int					GetInt(const idDictKey &key, const char *defaultString = "0") const;
+		bool				GetBool(const idDictKey &key, const char *defaultString = "0") const;
+		idVec3				GetVector(const idDictKey &key, const char *defaultString = NULL) const;
+		idMat3				GetMatrix(const idDictKey &key, const char *defaultString = NULL) const;
+		bool				GetString(const idDictKey &key, const char *defaultString, const char **out) const;
+		bool				GetString(const idDictKey &key, const char *defaultString, idStr &out) const;
+		bool				GetVector(const idDictKey &key, const char *defaultString, idVec3 &out) const;
+		bool				GetMatrix(const idDictKey &key, const char *defaultString, idMat3 &out) const;
+
 		int					GetNumKeyVals(void) const;
 		const idKeyValue 	*GetKeyVal(int index) const;
 		// returns the key/value pair with the given key
@@ -144,6 +212,8 @@ class idDict
 		// returns the index to the key/value pair with the given key
 		// returns -1 if the key/value pair does not exist
 		int					FindKeyIndex(const char *key) const;
+		const idKeyValue 	*FindKey(const idDictKey &key) const;
+		int					FindKeyIndex(const idDictKey &key) const;
 		// delete the key/value pair with the given key
 		void				Delete(const char *key);
 		// finds the next key/value pair with the given key prefix.
@@ -164,6 +234,7 @@ class idDict
 		static void			ShowMemoryUsage_f(const idCmdArgs &args);
 		static void			ListKeys_f(const idCmdArgs &args);
 		static void			ListValues_f(const idCmdArgs &args);
+		static void			TestKeys_f(const idCmdArgs &args);
 
 	private:
 		idList<idKeyValue>	args;
@@ -186,6 +257,13 @@ ID_INLINE idDict::idDict(const idDict &other)
 	*this = other;
 }
 
+#if __cplusplus >= 201103L
+ID_INLINE idDict::idDict(idDict &&other)
+{
+	*this = idMove(other);
+}
+#endif
+
 ID_INLINE idDict::~idDict(void)
 {
 	Clear();
@@ -331,6 +409,83 @@ ID_INLINE idMat3 idDict::GetMatrix(const char *key, const char *defaultString) c
 	return out;
 }
 
+ID_INLINE const char *idDict::GetString(const idDictKey &key, const char *defaultString) const
+{
+	const idKeyValue *kv = FindKey(key);
+
+	if (kv) {
+		return kv->GetValue();
+	}
+
+	return defaultString;
+}
+
+ID_INLINE bool idDict::GetString(const idDictKey &key, const char *defaultString, const char **out) const
+{
+	const idKeyValue *kv = FindKey(key);
+
+	if (kv) {
+		*out = kv->GetValue();
+		return true;
+	}
+
+	*out = defaultString;
+	return false;
+}
+
+ID_INLINE bool idDict::GetString(const idDictKey &key, const char *defaultString, idStr &out) const
+{
+	const idKeyValue *kv = FindKey(key);
+
+	if (kv) {
+		out = kv->GetValue();
+		return true;
+	}
+
+	out = defaultString;
+	return false;
+}
+
+ID_INLINE float idDict::GetFloat(const idDictKey &key, const char *defaultString) const
+{
+	return atof(GetString(key, defaultString));
+}
+
+ID_INLINE int idDict::GetInt(const idDictKey &key, const char *defaultString) const
+{
+	return atoi(GetString(key, defaultString));
+}
+
+ID_INLINE bool idDict::GetBool(const idDictKey &key, const char *defaultString) const
+{
+	return (atoi(GetString(key, defaultString)) != 0);
+}
+
+ID_INLINE idVec3 idDict::GetVector(const idDictKey &key, const char *defaultString) const
+{
+	idVec3 out;
+	GetVector(key, defaultString, out);
+	return out;
+}
+
+ID_INLINE idMat3 idDict::GetMatrix(const idDictKey &key, const char *defaultString) const
+{
+	idMat3 out;
+	GetMatrix(key, defaultString, out);
+	return out;
+}
+
+ID_INLINE const idKeyValue *idDict::FindKey(const idDictKey &key) const
+{
+	int i = FindKeyIndex(key);
+
+	if (i != -1) {
+		return &args[i];
+	}
+
+	return NULL;
+}
+
 ID_INLINE int idDict::GetNumKeyVals(void) const
 {
 	return args.Num();
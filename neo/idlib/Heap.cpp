@@ -33,6 +33,20 @@ If you have questions concerning this license or the applicable additional terms
 #define USE_LIBC_MALLOC		0
 #endif
 
+#ifndef USE_THREAD_HEAP
+#if USE_LIBC_MALLOC || defined( _WIN32 )
+#define USE_THREAD_HEAP		0
+#else
+#define USE_THREAD_HEAP		1
+#endif
+#endif
+
+#if USE_THREAD_HEAP
+#include <sys/mman.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #ifndef CRASH_ON_STATIC_ALLOCATION
 //	#define CRASH_ON_STATIC_ALLOCATION
 #endif
@@ -1043,213 +1057,1473 @@ void idHeap::LargeFree(void *ptr)
 	FreePage(pg);
 }
 
+typedef struct {
+	memoryStats_t	total;
+	memoryStats_t	frameAllocs;
+	memoryStats_t	frameFrees;
+} memThreadStats_t;
+
 //===============================================================
 //
-//	memory allocation all in one place
+//	idThreadHeap
+//
+//	Every thread hands out small blocks from spans of its own, one
+//	list of spans per allocation tag and size class, so allocating and
+//	freeing on the owning thread never locks. A block freed by another thread is
+//	pushed onto its span with a compare and swap and collected by the
+//	owner the next time it runs out of free blocks of some size. Spans
+//	are runs of 64kB pages found through a page map, empty ones go
+//	back to a central pool and past a few megabytes back to the OS.
+//	Blocks larger than THREADHEAP_MAX_SMALL get a span of their own.
 //
 //===============================================================
 
-#undef new
+#if USE_THREAD_HEAP
 
-static idHeap 			*mem_heap = NULL;
-static memoryStats_t	mem_total_allocs = { 0, 0x0fffffff, -1, 0 };
-static memoryStats_t	mem_frame_allocs;
-static memoryStats_t	mem_frame_frees;
+#define THREADHEAP_PAGE_SHIFT		16
+#define THREADHEAP_PAGE_SIZE		( 1 << THREADHEAP_PAGE_SHIFT )
+#define THREADHEAP_MAP_SHIFT		16								// page map entries per leaf
+#define THREADHEAP_ALIGN			16								// every block is 16 byte aligned
+#define THREADHEAP_MAX_SMALL		32768							// largest block handed out from a size class
+#define THREADHEAP_MAX_CLASSES		48
+#define THREADHEAP_SPAN_BLOCKS		8								// minimum number of blocks for multi page spans
+#define THREADHEAP_CACHED_PAGES		8								// largest span kept in the central pool
+#define THREADHEAP_RETAIN_PAGES		64								// empty pages kept before they go back to the OS
+
+#define THREADHEAP_ALIGN_SIZE( bytes )	( ( (bytes) + THREADHEAP_ALIGN - 1 ) & ~( THREADHEAP_ALIGN - 1 ) )
 
 /*
-==================
-Mem_ClearFrameStats
-==================
+================
+Heap_CompareAndSwap
+================
 */
-void Mem_ClearFrameStats(void)
+static ID_INLINE bool Heap_CompareAndSwap(void *volatile *ptr, void *oldValue, void *newValue)
 {
-	mem_frame_allocs.num = mem_frame_frees.num = 0;
-	mem_frame_allocs.minSize = mem_frame_frees.minSize = 0x0fffffff;
-	mem_frame_allocs.maxSize = mem_frame_frees.maxSize = -1;
-	mem_frame_allocs.totalSize = mem_frame_frees.totalSize = 0;
+	return __sync_bool_compare_and_swap(ptr, oldValue, newValue);
 }
 
 /*
-==================
-Mem_GetFrameStats
-==================
+================
+Heap_Exchange
+================
 */
-void Mem_GetFrameStats(memoryStats_t &allocs, memoryStats_t &frees)
+static ID_INLINE void *Heap_Exchange(void *volatile *ptr, void *newValue)
 {
-	allocs = mem_frame_allocs;
-	frees = mem_frame_frees;
+	void *oldValue;
+
+	do {
+		oldValue = *ptr;
+	} while (!Heap_CompareAndSwap(ptr, oldValue, newValue));
+
+	return oldValue;
 }
 
 /*
-==================
-Mem_GetStats
-==================
+================
+Heap_Lock
+================
 */
-void Mem_GetStats(memoryStats_t &stats)
+static void Heap_Lock(volatile int *lock)
 {
-	stats = mem_total_allocs;
+	for (int spin = 0; !__sync_bool_compare_and_swap(lock, 0, 1); spin++) {
+		if (spin > 64) {
+			sched_yield();
+		}
+	}
 }
 
 /*
-==================
-Mem_UpdateStats
-==================
+================
+Heap_Unlock
+================
 */
-void Mem_UpdateStats(memoryStats_t &stats, int size)
+static ID_INLINE void Heap_Unlock(volatile int *lock)
 {
-	stats.num++;
+	__sync_lock_release(lock);
+}
 
-	if (size < stats.minSize) {
-		stats.minSize = size;
-	}
+class idThreadHeap
+{
 
-	if (size > stats.maxSize) {
-		stats.maxSize = size;
-	}
+	public:
+		idThreadHeap(void);
+		~idThreadHeap(void);				// returns all pages to the OS
 
-	stats.totalSize += size;
-}
+		void 			*Allocate(const dword bytes);	// allocate memory
+		void			Free(void *p);				// free memory, from any thread
+		void 			*Allocate16(const dword bytes) { return Allocate(bytes); }
+		void			Free16(void *p) { Free(p); }
+		dword			Msize(void *p);				// return size of data block
+		void			Dump(void);
+
+		void 			AllocDefragBlock(void);		// hack for huge renderbumps
+
+		memThreadStats_t *ThreadStats(void);		// statistics of the calling thread
+		void			SumStats(memoryStats_t memThreadStats_t::*which, memoryStats_t &sum);
+		void			ClearFrameStats(void);
+		void			GetTagStats(memTagStats_t stats[MEMTAG_NUM]);
+
+		static memTag_t	SetTag(memTag_t tag) {
+			memTag_t previous = currentTag;
+			currentTag = tag;
+			return previous;
+		}
+
+	private:
+
+		struct threadCache_s;
+
+		struct span_s {
+			threadCache_s 		*owner;					// thread handing out the blocks, NULL for large blocks
+			span_s 				*prev;					// spans with free blocks of the same size class
+			span_s 				*next;
+			span_s 				*allPrev;				// all spans taken from the OS
+			span_s 				*allNext;
+			void 				*freeList;				// blocks freed by the owner
+			byte 				*bump;					// blocks never handed out start here
+			byte 				*end;
+			void 				*volatile remoteFree;	// blocks freed by other threads
+			span_s 				*remoteNext;			// next span in the owner's remoteSpans
+			int					tag;
+			int					sizeClass;				// -1 for large blocks
+			int					blockSize;
+			int					numPages;
+			int					used;					// blocks handed out and not collected back
+			bool				listed;					// in the owner's list for the size class
+		};
+
+		struct threadCache_s {
+			span_s 				*spans[MEMTAG_NUM][THREADHEAP_MAX_CLASSES];	// spans with free blocks
+			void 				*volatile remoteSpans;	// spans other threads freed blocks into
+			threadCache_s 		*next;					// all thread caches
+			threadCache_s 		*nextAbandoned;			// caches left behind by threads that exited
+			memThreadStats_t	stats;
+			memTagStats_t		tagStats[MEMTAG_NUM];	// frees count against the freeing thread
+		};
+
+		enum {
+			SPAN_HEADER_SIZE = THREADHEAP_ALIGN_SIZE(sizeof(span_s))
+		};
+
+		// variables
+		int				numClasses;
+		int				classSize[THREADHEAP_MAX_CLASSES];	// block size of each size class
+		int				classPages[THREADHEAP_MAX_CLASSES];	// pages per span of each size class
+		byte			classIndex[THREADHEAP_MAX_SMALL / THREADHEAP_ALIGN + 1];	// size / 16 to size class
+
+		volatile int	lock;							// guards everything below
+		span_s 		*freeSpans[THREADHEAP_CACHED_PAGES+1];	// empty spans by number of pages
+		int				cachedPages;					// pages held in freeSpans
+		span_s 		*allSpans;
+		int				mappedPages;					// pages currently taken from the OS
+		int				OSAllocs;						// number of allocs made to the OS
+		threadCache_s 	*caches;
+		threadCache_s 	*abandonedCaches;
+		pthread_key_t	cacheKey;
+
+		void			*defragBlock;					// a single huge block that can be allocated
+		// at startup, then freed when needed
+
+		// methods
+		threadCache_s 	*GetThreadCache(void);
+		static void		AbandonThreadCache(void *cache);
+
+		void 			*OSAllocate(dword bytes, dword alignment);
+		void			OSFree(void *p, dword bytes);
+		void			SetPageMap(span_s *span, span_s *value);
+
+		span_s 		*AllocateSpan(int numPages);
+		void			FreeSpan(span_s *span);
+
+		span_s 		*Refill(threadCache_s *cache, int tag, int sizeClass);
+		void			CollectRemoteFrees(threadCache_s *cache);
+		void			BlocksReturned(threadCache_s *cache, span_s *span);
+		void			LinkSpan(threadCache_s *cache, span_s *span);
+		void			UnlinkSpan(threadCache_s *cache, span_s *span);
+
+		void 			*LargeAllocate(dword bytes);
+		void			LargeFree(span_s *span);
+
+		static span_s 	*LookupSpan(const void *p);
+
+		static span_s 	**pageMap[1 << THREADHEAP_MAP_SHIFT];	// page number to span, two levels
+		static __thread threadCache_s *threadCache;
+		static __thread memTag_t currentTag;
+		static idThreadHeap *instance;
+};
+
+idThreadHeap::span_s				**idThreadHeap::pageMap[1 << THREADHEAP_MAP_SHIFT];
+__thread idThreadHeap::threadCache_s	*idThreadHeap::threadCache;
+__thread memTag_t					idThreadHeap::currentTag;
+idThreadHeap						*idThreadHeap::instance;
 
 /*
-==================
-Mem_UpdateAllocStats
-==================
+================
+idThreadHeap::idThreadHeap
+================
 */
-void Mem_UpdateAllocStats(int size)
+idThreadHeap::idThreadHeap(void)
 {
-	Mem_UpdateStats(mem_frame_allocs, size);
-	Mem_UpdateStats(mem_total_allocs, size);
+	int size, step, i;
+
+	assert(!instance);
+	instance = this;
+
+	// 16 byte steps up to 256 bytes, four steps for every power of two after that
+	numClasses = 0;
+
+	for (size = THREADHEAP_ALIGN; size <= THREADHEAP_MAX_SMALL; size += step) {
+		assert(numClasses < THREADHEAP_MAX_CLASSES);
+		classSize[numClasses] = size;
+		classPages[numClasses] = (size * THREADHEAP_SPAN_BLOCKS + THREADHEAP_PAGE_SIZE - 1) >> THREADHEAP_PAGE_SHIFT;
+		numClasses++;
+
+		for (step = 1; step * 2 <= size; step <<= 1) {
+		}
+
+		step = Max(step >> 2, THREADHEAP_ALIGN);
+	}
+
+	for (i = 0, size = 0; i <= THREADHEAP_MAX_SMALL / THREADHEAP_ALIGN; i++) {
+		while (classSize[size] < i * THREADHEAP_ALIGN) {
+			size++;
+		}
+
+		classIndex[i] = size;
+	}
+
+	lock			= 0;
+	memset(freeSpans, 0, sizeof(freeSpans));
+	cachedPages		= 0;
+	allSpans		= NULL;
+	mappedPages		= 0;
+	OSAllocs		= 0;
+	caches			= NULL;
+	abandonedCaches	= NULL;
+	defragBlock		= NULL;
+
+	pthread_key_create(&cacheKey, AbandonThreadCache);
 }
 
 /*
-==================
-Mem_UpdateFreeStats
-==================
+================
+idThreadHeap::~idThreadHeap
+
+  returns all allocated memory back to OS
+================
 */
-void Mem_UpdateFreeStats(int size)
+idThreadHeap::~idThreadHeap(void)
 {
-	Mem_UpdateStats(mem_frame_frees, size);
-	mem_total_allocs.num--;
-	mem_total_allocs.totalSize -= size;
-}
+	span_s *span;
+	threadCache_s *cache;
+	int i;
 
+	pthread_key_delete(cacheKey);
 
-#ifndef ID_DEBUG_MEMORY
+	while (allSpans) {
+		span = allSpans;
+		allSpans = span->allNext;
+		SetPageMap(span, NULL);
+		OSFree(span, span->numPages << THREADHEAP_PAGE_SHIFT);
+	}
 
-/*
-==================
-Mem_Alloc
-==================
-*/
-void *Mem_Alloc(const int size)
-{
-	if (!size) {
-		return NULL;
+	while (caches) {
+		cache = caches;
+		caches = cache->next;
+		OSFree(cache, sizeof(threadCache_s));
 	}
 
-	if (!mem_heap) {
-#ifdef CRASH_ON_STATIC_ALLOCATION
-		*((intptr_t *)0x0) = 1;
-#endif
-		return malloc(size);
+	for (i = 0; i < (1 << THREADHEAP_MAP_SHIFT); i++) {
+		if (pageMap[i]) {
+			OSFree(pageMap[i], sizeof(span_s *) << THREADHEAP_MAP_SHIFT);
+			pageMap[i] = NULL;
+		}
 	}
 
-	void *mem = mem_heap->Allocate(size);
-	Mem_UpdateAllocStats(mem_heap->Msize(mem));
-	return mem;
+	if (defragBlock) {
+		free(defragBlock);
+	}
+
+	threadCache = NULL;
+	instance = NULL;
 }
 
 /*
-==================
-Mem_Free
-==================
+================
+idThreadHeap::AllocDefragBlock
+================
 */
-void Mem_Free(void *ptr)
+void idThreadHeap::AllocDefragBlock(void)
 {
-	if (!ptr) {
+	int		size = 0x40000000;
+
+	if (defragBlock) {
 		return;
 	}
 
-	if (!mem_heap) {
-#ifdef CRASH_ON_STATIC_ALLOCATION
-		*((intptr_t *)0x0) = 1;
-#endif
-		free(ptr);
-		return;
+	while (1) {
+		defragBlock = malloc(size);
+
+		if (defragBlock) {
+			break;
+		}
+
+		size >>= 1;
 	}
 
-	Mem_UpdateFreeStats(mem_heap->Msize(ptr));
-	mem_heap->Free(ptr);
+	idLib::common->Printf("Allocated a %i mb defrag block\n", size / (1024*1024));
 }
 
 /*
-==================
-Mem_Alloc16
-==================
+================
+idThreadHeap::GetThreadCache
+
+  returns the cache of the calling thread, taking one over from a thread
+  that exited or creating a new one the first time a thread allocates
+================
 */
-void *Mem_Alloc16(const int size)
+idThreadHeap::threadCache_s *idThreadHeap::GetThreadCache(void)
 {
-	if (!size) {
-		return NULL;
+	threadCache_s *cache = threadCache;
+
+	if (cache) {
+		return cache;
 	}
 
-	if (!mem_heap) {
-#ifdef CRASH_ON_STATIC_ALLOCATION
-		*((intptr_t *)0x0) = 1;
-#endif
-		return malloc(size);
+	Heap_Lock(&lock);
+
+	if (abandonedCaches) {
+		cache = abandonedCaches;
+		abandonedCaches = cache->nextAbandoned;
+	} else {
+		cache = (threadCache_s *)OSAllocate(sizeof(threadCache_s), 0);
+		cache->stats.total.minSize = cache->stats.frameAllocs.minSize = cache->stats.frameFrees.minSize = 0x0fffffff;
+		cache->stats.total.maxSize = cache->stats.frameAllocs.maxSize = cache->stats.frameFrees.maxSize = -1;
+		cache->next = caches;
+		caches = cache;
 	}
 
-	void *mem = mem_heap->Allocate16(size);
-	// make sure the memory is 16 byte aligned
-	assert((((intptr_t)mem) & 15) == 0);
-	return mem;
+	Heap_Unlock(&lock);
+
+	threadCache = cache;
+	pthread_setspecific(cacheKey, cache);
+
+	return cache;
 }
 
 /*
-==================
-Mem_Free16
-==================
+================
+idThreadHeap::AbandonThreadCache
+
+  called when a thread exits, its spans stay with the cache until another thread takes it over
+================
 */
-void Mem_Free16(void *ptr)
+void idThreadHeap::AbandonThreadCache(void *p)
 {
-	if (!ptr) {
-		return;
-	}
+	idThreadHeap *heap = instance;
+	threadCache_s *cache = (threadCache_s *)p;
 
-	if (!mem_heap) {
-#ifdef CRASH_ON_STATIC_ALLOCATION
-		*((intptr_t *)0x0) = 1;
-#endif
-		free(ptr);
+	if (!heap) {
 		return;
 	}
 
-	// make sure the memory is 16 byte aligned
-	assert((((intptr_t)ptr) & 15) == 0);
-	mem_heap->Free16(ptr);
+	Heap_Lock(&heap->lock);
+	cache->nextAbandoned = heap->abandonedCaches;
+	heap->abandonedCaches = cache;
+	Heap_Unlock(&heap->lock);
+
+	threadCache = NULL;
 }
 
 /*
-==================
-Mem_ClearedAlloc
-==================
+================
+idThreadHeap::OSAllocate
+
+  maps pages from the OS, aligned to alignment if it isn't zero
+================
 */
-void *Mem_ClearedAlloc(const int size)
+void *idThreadHeap::OSAllocate(dword bytes, dword alignment)
 {
-	void *mem = Mem_Alloc(size);
-	SIMDProcessor->Memset(mem, 0, size);
-	return mem;
+	byte *p, *start;
+
+	p = (byte *)mmap(NULL, bytes + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (p == MAP_FAILED) {
+		if (defragBlock) {
+			idLib::common->Printf("Freeing defragBlock on alloc of %i.\n", bytes + alignment);
+			free(defragBlock);
+			defragBlock = NULL;
+			p = (byte *)mmap(NULL, bytes + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			AllocDefragBlock();
+		}
+
+		if (p == MAP_FAILED) {
+			idLib::common->FatalError("mmap failure for %i", bytes);
+		}
+	}
+
+	OSAllocs++;
+
+	if (alignment) {
+		start = (byte *)(((intptr_t)p + alignment - 1) & ~(intptr_t)(alignment - 1));
+
+		if (start != p) {
+			munmap(p, start - p);
+		}
+
+		if (start + bytes != p + bytes + alignment) {
+			munmap(start + bytes, p + alignment - start);
+		}
+
+		p = start;
+	}
+
+	return p;
 }
 
 /*
-==================
-Mem_ClearedAlloc
-==================
+================
+idThreadHeap::OSFree
+================
 */
-void Mem_AllocDefragBlock(void)
+void idThreadHeap::OSFree(void *p, dword bytes)
 {
-	mem_heap->AllocDefragBlock();
+	munmap(p, bytes);
+}
+
+/*
+================
+idThreadHeap::SetPageMap
+
+  points the page map entries of all pages of the span to value, called with the lock held
+================
+*/
+void idThreadHeap::SetPageMap(span_s *span, span_s *value)
+{
+	uintptr_t page = (uintptr_t)span >> THREADHEAP_PAGE_SHIFT;
+
+	for (int i = 0; i < span->numPages; i++, page++) {
+		uintptr_t top = page >> THREADHEAP_MAP_SHIFT;
+
+		if (top >= (1 << THREADHEAP_MAP_SHIFT)) {
+			idLib::common->FatalError("idThreadHeap: page %p out of range", span);
+		}
+
+		span_s **leaf = pageMap[top];
+
+		if (!leaf) {
+			if (!value) {
+				continue;
+			}
+
+			leaf = (span_s **)OSAllocate(sizeof(span_s *) << THREADHEAP_MAP_SHIFT, 0);
+			__sync_synchronize();
+			pageMap[top] = leaf;
+		}
+
+		leaf[page & ((1 << THREADHEAP_MAP_SHIFT) - 1)] = value;
+	}
+}
+
+/*
+================
+idThreadHeap::LookupSpan
+
+  returns NULL for memory that didn't come from the heap
+================
+*/
+ID_INLINE idThreadHeap::span_s *idThreadHeap::LookupSpan(const void *p)
+{
+	uintptr_t page = (uintptr_t)p >> THREADHEAP_PAGE_SHIFT;
+	uintptr_t top = page >> THREADHEAP_MAP_SHIFT;
+
+	if (top >= (1 << THREADHEAP_MAP_SHIFT) || !pageMap[top]) {
+		return NULL;
+	}
+
+	return pageMap[top][page & ((1 << THREADHEAP_MAP_SHIFT) - 1)];
+}
+
+/*
+================
+idThreadHeap::AllocateSpan
+================
+*/
+idThreadHeap::span_s *idThreadHeap::AllocateSpan(int numPages)
+{
+	span_s *span;
+
+	Heap_Lock(&lock);
+
+	if (numPages <= THREADHEAP_CACHED_PAGES && freeSpans[numPages]) {
+		span = freeSpans[numPages];
+		freeSpans[numPages] = span->next;
+		cachedPages -= numPages;
+		Heap_Unlock(&lock);
+		return span;
+	}
+
+	span = (span_s *)OSAllocate(numPages << THREADHEAP_PAGE_SHIFT, THREADHEAP_PAGE_SIZE);
+	span->numPages = numPages;
+	span->allPrev = NULL;
+	span->allNext = allSpans;
+
+	if (allSpans) {
+		allSpans->allPrev = span;
+	}
+
+	allSpans = span;
+	mappedPages += numPages;
+	SetPageMap(span, span);
+
+	Heap_Unlock(&lock);
+
+	return span;
+}
+
+/*
+================
+idThreadHeap::FreeSpan
+
+  keeps a few megabytes of empty spans around, the rest goes back to the OS
+================
+*/
+void idThreadHeap::FreeSpan(span_s *span)
+{
+	int numPages = span->numPages;
+
+	Heap_Lock(&lock);
+
+	if (numPages <= THREADHEAP_CACHED_PAGES && cachedPages + numPages <= THREADHEAP_RETAIN_PAGES) {
+		span->next = freeSpans[numPages];
+		freeSpans[numPages] = span;
+		cachedPages += numPages;
+		Heap_Unlock(&lock);
+		return;
+	}
+
+	SetPageMap(span, NULL);
+
+	if (span->allPrev) {
+		span->allPrev->allNext = span->allNext;
+	} else {
+		allSpans = span->allNext;
+	}
+
+	if (span->allNext) {
+		span->allNext->allPrev = span->allPrev;
+	}
+
+	mappedPages -= numPages;
+
+	Heap_Unlock(&lock);
+
+	OSFree(span, numPages << THREADHEAP_PAGE_SHIFT);
+}
+
+/*
+================
+idThreadHeap::LinkSpan
+================
+*/
+ID_INLINE void idThreadHeap::LinkSpan(threadCache_s *cache, span_s *span)
+{
+	span->prev = NULL;
+	span->next = cache->spans[span->tag][span->sizeClass];
+
+	if (span->next) {
+		span->next->prev = span;
+	}
+
+	cache->spans[span->tag][span->sizeClass] = span;
+	span->listed = true;
+}
+
+/*
+================
+idThreadHeap::UnlinkSpan
+================
+*/
+ID_INLINE void idThreadHeap::UnlinkSpan(threadCache_s *cache, span_s *span)
+{
+	if (span->prev) {
+		span->prev->next = span->next;
+	} else {
+		cache->spans[span->tag][span->sizeClass] = span->next;
+	}
+
+	if (span->next) {
+		span->next->prev = span->prev;
+	}
+
+	span->prev = span->next = NULL;
+	span->listed = false;
+}
+
+/*
+================
+idThreadHeap::BlocksReturned
+
+  puts a span that was full back in the list, or releases it when it is empty
+  and not the one blocks are currently handed out from
+================
+*/
+void idThreadHeap::BlocksReturned(threadCache_s *cache, span_s *span)
+{
+	if (span->used == 0 && cache->spans[span->tag][span->sizeClass] != span) {
+		if (span->listed) {
+			UnlinkSpan(cache, span);
+		}
+
+		FreeSpan(span);
+	} else if (!span->listed) {
+		LinkSpan(cache, span);
+	}
+}
+
+/*
+================
+idThreadHeap::CollectRemoteFrees
+
+  takes back the blocks other threads freed into the spans of the cache
+================
+*/
+void idThreadHeap::CollectRemoteFrees(threadCache_s *cache)
+{
+	span_s *span, *next;
+	void *blocks, *last;
+	int count;
+
+	for (span = (span_s *)Heap_Exchange(&cache->remoteSpans, NULL); span; span = next) {
+		// the span can be queued again as soon as its remote list is taken
+		next = span->remoteNext;
+		blocks = Heap_Exchange(&span->remoteFree, NULL);
+		assert(blocks);
+
+		for (count = 1, last = blocks; *(void **)last; last = *(void **)last) {
+			count++;
+		}
+
+		*(void **)last = span->freeList;
+		span->freeList = blocks;
+		span->used -= count;
+
+		BlocksReturned(cache, span);
+	}
+}
+
+/*
+================
+idThreadHeap::Refill
+
+  returns a span with free blocks of the tag and size class
+================
+*/
+idThreadHeap::span_s *idThreadHeap::Refill(threadCache_s *cache, int tag, int sizeClass)
+{
+	span_s *span;
+
+	CollectRemoteFrees(cache);
+
+	if (cache->spans[tag][sizeClass]) {
+		return cache->spans[tag][sizeClass];
+	}
+
+	span = AllocateSpan(classPages[sizeClass]);
+	span->owner = cache;
+	span->freeList = NULL;
+	span->bump = (byte *)span + SPAN_HEADER_SIZE;
+	span->end = (byte *)span + (span->numPages << THREADHEAP_PAGE_SHIFT);
+	span->remoteFree = NULL;
+	span->remoteNext = NULL;
+	span->tag = tag;
+	span->sizeClass = sizeClass;
+	span->blockSize = classSize[sizeClass];
+	span->used = 0;
+	LinkSpan(cache, span);
+
+	return span;
+}
+
+/*
+================
+idThreadHeap::Allocate
+================
+*/
+void *idThreadHeap::Allocate(const dword bytes)
+{
+	threadCache_s *cache;
+	memTagStats_t *stats;
+	span_s *span;
+	void *p;
+	int sizeClass, tag;
+
+	if (!bytes) {
+		return NULL;
+	}
+
+	if (bytes > THREADHEAP_MAX_SMALL) {
+		return LargeAllocate(bytes);
+	}
+
+	sizeClass = classIndex[(bytes + THREADHEAP_ALIGN - 1) / THREADHEAP_ALIGN];
+	tag = currentTag;
+	cache = GetThreadCache();
+	span = cache->spans[tag][sizeClass];
+
+	if (!span) {
+		span = Refill(cache, tag, sizeClass);
+	}
+
+	if (span->freeList) {
+		p = span->freeList;
+		span->freeList = *(void **)p;
+	} else {
+		p = span->bump;
+		span->bump += span->blockSize;
+	}
+
+	span->used++;
+
+	// full spans leave the list until a block comes back
+	if (!span->freeList && span->bump + span->blockSize > span->end) {
+		UnlinkSpan(cache, span);
+	}
+
+	stats = &cache->tagStats[tag];
+	stats->size += span->blockSize;
+	stats->num++;
+	stats->totalSize += span->blockSize;
+	stats->totalNum++;
+
+	return p;
+}
+
+/*
+================
+idThreadHeap::Free
+================
+*/
+void idThreadHeap::Free(void *p)
+{
+	span_s *span;
+	threadCache_s *cache, *owner;
+	memTagStats_t *stats;
+	void *head;
+
+	if (!p) {
+		return;
+	}
+
+	span = LookupSpan(p);
+
+	if (!span) {
+		// allocated before the heap was initialized
+		::free(p);
+		return;
+	}
+
+	if (span->sizeClass < 0) {
+		LargeFree(span);
+		return;
+	}
+
+	cache = GetThreadCache();
+	stats = &cache->tagStats[span->tag];
+	stats->size -= span->blockSize;
+	stats->num--;
+
+	if (span->owner == cache) {
+		*(void **)p = span->freeList;
+		span->freeList = p;
+		span->used--;
+		BlocksReturned(cache, span);
+		return;
+	}
+
+	// another thread owns the span, the block that makes its remote list non empty queues it with the owner
+	do {
+		head = span->remoteFree;
+		*(void **)p = head;
+	} while (!Heap_CompareAndSwap(&span->remoteFree, head, p));
+
+	if (!head) {
+		owner = span->owner;
+
+		do {
+			head = owner->remoteSpans;
+			span->remoteNext = (span_s *)head;
+		} while (!Heap_CompareAndSwap(&owner->remoteSpans, head, span));
+	}
+}
+
+/*
+================
+idThreadHeap::LargeAllocate
+
+  gives the block a span of its own
+================
+*/
+void *idThreadHeap::LargeAllocate(dword bytes)
+{
+	span_s *span = AllocateSpan((bytes + SPAN_HEADER_SIZE + THREADHEAP_PAGE_SIZE - 1) >> THREADHEAP_PAGE_SHIFT);
+	memTagStats_t *stats = &GetThreadCache()->tagStats[currentTag];
+
+	stats->size += (span->numPages << THREADHEAP_PAGE_SHIFT) - SPAN_HEADER_SIZE;
+	stats->num++;
+	stats->totalSize += (span->numPages << THREADHEAP_PAGE_SHIFT) - SPAN_HEADER_SIZE;
+	stats->totalNum++;
+
+	span->owner = NULL;
+	span->prev = span->next = NULL;
+	span->freeList = NULL;
+	span->remoteFree = NULL;
+	span->tag = currentTag;
+	span->sizeClass = -1;
+	span->blockSize = bytes;
+	span->used = 1;
+	span->listed = false;
+
+	return (byte *)span + SPAN_HEADER_SIZE;
+}
+
+/*
+================
+idThreadHeap::LargeFree
+================
+*/
+void idThreadHeap::LargeFree(span_s *span)
+{
+	memTagStats_t *stats = &GetThreadCache()->tagStats[span->tag];
+
+	stats->size -= (span->numPages << THREADHEAP_PAGE_SHIFT) - SPAN_HEADER_SIZE;
+	stats->num--;
+
+	FreeSpan(span);
+}
+
+/*
+================
+idThreadHeap::Msize
+================
+*/
+dword idThreadHeap::Msize(void *p)
+{
+	span_s *span;
+
+	if (!p) {
+		return 0;
+	}
+
+	span = LookupSpan(p);
+
+	if (!span) {
+		return 0;
+	}
+
+	if (span->sizeClass < 0) {
+		return (span->numPages << THREADHEAP_PAGE_SHIFT) - SPAN_HEADER_SIZE;
+	}
+
+	return span->blockSize;
+}
+
+/*
+================
+idThreadHeap::Dump
+================
+*/
+void idThreadHeap::Dump(void)
+{
+	threadCache_s *cache;
+	int numCaches, numAbandoned;
+
+	Heap_Lock(&lock);
+
+	for (numCaches = 0, cache = caches; cache; cache = cache->next) {
+		numCaches++;
+	}
+
+	for (numAbandoned = 0, cache = abandonedCaches; cache; cache = cache->nextAbandoned) {
+		numAbandoned++;
+	}
+
+	idLib::common->Printf("%d size classes, %d thread caches (%d abandoned)\n", numClasses, numCaches, numAbandoned);
+	idLib::common->Printf("%d kB mapped, %d kB of empty spans cached, %d OS allocs\n", mappedPages * (THREADHEAP_PAGE_SIZE >> 10), cachedPages * (THREADHEAP_PAGE_SIZE >> 10), OSAllocs);
+
+	Heap_Unlock(&lock);
+}
+
+/*
+================
+idThreadHeap::ThreadStats
+================
+*/
+memThreadStats_t *idThreadHeap::ThreadStats(void)
+{
+	return &GetThreadCache()->stats;
+}
+
+/*
+================
+idThreadHeap::SumStats
+
+  adds the statistics of all threads to sum
+================
+*/
+void idThreadHeap::SumStats(memoryStats_t memThreadStats_t::*which, memoryStats_t &sum)
+{
+	Heap_Lock(&lock);
+
+	for (threadCache_s *cache = caches; cache; cache = cache->next) {
+		const memoryStats_t &stats = cache->stats.*which;
+		sum.num += stats.num;
+		sum.minSize = Min(sum.minSize, stats.minSize);
+		sum.maxSize = Max(sum.maxSize, stats.maxSize);
+		sum.totalSize += stats.totalSize;
+	}
+
+	Heap_Unlock(&lock);
+}
+
+/*
+================
+idThreadHeap::ClearFrameStats
+================
+*/
+void idThreadHeap::ClearFrameStats(void)
+{
+	Heap_Lock(&lock);
+
+	for (threadCache_s *cache = caches; cache; cache = cache->next) {
+		cache->stats.frameAllocs.num = cache->stats.frameFrees.num = 0;
+		cache->stats.frameAllocs.minSize = cache->stats.frameFrees.minSize = 0x0fffffff;
+		cache->stats.frameAllocs.maxSize = cache->stats.frameFrees.maxSize = -1;
+		cache->stats.frameAllocs.totalSize = cache->stats.frameFrees.totalSize = 0;
+	}
+
+	Heap_Unlock(&lock);
+}
+
+/*
+================
+idThreadHeap::GetTagStats
+
+  adds the tag statistics of all threads to stats
+================
+*/
+void idThreadHeap::GetTagStats(memTagStats_t stats[MEMTAG_NUM])
+{
+	Heap_Lock(&lock);
+
+	for (threadCache_s *cache = caches; cache; cache = cache->next) {
+		for (int i = 0; i < MEMTAG_NUM; i++) {
+			stats[i].size += cache->tagStats[i].size;
+			stats[i].num += cache->tagStats[i].num;
+			stats[i].totalSize += cache->tagStats[i].totalSize;
+			stats[i].totalNum += cache->tagStats[i].totalNum;
+		}
+	}
+
+	Heap_Unlock(&lock);
+}
+
+#endif /* USE_THREAD_HEAP */
+
+//===============================================================
+//
+//	memory allocation all in one place
+//
+//===============================================================
+
+#undef new
+
+#if USE_THREAD_HEAP
+typedef idThreadHeap	idMemHeap;
+#else
+typedef idHeap			idMemHeap;
+#endif
+
+static idMemHeap 		*mem_heap = NULL;
+static memoryStats_t	mem_total_allocs = { 0, 0x0fffffff, -1, 0 };
+static memoryStats_t	mem_frame_allocs;
+static memoryStats_t	mem_frame_frees;
+
+/*
+==================
+Mem_ClearFrameStats
+==================
+*/
+void Mem_ClearFrameStats(void)
+{
+	mem_frame_allocs.num = mem_frame_frees.num = 0;
+	mem_frame_allocs.minSize = mem_frame_frees.minSize = 0x0fffffff;
+	mem_frame_allocs.maxSize = mem_frame_frees.maxSize = -1;
+	mem_frame_allocs.totalSize = mem_frame_frees.totalSize = 0;
+
+#if USE_THREAD_HEAP
+	if (mem_heap) {
+		mem_heap->ClearFrameStats();
+	}
+#endif
+}
+
+/*
+==================
+Mem_GetFrameStats
+==================
+*/
+void Mem_GetFrameStats(memoryStats_t &allocs, memoryStats_t &frees)
+{
+	allocs = mem_frame_allocs;
+	frees = mem_frame_frees;
+
+#if USE_THREAD_HEAP
+	if (mem_heap) {
+		mem_heap->SumStats(&memThreadStats_t::frameAllocs, allocs);
+		mem_heap->SumStats(&memThreadStats_t::frameFrees, frees);
+	}
+#endif
+}
+
+/*
+==================
+Mem_GetStats
+==================
+*/
+void Mem_GetStats(memoryStats_t &stats)
+{
+	stats = mem_total_allocs;
+
+#if USE_THREAD_HEAP
+	if (mem_heap) {
+		mem_heap->SumStats(&memThreadStats_t::total, stats);
+	}
+#endif
+}
+
+/*
+==================
+Mem_UpdateStats
+==================
+*/
+void Mem_UpdateStats(memoryStats_t &stats, int size)
+{
+	stats.num++;
+
+	if (size < stats.minSize) {
+		stats.minSize = size;
+	}
+
+	if (size > stats.maxSize) {
+		stats.maxSize = size;
+	}
+
+	stats.totalSize += size;
+}
+
+/*
+==================
+Mem_UpdateAllocStats
+==================
+*/
+void Mem_UpdateAllocStats(int size)
+{
+#if USE_THREAD_HEAP
+	// every thread counts its own
+	if (mem_heap) {
+		memThreadStats_t *stats = mem_heap->ThreadStats();
+		Mem_UpdateStats(stats->frameAllocs, size);
+		Mem_UpdateStats(stats->total, size);
+		return;
+	}
+#endif
+
+	Mem_UpdateStats(mem_frame_allocs, size);
+	Mem_UpdateStats(mem_total_allocs, size);
+}
+
+/*
+==================
+Mem_UpdateFreeStats
+==================
+*/
+void Mem_UpdateFreeStats(int size)
+{
+#if USE_THREAD_HEAP
+	if (mem_heap) {
+		memThreadStats_t *stats = mem_heap->ThreadStats();
+		Mem_UpdateStats(stats->frameFrees, size);
+		stats->total.num--;
+		stats->total.totalSize -= size;
+		return;
+	}
+#endif
+
+	Mem_UpdateStats(mem_frame_frees, size);
+	mem_total_allocs.num--;
+	mem_total_allocs.totalSize -= size;
+}
+
+/*
+==================
+Mem_SetTag
+==================
+*/
+memTag_t Mem_SetTag(memTag_t tag)
+{
+#if USE_THREAD_HEAP
+	return idThreadHeap::SetTag(tag);
+#else
+	return MEMTAG_GENERAL;
+#endif
+}
+
+/*
+==================
+Mem_GetTagStats
+==================
+*/
+void Mem_GetTagStats(memTagStats_t stats[MEMTAG_NUM])
+{
+	memset(stats, 0, MEMTAG_NUM * sizeof(stats[0]));
+
+#if USE_THREAD_HEAP
+	if (mem_heap) {
+		mem_heap->GetTagStats(stats);
+	}
+#endif
+}
+
+/*
+==================
+Mem_GetTagName
+==================
+*/
+const char *Mem_GetTagName(memTag_t tag)
+{
+	static const char *tagNames[MEMTAG_NUM] = {
+		"general",
+		"geometry",
+		"images",
+		"collision",
+		"aas",
+		"script",
+		"decls",
+		"sound",
+		"gui",
+		"entities"
+	};
+
+	return tagNames[tag];
+}
+
+
+/*
+===============================================================================
+
+	idLevelArena
+
+===============================================================================
+*/
+
+#define LEVELARENA_ALIGN			16
+#define LEVELARENA_MIN_CHUNK		(32 << 10)
+#define LEVELARENA_HEADER			((int)( ( sizeof( chunk_t ) + LEVELARENA_ALIGN - 1 ) & ~( LEVELARENA_ALIGN - 1 ) ))
+
+idLevelArena *idLevelArena::arenas = NULL;
+
+/*
+==================
+idLevelArena::idLevelArena
+==================
+*/
+idLevelArena::idLevelArena(const char *name, memTag_t tag, int maxChunkSize)
+{
+	this->name = name;
+	this->tag = tag;
+	this->maxChunkSize = Max(maxChunkSize, LEVELARENA_MIN_CHUNK);
+	nextChunkSize = LEVELARENA_MIN_CHUNK;
+	chunks = NULL;
+	numChunks = 0;
+	numAllocs = 0;
+	usedSize = 0;
+	chunkSize = 0;
+	peakChunkSize = 0;
+	lastFreeSize = 0;
+	lastFreeMsec = 0.0f;
+
+	next = arenas;
+	arenas = this;
+}
+
+/*
+==================
+idLevelArena::~idLevelArena
+==================
+*/
+idLevelArena::~idLevelArena(void)
+{
+	idLevelArena **link;
+
+	FreeAll();
+
+	for (link = &arenas; *link; link = &(*link)->next) {
+		if (*link == this) {
+			*link = next;
+			break;
+		}
+	}
+}
+
+/*
+==================
+idLevelArena::Alloc
+==================
+*/
+void *idLevelArena::Alloc(const int size)
+{
+	chunk_t *chunk;
+	void *ptr;
+	int bytes;
+
+	bytes = (Max(size, 1) + LEVELARENA_ALIGN - 1) & ~(LEVELARENA_ALIGN - 1);
+
+	if (!chunks || chunks->used + bytes > chunks->size) {
+		idScopedMemTag memTag(tag);
+
+		if (bytes > maxChunkSize / 4 && chunks) {
+			// large blocks get a chunk of their own behind the one being filled
+			// so the space left in the current chunk is not thrown away
+			chunk = (chunk_t *) Mem_Alloc16(LEVELARENA_HEADER + bytes);
+			chunk->size = LEVELARENA_HEADER + bytes;
+			chunk->next = chunks->next;
+			chunks->next = chunk;
+		} else {
+			chunk = (chunk_t *) Mem_Alloc16(Max(nextChunkSize, LEVELARENA_HEADER + bytes));
+			chunk->size = Max(nextChunkSize, LEVELARENA_HEADER + bytes);
+			chunk->next = chunks;
+			chunks = chunk;
+			nextChunkSize = Min(nextChunkSize * 2, maxChunkSize);
+		}
+
+		chunk->used = LEVELARENA_HEADER;
+		numChunks++;
+		chunkSize += chunk->size;
+
+		if (chunkSize > peakChunkSize) {
+			peakChunkSize = chunkSize;
+		}
+	} else {
+		chunk = chunks;
+	}
+
+	ptr = (byte *) chunk + chunk->used;
+	chunk->used += bytes;
+	usedSize += bytes;
+	numAllocs++;
+
+	return ptr;
+}
+
+/*
+==================
+idLevelArena::ClearedAlloc
+==================
+*/
+void *idLevelArena::ClearedAlloc(const int size)
+{
+	void *ptr = Alloc(size);
+	memset(ptr, 0, size);
+	return ptr;
+}
+
+/*
+==================
+idLevelArena::FreeAll
+
+  one free per chunk no matter how many blocks were handed out
+==================
+*/
+void idLevelArena::FreeAll(void)
+{
+	chunk_t *chunk, *nextChunk;
+	idTimer timer;
+
+	if (!chunks) {
+		return;
+	}
+
+	timer.Start();
+
+	for (chunk = chunks; chunk; chunk = nextChunk) {
+		nextChunk = chunk->next;
+		Mem_Free16(chunk);
+	}
+
+	timer.Stop();
+
+	lastFreeSize = chunkSize;
+	lastFreeMsec = timer.Milliseconds();
+
+	chunks = NULL;
+	nextChunkSize = LEVELARENA_MIN_CHUNK;
+	numChunks = 0;
+	numAllocs = 0;
+	usedSize = 0;
+	chunkSize = 0;
+}
+
+/*
+==================
+idLevelArena::Print
+==================
+*/
+void idLevelArena::Print(void) const
+{
+	int waste = chunkSize - usedSize - numChunks * LEVELARENA_HEADER;
+
+	idLib::common->Printf("%-16s %3d chunks %7d blocks %6d kB used %6d kB chunks %5.1f%% waste %6d kB peak, freed %d kB in %.3f msec\n",
+	                      name, numChunks, numAllocs, usedSize >> 10, chunkSize >> 10,
+	                      chunkSize ? 100.0f * waste / chunkSize : 0.0f, peakChunkSize >> 10, lastFreeSize >> 10, lastFreeMsec);
+}
+
+/*
+==================
+idLevelArena::List_f
+==================
+*/
+void idLevelArena::List_f(const idCmdArgs &args)
+{
+	idLevelArena *arena;
+	int used = 0, total = 0;
+
+	for (arena = arenas; arena; arena = arena->next) {
+		arena->Print();
+		used += arena->usedSize;
+		total += arena->chunkSize;
+	}
+
+	idLib::common->Printf("%d kB used in %d kB of level arena chunks\n", used >> 10, total >> 10);
+}
+
+
+#ifndef ID_DEBUG_MEMORY
+
+/*
+==================
+Mem_Alloc
+==================
+*/
+void *Mem_Alloc(const int size)
+{
+	if (!size) {
+		return NULL;
+	}
+
+	if (!mem_heap) {
+#ifdef CRASH_ON_STATIC_ALLOCATION
+		*((intptr_t *)0x0) = 1;
+#endif
+		return malloc(size);
+	}
+
+	void *mem = mem_heap->Allocate(size);
+	Mem_UpdateAllocStats(mem_heap->Msize(mem));
+	return mem;
+}
+
+/*
+==================
+Mem_Free
+==================
+*/
+void Mem_Free(void *ptr)
+{
+	if (!ptr) {
+		return;
+	}
+
+	if (!mem_heap) {
+#ifdef CRASH_ON_STATIC_ALLOCATION
+		*((intptr_t *)0x0) = 1;
+#endif
+		free(ptr);
+		return;
+	}
+
+	Mem_UpdateFreeStats(mem_heap->Msize(ptr));
+	mem_heap->Free(ptr);
+}
+
+/*
+==================
+Mem_Alloc16
+==================
+*/
+void *Mem_Alloc16(const int size)
+{
+	if (!size) {
+		return NULL;
+	}
+
+	if (!mem_heap) {
+#ifdef CRASH_ON_STATIC_ALLOCATION
+		*((intptr_t *)0x0) = 1;
+#endif
+		return malloc(size);
+	}
+
+	void *mem = mem_heap->Allocate16(size);
+	// make sure the memory is 16 byte aligned
+	assert((((intptr_t)mem) & 15) == 0);
+	return mem;
+}
+
+/*
+==================
+Mem_Free16
+==================
+*/
+void Mem_Free16(void *ptr)
+{
+	if (!ptr) {
+		return;
+	}
+
+	if (!mem_heap) {
+#ifdef CRASH_ON_STATIC_ALLOCATION
+		*((intptr_t *)0x0) = 1;
+#endif
+		free(ptr);
+		return;
+	}
+
+	// make sure the memory is 16 byte aligned
+	assert((((intptr_t)ptr) & 15) == 0);
+	mem_heap->Free16(ptr);
+}
+
+/*
+==================
+Mem_ClearedAlloc
+==================
+*/
+void *Mem_ClearedAlloc(const int size)
+{
+	void *mem = Mem_Alloc(size);
+	SIMDProcessor->Memset(mem, 0, size);
+	return mem;
+}
+
+/*
+==================
+Mem_ClearedAlloc
+==================
+*/
+void Mem_AllocDefragBlock(void)
+{
+	mem_heap->AllocDefragBlock();
 }
 
 /*
@@ -1291,7 +2565,7 @@ Mem_Init
 */
 void Mem_Init(void)
 {
-	mem_heap = new idHeap;
+	mem_heap = new idMemHeap;
 	Mem_ClearFrameStats();
 }
 
@@ -1302,7 +2576,7 @@ Mem_Shutdown
 */
 void Mem_Shutdown(void)
 {
-	idHeap *m = mem_heap;
+	idMemHeap *m = mem_heap;
 	mem_heap = NULL;
 	delete m;
 }
@@ -1886,7 +3160,7 @@ Mem_Init
 */
 void Mem_Init(void)
 {
-	mem_heap = new idHeap;
+	mem_heap = new idMemHeap;
 }
 
 /*
@@ -1903,7 +3177,7 @@ void Mem_Shutdown(void)
 		Mem_DumpCompressed(va("%s_leak_cs1.txt", mem_leakName), MEMSORT_CALLSTACK, 2, 0);
 	}
 
-	idHeap *m = mem_heap;
+	idMemHeap *m = mem_heap;
 	mem_heap = NULL;
 	delete m;
 }
@@ -1919,3 +3193,197 @@ void Mem_EnableLeakTest(const char *name)
 }
 
 #endif /* !ID_DEBUG_MEMORY */
+
+//===============================================================
+//
+//	heap benchmark
+//
+//===============================================================
+
+#if USE_THREAD_HEAP
+
+#define HEAPTEST_SLOTS			1024
+#define HEAPTEST_EXCHANGE		256
+
+typedef enum {
+	HEAPTEST_THREAD_HEAP,
+	HEAPTEST_LIBC,
+	HEAPTEST_ID_HEAP,
+	HEAPTEST_NUM_ALLOCATORS
+} heapTestAllocator_t;
+
+static const char *heapTest_names[HEAPTEST_NUM_ALLOCATORS] = { "idThreadHeap", "libc", "idHeap" };
+
+typedef struct {
+	heapTestAllocator_t	allocator;
+	idHeap 				*heap;
+	int					seed;
+	int					iterations;
+} heapTestParms_t;
+
+static void *volatile	heapTest_exchange[HEAPTEST_EXCHANGE];
+static volatile int		heapTest_lock;
+
+/*
+==================
+HeapTest_Alloc
+==================
+*/
+static void *HeapTest_Alloc(const heapTestParms_t *parms, int size)
+{
+	void *p;
+
+	switch (parms->allocator) {
+		case HEAPTEST_THREAD_HEAP:
+			return mem_heap->Allocate(size);
+		case HEAPTEST_LIBC:
+			return malloc(size);
+		default:
+			// idHeap isn't thread safe, this is what it would cost to share it
+			Heap_Lock(&heapTest_lock);
+			p = parms->heap->Allocate(size);
+			Heap_Unlock(&heapTest_lock);
+			return p;
+	}
+}
+
+/*
+==================
+HeapTest_Free
+==================
+*/
+static void HeapTest_Free(const heapTestParms_t *parms, void *p)
+{
+	switch (parms->allocator) {
+		case HEAPTEST_THREAD_HEAP:
+			mem_heap->Free(p);
+			break;
+		case HEAPTEST_LIBC:
+			free(p);
+			break;
+		default:
+			Heap_Lock(&heapTest_lock);
+			parms->heap->Free(p);
+			Heap_Unlock(&heapTest_lock);
+			break;
+	}
+}
+
+/*
+==================
+HeapTest_Thread
+==================
+*/
+static void *HeapTest_Thread(void *data)
+{
+	const heapTestParms_t *parms = (const heapTestParms_t *)data;
+	void *slots[HEAPTEST_SLOTS];
+	idRandom random(parms->seed);
+	int i, j, r, size;
+
+	memset(slots, 0, sizeof(slots));
+
+	for (i = 0; i < parms->iterations; i++) {
+		j = random.RandomInt(HEAPTEST_SLOTS);
+
+		if (slots[j]) {
+			HeapTest_Free(parms, slots[j]);
+		}
+
+		// mostly small blocks, the odd large one
+		r = random.RandomInt(100);
+
+		if (r < 80) {
+			size = 8 + random.RandomInt(248);
+		} else if (r < 98) {
+			size = 256 + random.RandomInt(4096 - 256);
+		} else {
+			size = 4096 + random.RandomInt(65536 - 4096);
+		}
+
+		slots[j] = HeapTest_Alloc(parms, size);
+		*(byte *)slots[j] = 0;
+
+		// hand every eighth block to whichever thread picks it up next
+		if ((i & 7) == 7) {
+			void *old = Heap_Exchange(&heapTest_exchange[random.RandomInt(HEAPTEST_EXCHANGE)], slots[j]);
+			slots[j] = NULL;
+
+			if (old) {
+				HeapTest_Free(parms, old);
+			}
+		}
+	}
+
+	for (j = 0; j < HEAPTEST_SLOTS; j++) {
+		if (slots[j]) {
+			HeapTest_Free(parms, slots[j]);
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* USE_THREAD_HEAP */
+
+/*
+==================
+Mem_TestHeap_f
+
+  allocation speed of the heaps from several threads, part of the blocks
+  are handed over and freed by another thread
+==================
+*/
+void Mem_TestHeap_f(const idCmdArgs &args)
+{
+#if USE_THREAD_HEAP
+	heapTestParms_t parms[16];
+	pthread_t threads[16];
+	idHeap *heap;
+	idTimer timer;
+	int numThreads, iterations, i, j;
+
+	numThreads = idMath::ClampInt(1, 16, args.Argc() > 1 ? atoi(args.Argv(1)) : 4);
+	iterations = Max(1, args.Argc() > 2 ? atoi(args.Argv(2)) : 1000000);
+
+	if (!mem_heap) {
+		return;
+	}
+
+	for (i = 0; i < HEAPTEST_NUM_ALLOCATORS; i++) {
+		heap = (i == HEAPTEST_ID_HEAP) ? new idHeap : NULL;
+
+		timer.Clear();
+		timer.Start();
+
+		for (j = 0; j < numThreads; j++) {
+			parms[j].allocator = (heapTestAllocator_t)i;
+			parms[j].heap = heap;
+			parms[j].seed = j;
+			parms[j].iterations = iterations;
+			pthread_create(&threads[j], NULL, HeapTest_Thread, &parms[j]);
+		}
+
+		for (j = 0; j < numThreads; j++) {
+			pthread_join(threads[j], NULL);
+		}
+
+		for (j = 0; j < HEAPTEST_EXCHANGE; j++) {
+			if (heapTest_exchange[j]) {
+				HeapTest_Free(&parms[0], heapTest_exchange[j]);
+				heapTest_exchange[j] = NULL;
+			}
+		}
+
+		timer.Stop();
+
+		idLib::common->Printf("%-12s %2d threads %6.0f msec %6.2f M allocs/sec\n", heapTest_names[i], numThreads, timer.Milliseconds(), (float)numThreads * iterations / (timer.Milliseconds() * 1000.0f));
+
+		delete heap;
+	}
+
+	mem_heap->Dump();
+#else
+	idLib::common->Printf("the thread heap is not compiled in\n");
+#endif
+}
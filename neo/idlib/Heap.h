@@ -49,6 +49,28 @@ typedef struct {
 	int		totalSize;
 } memoryStats_t;
 
+// what an allocation is for, set on the allocating thread with idScopedMemTag
+typedef enum {
+	MEMTAG_GENERAL,
+	MEMTAG_GEOMETRY,			// renderer models and surfaces
+	MEMTAG_IMAGES,
+	MEMTAG_COLLISION,
+	MEMTAG_AAS,
+	MEMTAG_SCRIPT,
+	MEMTAG_DECLS,
+	MEMTAG_SOUND,				// sound cache
+	MEMTAG_GUI,
+	MEMTAG_ENTITIES,			// game entities
+	MEMTAG_NUM
+} memTag_t;
+
+typedef struct {
+	int				size;		// bytes currently allocated
+	int				num;		// blocks currently allocated
+	unsigned int	totalSize;	// bytes allocated since startup, wraps
+	unsigned int	totalNum;	// blocks allocated since startup, wraps
+} memTagStats_t;
+
 
 void		Mem_Init(void);
 void		Mem_Shutdown(void);
@@ -58,7 +80,25 @@ void		Mem_GetFrameStats(memoryStats_t &allocs, memoryStats_t &frees);
 void		Mem_GetStats(memoryStats_t &stats);
 void		Mem_Dump_f(const class idCmdArgs &args);
 void		Mem_DumpCompressed_f(const class idCmdArgs &args);
+void		Mem_TestHeap_f(const class idCmdArgs &args);
 void		Mem_AllocDefragBlock(void);
+memTag_t	Mem_SetTag(memTag_t tag);			// returns the previous tag of the thread
+void		Mem_GetTagStats(memTagStats_t stats[MEMTAG_NUM]);
+const char *Mem_GetTagName(memTag_t tag);
+
+class idScopedMemTag
+{
+	public:
+		idScopedMemTag(memTag_t tag) {
+			previous = Mem_SetTag(tag);
+		}
+		~idScopedMemTag(void) {
+			Mem_SetTag(previous);
+		}
+
+	private:
+		memTag_t		previous;
+};
 
 
 #ifndef ID_DEBUG_MEMORY
@@ -151,6 +191,64 @@ __inline void operator delete[](void *p)
 #endif /* ID_DEBUG_MEMORY */
 
 
+/*
+===============================================================================
+
+	Level arena
+
+	Memory for data that lives exactly as long as the loaded level. Blocks
+	are carved out of a few large chunks and are never freed one by one,
+	FreeAll gives everything back at once when the level is unloaded.
+	Not thread safe, the level is loaded and freed on the main thread.
+
+===============================================================================
+*/
+
+class idLevelArena
+{
+	public:
+		idLevelArena(const char *name, memTag_t tag, int maxChunkSize = 1 << 20);
+		~idLevelArena(void);
+
+		void 					*Alloc(const int size);			// 16 byte aligned
+		void 					*ClearedAlloc(const int size);
+		void					FreeAll(void);
+
+		int						GetUsedSize(void) const {
+			return usedSize;
+		}
+		int						GetChunkSize(void) const {
+			return chunkSize;
+		}
+
+		void					Print(void) const;
+		static void				List_f(const class idCmdArgs &args);
+
+	private:
+		typedef struct chunk_s {
+			struct chunk_s 		*next;
+			int					size;
+			int					used;
+		} chunk_t;
+
+		const char 				*name;
+		memTag_t				tag;
+		int						maxChunkSize;
+		int						nextChunkSize;		// chunks double up to maxChunkSize
+		chunk_t 				*chunks;			// the first chunk is the one being filled
+		int						numChunks;
+		int						numAllocs;
+		int						usedSize;			// bytes handed out
+		int						chunkSize;			// bytes taken from the heap
+		int						peakChunkSize;
+		int						lastFreeSize;
+		float					lastFreeMsec;		// time the last FreeAll took
+		idLevelArena 			*next;
+
+		static idLevelArena 	*arenas;
+};
+
+
 /*
 ===============================================================================
 
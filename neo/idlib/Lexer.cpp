@@ -112,6 +112,113 @@ int default_setup;
 
 char idLexer::baseFolder[ 256 ];
 
+static idCVar lexer_tokenCache("lexer_tokenCache", "1", CVAR_SYSTEM | CVAR_BOOL, "replay the tokens of script files loaded with LEXFL_TOKENCACHE from a binary token cache instead of scanning the files");
+
+/*
+===============================================================================
+
+	Token cache
+
+	The cache file stores the tokens read from a script together with the
+	offsets of the white space before the token and the end of the token,
+	so the script pointer stays valid for the calls which read the script
+	text directly. Number values are not stored, they are parsed from the
+	token string when they are asked for, the same as for scanned tokens.
+	Cache files are written in native byte order.
+
+	Only scripts loaded with LEXFL_TOKENCACHE are cached. A cached token is
+	several times the size of its source text, so files which are mostly
+	numbers, like models, animations and maps, are scanned.
+
+===============================================================================
+*/
+
+#define TOKENCACHE_IDENT		(('C'<<24)+('K'<<16)+('O'<<8)+'T')
+#define TOKENCACHE_VERSION		2
+#define TOKENCACHE_MIN_LENGTH	4096		// smaller scripts are scanned faster than the cache file is opened
+
+typedef struct tokenCacheHeader_s {
+	int						ident;
+	int						version;
+	int						checksum;			// checksum of the script
+	int						length;				// length of the script
+	int						flags;				// lexer flags the script was read with
+	int						punctuations;		// checksum of the punctuations the script was read with
+	int						numTokens;
+	int						stringsSize;
+} tokenCacheHeader_t;
+
+typedef struct cachedToken_s {
+	int						whiteSpaceStart;	// offset of the white space before the token
+	int						whiteSpaceEnd;		// offset of the token
+	int						end;				// offset after the token
+	int						line;
+	int						linesCrossed;
+	int						endLine;			// line after the token
+	int						type;
+	int						subtype;
+	int						flags;
+	int						string;				// offset of the token string in the string table
+	int						length;
+} cachedToken_t;
+
+typedef enum {
+	TOKENCACHE_UNCHECKED,
+	TOKENCACHE_REPLAY,
+	TOKENCACHE_RECORD,
+	TOKENCACHE_DISABLED
+} tokenCacheState_t;
+
+class idTokenCache
+{
+	public:
+		idTokenCache(void);
+
+		idStr					fileName;
+		tokenCacheState_t		state;
+		int						flags;
+		const punctuation_t 	*punctuations;
+		int						checksum;
+		int						punctuationChecksum;
+
+		// replay
+		void 					*data;
+		const cachedToken_t 	*tokens;
+		const char 				*strings;
+		int						numTokens;
+		int						current;
+
+		// record
+		idList<cachedToken_t>	recordTokens;
+		idList<char>			recordStrings;
+		idList<int>				stringOffsets;
+		idHashIndex				stringHash;
+		int						lastWhiteSpaceStart;
+};
+
+idTokenCache::idTokenCache(void)
+{
+	state = TOKENCACHE_UNCHECKED;
+	flags = 0;
+	punctuations = NULL;
+	checksum = 0;
+	punctuationChecksum = 0;
+	data = NULL;
+	tokens = NULL;
+	strings = NULL;
+	numTokens = 0;
+	current = 0;
+	recordTokens.SetGranularity(1024);
+	recordStrings.SetGranularity(16384);
+	stringOffsets.SetGranularity(1024);
+	lastWhiteSpaceStart = -1;
+}
+
+static int tokenCacheNumReplayed;		// number of scripts replayed from the cache
+static int tokenCacheNumWritten;		// number of cache files written
+static int tokenCacheNumTokens;			// number of tokens replayed from the cache
+static int tokenCacheNumScanned;		// number of tokens scanned from scripts with a cache
+
 /*
 ================
 idLexer::CreatePunctuationTable
@@ -235,6 +342,11 @@ void idLexer::Error(const char *str, ...)
 
 	hadError = true;
 
+	// a cache would lose the error
+	if (tokenCache && tokenCache->state == TOKENCACHE_RECORD) {
+		tokenCache->state = TOKENCACHE_DISABLED;
+	}
+
 	if (idLexer::flags & LEXFL_NOERRORS) {
 		return;
 	}
@@ -260,6 +372,11 @@ void idLexer::Warning(const char *str, ...)
 	char text[MAX_STRING_CHARS];
 	va_list ap;
 
+	// a cache would lose the warning
+	if (tokenCache && tokenCache->state == TOKENCACHE_RECORD) {
+		tokenCache->state = TOKENCACHE_DISABLED;
+	}
+
 	if (idLexer::flags & LEXFL_NOWARNINGS) {
 		return;
 	}
@@ -306,12 +423,12 @@ int idLexer::ReadWhiteSpace(void)
 {
 	while (1) {
 		// skip white space
-		while (*idLexer::script_p <= ' ') {
-			if (!*idLexer::script_p) {
+		while (idLexer::CharAt(0) <= ' ') {
+			if (!idLexer::CharAt(0)) {
 				return 0;
 			}
 
-			if (*idLexer::script_p == '\n') {
+			if (idLexer::CharAt(0) == '\n') {
 				idLexer::line++;
 			}
 
@@ -319,47 +436,47 @@ int idLexer::ReadWhiteSpace(void)
 		}
 
 		// skip comments
-		if (*idLexer::script_p == '/') {
+		if (idLexer::CharAt(0) == '/') {
 			// comments //
-			if (*(idLexer::script_p+1) == '/') {
+			if (idLexer::CharAt(1) == '/') {
 				idLexer::script_p++;
 
 				do {
 					idLexer::script_p++;
 
-					if (!*idLexer::script_p) {
+					if (!idLexer::CharAt(0)) {
 						return 0;
 					}
-				} while (*idLexer::script_p != '\n');
+				} while (idLexer::CharAt(0) != '\n');
 
 				idLexer::line++;
 				idLexer::script_p++;
 
-				if (!*idLexer::script_p) {
+				if (!idLexer::CharAt(0)) {
 					return 0;
 				}
 
 				continue;
 			}
 			// comments /* */
-			else if (*(idLexer::script_p+1) == '*') {
+			else if (idLexer::CharAt(1) == '*') {
 				idLexer::script_p++;
 
 				while (1) {
 					idLexer::script_p++;
 
-					if (!*idLexer::script_p) {
+					if (!idLexer::CharAt(0)) {
 						return 0;
 					}
 
-					if (*idLexer::script_p == '\n') {
+					if (idLexer::CharAt(0) == '\n') {
 						idLexer::line++;
-					} else if (*idLexer::script_p == '/') {
+					} else if (idLexer::CharAt(0) == '/') {
 						if (*(idLexer::script_p-1) == '*') {
 							break;
 						}
 
-						if (*(idLexer::script_p+1) == '*') {
+						if (idLexer::CharAt(1) == '*') {
 							idLexer::Warning("nested comment");
 						}
 					}
@@ -367,13 +484,13 @@ int idLexer::ReadWhiteSpace(void)
 
 				idLexer::script_p++;
 
-				if (!*idLexer::script_p) {
+				if (!idLexer::CharAt(0)) {
 					return 0;
 				}
 
 				idLexer::script_p++;
 
-				if (!*idLexer::script_p) {
+				if (!idLexer::CharAt(0)) {
 					return 0;
 				}
 
@@ -400,7 +517,7 @@ int idLexer::ReadEscapeCharacter(char *ch)
 	idLexer::script_p++;
 
 	// determine the escape character
-	switch (*idLexer::script_p) {
+	switch (idLexer::CharAt(0)) {
 		case '\\':
 			c = '\\';
 			break;
@@ -438,7 +555,7 @@ int idLexer::ReadEscapeCharacter(char *ch)
 			idLexer::script_p++;
 
 			for (i = 0, val = 0; ; i++, idLexer::script_p++) {
-				c = *idLexer::script_p;
+				c = idLexer::CharAt(0);
 
 				if (c >= '0' && c <= '9')
 					c = c - '0';
@@ -463,12 +580,12 @@ int idLexer::ReadEscapeCharacter(char *ch)
 			break;
 		}
 		default: { //NOTE: decimal ASCII code, NOT octal
-			if (*idLexer::script_p < '0' || *idLexer::script_p > '9') {
+			if (idLexer::CharAt(0) < '0' || idLexer::CharAt(0) > '9') {
 				idLexer::Error("unknown escape char");
 			}
 
 			for (i = 0, val = 0; ; i++, idLexer::script_p++) {
-				c = *idLexer::script_p;
+				c = idLexer::CharAt(0);
 
 				if (c >= '0' && c <= '9')
 					c = c - '0';
@@ -523,7 +640,7 @@ int idLexer::ReadString(idToken *token, int quote)
 
 	while (1) {
 		// if there is an escape character and escape characters are allowed
-		if (*idLexer::script_p == '\\' && !(idLexer::flags & LEXFL_NOSTRINGESCAPECHARS)) {
+		if (idLexer::CharAt(0) == '\\' && !(idLexer::flags & LEXFL_NOSTRINGESCAPECHARS)) {
 			if (!idLexer::ReadEscapeCharacter(&ch)) {
 				return 0;
 			}
@@ -531,7 +648,7 @@ int idLexer::ReadString(idToken *token, int quote)
 			token->AppendDirty(ch);
 		}
 		// if a trailing quote
-		else if (*idLexer::script_p == quote) {
+		else if (idLexer::CharAt(0) == quote) {
 			// step over the quote
 			idLexer::script_p++;
 
@@ -552,7 +669,7 @@ int idLexer::ReadString(idToken *token, int quote)
 			}
 
 			if (idLexer::flags & LEXFL_NOSTRINGCONCAT) {
-				if (*idLexer::script_p != '\\') {
+				if (idLexer::CharAt(0) != '\\') {
 					idLexer::script_p = tmpscript_p;
 					idLexer::line = tmpline;
 					break;
@@ -561,14 +678,14 @@ int idLexer::ReadString(idToken *token, int quote)
 				// step over the '\\'
 				idLexer::script_p++;
 
-				if (!idLexer::ReadWhiteSpace() || (*idLexer::script_p != quote)) {
+				if (!idLexer::ReadWhiteSpace() || (idLexer::CharAt(0) != quote)) {
 					idLexer::Error("expecting string after '\' terminated line");
 					return 0;
 				}
 			}
 
 			// if there's no leading qoute
-			if (*idLexer::script_p != quote) {
+			if (idLexer::CharAt(0) != quote) {
 				idLexer::script_p = tmpscript_p;
 				idLexer::line = tmpline;
 				break;
@@ -577,12 +694,12 @@ int idLexer::ReadString(idToken *token, int quote)
 			// step over the new leading quote
 			idLexer::script_p++;
 		} else {
-			if (*idLexer::script_p == '\0') {
+			if (idLexer::CharAt(0) == '\0') {
 				idLexer::Error("missing trailing quote");
 				return 0;
 			}
 
-			if (*idLexer::script_p == '\n') {
+			if (idLexer::CharAt(0) == '\n') {
 				idLexer::Error("newline inside string");
 				return 0;
 			}
@@ -622,7 +739,7 @@ int idLexer::ReadName(idToken *token)
 
 	do {
 		token->AppendDirty(*idLexer::script_p++);
-		c = *idLexer::script_p;
+		c = idLexer::CharAt(0);
 	} while ((c >= 'a' && c <= 'z') ||
 	         (c >= 'A' && c <= 'Z') ||
 	         (c >= '0' && c <= '9') ||
@@ -648,7 +765,7 @@ ID_INLINE int idLexer::CheckString(const char *str) const
 	int i;
 
 	for (i = 0; str[i]; i++) {
-		if (idLexer::script_p[i] != str[i]) {
+		if (idLexer::CharAt(i) != str[i]) {
 			return false;
 		}
 	}
@@ -672,21 +789,21 @@ int idLexer::ReadNumber(idToken *token)
 	token->intvalue = 0;
 	token->floatvalue = 0;
 
-	c = *idLexer::script_p;
-	c2 = *(idLexer::script_p + 1);
+	c = idLexer::CharAt(0);
+	c2 = idLexer::CharAt(1);
 
 	if (c == '0' && c2 != '.') {
 		// check for a hexadecimal number
 		if (c2 == 'x' || c2 == 'X') {
 			token->AppendDirty(*idLexer::script_p++);
 			token->AppendDirty(*idLexer::script_p++);
-			c = *idLexer::script_p;
+			c = idLexer::CharAt(0);
 
 			while ((c >= '0' && c <= '9') ||
 			       (c >= 'a' && c <= 'f') ||
 			       (c >= 'A' && c <= 'F')) {
 				token->AppendDirty(c);
-				c = *(++idLexer::script_p);
+				c = idLexer::NextChar();
 			}
 
 			token->subtype = TT_HEX | TT_INTEGER;
@@ -695,11 +812,11 @@ int idLexer::ReadNumber(idToken *token)
 		else if (c2 == 'b' || c2 == 'B') {
 			token->AppendDirty(*idLexer::script_p++);
 			token->AppendDirty(*idLexer::script_p++);
-			c = *idLexer::script_p;
+			c = idLexer::CharAt(0);
 
 			while (c == '0' || c == '1') {
 				token->AppendDirty(c);
-				c = *(++idLexer::script_p);
+				c = idLexer::NextChar();
 			}
 
 			token->subtype = TT_BINARY | TT_INTEGER;
@@ -707,11 +824,11 @@ int idLexer::ReadNumber(idToken *token)
 		// its an octal number
 		else {
 			token->AppendDirty(*idLexer::script_p++);
-			c = *idLexer::script_p;
+			c = idLexer::CharAt(0);
 
 			while (c >= '0' && c <= '7') {
 				token->AppendDirty(c);
-				c = *(++idLexer::script_p);
+				c = idLexer::NextChar();
 			}
 
 			token->subtype = TT_OCTAL | TT_INTEGER;
@@ -729,7 +846,7 @@ int idLexer::ReadNumber(idToken *token)
 			}
 
 			token->AppendDirty(c);
-			c = *(++idLexer::script_p);
+			c = idLexer::NextChar();
 		}
 
 		if (c == 'e' && dot == 0) {
@@ -745,19 +862,19 @@ int idLexer::ReadNumber(idToken *token)
 			if (c == 'e') {
 				//Append the e so that GetFloatValue code works
 				token->AppendDirty(c);
-				c = *(++idLexer::script_p);
+				c = idLexer::NextChar();
 
 				if (c == '-') {
 					token->AppendDirty(c);
-					c = *(++idLexer::script_p);
+					c = idLexer::NextChar();
 				} else if (c == '+') {
 					token->AppendDirty(c);
-					c = *(++idLexer::script_p);
+					c = idLexer::NextChar();
 				}
 
 				while (c >= '0' && c <= '9') {
 					token->AppendDirty(c);
-					c = *(++idLexer::script_p);
+					c = idLexer::NextChar();
 				}
 			}
 			// check for floating point exception infinite 1.#INF or indefinite 1.#IND or NaN
@@ -780,12 +897,12 @@ int idLexer::ReadNumber(idToken *token)
 
 				for (i = 0; i < c2; i++) {
 					token->AppendDirty(c);
-					c = *(++idLexer::script_p);
+					c = idLexer::NextChar();
 				}
 
 				while (c >= '0' && c <= '9') {
 					token->AppendDirty(c);
-					c = *(++idLexer::script_p);
+					c = idLexer::NextChar();
 				}
 
 				if (!(idLexer::flags & LEXFL_ALLOWFLOATEXCEPTIONS)) {
@@ -844,17 +961,17 @@ int idLexer::ReadNumber(idToken *token)
 					break;
 				}
 
-				c = *(++idLexer::script_p);
+				c = idLexer::NextChar();
 			}
 		}
 	} else if (token->subtype & TT_IPADDRESS) {
 		if (c == ':') {
 			token->AppendDirty(c);
-			c = *(++idLexer::script_p);
+			c = idLexer::NextChar();
 
 			while (c >= '0' && c <= '9') {
 				token->AppendDirty(c);
-				c = *(++idLexer::script_p);
+				c = idLexer::NextChar();
 			}
 
 			token->subtype |= TT_IPPORT;
@@ -878,7 +995,7 @@ int idLexer::ReadPunctuation(idToken *token)
 
 #ifdef PUNCTABLE
 
-	for (n = idLexer::punctuationtable[(unsigned int)*(idLexer::script_p)]; n >= 0; n = idLexer::nextpunctuation[n]) {
+	for (n = idLexer::punctuationtable[(unsigned int)idLexer::CharAt(0)]; n >= 0; n = idLexer::nextpunctuation[n]) {
 		punc = &(idLexer::punctuations[n]);
 #else
 	int i;
@@ -889,8 +1006,8 @@ int idLexer::ReadPunctuation(idToken *token)
 		p = punc->p;
 
 		// check for this punctuation in the script
-		for (l = 0; p[l] && idLexer::script_p[l]; l++) {
-			if (idLexer::script_p[l] != p[l]) {
+		for (l = 0; p[l] && idLexer::CharAt(l); l++) {
+			if (idLexer::CharAt(l) != p[l]) {
 				break;
 			}
 		}
@@ -937,6 +1054,11 @@ int idLexer::ReadToken(idToken *token)
 		return 1;
 	}
 
+	// replay the token from the token cache
+	if (tokenCache && ReadCachedToken(token)) {
+		return 1;
+	}
+
 	// save script pointer
 	lastScript_p = script_p;
 	// save line counter
@@ -950,6 +1072,10 @@ int idLexer::ReadToken(idToken *token)
 
 	// read white space before token
 	if (!ReadWhiteSpace()) {
+		if (tokenCache && tokenCache->state == TOKENCACHE_RECORD) {
+			WriteTokenCache();
+		}
+
 		return 0;
 	}
 
@@ -963,7 +1089,7 @@ int idLexer::ReadToken(idToken *token)
 	// clear token flags
 	token->flags = 0;
 
-	c = *idLexer::script_p;
+	c = idLexer::CharAt(0);
 
 	// if we're keeping everything as whitespace deliminated strings
 	if (idLexer::flags & LEXFL_ONLYSTRINGS) {
@@ -978,14 +1104,14 @@ int idLexer::ReadToken(idToken *token)
 	}
 	// if there is a number
 	else if ((c >= '0' && c <= '9') ||
-	         (c == '.' && (*(idLexer::script_p + 1) >= '0' && *(idLexer::script_p + 1) <= '9'))) {
+	         (c == '.' && (idLexer::CharAt(1) >= '0' && idLexer::CharAt(1) <= '9'))) {
 		if (!idLexer::ReadNumber(token)) {
 			return 0;
 		}
 
 		// if names are allowed to start with a number
 		if (idLexer::flags & LEXFL_ALLOWNUMBERNAMES) {
-			c = *idLexer::script_p;
+			c = idLexer::CharAt(0);
 
 			if ((c >= 'a' && c <= 'z') ||	(c >= 'A' && c <= 'Z') || c == '_') {
 				if (!idLexer::ReadName(token)) {
@@ -1018,6 +1144,10 @@ int idLexer::ReadToken(idToken *token)
 		return 0;
 	}
 
+	if (tokenCache) {
+		RecordToken(token);
+	}
+
 	// succesfully read a token
 	return 1;
 }
@@ -1360,19 +1490,19 @@ const char	*idLexer::ReadRestOfLine(idStr &out)
 {
 	while (1) {
 
-		if (*idLexer::script_p == '\n') {
+		if (idLexer::CharAt(0) == '\n') {
 			idLexer::line++;
 			break;
 		}
 
-		if (!*idLexer::script_p) {
+		if (!idLexer::CharAt(0)) {
 			break;
 		}
 
-		if (*idLexer::script_p <= ' ') {
+		if (idLexer::CharAt(0) <= ' ') {
 			out += " ";
 		} else {
-			out += *idLexer::script_p;
+			out += idLexer::CharAt(0);
 		}
 
 		idLexer::script_p++;
@@ -1567,7 +1697,7 @@ const char *idLexer::ParseBracedSectionExact(idStr &out, int tabs)
 	skipWhite = false;
 	doTabs = tabs >= 0;
 
-	while (depth && *idLexer::script_p) {
+	while (depth && idLexer::CharAt(0)) {
 		char c = *(idLexer::script_p++);
 
 		switch (c) {
@@ -1762,6 +1892,10 @@ void idLexer::Reset(void)
 	idLexer::lastline = 1;
 	// clear the saved token
 	idLexer::token = "";
+
+	if (idLexer::tokenCache) {
+		idLexer::tokenCache->current = 0;
+	}
 }
 
 /*
@@ -1784,6 +1918,299 @@ int idLexer::NumLinesCrossed(void)
 	return idLexer::line - idLexer::lastline;
 }
 
+/*
+================
+idLexer::OpenTokenCache
+
+  checks for a token cache of the script read with the current flags and punctuations
+================
+*/
+void idLexer::OpenTokenCache(void)
+{
+	const tokenCacheHeader_t *header;
+	unsigned long crc;
+	int i, size;
+	void *data = NULL;
+
+	if (!(flags & LEXFL_TOKENCACHE)) {
+		tokenCache->state = TOKENCACHE_DISABLED;
+		return;
+	}
+
+	tokenCache->flags = flags;
+	tokenCache->punctuations = punctuations;
+	tokenCache->checksum = MD5_BlockChecksum(buffer, length);
+
+	CRC32_InitChecksum(crc);
+
+	for (i = 0; punctuations[i].p; i++) {
+		CRC32_UpdateChecksum(crc, punctuations[i].p, strlen(punctuations[i].p));
+		CRC32_UpdateChecksum(crc, &punctuations[i].n, sizeof(punctuations[i].n));
+	}
+
+	CRC32_FinishChecksum(crc);
+	tokenCache->punctuationChecksum = crc;
+
+	tokenCache->state = TOKENCACHE_RECORD;
+
+	size = idLib::fileSystem->ReadFile(tokenCache->fileName, &data);
+
+	if (size < (int)sizeof(tokenCacheHeader_t)) {
+		if (data) {
+			idLib::fileSystem->FreeFile(data);
+		}
+
+		return;
+	}
+
+	header = (const tokenCacheHeader_t *) data;
+
+	if (header->ident != TOKENCACHE_IDENT || header->version != TOKENCACHE_VERSION ||
+	    header->checksum != tokenCache->checksum || header->length != length ||
+	    header->flags != flags || header->punctuations != tokenCache->punctuationChecksum ||
+	    header->numTokens < 0 || header->stringsSize < 0 ||
+	    size != (int)(sizeof(tokenCacheHeader_t) + header->numTokens * sizeof(cachedToken_t)) + header->stringsSize) {
+		// stale cache, the script is recorded again
+		idLib::fileSystem->FreeFile(data);
+		return;
+	}
+
+	tokenCache->data = data;
+	tokenCache->tokens = (const cachedToken_t *)(header + 1);
+	tokenCache->strings = (const char *)(tokenCache->tokens + header->numTokens);
+	tokenCache->numTokens = header->numTokens;
+	tokenCache->current = 0;
+	tokenCache->state = TOKENCACHE_REPLAY;
+
+	tokenCacheNumReplayed++;
+}
+
+/*
+================
+idLexer::ReadCachedToken
+
+  returns 0 if there is no cached token at the current position in the script
+================
+*/
+int idLexer::ReadCachedToken(idToken *token)
+{
+	const cachedToken_t *t;
+	int offset, i;
+
+	if (tokenCache->state == TOKENCACHE_UNCHECKED) {
+		OpenTokenCache();
+	}
+
+	if (tokenCache->state != TOKENCACHE_REPLAY) {
+		return 0;
+	}
+
+	if (flags != tokenCache->flags || punctuations != tokenCache->punctuations) {
+		return 0;
+	}
+
+	offset = script_p - buffer;
+	i = tokenCache->current;
+
+	if (i >= tokenCache->numTokens || tokenCache->tokens[i].whiteSpaceStart != offset) {
+		// the script was read without reading tokens, find the token at the new position
+		int low = 0, high = tokenCache->numTokens - 1;
+
+		i = -1;
+
+		while (low <= high) {
+			int mid = (low + high) >> 1;
+
+			if (tokenCache->tokens[mid].whiteSpaceStart < offset) {
+				low = mid + 1;
+			} else if (tokenCache->tokens[mid].whiteSpaceStart > offset) {
+				high = mid - 1;
+			} else {
+				i = mid;
+				break;
+			}
+		}
+
+		if (i == -1) {
+			return 0;
+		}
+	}
+
+	t = &tokenCache->tokens[i];
+
+	if (t->line - t->linesCrossed != line) {
+		return 0;
+	}
+
+	lastScript_p = script_p;
+	lastline = line;
+	whiteSpaceStart_p = buffer + t->whiteSpaceStart;
+	whiteSpaceEnd_p = buffer + t->whiteSpaceEnd;
+
+	token->EnsureAlloced(t->length + 1, false);
+	memcpy(token->data, tokenCache->strings + t->string, t->length + 1);
+	token->len = t->length;
+	token->type = t->type;
+	token->subtype = t->subtype;
+	token->line = t->line;
+	token->linesCrossed = t->linesCrossed;
+	token->flags = t->flags;
+	token->intvalue = 0;
+	token->floatvalue = 0;
+	token->whiteSpaceStart_p = whiteSpaceStart_p;
+	token->whiteSpaceEnd_p = whiteSpaceEnd_p;
+
+	script_p = buffer + t->end;
+	line = t->endLine;
+
+	tokenCache->current = i + 1;
+	tokenCacheNumTokens++;
+
+	return 1;
+}
+
+/*
+================
+idLexer::RecordToken
+================
+*/
+void idLexer::RecordToken(const idToken *token)
+{
+	int offset, hash, i;
+
+	if (tokenCache->state == TOKENCACHE_REPLAY) {
+		tokenCacheNumScanned++;
+		return;
+	}
+
+	if (tokenCache->state != TOKENCACHE_RECORD) {
+		return;
+	}
+
+	if (flags != tokenCache->flags || punctuations != tokenCache->punctuations) {
+		// the stream depends on more than the script
+		tokenCache->state = TOKENCACHE_DISABLED;
+		return;
+	}
+
+	offset = token->whiteSpaceStart_p - buffer;
+
+	// only keep the tokens in script order, a token read again after a Reset is already recorded
+	if (offset <= tokenCache->lastWhiteSpaceStart) {
+		return;
+	}
+
+	tokenCache->lastWhiteSpaceStart = offset;
+
+	cachedToken_t &t = tokenCache->recordTokens.Alloc();
+
+	t.whiteSpaceStart = offset;
+	t.whiteSpaceEnd = token->whiteSpaceEnd_p - buffer;
+	t.end = script_p - buffer;
+	t.line = token->line;
+	t.linesCrossed = token->linesCrossed;
+	t.endLine = line;
+	t.type = token->type;
+	t.subtype = token->subtype;
+	t.flags = token->flags;
+	t.length = token->Length();
+
+	// share the strings of equal tokens
+	hash = tokenCache->stringHash.GenerateKey(token->c_str(), true);
+
+	for (i = tokenCache->stringHash.First(hash); i != -1; i = tokenCache->stringHash.Next(i)) {
+		if (strcmp(tokenCache->recordStrings.Ptr() + tokenCache->stringOffsets[i], token->c_str()) == 0) {
+			break;
+		}
+	}
+
+	if (i == -1) {
+		int stringOffset = tokenCache->recordStrings.Num();
+
+		tokenCache->recordStrings.SetNum(stringOffset + t.length + 1, false);
+		memcpy(tokenCache->recordStrings.Ptr() + stringOffset, token->c_str(), t.length + 1);
+		tokenCache->stringHash.Add(hash, tokenCache->stringOffsets.Append(stringOffset));
+		i = tokenCache->stringOffsets.Num() - 1;
+	}
+
+	t.string = tokenCache->stringOffsets[i];
+}
+
+/*
+================
+idLexer::WriteTokenCache
+
+  writes the tokens recorded when the end of the script is reached
+================
+*/
+void idLexer::WriteTokenCache(void)
+{
+	tokenCacheHeader_t header;
+	idFile *f;
+
+	tokenCache->state = TOKENCACHE_DISABLED;
+
+	if (!tokenCache->recordTokens.Num()) {
+		return;
+	}
+
+	f = idLib::fileSystem->OpenFileWrite(tokenCache->fileName);
+
+	if (f) {
+		header.ident = TOKENCACHE_IDENT;
+		header.version = TOKENCACHE_VERSION;
+		header.checksum = tokenCache->checksum;
+		header.length = length;
+		header.flags = tokenCache->flags;
+		header.punctuations = tokenCache->punctuationChecksum;
+		header.numTokens = tokenCache->recordTokens.Num();
+		header.stringsSize = tokenCache->recordStrings.Num();
+
+		f->Write(&header, sizeof(header));
+		f->Write(tokenCache->recordTokens.Ptr(), tokenCache->recordTokens.Num() * sizeof(cachedToken_t));
+		f->Write(tokenCache->recordStrings.Ptr(), tokenCache->recordStrings.Num());
+		idLib::fileSystem->CloseFile(f);
+
+		tokenCacheNumWritten++;
+	}
+
+	tokenCache->recordTokens.Clear();
+	tokenCache->recordStrings.Clear();
+	tokenCache->stringOffsets.Clear();
+	tokenCache->stringHash.Free();
+}
+
+/*
+================
+idLexer::FreeTokenCache
+================
+*/
+void idLexer::FreeTokenCache(void)
+{
+	if (!tokenCache) {
+		return;
+	}
+
+	if (tokenCache->data) {
+		idLib::fileSystem->FreeFile(tokenCache->data);
+	}
+
+	delete tokenCache;
+	tokenCache = NULL;
+}
+
+/*
+================
+idLexer::TokenCacheStats_f
+================
+*/
+void idLexer::TokenCacheStats_f(const idCmdArgs &args)
+{
+	idLib::common->Printf("%5d scripts replayed from the token cache\n", tokenCacheNumReplayed);
+	idLib::common->Printf("%5d token cache files written\n", tokenCacheNumWritten);
+	idLib::common->Printf("%7d tokens replayed, %d tokens scanned\n", tokenCacheNumTokens, tokenCacheNumScanned);
+}
+
 /*
 ================
 idLexer::LoadFile
@@ -1809,21 +2236,32 @@ int idLexer::LoadFile(const char *filename, bool OSPath)
 
 	if (OSPath) {
 		fp = idLib::fileSystem->OpenExplicitFileRead(pathname);
+
+		if (!fp) {
+			return false;
+		}
+
+		length = fp->Length();
+		buf = (char *) Mem_Alloc(length + 1);
+		buf[length] = '\0';
+		fp->Read(buf, length);
+		idLexer::fileTime = fp->Timestamp();
+		idLexer::filename = fp->GetFullPath();
+		idLib::fileSystem->CloseFile(fp);
+		idLexer::fileBuffer = false;
 	} else {
-		fp = idLib::fileSystem->OpenFileRead(pathname);
-	}
+		const void *data;
 
-	if (!fp) {
-		return false;
-	}
+		// the lexer stops at end_p, so a mapping without a trailing 0 is used as it is
+		length = idLib::fileSystem->ReadFileMapped(pathname, &data, NULL, &fileTime, &this->filename);
+
+		if (length < 0) {
+			return false;
+		}
 
-	length = fp->Length();
-	buf = (char *) Mem_Alloc(length + 1);
-	buf[length] = '\0';
-	fp->Read(buf, length);
-	idLexer::fileTime = fp->Timestamp();
-	idLexer::filename = fp->GetFullPath();
-	idLib::fileSystem->CloseFile(fp);
+		buf = (char *) data;
+		idLexer::fileBuffer = true;
+	}
 
 	idLexer::buffer = buf;
 	idLexer::length = length;
@@ -1840,6 +2278,12 @@ int idLexer::LoadFile(const char *filename, bool OSPath)
 	idLexer::allocated = true;
 	idLexer::loaded = true;
 
+	// the cache is checked when the first token is read, after the flags and punctuations have been set
+	if (!OSPath && length >= TOKENCACHE_MIN_LENGTH && lexer_tokenCache.GetBool()) {
+		tokenCache = new idTokenCache;
+		tokenCache->fileName = "tokencache/" + pathname + ".tok";
+	}
+
 	return true;
 }
 
@@ -1897,11 +2341,18 @@ void idLexer::FreeSource(void)
 #endif //PUNCTABLE
 
 	if (idLexer::allocated) {
-		Mem_Free((void *) idLexer::buffer);
+		if (idLexer::fileBuffer) {
+			idLib::fileSystem->FreeFileMapped(idLexer::buffer);
+		} else {
+			Mem_Free((void *) idLexer::buffer);
+		}
+
 		idLexer::buffer = NULL;
 		idLexer::allocated = false;
 	}
 
+	FreeTokenCache();
+
 	idLexer::tokenavailable = 0;
 	idLexer::token = "";
 	idLexer::loaded = false;
@@ -1919,6 +2370,7 @@ idLexer::idLexer(void)
 	idLexer::flags = 0;
 	idLexer::SetPunctuations(NULL);
 	idLexer::allocated = false;
+	idLexer::fileBuffer = false;
 	idLexer::fileTime = 0;
 	idLexer::length = 0;
 	idLexer::line = 0;
@@ -1927,6 +2379,7 @@ idLexer::idLexer(void)
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::tokenCache = NULL;
 }
 
 /*
@@ -1941,6 +2394,7 @@ idLexer::idLexer(int flags)
 	idLexer::flags = flags;
 	idLexer::SetPunctuations(NULL);
 	idLexer::allocated = false;
+	idLexer::fileBuffer = false;
 	idLexer::fileTime = 0;
 	idLexer::length = 0;
 	idLexer::line = 0;
@@ -1949,6 +2403,7 @@ idLexer::idLexer(int flags)
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::tokenCache = NULL;
 }
 
 /*
@@ -1962,9 +2417,11 @@ idLexer::idLexer(const char *filename, int flags, bool OSPath)
 	idLexer::flags = flags;
 	idLexer::SetPunctuations(NULL);
 	idLexer::allocated = false;
+	idLexer::fileBuffer = false;
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::tokenCache = NULL;
 	idLexer::LoadFile(filename, OSPath);
 }
 
@@ -1979,9 +2436,11 @@ idLexer::idLexer(const char *ptr, int length, const char *name, int flags)
 	idLexer::flags = flags;
 	idLexer::SetPunctuations(NULL);
 	idLexer::allocated = false;
+	idLexer::fileBuffer = false;
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::tokenCache = NULL;
 	idLexer::LoadMemory(ptr, length, name);
 }
 
@@ -42,6 +42,11 @@ If you have questions concerning this license or the applicable additional terms
 	assumed to be in decimal format instead of octal. Binary numbers of
 	the form 0b.. or 0B.. can also be used.
 
+	The token stream of a script loaded with LoadFile() is written to a
+	binary token cache once the whole script has been read, and replayed
+	from the cache without scanning the next time the script with the same
+	checksum is loaded with the same lexer flags and punctuations.
+
 ===============================================================================
 */
 
@@ -60,7 +65,8 @@ typedef enum {
 	LEXFL_ALLOWFLOATEXCEPTIONS			= BIT(10),	// allow float exceptions like 1.#INF or 1.#IND to be parsed
 	LEXFL_ALLOWMULTICHARLITERALS		= BIT(11),	// allow multi character literals
 	LEXFL_ALLOWBACKSLASHSTRINGCONCAT	= BIT(12),	// allow multiple strings seperated by '\' to be concatenated
-	LEXFL_ONLYSTRINGS					= BIT(13)	// parse as whitespace deliminated strings (quoted strings keep quotes)
+	LEXFL_ONLYSTRINGS					= BIT(13),	// parse as whitespace deliminated strings (quoted strings keep quotes)
+	LEXFL_TOKENCACHE					= BIT(14)	// replay the tokens of files loaded with LoadFile from the token cache
 } lexerFlags_t;
 
 // punctuation ids
@@ -133,6 +139,9 @@ typedef struct punctuation_s {
 } punctuation_t;
 
 
+class idCmdArgs;
+class idTokenCache;
+
 class idLexer
 {
 
@@ -242,11 +251,14 @@ class idLexer
 
 		// set the base folder to load files from
 		static void		SetBaseFolder(const char *path);
+		// print token cache statistics
+		static void		TokenCacheStats_f(const idCmdArgs &args);
 
 	private:
 		int				loaded;					// set when a script file is loaded from file or memory
 		idStr			filename;				// file name of the script
 		int				allocated;				// true if buffer memory was allocated
+		bool			fileBuffer;				// buffer came from idFileSystem::ReadFileMapped and may not be 0 terminated
 		const char 	*buffer;					// buffer containing the script
 		const char 	*script_p;				// current pointer in the script
 		const char 	*end_p;					// pointer to the end of the script
@@ -265,11 +277,14 @@ class idLexer
 		idToken			token;					// available token
 		idLexer 		*next;					// next script in a chain
 		bool			hadError;				// set by idLexer::Error, even if the error is supressed
+		idTokenCache 	*tokenCache;			// cached token stream of the script
 
 		static char		baseFolder[ 256 ];		// base folder to load files from
 
 	private:
 		void			CreatePunctuationTable(const punctuation_t *punctuations);
+		char			CharAt(int offset) const;
+		char			NextChar(void);
 		int				ReadWhiteSpace(void);
 		int				ReadEscapeCharacter(char *ch);
 		int				ReadString(idToken *token, int quote);
@@ -279,8 +294,25 @@ class idLexer
 		int				ReadPrimitive(idToken *token);
 		int				CheckString(const char *str) const;
 		int				NumLinesCrossed(void);
+		void			OpenTokenCache(void);
+		int				ReadCachedToken(idToken *token);
+		void			RecordToken(const idToken *token);
+		void			WriteTokenCache(void);
+		void			FreeTokenCache(void);
 };
 
+// the script buffer is bounded by end_p, reading past it gives a 0 like a terminated string
+ID_INLINE char idLexer::CharAt(int offset) const
+{
+	return (script_p + offset < end_p) ? script_p[offset] : '\0';
+}
+
+ID_INLINE char idLexer::NextChar(void)
+{
+	script_p++;
+	return (script_p < end_p) ? *script_p : '\0';
+}
+
 ID_INLINE const char *idLexer::GetFileName(void)
 {
 	return idLexer::filename;
@@ -1107,8 +1107,9 @@ int idParser::Directive_include(void)
 		}
 
 		script = new idLexer;
+		path = includepath + path;
 
-		if (!script->LoadFile(includepath + path, OSPath)) {
+		if (!script->LoadFile(path, OSPath)) {
 			delete script;
 			script = NULL;
 		}
@@ -1125,6 +1126,7 @@ int idParser::Directive_include(void)
 	script->SetFlags(idParser::flags);
 	script->SetPunctuations(idParser::punctuations);
 	idParser::PushScript(script);
+	idParser::loadedFiles.AddUnique(path);
 	return true;
 }
 
@@ -3347,37 +3349,30 @@ idParser::GetStringFromMarker
 */
 void idParser::GetStringFromMarker(idStr &out, bool clean)
 {
-	char	*p;
-	char	save;
+	const char *p;
 
 	if (marker_p == NULL) {
 		marker_p = scriptstack->buffer;
 	}
 
 	if (tokens) {
-		p = (char *)tokens->whiteSpaceStart_p;
+		p = tokens->whiteSpaceStart_p;
 	} else {
-		p = (char *)scriptstack->script_p;
+		p = scriptstack->script_p;
 	}
 
-	// Set the end character to NULL to give us a complete string
-	save = *p;
-	*p = 0;
-
-	// If cleaning then reparse
+	// the script buffer may be a read-only file mapping, so it can't be terminated in place
 	if (clean) {
-		idParser temp(marker_p, strlen(marker_p), "temp", flags);
+		idParser temp(marker_p, p - marker_p, "temp", flags);
 		idToken token;
 
 		while (temp.ReadToken(&token)) {
 			out += token;
 		}
 	} else {
-		out = marker_p;
+		out.Empty();
+		out.Append(marker_p, p - marker_p);
 	}
-
-	// restore the character we set to NULL
-	*p = save;
 }
 
 /*
@@ -3458,6 +3453,8 @@ int idParser::LoadFile(const char *filename, bool OSPath)
 	script->next = NULL;
 	idParser::OSPath = OSPath;
 	idParser::filename = filename;
+	idParser::loadedFiles.Clear();
+	idParser::loadedFiles.Append(filename);
 	idParser::scriptstack = script;
 	idParser::tokens = NULL;
 	idParser::indentstack = NULL;
@@ -3498,6 +3495,7 @@ int idParser::LoadMemory(const char *ptr, int length, const char *name)
 	script->SetPunctuations(idParser::punctuations);
 	script->next = NULL;
 	idParser::filename = name;
+	idParser::loadedFiles.Clear();
 	idParser::scriptstack = script;
 	idParser::tokens = NULL;
 	idParser::indentstack = NULL;
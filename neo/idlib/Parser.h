@@ -161,6 +161,10 @@ class idParser
 		int				GetFlags(void) const;
 		// returns the current filename
 		const char 	*GetFileName(void) const;
+		// returns the names of all files loaded or included for the last loaded source
+		const idList<idStr> &GetLoadedFiles(void) const {
+			return idParser::loadedFiles;
+		}
 		// get current offset in current script
 		const int		GetFileOffset(void) const;
 		// get file time for current script
@@ -195,6 +199,7 @@ class idParser
 		indent_t 		*indentstack;				// stack with indents
 		int				skip;						// > 0 if skipping conditional code
 		const char		*marker_p;
+		idList<idStr>	loadedFiles;				// files loaded or included for the source
 
 		static define_t *globaldefines;				// list with global defines added to every source loaded
 
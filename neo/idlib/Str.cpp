@@ -37,6 +37,8 @@ If you have questions concerning this license or the applicable additional terms
 static idDynamicBlockAlloc<char, 1<<18, 128>	stringDataAllocator;
 #endif
 
+static int stringNumAllocs;			// string buffers allocated since startup
+
 idVec4	g_color_table[16] = {
 	idVec4(0.0f, 0.0f, 0.0f, 1.0f),
 	idVec4(1.0f, 0.0f, 0.0f, 1.0f), // S_COLOR_RED
@@ -94,6 +96,7 @@ void idStr::ReAllocate(int amount, bool keepold)
 	}
 
 	alloced = newsize;
+	stringNumAllocs++;
 
 #ifdef USE_STRING_DATA_ALLOCATOR
 	newbuffer = stringDataAllocator.Alloc(alloced);
@@ -1841,6 +1844,99 @@ void idStr::ShowMemoryUsage_f(const idCmdArgs &args)
 #endif
 }
 
+/*
+================
+idStr::GetNumAllocs
+================
+*/
+int idStr::GetNumAllocs(void)
+{
+	return stringNumAllocs;
+}
+
+/*
+================
+idStr::TestMoves_f
+
+  string allocations and time of the container operations that used to
+  copy every element, run it on a build without move semantics to compare
+================
+*/
+void idStr::TestMoves_f(const idCmdArgs &args)
+{
+	idTimer timer;
+	int i, j, count, allocs;
+
+	count = Max(16, args.Argc() > 1 ? atoi(args.Argv(1)) : 4096);
+
+#if __cplusplus >= 201103L
+	idLib::common->Printf("%d elements, with move semantics\n", count);
+#else
+	idLib::common->Printf("%d elements, without move semantics\n", count);
+#endif
+
+	// growing a list of names the way the decl and map parsers do
+	allocs = stringNumAllocs;
+	timer.Clear();
+	timer.Start();
+	{
+		idStrList list;
+
+		for (i = 0; i < count; i++) {
+			list.Append(va("textures/base_wall/long_material_name_%d", i));
+		}
+	}
+	timer.Stop();
+	idLib::common->Printf("%-22s %8d string allocs %8.2f msec\n", "idStrList append", stringNumAllocs - allocs, timer.Milliseconds());
+
+	// inserting at the front shifts all the strings
+	allocs = stringNumAllocs;
+	timer.Clear();
+	timer.Start();
+	{
+		idStrList list;
+
+		for (i = 0; i < count / 8; i++) {
+			list.Insert(va("textures/base_wall/long_material_name_%d", i), 0);
+		}
+	}
+	timer.Stop();
+	idLib::common->Printf("%-22s %8d string allocs %8.2f msec\n", "idStrList insert", stringNumAllocs - allocs, timer.Milliseconds());
+
+	// spawn args built up and handed over to a list
+	allocs = stringNumAllocs;
+	timer.Clear();
+	timer.Start();
+	{
+		idList<idDict> dicts;
+
+		for (i = 0; i < count / 16; i++) {
+			idDict dict;
+
+			for (j = 0; j < 16; j++) {
+				dict.Set(va("key%d", j), va("value%d", i * 16 + j));
+			}
+
+			dicts.Append(idMove(dict));
+		}
+	}
+	timer.Stop();
+	idLib::common->Printf("%-22s %8d string allocs %8.2f msec\n", "idList<idDict> append", stringNumAllocs - allocs, timer.Milliseconds());
+
+	// trivially copyable vertices
+	timer.Clear();
+	timer.Start();
+	{
+		idList<idDrawVert> verts;
+
+		for (i = 0; i < count * 16; i++) {
+			verts.Alloc().Clear();
+		}
+	}
+	timer.Stop();
+	idLib::common->Printf("%-22s %8s               %8.2f msec\n", "idList<idDrawVert> grow", "", timer.Milliseconds());
+}
+
 /*
 ================
 idStr::FormatNumber
@@ -121,6 +121,9 @@ class idStr
 	public:
 		idStr(void);
 		idStr(const idStr &text);
+#if __cplusplus >= 201103L
+		idStr(idStr &&text);
+#endif
 		idStr(const idStr &text, int start, int end);
 		idStr(const char *text);
 		idStr(const char *text, int start, int end);
@@ -140,6 +143,9 @@ class idStr
 		char 				&operator[](int index);
 
 		void				operator=(const idStr &text);
+#if __cplusplus >= 201103L
+		void				operator=(idStr &&text);					// takes over the buffer of a long string
+#endif
 		void				operator=(const char *text);
 
 		friend idStr		operator+(const idStr &a, const idStr &b);
@@ -311,6 +317,8 @@ class idStr
 		static void			ShutdownMemory(void);
 		static void			PurgeMemory(void);
 		static void			ShowMemoryUsage_f(const idCmdArgs &args);
+		static int			GetNumAllocs(void);								// number of string buffers allocated since startup
+		static void			TestMoves_f(const idCmdArgs &args);
 
 		int					DynamicMemoryUsed() const;
 		static idStr		FormatNumber(int number);
@@ -362,6 +370,14 @@ ID_INLINE idStr::idStr(const idStr &text)
 	len = l;
 }
 
+#if __cplusplus >= 201103L
+ID_INLINE idStr::idStr(idStr &&text)
+{
+	Init();
+	*this = idMove(text);
+}
+#endif
+
 ID_INLINE idStr::idStr(const idStr &text, int start, int end)
 {
 	int i;
@@ -549,6 +565,23 @@ ID_INLINE void idStr::operator=(const idStr &text)
 	len = l;
 }
 
+#if __cplusplus >= 201103L
+ID_INLINE void idStr::operator=(idStr &&text)
+{
+	// short strings live in the base buffer and are simply copied
+	if (text.data == text.baseBuffer || this == &text) {
+		*this = static_cast<const idStr &>(text);
+		return;
+	}
+
+	FreeData();
+	data = text.data;
+	len = text.len;
+	alloced = text.alloced;
+	text.Init();
+}
+#endif
+
 ID_INLINE idStr operator+(const idStr &a, const idStr &b)
 {
 	idStr result(a);
@@ -54,6 +54,12 @@ class idHashIndex
 		size_t			Size(void) const;
 
 		idHashIndex 	&operator=(const idHashIndex &other);
+#if __cplusplus >= 201103L
+		idHashIndex(idHashIndex &&other);
+		idHashIndex 	&operator=(idHashIndex &&other);
+#endif
+		// swap the contents of the hash indexes
+		void			Swap(idHashIndex &other);
 		// add an index to the hash, assumes the index has not yet been added to the hash
 		void			Add(const int key, const int index);
 		// remove an index from the hash
@@ -195,6 +201,52 @@ ID_INLINE idHashIndex &idHashIndex::operator=(const idHashIndex &other)
 	return *this;
 }
 
+#if __cplusplus >= 201103L
+/*
+================
+idHashIndex::idHashIndex
+================
+*/
+ID_INLINE idHashIndex::idHashIndex(idHashIndex &&other)
+{
+	Init(other.hashSize, other.indexSize);
+	Swap(other);
+}
+
+/*
+================
+idHashIndex::operator=
+
+  takes over the memory of the other hash index which is left empty
+================
+*/
+ID_INLINE idHashIndex &idHashIndex::operator=(idHashIndex &&other)
+{
+	if (this != &other) {
+		Free();
+		Swap(other);
+	}
+
+	return *this;
+}
+#endif
+
+/*
+================
+idHashIndex::Swap
+================
+*/
+ID_INLINE void idHashIndex::Swap(idHashIndex &other)
+{
+	idSwap(hashSize, other.hashSize);
+	idSwap(hash, other.hash);
+	idSwap(indexSize, other.indexSize);
+	idSwap(indexChain, other.indexChain);
+	idSwap(granularity, other.granularity);
+	idSwap(hashMask, other.hashMask);
+	idSwap(lookupMask, other.lookupMask);
+}
+
 /*
 ================
 idHashIndex::Add
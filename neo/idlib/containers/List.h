@@ -71,6 +71,28 @@ ID_INLINE type *idListNewElement(void)
 	return new type;
 }
 
+/*
+================
+idMove<type>
+
+  turns an lvalue into something that can be moved from, with compilers that
+  don't support move semantics it is a plain reference and the value gets copied
+================
+*/
+#if __cplusplus >= 201103L
+template< class type >
+ID_INLINE type &&idMove(type &a)
+{
+	return static_cast<type &&>(a);
+}
+#else
+template< class type >
+ID_INLINE type &idMove(type &a)
+{
+	return a;
+}
+#endif
+
 /*
 ================
 idSwap<type>
@@ -79,9 +101,50 @@ idSwap<type>
 template< class type >
 ID_INLINE void idSwap(type &a, type &b)
 {
-	type c = a;
-	a = b;
-	b = c;
+	type c = idMove(a);
+	a = idMove(b);
+	b = idMove(c);
+}
+
+/*
+================
+idListRelocate<type>
+
+  moves the elements into a newly allocated list, trivially copyable
+  types are copied in one go
+================
+*/
+template< class type, bool trivial >
+class idListRelocator
+{
+	public:
+		static void Relocate(type *dest, type *src, int num) {
+			for (int i = 0; i < num; i++) {
+				dest[ i ] = idMove(src[ i ]);
+			}
+		}
+};
+
+// only instantiated for trivially copyable types
+template< class type >
+class idListRelocator< type, true >
+{
+	public:
+		static void Relocate(type *dest, type *src, int num) {
+			if (num > 0) {
+				memcpy(dest, src, num * sizeof(type));
+			}
+		}
+};
+
+template< class type >
+ID_INLINE void idListRelocate(type *dest, type *src, int num)
+{
+#if __cplusplus >= 201103L
+	idListRelocator< type, std::is_trivially_copyable<type>::value >::Relocate(dest, src, num);
+#else
+	idListRelocator< type, false >::Relocate(dest, src, num);
+#endif
 }
 
 template< class type >
@@ -94,6 +157,9 @@ class idList
 
 		idList(int newgranularity = 16);
 		idList(const idList<type> &other);
+#if __cplusplus >= 201103L
+		idList(idList<type> &&other);
+#endif
 		~idList<type>(void);
 
 		void			Clear(void);										// clear the list
@@ -107,6 +173,9 @@ class idList
 		size_t			MemoryUsed(void) const;							// returns size of the used elements in the list
 
 		idList<type> &	operator=(const idList<type> &other);
+#if __cplusplus >= 201103L
+		idList<type> &	operator=(idList<type> &&other);				// takes over the memory of the other list
+#endif
 		const type 	&operator[](int index) const;
 		type 			&operator[](int index);
 
@@ -125,6 +194,12 @@ class idList
 		int				Append(const idList<type> &other);				// append list
 		int				AddUnique(const type &obj);						// add unique element
 		int				Insert(const type &obj, int index = 0);			// insert the element at the given index
+#if __cplusplus >= 201103L
+		int				Append(type &&obj);								// append element, moving it into the list
+		int				Insert(type &&obj, int index = 0);				// insert element, moving it into the list
+		template< typename... argTypes >
+		int				Emplace(argTypes &&... args);					// append element constructed from the arguments
+#endif
 		int				FindIndex(const type &obj) const;				// find the index for the given element
 		type 			*Find(type const &obj) const;						// find pointer to the given element
 		int				FindNull(void) const;								// find the index for the first NULL pointer in the list
@@ -170,6 +245,22 @@ ID_INLINE idList<type>::idList(const idList<type> &other)
 	*this = other;
 }
 
+#if __cplusplus >= 201103L
+/*
+================
+idList<type>::idList( idList<type> &&other )
+================
+*/
+template< class type >
+ID_INLINE idList<type>::idList(idList<type> &&other)
+{
+	list		= NULL;
+	granularity	= other.granularity;
+	Clear();
+	Swap(other);
+}
+#endif
+
 /*
 ================
 idList<type>::~idList<type>
@@ -375,14 +466,14 @@ ID_INLINE void idList<type>::Condense(void)
 idList<type>::Resize
 
 Allocates memory for the amount of elements requested while keeping the contents intact.
-Contents are copied using their = operator so that data is correnctly instantiated.
+Contents are moved using their = operator so that data is correnctly instantiated.
+Trivially copyable contents are copied with memcpy when the compiler can tell.
 ================
 */
 template< class type >
 ID_INLINE void idList<type>::Resize(int newsize)
 {
 	type	*temp;
-	int		i;
 
 	assert(newsize >= 0);
 
@@ -404,12 +495,9 @@ ID_INLINE void idList<type>::Resize(int newsize)
 		num = size;
 	}
 
-	// copy the old list into our new one
+	// move the old list into our new one
 	list = new type[ size ];
-
-	for (i = 0; i < num; i++) {
-		list[ i ] = temp[ i ];
-	}
+	idListRelocate(list, temp, num);
 
 	// delete the old list if it exists
 	if (temp) {
@@ -422,14 +510,14 @@ ID_INLINE void idList<type>::Resize(int newsize)
 idList<type>::Resize
 
 Allocates memory for the amount of elements requested while keeping the contents intact.
-Contents are copied using their = operator so that data is correnctly instantiated.
+Contents are moved using their = operator so that data is correnctly instantiated.
+Trivially copyable contents are copied with memcpy when the compiler can tell.
 ================
 */
 template< class type >
 ID_INLINE void idList<type>::Resize(int newsize, int newgranularity)
 {
 	type	*temp;
-	int		i;
 
 	assert(newsize >= 0);
 
@@ -449,12 +537,9 @@ ID_INLINE void idList<type>::Resize(int newsize, int newgranularity)
 		num = size;
 	}
 
-	// copy the old list into our new one
+	// move the old list into our new one
 	list = new type[ size ];
-
-	for (i = 0; i < num; i++) {
-		list[ i ] = temp[ i ];
-	}
+	idListRelocate(list, temp, num);
 
 	// delete the old list if it exists
 	if (temp) {
@@ -582,6 +667,26 @@ ID_INLINE idList<type> &idList<type>::operator=(const idList<type> &other)
 	return *this;
 }
 
+#if __cplusplus >= 201103L
+/*
+================
+idList<type>::operator=
+
+Takes over the contents of another list, the other list is left empty.
+================
+*/
+template< class type >
+ID_INLINE idList<type> &idList<type>::operator=(idList<type> &&other)
+{
+	if (this != &other) {
+		Clear();
+		Swap(other);
+	}
+
+	return *this;
+}
+#endif
+
 /*
 ================
 idList<type>::operator[] const
@@ -740,7 +845,7 @@ ID_INLINE int idList<type>::Insert(type const &obj, int index)
 	}
 
 	for (int i = num; i > index; --i) {
-		list[i] = list[i-1];
+		list[i] = idMove(list[i-1]);
 	}
 
 	num++;
@@ -748,6 +853,101 @@ ID_INLINE int idList<type>::Insert(type const &obj, int index)
 	return index;
 }
 
+#if __cplusplus >= 201103L
+/*
+================
+idList<type>::Append
+
+Increases the size of the list by one element and moves the supplied data into it.
+
+Returns the index of the new element.
+================
+*/
+template< class type >
+ID_INLINE int idList<type>::Append(type &&obj)
+{
+	if (!list) {
+		Resize(granularity);
+	}
+
+	if (num == size) {
+		int newsize;
+
+		if (granularity == 0) {	// this is a hack to fix our memset classes
+			granularity = 16;
+		}
+
+		newsize = size + granularity;
+		Resize(newsize - newsize % granularity);
+	}
+
+	list[ num ] = idMove(obj);
+	num++;
+
+	return num - 1;
+}
+
+/*
+================
+idList<type>::Insert
+
+Increases the size of the list by at leat one element if necessary
+and moves the supplied data into it.
+
+Returns the index of the new element.
+================
+*/
+template< class type >
+ID_INLINE int idList<type>::Insert(type &&obj, int index)
+{
+	if (!list) {
+		Resize(granularity);
+	}
+
+	if (num == size) {
+		int newsize;
+
+		if (granularity == 0) {	// this is a hack to fix our memset classes
+			granularity = 16;
+		}
+
+		newsize = size + granularity;
+		Resize(newsize - newsize % granularity);
+	}
+
+	if (index < 0) {
+		index = 0;
+	} else if (index > num) {
+		index = num;
+	}
+
+	for (int i = num; i > index; --i) {
+		list[i] = idMove(list[i-1]);
+	}
+
+	num++;
+	list[index] = idMove(obj);
+	return index;
+}
+
+/*
+================
+idList<type>::Emplace
+
+Appends an element constructed from the arguments. The list allocates its elements
+up front so the new element is built in place of a temporary and moved into the list.
+
+Returns the index of the new element.
+================
+*/
+template< class type >
+template< typename... argTypes >
+ID_INLINE int idList<type>::Emplace(argTypes &&... args)
+{
+	return Append(type(static_cast<argTypes &&>(args)...));
+}
+#endif
+
 /*
 ================
 idList<type>::Append
@@ -914,7 +1114,7 @@ ID_INLINE bool idList<type>::RemoveIndex(int index)
 	num--;
 
 	for (i = index; i < num; i++) {
-		list[ i ] = list[ i + 1 ];
+		list[ i ] = idMove(list[ i + 1 ]);
 	}
 
 	return true;
@@ -63,6 +63,10 @@ class idPoolStr : public idStr
 		const idStrPool 	*GetPool(void) const {
 			return pool;
 		}
+		// returns the number of references to this string
+		int					GetNumUsers(void) const {
+			return numUsers;
+		}
 
 	private:
 		idStrPool 			*pool;
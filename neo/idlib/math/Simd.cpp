@@ -36,6 +36,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "Simd_SSE2.h"
 #include "Simd_SSE3.h"
 #include "Simd_AltiVec.h"
+#include "Simd_NEON.h"
 
 
 idSIMDProcessor		*processor = NULL;			// pointer to SIMD processor
@@ -77,6 +78,8 @@ void idSIMD::InitProcessor(const char *module, bool forceGeneric)
 		if (!processor) {
 			if ((cpuid & CPUID_ALTIVEC)) {
 				processor = new idSIMD_AltiVec;
+			} else if ((cpuid & CPUID_NEON)) {
+				processor = new idSIMD_NEON;
 			} else if ((cpuid & CPUID_MMX) && (cpuid & CPUID_SSE) && (cpuid & CPUID_SSE2) && (cpuid & CPUID_SSE3)) {
 				processor = new idSIMD_SSE3;
 			} else if ((cpuid & CPUID_MMX) && (cpuid & CPUID_SSE) && (cpuid & CPUID_SSE2)) {
@@ -113,6 +116,16 @@ void idSIMD::InitProcessor(const char *module, bool forceGeneric)
 	}
 }
 
+/*
+================
+idSIMD::GetGenericProcessor
+================
+*/
+idSIMDProcessor *idSIMD::GetGenericProcessor(void)
+{
+	return generic;
+}
+
 /*
 ================
 idSIMD::Shutdown
@@ -2595,6 +2608,60 @@ void TestBlendJoints(void)
 	PrintClocks(va("   simd->BlendJoints() %s", result), COUNT, bestClocksSIMD, bestClocksGeneric);
 }
 
+/*
+============
+TestDequantizeComponents
+============
+*/
+void TestDequantizeComponents(void)
+{
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16(unsigned short src[COUNT]);
+	ALIGN16(float bias[COUNT]);
+	ALIGN16(float scale[COUNT]);
+	ALIGN16(float dst1[COUNT]);
+	ALIGN16(float dst2[COUNT]);
+	const char *result;
+
+	idRandom srnd(RANDOM_SEED);
+
+	for (i = 0; i < COUNT; i++) {
+		src[i] = srnd.RandomInt(65536);
+		bias[i] = srnd.CRandomFloat() * 10.0f;
+		scale[i] = srnd.RandomFloat() * 20.0f / 65535.0f;
+	}
+
+	bestClocksGeneric = 0;
+
+	for (i = 0; i < NUMTESTS; i++) {
+		StartRecordTime(start);
+		p_generic->DequantizeComponents(dst1, src, bias, scale, COUNT);
+		StopRecordTime(end);
+		GetBest(start, end, bestClocksGeneric);
+	}
+
+	PrintClocks("generic->DequantizeComponents()", COUNT, bestClocksGeneric);
+
+	bestClocksSIMD = 0;
+
+	for (i = 0; i < NUMTESTS; i++) {
+		StartRecordTime(start);
+		p_simd->DequantizeComponents(dst2, src, bias, scale, COUNT);
+		StopRecordTime(end);
+		GetBest(start, end, bestClocksSIMD);
+	}
+
+	for (i = 0; i < COUNT; i++) {
+		if (idMath::Fabs(dst1[i] - dst2[i]) > 1e-5f) {
+			break;
+		}
+	}
+
+	result = (i >= COUNT) ? "ok" : S_COLOR_RED"X";
+	PrintClocks(va("   simd->DequantizeComponents() %s", result), COUNT, bestClocksSIMD, bestClocksGeneric);
+}
+
 /*
 ============
 TestConvertJointQuatsToJointMats
@@ -4477,8 +4544,15 @@ void idSIMD::Test_f(const idCmdArgs &args)
 			}
 
 			p_simd = new idSIMD_AltiVec();
+		} else if (idStr::Icmp(argString, "NEON") == 0) {
+			if (!(cpuid & CPUID_NEON)) {
+				common->Printf("CPU does not support NEON\n");
+				return;
+			}
+
+			p_simd = new idSIMD_NEON();
 		} else {
-			common->Printf("invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n");
+			common->Printf("invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec, NEON\n");
 			return;
 		}
 	}
@@ -4517,6 +4591,7 @@ void idSIMD::Test_f(const idCmdArgs &args)
 	idLib::common->Printf("====================================\n");
 
 	TestBlendJoints();
+	TestDequantizeComponents();
 	TestConvertJointQuatsToJointMats();
 	TestConvertJointMatsToJointQuats();
 	TestTransformJoints();
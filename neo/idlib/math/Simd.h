@@ -46,6 +46,7 @@ class idSIMD
 		static void			Init(void);
 		static void			InitProcessor(const char *module, bool forceGeneric);
 		static void			Shutdown(void);
+		static class idSIMDProcessor *GetGenericProcessor(void);
 		static void			Test_f(const class idCmdArgs &args);
 };
 
@@ -176,6 +177,7 @@ class idSIMDProcessor
 
 		// rendering
 		virtual void VPCALL BlendJoints(idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints) = 0;
+		virtual void VPCALL DequantizeComponents(float *dst, const unsigned short *src, const float *bias, const float *scale, const int count) = 0;
 		virtual void VPCALL ConvertJointQuatsToJointMats(idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints) = 0;
 		virtual void VPCALL ConvertJointMatsToJointQuats(idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints) = 0;
 		virtual void VPCALL TransformJoints(idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint) = 0;
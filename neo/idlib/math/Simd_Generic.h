@@ -110,6 +110,7 @@ class idSIMD_Generic : public idSIMDProcessor
 		virtual bool VPCALL MatX_LDLTFactor(idMatX &mat, idVecX &invDiag, const int n);
 
 		virtual void VPCALL BlendJoints(idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints);
+		virtual void VPCALL DequantizeComponents(float *dst, const unsigned short *src, const float *bias, const float *scale, const int count);
 		virtual void VPCALL ConvertJointQuatsToJointMats(idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints);
 		virtual void VPCALL ConvertJointMatsToJointQuats(idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints);
 		virtual void VPCALL TransformJoints(idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint);
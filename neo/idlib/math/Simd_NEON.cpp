@@ -0,0 +1,284 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+#include "Simd_Generic.h"
+#include "Simd_NEON.h"
+
+
+//===============================================================
+//
+//	NEON implementation of idSIMDProcessor
+//
+//===============================================================
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+/*
+============
+NEON_Dot
+
+  returns the inner product of a and b, the arrays do not have to be aligned
+============
+*/
+static ID_INLINE float NEON_Dot(const float *a, const float *b, const int count)
+{
+	float32x4_t s0, s1;
+	float32x2_t s;
+	float sum;
+	int i;
+
+	s0 = vdupq_n_f32(0.0f);
+	s1 = vdupq_n_f32(0.0f);
+
+	for (i = 0; i + 8 <= count; i += 8) {
+		s0 = vmlaq_f32(s0, vld1q_f32(a + i + 0), vld1q_f32(b + i + 0));
+		s1 = vmlaq_f32(s1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+	}
+
+	if (i + 4 <= count) {
+		s0 = vmlaq_f32(s0, vld1q_f32(a + i), vld1q_f32(b + i));
+		i += 4;
+	}
+
+	s0 = vaddq_f32(s0, s1);
+	s = vadd_f32(vget_low_f32(s0), vget_high_f32(s0));
+	sum = vget_lane_f32(vpadd_f32(s, s), 0);
+
+	for (; i < count; i++) {
+		sum += a[i] * b[i];
+	}
+
+	return sum;
+}
+
+/*
+============
+NEON_MulSub
+
+  dst[i] -= constant * src[i];
+============
+*/
+static ID_INLINE void NEON_MulSub(float *dst, const float constant, const float *src, const int count)
+{
+	float32x4_t c;
+	int i;
+
+	c = vdupq_n_f32(constant);
+
+	for (i = 0; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vmlsq_f32(vld1q_f32(dst + i), c, vld1q_f32(src + i)));
+	}
+
+	for (; i < count; i++) {
+		dst[i] -= constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_NEON::GetName
+============
+*/
+const char *idSIMD_NEON::GetName(void) const
+{
+	return "NEON";
+}
+
+/*
+============
+idSIMD_NEON::Mul
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_NEON::Mul(float *dst, const float *src0, const float *src1, const int count)
+{
+	int i;
+
+	for (i = 0; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src0 + i), vld1q_f32(src1 + i)));
+	}
+
+	for (; i < count; i++) {
+		dst[i] = src0[i] * src1[i];
+	}
+}
+
+/*
+============
+idSIMD_NEON::MulAdd
+
+  dst[i] += constant * src[i];
+============
+*/
+void VPCALL idSIMD_NEON::MulAdd(float *dst, const float constant, const float *src, const int count)
+{
+	NEON_MulSub(dst, -constant, src, count);
+}
+
+/*
+============
+idSIMD_NEON::MulSub
+
+  dst[i] -= constant * src[i];
+============
+*/
+void VPCALL idSIMD_NEON::MulSub(float *dst, const float constant, const float *src, const int count)
+{
+	NEON_MulSub(dst, constant, src, count);
+}
+
+/*
+============
+idSIMD_NEON::Dot
+
+  dot = src1[0] * src2[0] + src1[1] * src2[1] + src1[2] * src2[2] + ...
+============
+*/
+void VPCALL idSIMD_NEON::Dot(float &dot, const float *src1, const float *src2, const int count)
+{
+	dot = NEON_Dot(src1, src2, count);
+}
+
+/*
+============
+idSIMD_NEON::MatX_LowerTriangularSolve
+
+  solves x in Lx = b for the n * n sub-matrix of L
+  if skip > 0 the first skip elements of x are assumed to be valid already
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+============
+*/
+void VPCALL idSIMD_NEON::MatX_LowerTriangularSolve(const idMatX &L, float *x, const float *b, const int n, int skip)
+{
+	int i;
+
+	for (i = skip; i < n; i++) {
+		x[i] = b[i] - NEON_Dot(L[i], x, i);
+	}
+}
+
+/*
+============
+idSIMD_NEON::MatX_LowerTriangularSolveTranspose
+
+  solves x in L'x = b for the n * n sub-matrix of L
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+
+  the generic code walks the columns of L, here the solved elements are
+  subtracted from the remaining right hand side one row of L at a time
+  so all memory access is sequential
+============
+*/
+void VPCALL idSIMD_NEON::MatX_LowerTriangularSolveTranspose(const idMatX &L, float *x, const float *b, const int n)
+{
+	int i;
+
+	if (x != b) {
+		memcpy(x, b, n * sizeof(float));
+	}
+
+	for (i = n - 1; i > 0; i--) {
+		NEON_MulSub(x, x[i], L[i], i);
+	}
+}
+
+/*
+============
+idSIMD_NEON::MatX_LDLTFactor
+
+  in-place factorization LDL' of the n * n sub-matrix of mat
+  the reciprocal of the diagonal elements are stored in invDiag
+============
+*/
+bool VPCALL idSIMD_NEON::MatX_LDLTFactor(idMatX &mat, idVecX &invDiag, const int n)
+{
+	int i, j;
+	float *v, *diag, *mptr;
+	float sum, d;
+
+	v = (float *) _alloca16(n * sizeof(float));
+	diag = (float *) _alloca16(n * sizeof(float));
+
+	for (i = 0; i < n; i++) {
+
+		mptr = mat[i];
+
+		Mul(v, diag, mptr, i);
+		sum = mptr[i] - NEON_Dot(v, mptr, i);
+
+		if (sum == 0.0f) {
+			return false;
+		}
+
+		mptr[i] = sum;
+		diag[i] = sum;
+		invDiag[i] = d = 1.0f / sum;
+
+		for (j = i + 1; j < n; j++) {
+			mptr = mat[j];
+			mptr[i] = (mptr[i] - NEON_Dot(mptr, v, i)) * d;
+		}
+	}
+
+	return true;
+}
+
+/*
+============
+idSIMD_NEON::DequantizeComponents
+
+  dst[i] = bias[i] + scale[i] * src[i];
+============
+*/
+void VPCALL idSIMD_NEON::DequantizeComponents(float *dst, const unsigned short *src, const float *bias, const float *scale, const int count)
+{
+	uint16x8_t s;
+	float32x4_t lo, hi;
+	int i;
+
+	for (i = 0; i + 8 <= count; i += 8) {
+		s = vld1q_u16(src + i);
+		lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(s)));
+		hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(s)));
+		vst1q_f32(dst + i + 0, vmlaq_f32(vld1q_f32(bias + i + 0), vld1q_f32(scale + i + 0), lo));
+		vst1q_f32(dst + i + 4, vmlaq_f32(vld1q_f32(bias + i + 4), vld1q_f32(scale + i + 4), hi));
+	}
+
+	for (; i < count; i++) {
+		dst[i] = bias[i] + scale[i] * src[i];
+	}
+}
+
+#endif /* __ARM_NEON__ */
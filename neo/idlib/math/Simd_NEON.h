@@ -0,0 +1,60 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __MATH_SIMD_NEON_H__
+#define __MATH_SIMD_NEON_H__
+
+/*
+===============================================================================
+
+	NEON implementation of idSIMDProcessor
+
+===============================================================================
+*/
+
+class idSIMD_NEON : public idSIMD_Generic
+{
+	public:
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+		virtual const char *VPCALL GetName(void) const;
+
+		virtual void VPCALL Mul(float *dst,			const float *src0,		const float *src1,		const int count);
+		virtual void VPCALL MulAdd(float *dst,			const float constant,	const float *src,		const int count);
+		virtual void VPCALL MulSub(float *dst,			const float constant,	const float *src,		const int count);
+
+		virtual void VPCALL Dot(float &dot,			const float *src1,		const float *src2,		const int count);
+
+		virtual void VPCALL MatX_LowerTriangularSolve(const idMatX &L, float *x, const float *b, const int n, int skip = 0);
+		virtual void VPCALL MatX_LowerTriangularSolveTranspose(const idMatX &L, float *x, const float *b, const int n);
+		virtual bool VPCALL MatX_LDLTFactor(idMatX &mat, idVecX &invDiag, const int n);
+
+		virtual void VPCALL DequantizeComponents(float *dst, const unsigned short *src, const float *bias, const float *scale, const int count);
+#endif
+};
+
+#endif /* !__MATH_SIMD_NEON_H__ */
@@ -101,6 +101,9 @@ If you have questions concerning this license or the applicable additional terms
 #include <time.h>
 #include <ctype.h>
 #include <typeinfo>
+#if __cplusplus >= 201103L
+#include <type_traits>
+#endif
 #include <errno.h>
 #include <math.h>
 
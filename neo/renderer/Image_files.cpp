@@ -266,7 +266,7 @@ static void LoadBMP(const char *name, byte **pic, int *width, int *height, ID_TI
 	//
 	// load the file
 	//
-	length = fileSystem->ReadFile(name, (void **)&buffer, timestamp);
+	length = fileSystem->ReadFileMapped(name, (const void **)&buffer, NULL, timestamp);
 
 	if (!buffer) {
 		return;
@@ -395,7 +395,7 @@ static void LoadBMP(const char *name, byte **pic, int *width, int *height, ID_TI
 		}
 	}
 
-	fileSystem->FreeFile(buffer);
+	fileSystem->FreeFileMapped(buffer);
 
 }
 
@@ -579,7 +579,7 @@ static void LoadTGA(const char *name, byte **pic, int *width, int *height, ID_TI
 	//
 	// load the file
 	//
-	fileSize = fileSystem->ReadFile(name, (void **)&buffer, timestamp);
+	fileSize = fileSystem->ReadFileMapped(name, (const void **)&buffer, NULL, timestamp);
 
 	if (!buffer) {
 		return;
@@ -797,7 +797,7 @@ breakOut:
 		R_VerticalFlip(*pic, *width, *height);
 	}
 
-	fileSystem->FreeFile(buffer);
+	fileSystem->FreeFileMapped(buffer);
 }
 
 /*
@@ -847,38 +847,20 @@ static void LoadJPG(const char *filename, unsigned char **pic, int *width, int *
 	 * requires it in order to read binary files.
 	 */
 
-	// JDC: because fill_input_buffer() blindly copies INPUT_BUF_SIZE bytes,
-	// we need to make sure the file buffer is padded or it may crash
-	if (pic) {
-		*pic = NULL;		// until proven otherwise
+	if (!pic) {
+		fileSystem->ReadFile(filename, NULL, timestamp);
+		return;	// just getting timestamp
 	}
 
-	{
-		idFile *f;
-
-		f = fileSystem->OpenFileRead(filename);
-
-		if (!f) {
-			return;
-		}
+	*pic = NULL;		// until proven otherwise
 
-		len = f->Length();
+	// jpeg_mem_src never reads past the end of the buffer, so a view into a pak mapping is fine
+	len = fileSystem->ReadFileMapped(filename, (const void **)&fbuffer, NULL, timestamp);
 
-		if (timestamp) {
-			*timestamp = f->Timestamp();
-		}
-
-		if (!pic) {
-			fileSystem->CloseFile(f);
-			return;	// just getting timestamp
-		}
-
-		fbuffer = (byte *)Mem_ClearedAlloc(len + 4096);
-		f->Read(fbuffer, len);
-		fileSystem->CloseFile(f);
+	if (!fbuffer) {
+		return;
 	}
 
-
 	/* Step 1: allocate and initialize JPEG decompression object */
 
 	/* We have to set up the error handler first, in case the initialization
@@ -984,7 +966,7 @@ static void LoadJPG(const char *filename, unsigned char **pic, int *width, int *
 	 * so as to simplify the setjmp error logic above.  (Actually, I don't
 	 * think that jpeg_destroy can do an error exit, but why assume anything...)
 	 */
-	Mem_Free(fbuffer);
+	fileSystem->FreeFileMapped(fbuffer);
 
 	/* At this point you may want to check to see whether any corrupt-data
 	 * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
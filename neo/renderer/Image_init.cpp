@@ -2196,6 +2196,65 @@ void idImageManager::BeginLevelLoad()
 	}
 }
 
+static const int IMAGE_PREFETCH_AHEAD = 16;
+
+/*
+====================
+R_PrefetchImage
+
+Gets the source files of an image that EndLevelLoad is about to load
+on their way on the async read thread.
+====================
+*/
+static void R_PrefetchImage(const idImage *image)
+{
+	idLexer		src;
+	idToken		token;
+	idStr		name;
+
+	if (image->generatorFunction || !image->levelLoadReferenced || image->texnum != idImage::TEXTURE_NOT_LOADED || image->partialImage) {
+		return;
+	}
+
+	// cube maps get their names from R_LoadCubeImages
+	if (image->cubeFiles != CF_2D) {
+		return;
+	}
+
+#if !defined(GL_ES_VERSION_2_0)
+
+	// the .dds will most likely be used instead
+	if (globalImages->image_usePrecompressedTextures.GetBool() && glConfig.textureCompressionAvailable) {
+		return;
+	}
+
+#endif
+
+	src.LoadMemory(image->imgName, image->imgName.Length(), image->imgName);
+	src.SetFlags(LEXFL_NOFATALERRORS | LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES | LEXFL_NOERRORS | LEXFL_NOWARNINGS);
+
+	while (src.ReadToken(&token)) {
+		if (token.type != TT_NAME || token[0] == '_') {
+			continue;
+		}
+
+		// image program functions
+		if (src.CheckTokenString("(")) {
+			continue;
+		}
+
+		// same search order as R_LoadImage
+		name = token;
+		name.DefaultFileExtension(".tga");
+		name.ToLower();
+
+		if (!fileSystem->PrefetchFile(name) && name.CheckExtension(".tga")) {
+			name.SetFileExtension(".jpg");
+			fileSystem->PrefetchFile(name);
+		}
+	}
+}
+
 /*
 ====================
 EndLevelLoad
@@ -2245,6 +2304,8 @@ void idImageManager::EndLevelLoad()
 	}
 
 	// load the ones we do need, if we are preloading
+	int		prefetchCount = 0;
+
 	for (int i = 0 ; i < images.Num() ; i++) {
 		idImage	*image = images[ i ];
 
@@ -2253,6 +2314,11 @@ void idImageManager::EndLevelLoad()
 		}
 
 		if (image->levelLoadReferenced && image->texnum == idImage::TEXTURE_NOT_LOADED && !image->partialImage) {
+			// keep the async read thread busy with the images coming up
+			for (; prefetchCount < images.Num() && prefetchCount <= i + IMAGE_PREFETCH_AHEAD; prefetchCount++) {
+				R_PrefetchImage(images[ prefetchCount ]);
+			}
+
 //			common->Printf( "Loading %s\n", image->imgName.c_str() );
 			loadCount++;
 			image->ActuallyLoadImage(true, false);
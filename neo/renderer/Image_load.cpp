@@ -1694,6 +1694,7 @@ void	idImage::ActuallyLoadImage(bool checkForPrecompressed, bool fromBackEnd)
 {
 	int		width, height;
 	byte	*pic;
+	idScopedMemTag	memTag(MEMTAG_IMAGES);
 
 	// this is the ONLY place generatorFunction will ever be called
 	if (generatorFunction) {
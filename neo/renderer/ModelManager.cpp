@@ -267,6 +267,7 @@ idRenderModel *idRenderModelManagerLocal::GetModel(const char *modelName, bool c
 {
 	idStr		canonical;
 	idStr		extension;
+	idScopedMemTag	memTag(MEMTAG_GEOMETRY);
 
 	if (!modelName || !modelName[0]) {
 		return NULL;
@@ -534,6 +535,8 @@ void idRenderModelManagerLocal::BeginLevelLoad()
 	R_PurgeTriSurfData(frameData);
 }
 
+static const int MODEL_PREFETCH_AHEAD = 8;
+
 /*
 =================
 idRenderModelManagerLocal::EndLevelLoad
@@ -576,11 +579,22 @@ void idRenderModelManagerLocal::EndLevelLoad()
 	R_PurgeTriSurfData(frameData);
 
 	// load any new ones
+	int prefetchCount = 0;
+
 	for (int i = 0 ; i < models.Num() ; i++) {
 		idRenderModel *model = models[i];
 
 		if (model->IsLevelLoadReferenced() && !model->IsLoaded() && model->IsReloadable()) {
 
+			// keep the async read thread busy with the models coming up
+			for (; prefetchCount < models.Num() && prefetchCount <= i + MODEL_PREFETCH_AHEAD; prefetchCount++) {
+				idRenderModel *next = models[prefetchCount];
+
+				if (next->IsLevelLoadReferenced() && !next->IsLoaded() && next->IsReloadable() && next->Name()[0] != '_') {
+					fileSystem->PrefetchFile(next->Name());
+				}
+			}
+
 			loadCount++;
 			model->LoadModel();
 
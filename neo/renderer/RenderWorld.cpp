@@ -139,7 +139,7 @@ void R_ListRenderEntityDefs_f(const idCmdArgs &args)
 idRenderWorldLocal::idRenderWorldLocal
 ===================
 */
-idRenderWorldLocal::idRenderWorldLocal()
+idRenderWorldLocal::idRenderWorldLocal() : levelArena("renderWorld", MEMTAG_GEOMETRY)
 {
 	mapName.Clear();
 	mapTimeStamp = FILE_NOT_FOUND_TIMESTAMP;
@@ -54,7 +54,6 @@ void idRenderWorldLocal::FreeWorld()
 		for (portal = area->portals ; portal ; portal = nextPortal) {
 			nextPortal = portal->next;
 			delete portal->w;
-			R_StaticFree(portal);
 		}
 
 		// there shouldn't be any remaining lightRefs or entityRefs
@@ -67,24 +66,15 @@ void idRenderWorldLocal::FreeWorld()
 		}
 	}
 
-	if (portalAreas) {
-		R_StaticFree(portalAreas);
-		portalAreas = NULL;
-		numPortalAreas = 0;
-		R_StaticFree(areaScreenRect);
-		areaScreenRect = NULL;
-	}
-
-	if (doublePortals) {
-		R_StaticFree(doublePortals);
-		doublePortals = NULL;
-		numInterAreaPortals = 0;
-	}
+	// the portals, areas and nodes all come from the level arena
+	levelArena.FreeAll();
 
-	if (areaNodes) {
-		R_StaticFree(areaNodes);
-		areaNodes = NULL;
-	}
+	portalAreas = NULL;
+	numPortalAreas = 0;
+	areaScreenRect = NULL;
+	doublePortals = NULL;
+	numInterAreaPortals = 0;
+	areaNodes = NULL;
 
 	// free all the inline idRenderModels
 	for (i = 0 ; i < localModels.Num() ; i++) {
@@ -297,8 +287,8 @@ void idRenderWorldLocal::ParseInterAreaPortals(idLexer *src)
 		return;
 	}
 
-	portalAreas = (portalArea_t *)R_ClearedStaticAlloc(numPortalAreas * sizeof(portalAreas[0]));
-	areaScreenRect = (idScreenRect *) R_ClearedStaticAlloc(numPortalAreas * sizeof(idScreenRect));
+	portalAreas = (portalArea_t *)levelArena.ClearedAlloc(numPortalAreas * sizeof(portalAreas[0]));
+	areaScreenRect = (idScreenRect *) levelArena.ClearedAlloc(numPortalAreas * sizeof(idScreenRect));
 
 	// set the doubly linked lists
 	SetupAreaRefs();
@@ -310,7 +300,7 @@ void idRenderWorldLocal::ParseInterAreaPortals(idLexer *src)
 		return;
 	}
 
-	doublePortals = (doublePortal_t *)R_ClearedStaticAlloc(numInterAreaPortals *
+	doublePortals = (doublePortal_t *)levelArena.ClearedAlloc(numInterAreaPortals *
 	                sizeof(doublePortals [0]));
 
 	for (i = 0 ; i < numInterAreaPortals ; i++) {
@@ -333,7 +323,7 @@ void idRenderWorldLocal::ParseInterAreaPortals(idLexer *src)
 		}
 
 		// add the portal to a1
-		p = (portal_t *)R_ClearedStaticAlloc(sizeof(*p));
+		p = (portal_t *)levelArena.ClearedAlloc(sizeof(*p));
 		p->intoArea = a2;
 		p->doublePortal = &doublePortals[i];
 		p->w = w;
@@ -345,7 +335,7 @@ void idRenderWorldLocal::ParseInterAreaPortals(idLexer *src)
 		doublePortals[i].portals[0] = p;
 
 		// reverse it for a2
-		p = (portal_t *)R_ClearedStaticAlloc(sizeof(*p));
+		p = (portal_t *)levelArena.ClearedAlloc(sizeof(*p));
 		p->intoArea = a1;
 		p->doublePortal = &doublePortals[i];
 		p->w = w->Reverse();
@@ -377,7 +367,7 @@ void idRenderWorldLocal::ParseNodes(idLexer *src)
 		src->Error("R_ParseNodes: bad numAreaNodes");
 	}
 
-	areaNodes = (areaNode_t *)R_ClearedStaticAlloc(numAreaNodes * sizeof(areaNodes[0]));
+	areaNodes = (areaNode_t *)levelArena.ClearedAlloc(numAreaNodes * sizeof(areaNodes[0]));
 
 	for (i = 0 ; i < numAreaNodes ; i++) {
 		areaNode_t	*node;
@@ -441,15 +431,15 @@ Sets up for a single area world
 void idRenderWorldLocal::ClearWorld()
 {
 	numPortalAreas = 1;
-	portalAreas = (portalArea_t *)R_ClearedStaticAlloc(sizeof(portalAreas[0]));
-	areaScreenRect = (idScreenRect *) R_ClearedStaticAlloc(sizeof(idScreenRect));
+	portalAreas = (portalArea_t *)levelArena.ClearedAlloc(sizeof(portalAreas[0]));
+	areaScreenRect = (idScreenRect *) levelArena.ClearedAlloc(sizeof(idScreenRect));
 
 	SetupAreaRefs();
 
 	// even though we only have a single area, create a node
 	// that has both children pointing at it so we don't need to
 	//
-	areaNodes = (areaNode_t *)R_ClearedStaticAlloc(sizeof(areaNodes[0]));
+	areaNodes = (areaNode_t *)levelArena.ClearedAlloc(sizeof(areaNodes[0]));
 	areaNodes[0].plane[3] = 1;
 	areaNodes[0].children[0] = -1;
 	areaNodes[0].children[1] = -1;
@@ -512,6 +502,7 @@ bool idRenderWorldLocal::InitFromMap(const char *name)
 	idToken			token;
 	idStr			filename;
 	idRenderModel 	*lastModel;
+	idScopedMemTag	memTag(MEMTAG_GEOMETRY);
 
 	// if this is an empty world, initialize manually
 	if (!name || !name[0]) {
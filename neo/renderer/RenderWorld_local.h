@@ -159,6 +159,9 @@ class idRenderWorldLocal : public idRenderWorld
 		idBlockAlloc<idInteraction, 256>	interactionAllocator;
 		idBlockAlloc<areaNumRef_t, 1024>	areaNumRefAllocator;
 
+		// portals, areas and area nodes of the loaded map
+		idLevelArena			levelArena;
+
 		// all light / entity interactions are referenced here for fast lookup without
 		// having to crawl the doubly linked lists.  EnntityDefs are sequential for better
 		// cache access, because the table is accessed by light in idRenderWorldLocal::CreateLightDefInteractions()
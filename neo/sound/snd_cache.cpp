@@ -90,6 +90,7 @@ Adds a sound object to the cache and returns a handle for it.
 idSoundSample *idSoundCache::FindSound(const idStr &filename, bool loadOnDemandOnly)
 {
 	idStr fname;
+	idScopedMemTag	memTag(MEMTAG_SOUND);
 
 	fname = filename;
 	fname.BackSlashesToSlashes();
@@ -136,6 +137,41 @@ idSoundSample *idSoundCache::FindSound(const idStr &filename, bool loadOnDemandO
 	return def;
 }
 
+/*
+===================
+idSoundCache::PrefetchSound
+
+Only done during level loads, idWaveFile::Open prefers the .ogg version.
+===================
+*/
+void idSoundCache::PrefetchSound(const idStr &filename)
+{
+	idStr fname;
+
+	if (!insideLevelLoad) {
+		return;
+	}
+
+	fname = filename;
+	fname.BackSlashesToSlashes();
+	fname.ToLower();
+
+	for (int i = 0; i < listCache.Num(); i++) {
+		idSoundSample *def = listCache[i];
+
+		if (def && def->name == fname && !def->purged) {
+			return;
+		}
+	}
+
+	idStr oggName = fname;
+	oggName.SetFileExtension(".ogg");
+
+	if (!fileSystem->PrefetchFile(oggName)) {
+		fileSystem->PrefetchFile(fname);
+	}
+}
+
 /*
 ===================
 idSoundCache::ReloadSounds
@@ -470,6 +506,8 @@ Loads based on name, possibly doing a MakeDefault if necessary
 */
 void idSoundSample::Load(void)
 {
+	idScopedMemTag	memTag(MEMTAG_SOUND);
+
 	defaultSound = false;
 	purged = false;
 	hardwareBuffer = false;
@@ -999,6 +999,8 @@ class idSoundCache
 		~idSoundCache();
 
 		idSoundSample 			*FindSound(const idStr &fname, bool loadOnDemandOnly);
+		// starts reading a sample that is about to be loaded in the background
+		void					PrefetchSound(const idStr &fname);
 
 		const int				GetNumObjects(void) {
 			return listCache.Num();
@@ -128,6 +128,42 @@ const char *idSoundShader::DefaultDefinition() const
 	        "}";
 }
 
+/*
+===============
+PrefetchShaderSamples
+
+Gets the sample files of a shader on their way before ParseShader
+loads them one after the other.
+===============
+*/
+static void PrefetchShaderSamples(const char *text, const int textLength)
+{
+	idLexer		src;
+	idToken		token;
+	idStrList	samples;
+
+	if (!soundSystemLocal.soundCache) {
+		return;
+	}
+
+	src.LoadMemory(text, textLength, "");
+	src.SetFlags(DECL_LEXER_FLAGS | LEXFL_NOERRORS | LEXFL_NOWARNINGS);
+
+	while (src.ReadToken(&token)) {
+		if (!token.Icmp("onDemand")) {
+			return;
+		}
+
+		if (samples.Num() < SOUND_MAX_LIST_WAVS && (token.Find(".wav", false) != -1 || token.Find(".ogg", false) != -1)) {
+			samples.Append(token);
+		}
+	}
+
+	for (int i = 0; i < samples.Num(); i++) {
+		soundSystemLocal.soundCache->PrefetchSound(samples[i]);
+	}
+}
+
 /*
 ===============
 idSoundShader::Parse
@@ -139,6 +175,8 @@ bool idSoundShader::Parse(const char *text, const int textLength)
 {
 	idLexer	src;
 
+	PrefetchShaderSamples(text, textLength);
+
 	src.LoadMemory(text, textLength, GetFileName(), GetLineNum());
 	src.SetFlags(DECL_LEXER_FLAGS);
 	src.SkipUntilString("{");
@@ -307,7 +307,11 @@ Sys_GetProcessorId
 */
 cpuid_t Sys_GetProcessorId(void)
 {
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+	return (cpuid_t)(CPUID_GENERIC | CPUID_NEON);
+#else
 	return CPUID_GENERIC;
+#endif
 }
 
 /*
@@ -317,7 +321,11 @@ Sys_GetProcessorString
 */
 const char *Sys_GetProcessorString(void)
 {
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+	return "generic NEON";
+#else
 	return "generic";
+#endif
 }
 
 /*
@@ -271,6 +271,68 @@ int Sys_ListFiles(const char *directory, const char *extension, idStrList &list)
 	return list.Num();
 }
 
+/*
+================
+Sys_MapFile
+
+mmap wants a page aligned offset, the returned pointer is moved past the extra
+bytes at the start of the first page.
+================
+*/
+const void *Sys_MapFile(FILE *fp, int offset, int length)
+{
+	long pageSize;
+	int pageOffset;
+	byte *data;
+
+	if (!fp || offset < 0 || length <= 0) {
+		return NULL;
+	}
+
+	pageSize = sysconf(_SC_PAGESIZE);
+	pageOffset = offset % pageSize;
+
+	// the mapping stays valid after the file is closed
+	data = (byte *)mmap(NULL, length + pageOffset, PROT_READ, MAP_PRIVATE, fileno(fp), offset - pageOffset);
+
+	if (data == (byte *)MAP_FAILED) {
+		return NULL;
+	}
+
+	return data + pageOffset;
+}
+
+/*
+================
+Sys_UnmapFile
+================
+*/
+void Sys_UnmapFile(const void *data, int length)
+{
+	long pageSize;
+	int pageOffset;
+
+	if (!data) {
+		return;
+	}
+
+	pageSize = sysconf(_SC_PAGESIZE);
+	pageOffset = (int)((size_t)data % pageSize);
+	munmap((byte *)const_cast<void *>(data) - pageOffset, length + pageOffset);
+}
+
+/*
+================
+Sys_ReadAhead
+================
+*/
+void Sys_ReadAhead(FILE *fp, int offset, int length)
+{
+	if (fp && length > 0) {
+		posix_fadvise(fileno(fp), offset, length, POSIX_FADV_WILLNEED);
+	}
+}
+
 /*
 ============================================================================
 EVENT LOOP
@@ -273,6 +273,165 @@ const char *Sys_GetThreadName(int *index)
 	return "main";
 }
 
+/*
+======================================================
+job threads
+
+parallel jobs are split in batches between the job threads and the calling thread.
+the threads are started on the first call and sleep on job_wake in between
+======================================================
+*/
+
+const int MAX_JOB_THREADS			= 4;
+
+static idCVar sys_jobThreads("sys_jobThreads", "3", CVAR_SYSTEM | CVAR_INIT | CVAR_INTEGER, "number of threads helping with parallel jobs, 0 runs them on the calling thread", 0, MAX_JOB_THREADS);
+
+static const char		*jobThreadNames[ MAX_JOB_THREADS ] = { "job0", "job1", "job2", "job3" };
+static xthreadInfo		jobThreads[ MAX_JOB_THREADS ];
+static int				numJobThreads = -1;		// -1 until the threads are started
+
+static pthread_mutex_t	job_lock;
+static pthread_cond_t	job_wake;
+static pthread_cond_t	job_done;
+
+static xjob_t			jobFunction;
+static void				*jobData;
+static int				jobCount;
+static int				jobNext;
+static int				jobBatch;
+static int				jobPending;
+static int				jobGeneration;
+static bool				jobActive;
+
+/*
+==================
+Sys_RunJobs
+
+runs batches of the current job until none are left, job_lock must be held
+==================
+*/
+static void Sys_RunJobs(void)
+{
+	while (jobNext < jobCount) {
+		xjob_t function = jobFunction;
+		void *data = jobData;
+		int first = jobNext;
+		int last = Min(first + jobBatch, jobCount);
+
+		jobNext = last;
+
+		pthread_mutex_unlock(&job_lock);
+
+		for (int i = first; i < last; i++) {
+			function(data, i);
+		}
+
+		pthread_mutex_lock(&job_lock);
+
+		jobPending -= last - first;
+
+		if (jobPending == 0) {
+			pthread_cond_broadcast(&job_done);
+		}
+	}
+}
+
+/*
+==================
+Sys_JobThread
+==================
+*/
+static void Sys_JobThreadCleanup(void *parms)
+{
+	pthread_mutex_unlock(&job_lock);
+}
+
+static void *Sys_JobThread(void *parms)
+{
+	int generation = 0;
+
+	pthread_mutex_lock(&job_lock);
+	pthread_cleanup_push(Sys_JobThreadCleanup, NULL);
+
+	while (1) {
+		while (generation == jobGeneration) {
+			pthread_cond_wait(&job_wake, &job_lock);
+		}
+
+		generation = jobGeneration;
+		Sys_RunJobs();
+	}
+
+	pthread_cleanup_pop(1);
+	return NULL;
+}
+
+/*
+==================
+Sys_NumJobThreads
+==================
+*/
+int Sys_NumJobThreads(void)
+{
+	return Max(numJobThreads, 0);
+}
+
+/*
+==================
+Sys_ParallelJobs
+==================
+*/
+void Sys_ParallelJobs(xjob_t function, void *data, int count)
+{
+	if (count <= 0) {
+		return;
+	}
+
+	pthread_mutex_lock(&job_lock);
+
+	if (numJobThreads < 0) {
+		numJobThreads = 0;
+
+		for (int i = 0; i < sys_jobThreads.GetInteger(); i++) {
+			Sys_CreateThread(Sys_JobThread, NULL, THREAD_NORMAL, jobThreads[ i ], jobThreadNames[ i ], g_threads, &g_thread_count);
+			numJobThreads++;
+		}
+	}
+
+	if (jobActive || numJobThreads == 0 || count == 1) {
+		// a job is adding more jobs, or another thread is already running a job
+		pthread_mutex_unlock(&job_lock);
+
+		for (int i = 0; i < count; i++) {
+			function(data, i);
+		}
+
+		return;
+	}
+
+	// a few batches per thread so that uneven jobs still balance
+	jobActive = true;
+	jobFunction = function;
+	jobData = data;
+	jobCount = count;
+	jobNext = 0;
+	jobBatch = Max(1, count / ((numJobThreads + 1) * 4));
+	jobPending = count;
+	jobGeneration++;
+
+	pthread_cond_broadcast(&job_wake);
+
+	Sys_RunJobs();
+
+	while (jobPending > 0) {
+		pthread_cond_wait(&job_done, &job_lock);
+	}
+
+	jobActive = false;
+
+	pthread_mutex_unlock(&job_lock);
+}
+
 /*
 =========================================================
 Async Thread
@@ -326,5 +485,10 @@ void Posix_InitPThreads()
 	for (i = 0; i < MAX_THREADS; i++) {
 		g_threads[ i ] = NULL;
 	}
+
+	// init job threads, they are started on demand
+	pthread_mutex_init(&job_lock, NULL);
+	pthread_cond_init(&job_wake, NULL);
+	pthread_cond_init(&job_done, NULL);
 }
 
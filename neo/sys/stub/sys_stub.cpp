@@ -157,6 +157,19 @@ void	Sys_Mkdir(const char *path)
 {
 }
 
+const void *Sys_MapFile(FILE *fp, int offset, int length)
+{
+	return NULL;
+}
+
+void	Sys_UnmapFile(const void *data, int length)
+{
+}
+
+void	Sys_ReadAhead(FILE *fp, int offset, int length)
+{
+}
+
 const char *Sys_DefaultCDPath(void)
 {
 	return "";
@@ -179,6 +179,26 @@ void idSysLocal::FPU_EnableExceptions(int exceptions)
 	Sys_FPU_EnableExceptions(exceptions);
 }
 
+void idSysLocal::ParallelJobs(xjob_t function, void *data, int count)
+{
+	Sys_ParallelJobs(function, data, count);
+}
+
+int idSysLocal::NumJobThreads(void)
+{
+	return Sys_NumJobThreads();
+}
+
+void idSysLocal::EnterCriticalSection(int index)
+{
+	Sys_EnterCriticalSection(index);
+}
+
+void idSysLocal::LeaveCriticalSection(int index)
+{
+	Sys_LeaveCriticalSection(index);
+}
+
 /*
 =================
 Sys_TimeStampToStr
@@ -72,6 +72,11 @@ class idSysLocal : public idSys
 
 		virtual void			OpenURL(const char *url, bool quit);
 		virtual void			StartProcess(const char *exeName, bool quit);
+
+		virtual void			ParallelJobs(xjob_t function, void *data, int count);
+		virtual int				NumJobThreads(void);
+		virtual void			EnterCriticalSection(int index);
+		virtual void			LeaveCriticalSection(int index);
 };
 
 #endif /* !__SYS_LOCAL__ */
@@ -114,7 +114,8 @@ typedef enum {
 	CPUID_HTT							= 0x01000,	// Hyper-Threading Technology
 	CPUID_CMOV							= 0x02000,	// Conditional Move (CMOV) and fast floating point comparison (FCOMI) instructions
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
-	CPUID_DAZ							= 0x08000	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_DAZ							= 0x08000,	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_NEON							= 0x10000	// ARM Advanced SIMD
 } cpuid_t;
 
 typedef enum {
@@ -340,6 +341,12 @@ const char 	*Sys_EXEPath(void);
 // returns -1 if directory was not found (the list is cleared)
 int				Sys_ListFiles(const char *directory, const char *extension, idList<class idStr> &list);
 
+// maps length bytes at offset of an open file read-only into the address space, returns NULL if it can't be mapped
+const void 	*Sys_MapFile(FILE *fp, int offset, int length);
+void			Sys_UnmapFile(const void *data, int length);
+// asks the OS to start reading a part of a file into its cache
+void			Sys_ReadAhead(FILE *fp, int offset, int length);
+
 // know early if we are performing a fatal error shutdown so the error message doesn't get lost
 void			Sys_SetFatalError(const char *error);
 
@@ -483,18 +490,27 @@ enum {
 void				Sys_EnterCriticalSection(int index = CRITICAL_SECTION_ZERO);
 void				Sys_LeaveCriticalSection(int index = CRITICAL_SECTION_ZERO);
 
-const int MAX_TRIGGER_EVENTS		= 4;
+const int MAX_TRIGGER_EVENTS		= 6;
 
 enum {
 	TRIGGER_EVENT_ZERO = 0,
 	TRIGGER_EVENT_ONE,
 	TRIGGER_EVENT_TWO,
-	TRIGGER_EVENT_THREE
+	TRIGGER_EVENT_THREE,
+	TRIGGER_EVENT_FOUR,
+	TRIGGER_EVENT_FIVE
 };
 
 void				Sys_WaitForEvent(int index = TRIGGER_EVENT_ZERO);
 void				Sys_TriggerEvent(int index = TRIGGER_EVENT_ZERO);
 
+typedef void (*xjob_t)(void *data, int index);
+
+// runs function( data, i ) for every i in [0, count) on the job threads and the calling thread
+// returns once all of them are done, nested or concurrent calls run on the calling thread alone
+void				Sys_ParallelJobs(xjob_t function, void *data, int count);
+int					Sys_NumJobThreads(void);
+
 /*
 ==============================================================
 
@@ -538,6 +554,11 @@ class idSys
 
 		virtual void			OpenURL(const char *url, bool quit) = 0;
 		virtual void			StartProcess(const char *exePath, bool quit) = 0;
+
+		virtual void			ParallelJobs(xjob_t function, void *data, int count) = 0;
+		virtual int				NumJobThreads(void) = 0;
+		virtual void			EnterCriticalSection(int index) = 0;
+		virtual void			LeaveCriticalSection(int index) = 0;
 };
 
 extern idSys 				*sys;
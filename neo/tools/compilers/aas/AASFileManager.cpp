@@ -60,6 +60,8 @@ idAASFileManagerLocal::LoadAAS
 */
 idAASFile *idAASFileManagerLocal::LoadAAS(const char *fileName, unsigned int mapFileCRC)
 {
+	idScopedMemTag	memTag(MEMTAG_AAS);
+
 	idAASFileLocal *file = new idAASFileLocal();
 
 	if (!file->Load(fileName, mapFileCRC)) {
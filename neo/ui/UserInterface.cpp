@@ -211,6 +211,8 @@ void idUserInterfaceManagerLocal::DeAlloc(idUserInterface *gui)
 
 idUserInterface *idUserInterfaceManagerLocal::FindGui(const char *qpath, bool autoLoad, bool needUnique, bool forceNOTUnique)
 {
+	idScopedMemTag	memTag(MEMTAG_GUI);
+
 	int c = guis.Num();
 
 	for (int i = 0; i < c; i++) {
@@ -312,6 +314,7 @@ bool idUserInterfaceLocal::IsInteractive() const
 
 bool idUserInterfaceLocal::InitFromFile(const char *qpath, bool rebuild, bool cache)
 {
+	idScopedMemTag	memTag(MEMTAG_GUI);
 
 	if (!(qpath && *qpath)) {
 		// FIXME: Memory leak!!